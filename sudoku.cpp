@@ -13,15 +13,20 @@
 // To solve puzzles in file sudoku17 with multi-threading, execute the below
 // $ bin/sudokusse.exe sudoku17 -N
 //
+// To count solutions of a puzzle in file puzzle_text_filename with multi-threading, execute the below
+// $ bin/sudokusse.exe 0 -N < puzzle_text_filename
+//
 // If you set C++ macro __DIAGONAL_SUDOKU=1__ and assembly macro
 // __DiagonalSudoku=1__ , the executable solves diagonal Sudoku puzzles
 // instead of original Sudoku puzzles.
 
 #include <algorithm>
+#include <atomic>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <limits>
+#include <numeric>
 #include <sstream>
 #include <typeinfo>
 #include <type_traits>
@@ -41,10 +46,10 @@ namespace {
 }
 
 extern "C" {
-    void PrintPattern(void) {
-        auto pInstance = SudokuSseEnumeratorMap::GetInstance();
+    void PrintPattern(SudokuSseEnumeratorContext* pContext) {
+        auto pInstance = pContext->pInstance;
         if (pInstance) {
-            pInstance->PrintFromAsm(sudokuXmmToPrint);
+            pInstance->PrintFromAsm(pContext->xmmToPrint);
         }
         return;
     }
@@ -106,14 +111,64 @@ namespace Sudoku {
 
         return;
     }
+
+    namespace {
+        bool subsetEliminationEnabled = false;
+    }
+
+    void SetSubsetElimination(bool enabled) {
+        subsetEliminationEnabled = enabled;
+        return;
+    }
+
+    bool UsesSubsetElimination(void) {
+        return subsetEliminationEnabled;
+    }
+
+    namespace {
+        SudokuBranchPolicy branchPolicy = SudokuBranchPolicy::FIXED_GROUP;
+    }
+
+    void SetBranchPolicy(SudokuBranchPolicy policy) {
+        branchPolicy = policy;
+        return;
+    }
+
+    SudokuBranchPolicy GetBranchPolicy(void) {
+        return branchPolicy;
+    }
+
+    namespace {
+        SudokuValueOrder valueOrder = SudokuValueOrder::ASCENDING;
+    }
+
+    void SetValueOrder(SudokuValueOrder order) {
+        valueOrder = order;
+        return;
+    }
+
+    SudokuValueOrder GetValueOrder(void) {
+        return valueOrder;
+    }
 }
 
 SudokuBaseSolver::SudokuBaseSolver(std::ostream* pSudokuOutStream) {
     count_ = 0;
+    guessCount_ = 0;
     pSudokuOutStream_ = pSudokuOutStream;
     return;
 }
 
+// Returns how many times this solver filled cells
+int SudokuBaseSolver::GetStepCount(void) const {
+    return count_;
+}
+
+// Returns how many times this solver guessed a candidate in backtracking
+int SudokuBaseSolver::GetGuessCount(void) const {
+    return guessCount_;
+}
+
 void SudokuBaseSolver::printType(const std::string& typeStr, std::ostream* pSudokuOutStream) {
     if (pSudokuOutStream) {
         (*pSudokuOutStream) << "[" << typeStr << "]\n";
@@ -121,6 +176,185 @@ void SudokuBaseSolver::printType(const std::string& typeStr, std::ostream* pSudo
     return;
 }
 
+void SudokuBaseSolver::clearCount(void) {
+    count_ = 0;
+    guessCount_ = 0;
+    return;
+}
+
+// Returns true if finding naked and hidden subsets is enabled and
+// the remaining search looks expensive when a solver stalls
+bool SudokuBaseSolver::canFindSubsets(SudokuIndex filledCellCnt) const {
+    return (Sudoku::UsesSubsetElimination() && (count_ < Sudoku::SubsetStepBudget) &&
+            (filledCellCnt <= Sudoku::MaxFilledCellsToFindSubsets));
+}
+
+// Define static constexpr members to refer them before C++17
+constexpr SudokuBranchSelector::GroupTable SudokuBranchSelector::Group_;
+constexpr SudokuBranchSelector::GroupTable SudokuBranchSelector::ReverseGroup_;
+constexpr SudokuIndex SudokuBranchSelector::TooManyCandidates;
+
+bool SudokuBranchSelector::Select(SudokuBranchPolicy policy, const CountSet& countSet, SudokuIndex& cellIndex) {
+    return (policy == SudokuBranchPolicy::MIN_REMAINING) ?
+        selectInCells(countSet, cellIndex) : selectInGroups(countSet, cellIndex);
+}
+
+// Selects a cell which has the fewest candidates in a group in the same manner as
+// SudokuMap::SelectBacktrackedCellIndex() but compares rows, columns, and boxes.
+// Prefers a group which has fewer candidates in ties.
+bool SudokuBranchSelector::selectInGroups(const CountSet& countSet, SudokuIndex& cellIndex) {
+    SudokuIndex leastCount = TooManyCandidates;
+    SudokuIndex leastGroupCount = 0;
+
+    for(SudokuLoopIndex group=0;group<(Geometry::SizeOfGroupsPerCell * Geometry::SizeOfGroupsPerMap);++group) {
+        SudokuIndex groupCount = 0;
+        SudokuIndex leastCountOfGroup = TooManyCandidates;
+        SudokuIndex candidateCellIndex = 0;
+        for(SudokuLoopIndex position=0;position<Geometry::SizeOfCellsPerGroup;++position) {
+            const auto index = Group_[group * Geometry::SizeOfCellsPerGroup + position];
+            const auto count = countSet[index];
+            groupCount = static_cast<SudokuIndex>(groupCount + count);
+            if ((count > Sudoku::SizeOfUniqueCandidate) && (leastCountOfGroup > count)) {
+                leastCountOfGroup = count;
+                candidateCellIndex = index;
+            }
+        }
+
+        if ((leastCountOfGroup < TooManyCandidates) &&
+            ((leastCount > leastCountOfGroup) ||
+             ((leastCount == leastCountOfGroup) && (leastGroupCount > groupCount)))) {
+            leastCount = leastCountOfGroup;
+            leastGroupCount = groupCount;
+            cellIndex = candidateCellIndex;
+        }
+    }
+
+    return (leastCount < TooManyCandidates);
+}
+
+// Selects a cell which has the fewest candidates in all cells (minimum remaining values).
+// Prefers a cell which has more blank cells in its row, column, and box in ties
+// because guessing it constrains more cells.
+bool SudokuBranchSelector::selectInCells(const CountSet& countSet, SudokuIndex& cellIndex) {
+    SudokuIndex blankCountSet[Geometry::SizeOfGroupsPerCell * Geometry::SizeOfGroupsPerMap] {0};
+    for(SudokuLoopIndex group=0;group<(Geometry::SizeOfGroupsPerCell * Geometry::SizeOfGroupsPerMap);++group) {
+        for(SudokuLoopIndex position=0;position<Geometry::SizeOfCellsPerGroup;++position) {
+            const auto count = countSet[Group_[group * Geometry::SizeOfCellsPerGroup + position]];
+            blankCountSet[group] = static_cast<SudokuIndex>(blankCountSet[group] + ((count > Sudoku::SizeOfUniqueCandidate) ? 1 : 0));
+        }
+    }
+
+    SudokuIndex leastCount = TooManyCandidates;
+    SudokuIndex mostDegree = 0;
+    for(SudokuLoopIndex index=0;index<Geometry::SizeOfAllCells;++index) {
+        const auto count = countSet[index];
+        if ((count <= Sudoku::SizeOfUniqueCandidate) || (count > leastCount)) {
+            continue;
+        }
+
+        SudokuIndex degree = 0;
+        for(SudokuLoopIndex groupId=0;groupId<Geometry::SizeOfGroupsPerCell;++groupId) {
+            const auto groupIndex = ReverseGroup_[index * Geometry::SizeOfGroupsPerCell + groupId];
+            degree = static_cast<SudokuIndex>(degree + blankCountSet[groupId * Geometry::SizeOfGroupsPerMap + groupIndex]);
+        }
+
+        if ((leastCount > count) || (mostDegree < degree)) {
+            leastCount = count;
+            mostDegree = degree;
+            cellIndex = static_cast<SudokuIndex>(index);
+        }
+    }
+
+    return (leastCount < TooManyCandidates);
+}
+
+// Orders candidates of a cell to guess with a value order.
+// Prefers smaller numbers in ties as the assembly code does.
+SudokuIndex SudokuBranchSelector::Order(SudokuValueOrder order, const CandidatesSet& candidatesSet,
+                                        SudokuIndex cellIndex, OrderedSet& orderedSet) {
+    const auto size = orderAscending(candidatesSet[cellIndex], orderedSet);
+    if ((order == SudokuValueOrder::ASCENDING) || (size <= Sudoku::SizeOfUniqueCandidate)) {
+        return size;
+    }
+
+    SudokuIndex scoreSet[Geometry::SizeOfCandidates] {0};
+    for(SudokuLoopIndex i=0;i<size;++i) {
+        scoreSet[i] = (order == SudokuValueOrder::LEAST_CONSTRAINING) ?
+            countPeers(candidatesSet, cellIndex, orderedSet[i]) : countPlaces(candidatesSet, cellIndex, orderedSet[i]);
+    }
+
+    // Insertion sort is stable and fast enough for nine numbers
+    for(SudokuLoopIndex i=1;i<size;++i) {
+        const auto score = scoreSet[i];
+        const auto candidate = orderedSet[i];
+        auto position = i;
+        for(;(position > 0) && (scoreSet[position-1] > score);--position) {
+            scoreSet[position] = scoreSet[position-1];
+            orderedSet[position] = orderedSet[position-1];
+        }
+        scoreSet[position] = score;
+        orderedSet[position] = candidate;
+    }
+
+    return size;
+}
+
+// Splits candidates into numbers from the smallest
+SudokuIndex SudokuBranchSelector::orderAscending(SudokuCellCandidates candidates, OrderedSet& orderedSet) {
+    SudokuIndex size = 0;
+    while((candidates != 0) && (size < Geometry::SizeOfCandidates)) {
+        const auto candidate = candidates & (~candidates + 1);
+        candidates ^= candidate;
+        orderedSet[size++] = candidate;
+    }
+    return size;
+}
+
+// Counts cells which hold a candidate in the row, column, and box of a cell.
+// Guessing the candidate removes it from these cells.
+SudokuIndex SudokuBranchSelector::countPeers(const CandidatesSet& candidatesSet, SudokuIndex cellIndex,
+                                             SudokuCellCandidates candidate) {
+    // Cells in both the box and the row (or the column) are counted once
+    bool visited[Geometry::SizeOfAllCells] {false};
+    visited[cellIndex] = true;
+    SudokuIndex count = 0;
+
+    for(SudokuLoopIndex groupId=0;groupId<Geometry::SizeOfGroupsPerCell;++groupId) {
+        const auto group = groupId * Geometry::SizeOfGroupsPerMap +
+            ReverseGroup_[cellIndex * Geometry::SizeOfGroupsPerCell + groupId];
+        for(SudokuLoopIndex position=0;position<Geometry::SizeOfCellsPerGroup;++position) {
+            const auto index = Group_[group * Geometry::SizeOfCellsPerGroup + position];
+            if (!visited[index] && (candidatesSet[index] & candidate)) {
+                ++count;
+            }
+            visited[index] = true;
+        }
+    }
+
+    return count;
+}
+
+// Counts cells to place a candidate in the row, column, and box of a cell and returns the least count.
+// A candidate which has fewer places is more likely to be correct.
+SudokuIndex SudokuBranchSelector::countPlaces(const CandidatesSet& candidatesSet, SudokuIndex cellIndex,
+                                              SudokuCellCandidates candidate) {
+    SudokuIndex leastCount = Geometry::SizeOfCellsPerGroup;
+
+    for(SudokuLoopIndex groupId=0;groupId<Geometry::SizeOfGroupsPerCell;++groupId) {
+        const auto group = groupId * Geometry::SizeOfGroupsPerMap +
+            ReverseGroup_[cellIndex * Geometry::SizeOfGroupsPerCell + groupId];
+        SudokuIndex count = 0;
+        for(SudokuLoopIndex position=0;position<Geometry::SizeOfCellsPerGroup;++position) {
+            if (candidatesSet[Group_[group * Geometry::SizeOfCellsPerGroup + position]] & candidate) {
+                ++count;
+            }
+        }
+        leastCount = std::min(leastCount, count);
+    }
+
+    return leastCount;
+}
+
 SudokuCell::SudokuCell(void) : indexNumber_(0), candidates_(SudokuAllCandidates) {
     return;
 }
@@ -199,6 +433,13 @@ INLINE void SudokuCell::SetCandidates(SudokuCellCandidates candidates) {
     return;
 }
 
+// Puts back candidates of a cell which it held before changes
+INLINE void SudokuCell::RestoreCandidates(SudokuCellCandidates candidates) {
+    candidates_ = candidates;
+    updateState();
+    return;
+}
+
 INLINE SudokuCellCandidates SudokuCell::GetCandidates(void) const {
     return candidates_;
 }
@@ -264,13 +505,153 @@ INLINE void SudokuCell::updateState(void) {
     return;
 }
 
-SudokuMap::SudokuMap(void) {
+SudokuMapTrail::SudokuMapTrail(void) : size_(0) {
+    return;
+}
+
+void SudokuMapTrail::Clear(void) {
+    size_ = 0;
+    return;
+}
+
+INLINE void SudokuMapTrail::Record(SudokuIndex cellIndex, SudokuCellCandidates candidates) {
+    assert(size_ < MaxEntryCnt);
+    entrySet_[size_].cellIndex = cellIndex;
+    entrySet_[size_].candidates = candidates;
+    ++size_;
+    return;
+}
+
+INLINE SudokuMapTrail::Mark SudokuMapTrail::GetMark(void) const {
+    return size_;
+}
+
+INLINE const SudokuMapTrail::Entry& SudokuMapTrail::Pop(void) {
+    assert(size_ > 0);
+    return entrySet_[--size_];
+}
+
+SudokuMap::SudokuMap(void) : pTrail_(nullptr) {
     for(SudokuIndex i=0;i<Sudoku::SizeOfAllCells;++i) {
         // Assign the same index as in the look up table
         cells_[i].SetIndex(i);
     }
 
     backtrackedGroup_ = 0;
+    collectPlacedCandidates();
+    clearPendingCells();
+    presetPending_ = false;
+    filledCellCnt_ = 0;
+    return;
+}
+
+// Records changed cells to the trail from now on
+void SudokuMap::SetTrail(SudokuMapTrail* pTrail) {
+    pTrail_ = pTrail;
+    return;
+}
+
+// Puts back cells which changed after the trail got the mark.
+// Solvers get the mark when Propagate() has nothing to do, so it discards pending cells.
+INLINE void SudokuMap::Rewind(SudokuMapTrail::Mark mark) {
+    while(pTrail_->GetMark() > mark) {
+        const auto& entry = pTrail_->Pop();
+        auto& cell = cells_[entry.cellIndex];
+        filledCellCnt_ -= cell.IsFilled();
+        cell.RestoreCandidates(entry.candidates);
+        filledCellCnt_ += cell.IsFilled();
+    }
+    clearPendingCells();
+    return;
+}
+
+// Records candidates of a cell to the trail only if they change.
+INLINE void SudokuMap::setCandidates(SudokuCell& targetCell, SudokuCellCandidates candidates) {
+    const auto oldCandidates = targetCell.GetCandidates();
+    if ((oldCandidates & candidates) == oldCandidates) {
+        return;
+    }
+
+    if (pTrail_ != nullptr) {
+        pTrail_->Record(targetCell.GetIndex(), oldCandidates);
+    }
+    targetCell.SetCandidates(candidates);
+    const auto uniqueCandidate = targetCell.GetUniqueCandidate();
+    // A cell holding a unique candidate can lose it only to be inconsistent
+    if (!SudokuCell::IsEmptyCandidates(uniqueCandidate)) {
+        ++filledCellCnt_;
+    } else if (SudokuCell::IsUniqueCandidate(oldCandidates)) {
+        --filledCellCnt_;
+    }
+    addPlacedCandidate(targetCell.GetIndex(), uniqueCandidate);
+    addPendingCell(targetCell.GetIndex(), uniqueCandidate);
+    return;
+}
+
+// Merges unique candidates of all cells in their row, column, box, and diagonal bars.
+// Rewinding cells and removing candidates in other ways than FillCrossing() do not
+// keep them, so FillCrossing() calls this at first.
+INLINE void SudokuMap::collectPlacedCandidates(void) {
+    for(SudokuLoopIndex i=0;i<Sudoku::SizeOfGroupsPerCell;++i) {
+        for(SudokuLoopIndex j=0;j<Sudoku::SizeOfGroupsPerMap;++j) {
+            placedCandidates_[i][j] = SudokuCell::GetEmptyCandidates();
+        }
+    }
+
+    for(auto& candidates : placedDiagonalCandidates_) {
+        candidates = SudokuCell::GetEmptyCandidates();
+    }
+
+    for(SudokuLoopIndex i=0;i<Sudoku::SizeOfAllCells;++i) {
+        addPlacedCandidate(i, cells_[i].GetUniqueCandidate());
+    }
+
+    return;
+}
+
+// Adds a unique candidate of a cell (empty if it has multiple candidates)
+// to groups which the cell belongs to.
+INLINE void SudokuMap::addPlacedCandidate(SudokuIndex cellIndex, SudokuCellCandidates candidate) {
+    for(SudokuLoopIndex i=0;i<Sudoku::SizeOfGroupsPerCell;++i) {
+        auto& candidates = placedCandidates_[i][ReverseGroup_[cellIndex][i]];
+        candidates = SudokuCell::MergeCandidates(candidates, candidate);
+    }
+
+    if CPP17_IF_CONSTEXPR (DiagonalSudokuMode) {
+        // 0,10,20,30,40,50,60,70,80
+        if ((cellIndex % (Sudoku::SizeOfCellsPerGroup + 1)) == 0) {
+            placedDiagonalCandidates_[0] = SudokuCell::MergeCandidates(placedDiagonalCandidates_[0], candidate);
+        }
+
+        // Include 8,16,24,32,40,48,56,64,72, exclude 0 and 80
+        if ((cellIndex > 0) && (cellIndex < (Sudoku::SizeOfAllCells - 1)) &&
+            ((cellIndex % (Sudoku::SizeOfCellsPerGroup - 1)) == 0)) {
+            placedDiagonalCandidates_[1] = SudokuCell::MergeCandidates(placedDiagonalCandidates_[1], candidate);
+        }
+    }
+
+    return;
+}
+
+// Propagate() has nothing to do
+INLINE void SudokuMap::clearPendingCells(void) {
+    for(auto& cells : pendingCells_) {
+        cells = 0;
+    }
+    pendingGroups_ = 0;
+    return;
+}
+
+// Marks groups of a cell which lost candidates and the cell if it got a unique candidate
+INLINE void SudokuMap::addPendingCell(SudokuIndex cellIndex, SudokuCellCandidates candidate) {
+    if (!SudokuCell::IsEmptyCandidates(candidate)) {
+        pendingCells_[cellIndex / SudokuCellsPerPendingWord] |= 1ull << (cellIndex % SudokuCellsPerPendingWord);
+    }
+
+    for(SudokuLoopIndex i=0;i<Sudoku::SizeOfGroupsPerCell;++i) {
+        pendingGroups_ |= 1u << (i * Sudoku::SizeOfGroupsPerMap + ReverseGroup_[cellIndex][i]);
+    }
+
     return;
 }
 
@@ -285,6 +666,11 @@ void SudokuMap::Preset(const std::string& presetStr, SudokuIndex seed) {
         }
     }
 
+    // Propagate() starts with all blank cells
+    clearPendingCells();
+    presetPending_ = true;
+    filledCellCnt_ = CountFilledCells();
+
     // It depends on puzzles which is the best choice
     backtrackedGroup_ = seed % Sudoku::SizeOfGroupsPerCell;
     assert(backtrackedGroup_ < Sudoku::SizeOfGroupsPerCell);
@@ -445,6 +831,7 @@ INLINE bool SudokuMap::IsFilled(void) const {
 // Inlining this function makes it run slower.
 bool SudokuMap::FillCrossing(void) {
     // Returns true if finding an inconsistent cell
+    collectPlacedCandidates();
 
     // It is faster to apply same functions continuously than interleave them.
     if CPP17_IF_CONSTEXPR (FastMode == false) {
@@ -659,69 +1046,458 @@ bool SudokuMap::FillCrossing(void) {
     return false;
 }
 
-// Forces a cell to have one candidate in backtracking
-INLINE bool SudokuMap::CanSetUniqueCell(SudokuIndex cellIndex, SudokuCellCandidates candidate) const {
-    return cells_[cellIndex].HasCandidate(candidate);
-}
+// Fills cells as FillCrossing() does until they cannot be filled anymore, but
+// visits only cells and groups which changed instead of sweeping all cells.
+// A cell that gets a unique candidate removes it from its neighbours (naked single)
+// and groups that lose candidates are searched for hidden singles.
+bool SudokuMap::Propagate(void) {
+    // Returns true if finding an inconsistent cell
+    if (presetPending_) {
+        // Masking blank cells costs less than visiting neighbours of many preset cells
+        presetPending_ = false;
+        collectPlacedCandidates();
+        for(SudokuLoopIndex i=0;i<Sudoku::SizeOfAllCells;++i) {
+            if (cells_[i].IsFilled()) {
+                continue;
+            }
+            // Groups without blank cells have no hidden singles
+            addPendingCell(i, SudokuCell::GetEmptyCandidates());
+            if (findUnusedCandidate(cells_[i])) {
+                return true;
+            }
+        }
+    }
 
-INLINE void SudokuMap::SetUniqueCell(SudokuIndex cellIndex, SudokuCellCandidates candidate) {
-    cells_[cellIndex].SetCandidates(candidate);
-    return;
-}
+    // Nothing remains to do when all cells are filled
+    while(filledCellCnt_ < Sudoku::SizeOfAllCells) {
+        SudokuLoopIndex word = 0;
+        for(; word<arraySizeof(pendingCells_); ++word) {
+            if (pendingCells_[word] != 0) {
+                break;
+            }
+        }
 
-// Use template metaprogramming and loop unrolling to run faster
-template <SudokuIndex index>
-INLINE SudokuIndex SudokuMap::unrolledCountFilledCells(SudokuIndex accumCount) const {
-    return cells_[index].IsFilled() + unrolledCountFilledCells<index-1>(accumCount);
-}
+        if (word < arraySizeof(pendingCells_)) {
+            const auto bit = __builtin_ctzll(pendingCells_[word]);
+            pendingCells_[word] &= pendingCells_[word] - 1;
+            if (removeCandidateFromNeighbours(static_cast<SudokuIndex>(word * SudokuCellsPerPendingWord + bit))) {
+                return true;
+            }
+            continue;
+        }
 
-template <>
-INLINE SudokuIndex SudokuMap::unrolledCountFilledCells<0>(SudokuIndex accumCount) const {
-    return cells_[0].IsFilled();
+        // Finds hidden singles after naked singles because they cost more
+        if (pendingGroups_ == 0) {
+            break;
+        }
+
+        const auto bit = __builtin_ctz(pendingGroups_);
+        pendingGroups_ &= pendingGroups_ - 1;
+        if (findHiddenSingles(bit / Sudoku::SizeOfGroupsPerMap, bit % Sudoku::SizeOfGroupsPerMap)) {
+            return true;
+        }
+    }
+
+    return false;
 }
 
-INLINE SudokuIndex SudokuMap::CountFilledCells(void) const {
-    SudokuIndex count = 0;
+// Removes a unique candidate of a cell from cells in its row, column, box, and diagonal bars
+INLINE bool SudokuMap::removeCandidateFromNeighbours(SudokuIndex cellIndex) {
+    // Returns true if finding a cell that cannot be filled.
+    const auto candidate = cells_[cellIndex].GetUniqueCandidate();
+    if (SudokuCell::IsEmptyCandidates(candidate)) {
+        // Lost its candidate after it got the unique candidate
+        return true;
+    }
 
-    if CPP17_IF_CONSTEXPR (FastMode == false) {
-        for(SudokuLoopIndex i=0;i<Sudoku::SizeOfAllCells;++i) {
-            if (cells_[i].IsFilled()) {
-                ++count;
+    for(SudokuLoopIndex i=0;i<Sudoku::SizeOfGroupsPerCell;++i) {
+        const auto groupIndex = ReverseGroup_[cellIndex][i];
+        for(SudokuLoopIndex j=0;j<Sudoku::SizeOfCellsPerGroup;++j) {
+            const auto neighbourIndex = Group_[i][groupIndex][j];
+            if ((neighbourIndex != cellIndex) && removeCandidateFromCell(neighbourIndex, candidate)) {
+                return true;
             }
         }
-    } else {
-        count = unrolledCountFilledCells<Sudoku::SizeOfAllCells - 1>(count);
     }
 
-    return count;
-}
-
-INLINE SudokuIndex SudokuMap::unrolledSelectBacktrackedCellIndexInnerCommon(SudokuIndex outerIndex, SudokuIndex innerIndex,
-                                                                            SudokuIndex& leastCountOfGroup,
-                                                                            SudokuIndex& candidateCellIndex) const {
-    const auto cellIndex = Group_[backtrackedGroup_][outerIndex][innerIndex];
-    // Use an out-of-range value to eliminate branches
-    const auto countOrOutOfRange = cells_[cellIndex].CountCandidatesIfMultiple();
-    assert(countOrOutOfRange > Sudoku::SizeOfUniqueCandidate);
-    const auto count = SudokuCell::MaskCandidatesUnlessMultiple(countOrOutOfRange);
-    assert(count <= Sudoku::SizeOfCandidates);
+    if CPP17_IF_CONSTEXPR (DiagonalSudokuMode) {
+        // 0,10,20,30,40,50,60,70,80
+        if ((cellIndex % (Sudoku::SizeOfCellsPerGroup + 1)) == 0) {
+            SudokuIndex neighbourIndex = 0;
+            for(SudokuLoopIndex i=0; i<Sudoku::SizeOfCellsPerGroup; ++i) {
+                if ((neighbourIndex != cellIndex) && removeCandidateFromCell(neighbourIndex, candidate)) {
+                    return true;
+                }
+                neighbourIndex += Sudoku::SizeOfCellsPerGroup + 1;
+            }
+        }
 
-    // 'count' is larger than a number of the cells if there are no candidate for the cells.
-    if (leastCountOfGroup > countOrOutOfRange) {
-        leastCountOfGroup = count;
-        candidateCellIndex = cellIndex;
+        // Include 8,16,24,32,40,48,56,64,72, exclude 0 and 80
+        if ((cellIndex > 0) && (cellIndex < (Sudoku::SizeOfAllCells - 1)) &&
+            ((cellIndex % (Sudoku::SizeOfCellsPerGroup - 1)) == 0)) {
+            SudokuIndex neighbourIndex = Sudoku::SizeOfCellsPerGroup - 1;
+            for(SudokuLoopIndex i=0; i<Sudoku::SizeOfCellsPerGroup; ++i) {
+                if ((neighbourIndex != cellIndex) && removeCandidateFromCell(neighbourIndex, candidate)) {
+                    return true;
+                }
+                neighbourIndex += Sudoku::SizeOfCellsPerGroup - 1;
+            }
+        }
     }
-    return count;
+
+    return false;
 }
 
-template <SudokuIndex innerIndex>
-INLINE SudokuIndex SudokuMap::unrolledSelectBacktrackedCellIndexInner(SudokuIndex outerIndex, SudokuIndex& leastCountOfGroup,
-                                                                     SudokuIndex& candidateCellIndex) const {
-    return unrolledSelectBacktrackedCellIndexInnerCommon(outerIndex, innerIndex, leastCountOfGroup, candidateCellIndex)
-        + unrolledSelectBacktrackedCellIndexInner<innerIndex-1>(outerIndex, leastCountOfGroup, candidateCellIndex);
+INLINE bool SudokuMap::removeCandidateFromCell(SudokuIndex cellIndex, SudokuCellCandidates candidate) {
+    // Returns true if finding a cell that cannot be filled.
+    auto& cell = cells_[cellIndex];
+    setCandidates(cell, SudokuCell::FlipCandidates(candidate));
+    return cell.HasNoCandidates();
 }
 
-template <>
+// Sets a number to a cell if only the cell in a group can hold the number
+INLINE bool SudokuMap::findHiddenSingles(SudokuIndex groupId, SudokuIndex groupIndex) {
+    // Returns true if finding a cell that cannot be filled.
+    auto candidatesOnce = SudokuCell::GetEmptyCandidates();
+    auto candidatesTwice = SudokuCell::GetEmptyCandidates();
+    for(SudokuLoopIndex i=0;i<Sudoku::SizeOfCellsPerGroup;++i) {
+        const auto candidates = cells_[Group_[groupId][groupIndex][i]].GetCandidates();
+        if (SudokuCell::IsEmptyCandidates(candidates)) {
+            // Other methods than Propagate() may remove all candidates of a cell
+            return true;
+        }
+        candidatesTwice = SudokuCell::MergeCandidates(candidatesTwice, candidatesOnce & candidates);
+        candidatesOnce = SudokuCell::MergeCandidates(candidatesOnce, candidates);
+    }
+
+    if (candidatesOnce != Sudoku::AllCandidates) {
+        // No cells in the group can hold a number
+        return true;
+    }
+
+    // All cells in the group are filled if no numbers are in two cells
+    const auto uniqueCandidates = candidatesOnce & SudokuCell::FlipCandidates(candidatesTwice);
+    if (SudokuCell::IsEmptyCandidates(uniqueCandidates) || SudokuCell::IsEmptyCandidates(candidatesTwice)) {
+        return false;
+    }
+
+    for(SudokuLoopIndex i=0;i<Sudoku::SizeOfCellsPerGroup;++i) {
+        auto& cell = cells_[Group_[groupId][groupIndex][i]];
+        const auto candidates = cell.GetCandidates() & uniqueCandidates;
+        if (SudokuCell::IsEmptyCandidates(candidates)) {
+            continue;
+        }
+        if (!SudokuCell::IsUniqueCandidate(candidates)) {
+            // A cell cannot hold two numbers
+            return true;
+        }
+        setCandidates(cell, candidates);
+    }
+
+    return false;
+}
+
+// Removes candidates with the locked candidates method when filling cells stalls.
+// If candidates of a number in a box are in a row (column), the number cannot be
+// in other cells of the row (column) out of the box (pointing). If candidates of
+// a number in a row (column) are in a box, the number cannot be in other cells of
+// the box out of the row (column) (claiming).
+bool SudokuMap::FindLockedCandidates(void) {
+    // Returns true if removing any candidates
+    bool found = false;
+
+    // Rows and then columns
+    for(SudokuLoopIndex groupId=0; groupId<SudokuBoxGroupId; ++groupId) {
+        for(SudokuLoopIndex band=0; band<Sudoku::SizeOfBoxesOnEdge; ++band) {
+            // Candidates in each part of three lines that crosses three boxes
+            SudokuCellCandidates parts[Sudoku::SizeOfCellsOnBoxEdge][Sudoku::SizeOfBoxesOnEdge];
+            for(SudokuLoopIndex line=0; line<Sudoku::SizeOfCellsOnBoxEdge; ++line) {
+                const auto groupIndex = band * Sudoku::SizeOfCellsOnBoxEdge + line;
+                for(SudokuLoopIndex part=0; part<Sudoku::SizeOfBoxesOnEdge; ++part) {
+                    auto candidates = SudokuCell::GetEmptyCandidates();
+                    for(SudokuLoopIndex i=0; i<Sudoku::SizeOfCellsOnBoxEdge; ++i) {
+                        const auto cellIndex = Group_[groupId][groupIndex][part * Sudoku::SizeOfCellsOnBoxEdge + i];
+                        candidates = SudokuCell::MergeCandidates(candidates, cells_[cellIndex].GetCandidates());
+                    }
+                    parts[line][part] = candidates;
+                }
+            }
+
+            for(SudokuLoopIndex line=0; line<Sudoku::SizeOfCellsOnBoxEdge; ++line) {
+                const auto groupIndex = band * Sudoku::SizeOfCellsOnBoxEdge + line;
+                const auto nextLine = (line + 1) % Sudoku::SizeOfCellsOnBoxEdge;
+                const auto lastLine = (line + 2) % Sudoku::SizeOfCellsOnBoxEdge;
+                for(SudokuLoopIndex part=0; part<Sudoku::SizeOfBoxesOnEdge; ++part) {
+                    const auto nextPart = (part + 1) % Sudoku::SizeOfBoxesOnEdge;
+                    const auto lastPart = (part + 2) % Sudoku::SizeOfBoxesOnEdge;
+                    const auto pointing = parts[line][part] & SudokuCell::FlipCandidates(
+                        SudokuCell::MergeCandidates(parts[nextLine][part], parts[lastLine][part]));
+                    const auto claiming = parts[line][part] & SudokuCell::FlipCandidates(
+                        SudokuCell::MergeCandidates(parts[line][nextPart], parts[line][lastPart]));
+                    const auto boxIndex = ReverseGroup_[Group_[groupId][groupIndex][part * Sudoku::SizeOfCellsOnBoxEdge]][SudokuBoxGroupId];
+
+                    for(SudokuLoopIndex i=0; i<Sudoku::SizeOfCellsPerGroup; ++i) {
+                        const auto lineCellIndex = Group_[groupId][groupIndex][i];
+                        if (!SudokuCell::IsEmptyCandidates(pointing) &&
+                            (ReverseGroup_[lineCellIndex][SudokuBoxGroupId] != boxIndex)) {
+                            found |= removeCandidates(lineCellIndex, pointing);
+                        }
+
+                        const auto boxCellIndex = Group_[SudokuBoxGroupId][boxIndex][i];
+                        if (!SudokuCell::IsEmptyCandidates(claiming) &&
+                            (ReverseGroup_[boxCellIndex][groupId] != groupIndex)) {
+                            found |= removeCandidates(boxCellIndex, claiming);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    return found;
+}
+
+// Returns true if a cell loses any of candidates
+INLINE bool SudokuMap::removeCandidates(SudokuIndex cellIndex, SudokuCellCandidates candidates) {
+    const auto oldCandidates = cells_[cellIndex].GetCandidates();
+    setCandidates(cells_[cellIndex], SudokuCell::FlipCandidates(candidates));
+    return (oldCandidates != cells_[cellIndex].GetCandidates());
+}
+
+// Removes candidates with naked and hidden pairs and triples when the locked
+// candidates method stalls. If N cells in a group hold N candidates in total,
+// the candidates cannot be in other cells of the group (naked subset).
+// If N candidates in a group are in N cells only, the cells cannot hold
+// other candidates (hidden subset).
+bool SudokuMap::FindSubsets(void) {
+    SudokuCellCandidates candidateSet[Sudoku::SizeOfAllCells];
+    for(SudokuLoopIndex i=0; i<Sudoku::SizeOfAllCells; ++i) {
+        candidateSet[i] = cells_[i].GetCandidates();
+    }
+
+    if (!FindSubsets(candidateSet)) {
+        return false;
+    }
+
+    for(SudokuLoopIndex i=0; i<Sudoku::SizeOfAllCells; ++i) {
+        setCandidates(cells_[i], candidateSet[i]);
+    }
+    return true;
+}
+
+// Shared with the SSE solver which holds candidates in its own layout
+bool SudokuMap::FindSubsets(SudokuCellCandidates (&candidateSet)[Sudoku::SizeOfAllCells]) {
+    // Returns true if removing any candidates
+    bool found = false;
+
+    for(SudokuLoopIndex groupId=0; groupId<Sudoku::SizeOfGroupsPerCell; ++groupId) {
+        for(SudokuLoopIndex groupIndex=0; groupIndex<Sudoku::SizeOfGroupsPerMap; ++groupIndex) {
+            // Filled cells are not in subsets
+            SudokuIndex cellIndexSet[Sudoku::SizeOfCellsPerGroup];
+            SudokuCellCandidates cells[Sudoku::SizeOfCellsPerGroup];
+            SudokuLoopIndex cellCnt = 0;
+            auto filledCandidates = SudokuCell::GetEmptyCandidates();
+            for(SudokuLoopIndex i=0; i<Sudoku::SizeOfCellsPerGroup; ++i) {
+                const auto cellIndex = Group_[groupId][groupIndex][i];
+                const auto candidates = candidateSet[cellIndex];
+                if (__builtin_popcount(candidates) > Sudoku::SizeOfUniqueCandidate) {
+                    cellIndexSet[cellCnt] = cellIndex;
+                    cells[cellCnt] = candidates;
+                    ++cellCnt;
+                } else {
+                    filledCandidates = SudokuCell::MergeCandidates(filledCandidates, candidates);
+                }
+            }
+
+            // Subsets of all blank cells remove nothing
+            if (cellCnt <= Sudoku::MinSubsetSize) {
+                continue;
+            }
+
+            const bool nakedFound = findNakedSubsets(cells, cellCnt);
+            const bool hiddenFound = findHiddenSubsets(cells, cellCnt, filledCandidates);
+            if (nakedFound || hiddenFound) {
+                for(SudokuLoopIndex i=0; i<cellCnt; ++i) {
+                    candidateSet[cellIndexSet[i]] = cells[i];
+                }
+                found = true;
+            }
+        }
+    }
+
+    return found;
+}
+
+// Finds naked pairs and triples in blank cells of a group
+bool SudokuMap::findNakedSubsets(SudokuCellCandidates* pCells, SudokuLoopIndex cellCnt) {
+    bool found = false;
+    const SudokuLoopIndex allCells = (1u << cellCnt) - 1;
+
+    for(SudokuLoopIndex first=0; first<cellCnt; ++first) {
+        for(SudokuLoopIndex second=first+1; second<cellCnt; ++second) {
+            const auto pairMembers = (1u << first) | (1u << second);
+            const auto pairCandidates = SudokuCell::MergeCandidates(pCells[first], pCells[second]);
+            const auto size = __builtin_popcount(pairCandidates);
+            if (size == Sudoku::MinSubsetSize) {
+                found |= restrictCandidates(pCells, cellCnt, allCells & ~pairMembers,
+                                            SudokuCell::FlipCandidates(pairCandidates));
+                continue;
+            }
+
+            // Any two cells in a triple hold three candidates at most
+            if (size != Sudoku::MaxSubsetSize) {
+                continue;
+            }
+
+            for(SudokuLoopIndex third=second+1; third<cellCnt; ++third) {
+                const auto candidates = SudokuCell::MergeCandidates(pairCandidates, pCells[third]);
+                if (__builtin_popcount(candidates) == Sudoku::MaxSubsetSize) {
+                    found |= restrictCandidates(pCells, cellCnt, allCells & ~(pairMembers | (1u << third)),
+                                                SudokuCell::FlipCandidates(candidates));
+                }
+            }
+        }
+    }
+
+    return found;
+}
+
+// Finds hidden pairs and triples in blank cells of a group.
+// Blank cells may still hold candidates of filled cells in the group.
+bool SudokuMap::findHiddenSubsets(SudokuCellCandidates* pCells, SudokuLoopIndex cellCnt,
+                                  SudokuCellCandidates filledCandidates) {
+    // Cells (bit i for pCells[i]) which hold each candidate
+    SudokuLoopIndex positionSet[Sudoku::SizeOfCandidates] {0};
+    for(SudokuLoopIndex i=0; i<cellCnt; ++i) {
+        const auto candidates = pCells[i] & SudokuCell::FlipCandidates(filledCandidates);
+        for(SudokuLoopIndex number=0; number<Sudoku::SizeOfCandidates; ++number) {
+            if (candidates & (SudokuCell::GetInitialCandidate() << number)) {
+                positionSet[number] |= (1u << i);
+            }
+        }
+    }
+
+    // Placed numbers and hidden singles are left to filling cells
+    auto isInSubset = [&positionSet](SudokuLoopIndex number) {
+        const auto size = __builtin_popcount(positionSet[number]);
+        return ((size >= Sudoku::MinSubsetSize) && (size <= Sudoku::MaxSubsetSize));
+    };
+
+    bool found = false;
+    for(SudokuLoopIndex first=0; first<Sudoku::SizeOfCandidates; ++first) {
+        if (!isInSubset(first)) {
+            continue;
+        }
+
+        for(SudokuLoopIndex second=first+1; second<Sudoku::SizeOfCandidates; ++second) {
+            if (!isInSubset(second)) {
+                continue;
+            }
+
+            const auto pairNumbers = (SudokuCell::GetInitialCandidate() << first) |
+                (SudokuCell::GetInitialCandidate() << second);
+            const auto pairPositions = positionSet[first] | positionSet[second];
+            const auto size = __builtin_popcount(pairPositions);
+            if (size == Sudoku::MinSubsetSize) {
+                found |= restrictCandidates(pCells, cellCnt, pairPositions, pairNumbers);
+                continue;
+            }
+
+            // Any two numbers in a triple are in three cells at most
+            if (size != Sudoku::MaxSubsetSize) {
+                continue;
+            }
+
+            for(SudokuLoopIndex third=second+1; third<Sudoku::SizeOfCandidates; ++third) {
+                const auto positions = pairPositions | positionSet[third];
+                if (isInSubset(third) && (__builtin_popcount(positions) == Sudoku::MaxSubsetSize)) {
+                    found |= restrictCandidates(pCells, cellCnt, positions,
+                                                pairNumbers | (SudokuCell::GetInitialCandidate() << third));
+                }
+            }
+        }
+    }
+
+    return found;
+}
+
+// Leaves only 'candidates' in cells (bit i for pCells[i]) and returns true if they lose any of candidates
+bool SudokuMap::restrictCandidates(SudokuCellCandidates* pCells, SudokuLoopIndex cellCnt,
+                                   SudokuLoopIndex cellBits, SudokuCellCandidates candidates) {
+    bool found = false;
+    for(SudokuLoopIndex i=0; i<cellCnt; ++i) {
+        if (cellBits & (1u << i)) {
+            const auto oldCandidates = pCells[i];
+            pCells[i] &= candidates;
+            found |= (oldCandidates != pCells[i]);
+        }
+    }
+    return found;
+}
+
+// Forces a cell to have one candidate in backtracking
+INLINE bool SudokuMap::CanSetUniqueCell(SudokuIndex cellIndex, SudokuCellCandidates candidate) const {
+    return cells_[cellIndex].HasCandidate(candidate);
+}
+
+INLINE void SudokuMap::SetUniqueCell(SudokuIndex cellIndex, SudokuCellCandidates candidate) {
+    setCandidates(cells_[cellIndex], candidate);
+    return;
+}
+
+// Use template metaprogramming and loop unrolling to run faster
+template <SudokuIndex index>
+INLINE SudokuIndex SudokuMap::unrolledCountFilledCells(SudokuIndex accumCount) const {
+    return cells_[index].IsFilled() + unrolledCountFilledCells<index-1>(accumCount);
+}
+
+template <>
+INLINE SudokuIndex SudokuMap::unrolledCountFilledCells<0>(SudokuIndex accumCount) const {
+    return cells_[0].IsFilled();
+}
+
+INLINE SudokuIndex SudokuMap::CountFilledCells(void) const {
+    SudokuIndex count = 0;
+
+    if CPP17_IF_CONSTEXPR (FastMode == false) {
+        for(SudokuLoopIndex i=0;i<Sudoku::SizeOfAllCells;++i) {
+            if (cells_[i].IsFilled()) {
+                ++count;
+            }
+        }
+    } else {
+        count = unrolledCountFilledCells<Sudoku::SizeOfAllCells - 1>(count);
+    }
+
+    return count;
+}
+
+INLINE SudokuIndex SudokuMap::unrolledSelectBacktrackedCellIndexInnerCommon(SudokuIndex outerIndex, SudokuIndex innerIndex,
+                                                                            SudokuIndex& leastCountOfGroup,
+                                                                            SudokuIndex& candidateCellIndex) const {
+    const auto cellIndex = Group_[backtrackedGroup_][outerIndex][innerIndex];
+    // Use an out-of-range value to eliminate branches
+    const auto countOrOutOfRange = cells_[cellIndex].CountCandidatesIfMultiple();
+    assert(countOrOutOfRange > Sudoku::SizeOfUniqueCandidate);
+    const auto count = SudokuCell::MaskCandidatesUnlessMultiple(countOrOutOfRange);
+    assert(count <= Sudoku::SizeOfCandidates);
+
+    // 'count' is larger than a number of the cells if there are no candidate for the cells.
+    if (leastCountOfGroup > countOrOutOfRange) {
+        leastCountOfGroup = count;
+        candidateCellIndex = cellIndex;
+    }
+    return count;
+}
+
+template <SudokuIndex innerIndex>
+INLINE SudokuIndex SudokuMap::unrolledSelectBacktrackedCellIndexInner(SudokuIndex outerIndex, SudokuIndex& leastCountOfGroup,
+                                                                     SudokuIndex& candidateCellIndex) const {
+    return unrolledSelectBacktrackedCellIndexInnerCommon(outerIndex, innerIndex, leastCountOfGroup, candidateCellIndex)
+        + unrolledSelectBacktrackedCellIndexInner<innerIndex-1>(outerIndex, leastCountOfGroup, candidateCellIndex);
+}
+
+template <>
 INLINE SudokuIndex SudokuMap::unrolledSelectBacktrackedCellIndexInner<0>(SudokuIndex outerIndex, SudokuIndex& leastCountOfGroup,
                                                                         SudokuIndex& candidateCellIndex) const {
     return unrolledSelectBacktrackedCellIndexInnerCommon(outerIndex, 0, leastCountOfGroup, candidateCellIndex);
@@ -729,6 +1505,18 @@ INLINE SudokuIndex SudokuMap::unrolledSelectBacktrackedCellIndexInner<0>(SudokuI
 
 // Selects a key cell to start backtracking
 INLINE SudokuIndex SudokuMap::SelectBacktrackedCellIndex(void) const {
+    const auto policy = Sudoku::GetBranchPolicy();
+    if (policy != SudokuBranchPolicy::FIXED_GROUP) {
+        SudokuBranchSelector::CountSet countSet;
+        for(SudokuLoopIndex i=0;i<Sudoku::SizeOfAllCells;++i) {
+            countSet[i] = cells_[i].CountCandidates();
+        }
+
+        SudokuIndex cellIndex = 0;
+        SudokuBranchSelector::Select(policy, countSet, cellIndex);
+        return cellIndex;
+    }
+
     SudokuIndex leastGroupCount = Sudoku::SizeOfCandidates * Sudoku::SizeOfCellsPerGroup;
     SudokuIndex leastCount = Sudoku::SizeOfCandidates;
     SudokuIndex resultCellIndex = 0;
@@ -767,6 +1555,22 @@ INLINE SudokuIndex SudokuMap::SelectBacktrackedCellIndex(void) const {
     return resultCellIndex;
 }
 
+// Orders candidates of a cell to guess with the value order
+INLINE SudokuIndex SudokuMap::OrderCandidates(SudokuIndex cellIndex, SudokuCellCandidates (&orderedSet)[Sudoku::SizeOfCandidates]) const {
+    const auto order = Sudoku::GetValueOrder();
+    SudokuBranchSelector::CandidatesSet candidatesSet;
+    if (order == SudokuValueOrder::ASCENDING) {
+        // Other cells do not matter
+        candidatesSet[cellIndex] = cells_[cellIndex].GetCandidates();
+    } else {
+        for(SudokuLoopIndex i=0;i<Sudoku::SizeOfAllCells;++i) {
+            candidatesSet[i] = cells_[i].GetCandidates();
+        }
+    }
+
+    return SudokuBranchSelector::Order(order, candidatesSet, cellIndex, orderedSet);
+}
+
 bool SudokuMap::IsConsistent(void) const {
     for(SudokuLoopIndex i=0;i<Sudoku::SizeOfGroupsPerCell;++i) {
         for(SudokuLoopIndex j=0;j<Sudoku::SizeOfGroupsPerMap;++j) {
@@ -793,59 +1597,6 @@ bool SudokuMap::IsConsistent(void) const {
     return true;
 }
 
-// Use template metaprogramming and loop unrolling to run faster
-INLINE SudokuCellCandidates SudokuMap::unrolledFindUnusedCandidateInnerCommon(SudokuIndex targetCellIndex, SudokuIndex outerIndex,
-                                                                              SudokuIndex groupIndex, SudokuIndex innerIndex,
-                                                                              SudokuCellCandidates candidates) const {
-    auto newCandidates = candidates;
-#if __cplusplus >= 201703L
-    if (const auto cellIndex = Group_[outerIndex][groupIndex][innerIndex];
-        cellIndex != targetCellIndex)
-#else
-    const auto cellIndex = Group_[outerIndex][groupIndex][innerIndex];
-    if (cellIndex != targetCellIndex)
-#endif
-    {
-        const auto cellCandidates = cells_[cellIndex].GetUniqueCandidate();
-        newCandidates = SudokuCell::MergeCandidates(candidates, cellCandidates);
-    }
-    return newCandidates;
-}
-
-template <SudokuIndex innerIndex>
-INLINE SudokuCellCandidates SudokuMap::unrolledFindUnusedCandidateInner(SudokuIndex targetCellIndex, SudokuIndex outerIndex,
-                                                                        SudokuIndex groupIndex, SudokuCellCandidates candidates) const {
-    const auto newCandidates =
-        unrolledFindUnusedCandidateInnerCommon(targetCellIndex, outerIndex, groupIndex, innerIndex, candidates);
-    return unrolledFindUnusedCandidateInner<innerIndex-1>(targetCellIndex, outerIndex, groupIndex, newCandidates);
-}
-
-template <>
-INLINE SudokuCellCandidates SudokuMap::unrolledFindUnusedCandidateInner<0>(SudokuIndex targetCellIndex, SudokuIndex outerIndex,
-                                                                           SudokuIndex groupIndex, SudokuCellCandidates candidates) const {
-    return unrolledFindUnusedCandidateInnerCommon(targetCellIndex, outerIndex, groupIndex, 0, candidates);
-}
-
-INLINE SudokuCellCandidates SudokuMap::unrolledFindUnusedCandidateOuterCommon(SudokuIndex targetCellIndex, SudokuIndex outerIndex,
-                                                                              SudokuCellCandidates candidates) const {
-    const auto groupIndex = ReverseGroup_[targetCellIndex][outerIndex];
-    return unrolledFindUnusedCandidateInner<Sudoku::SizeOfCellsPerGroup-1>
-        (targetCellIndex, outerIndex, groupIndex, candidates);
-}
-
-template <SudokuIndex outerIndex>
-INLINE SudokuCellCandidates SudokuMap::unrolledFindUnusedCandidateOuter(SudokuIndex targetCellIndex,
-                                                                        SudokuCellCandidates candidates) const {
-    const auto newCandidates = unrolledFindUnusedCandidateOuterCommon(targetCellIndex, outerIndex, candidates);
-    return unrolledFindUnusedCandidateOuter<outerIndex-1>(targetCellIndex, newCandidates);
-}
-
-template <>
-INLINE SudokuCellCandidates SudokuMap::unrolledFindUnusedCandidateOuter<0>(SudokuIndex targetCellIndex,
-                                                                           SudokuCellCandidates candidates) const {
-    return unrolledFindUnusedCandidateOuterCommon(targetCellIndex, 0, candidates);
-}
-
 // Searches a row, column, and box that the targetCell belongs and
 // sets a unique candidate to the cell if available.
 // This is commonly called 'naked single'.
@@ -853,53 +1604,31 @@ INLINE SudokuCellCandidates SudokuMap::unrolledFindUnusedCandidateOuter<0>(Sudok
 // Actually, we do not need to check whether the cell has one candidate
 // or not here. we simply mask by a complementary set of unique candidates
 // of a row, column, and box that the targetCell belongs.
-bool SudokuMap::findUnusedCandidate(SudokuCell& targetCell) const {
+// The targetCell must not be filled, so that the groups do not include
+// its own unique candidate.
+bool SudokuMap::findUnusedCandidate(SudokuCell& targetCell) {
     // Returns true if finding a cell that cannot be filled.
-    auto candidates = SudokuCell::GetEmptyCandidates();
     const auto targetCellIndex = targetCell.GetIndex();
+    const auto& groupIndexes = ReverseGroup_[targetCellIndex];
+    auto candidates = SudokuCell::MergeCandidates(
+        SudokuCell::MergeCandidates(placedCandidates_[0][groupIndexes[0]], placedCandidates_[1][groupIndexes[1]]),
+        placedCandidates_[SudokuBoxGroupId][groupIndexes[SudokuBoxGroupId]]);
 
     if CPP17_IF_CONSTEXPR (DiagonalSudokuMode) {
+        // 0,10,20,30,40,50,60,70,80
         if ((targetCellIndex % (Sudoku::SizeOfCellsPerGroup + 1)) == 0) {
-            // 0,10,20,30,40,50,60,70,80
-            SudokuIndex cellIndex = 0;
-            for(SudokuLoopIndex i=0; i<Sudoku::SizeOfCellsPerGroup; ++i) {
-                const auto cellCandidates = (cellIndex != targetCellIndex) ?
-                    cells_[cellIndex].GetUniqueCandidate() : Sudoku::EmptyCandidates;
-                candidates = SudokuCell::MergeCandidates(candidates, cellCandidates);
-                cellIndex += Sudoku::SizeOfCellsPerGroup + 1;
-            }
+            candidates = SudokuCell::MergeCandidates(candidates, placedDiagonalCandidates_[0]);
         }
 
         // Include 8,16,24,32,40,48,56,64,72, exclude 0 and 80
         if ((targetCellIndex > 0) && (targetCellIndex < (Sudoku::SizeOfAllCells - 1)) &&
             ((targetCellIndex % (Sudoku::SizeOfCellsPerGroup - 1)) == 0)) {
-            SudokuIndex cellIndex = Sudoku::SizeOfCellsPerGroup - 1;
-            for(SudokuLoopIndex i=0; i<Sudoku::SizeOfCellsPerGroup; ++i) {
-                const auto cellCandidates = (cellIndex != targetCellIndex) ?
-                    cells_[cellIndex].GetUniqueCandidate() : Sudoku::EmptyCandidates;
-                candidates = SudokuCell::MergeCandidates(candidates, cellCandidates);
-                cellIndex += Sudoku::SizeOfCellsPerGroup - 1;
-            }
-        }
-    }
-
-    if CPP17_IF_CONSTEXPR (FastMode == false) {
-        for(SudokuLoopIndex i=0;i<Sudoku::SizeOfGroupsPerCell;++i) {
-            const auto groupIndex = ReverseGroup_[targetCellIndex][i];
-            for(SudokuLoopIndex j=0;j<Sudoku::SizeOfCellsPerGroup;++j) {
-                const auto cellIndex = Group_[i][groupIndex][j];
-                if (cellIndex != targetCellIndex) {
-                    const auto cellCandidates = cells_[cellIndex].GetUniqueCandidate();
-                    candidates = SudokuCell::MergeCandidates(candidates, cellCandidates);
-                }
-            }
+            candidates = SudokuCell::MergeCandidates(candidates, placedDiagonalCandidates_[1]);
         }
-    } else {
-        candidates = unrolledFindUnusedCandidateOuter<Sudoku::SizeOfGroupsPerCell-1>(targetCellIndex, candidates);
     }
 
     candidates = SudokuCell::FlipCandidates(candidates);
-    targetCell.SetCandidates(candidates);
+    setCandidates(targetCell, candidates);
     return cells_[targetCellIndex].HasNoCandidates();
 }
 
@@ -944,7 +1673,7 @@ INLINE SudokuCellCandidates SudokuMap::unrolledFindUniqueCandidateInner<0>(Sudok
             (targetCellIndex, index, groupIndex, candidates); \
         candidates = SudokuCell::FlipCandidates(candidates); \
         if (SudokuCell::IsUniqueCandidate(candidates) != false) { \
-            targetCell.SetCandidates(candidates); \
+            setCandidates(targetCell, candidates); \
             return cells_[targetCellIndex].HasNoCandidates(); \
         } \
         if (SudokuCell::IsEmptyCandidates(candidates) == false) { \
@@ -956,7 +1685,7 @@ INLINE SudokuCellCandidates SudokuMap::unrolledFindUniqueCandidateInner<0>(Sudok
 // Set a candidate to the targetCell if there is a number that cannot
 // be set in a row, column, and box that the cell belongs.
 // This is commonly called 'hidden single'.
-bool SudokuMap::findUniqueCandidate(SudokuCell& targetCell) const {
+bool SudokuMap::findUniqueCandidate(SudokuCell& targetCell) {
     // Returns true if finding a cell that cannot be filled.
     const auto targetCellIndex = targetCell.GetIndex();
 
@@ -980,7 +1709,7 @@ bool SudokuMap::findUniqueCandidate(SudokuCell& targetCell) const {
             }
             candidates = SudokuCell::FlipCandidates(candidates);
             if (SudokuCell::IsUniqueCandidate(candidates) != false) {
-                targetCell.SetCandidates(candidates);
+                setCandidates(targetCell, candidates);
                 return cells_[targetCellIndex].HasNoCandidates();
             }
             if (SudokuCell::IsEmptyCandidates(candidates) != false) {
@@ -1026,23 +1755,21 @@ bool SudokuMap::areDiagonalBarsConsistent(void) const {
         allCandidates, allCandidates);
 }
 
-SudokuSseEnumeratorMap* SudokuSseEnumeratorMap::pInstance_ = nullptr;
-
 SudokuSseEnumeratorMap::SudokuSseEnumeratorMap(std::ostream* pSudokuOutStream)
     : rightBottomElement_(0), firstCell_(0), patternNumber_(0), pSudokuOutStream_(pSudokuOutStream) {
     ::memset(&xmmRegSet_, 0, sizeof(xmmRegSet_));
-    pInstance_ = this;
-    sudokuXmmPrintAllCandidate = 0;
+    ::memset(&context_, 0, sizeof(context_));
+    context_.pInstance = this;
     return;
 }
 
 SudokuSseEnumeratorMap::~SudokuSseEnumeratorMap() {
-    pInstance_ = nullptr;
+    context_.pInstance = nullptr;
     return;
 }
 
 void SudokuSseEnumeratorMap::SetToPrint(SudokuPatternCount printAllCandidate) {
-    sudokuXmmPrintAllCandidate = printAllCandidate;
+    context_.printAllCandidate = printAllCandidate;
     return;
 }
 
@@ -1096,7 +1823,7 @@ void SudokuSseEnumeratorMap::Print(bool solved, const XmmRegisterSet& xmmRegSet)
         static_assert(CellBitWidth <= std::numeric_limits<decltype(regValue)>::digits, "regValue too small");
 
         if ((row + 1) == Sudoku::SizeOfGroupsPerMap) {
-            const uint64_t value = (solved) ? sudokuXmmRightBottomSolved : rightBottomElement_;
+            const uint64_t value = (solved) ? context_.rightBottomSolved : rightBottomElement_;
             regValue = value & ((1 << CellBitWidth) - 1);
         } else {
             const size_t regIndex = RightColumnRegisterNum * (sizeof(xmmRegSet.regXmmVal_[0]) / sizeof(xmmRegSet.regVal_[0]));
@@ -1112,7 +1839,7 @@ void SudokuSseEnumeratorMap::Print(bool solved, const XmmRegisterSet& xmmRegSet)
 }
 
 void SudokuSseEnumeratorMap::PrintFromAsm(const XmmRegisterSet& xmmRegSet) {
-    if (patternNumber_ >= sudokuXmmPrintAllCandidate) {
+    if (patternNumber_ >= context_.printAllCandidate) {
         return;
     }
 
@@ -1125,26 +1852,30 @@ void SudokuSseEnumeratorMap::PrintFromAsm(const XmmRegisterSet& xmmRegSet) {
 }
 
 SudokuPatternCount SudokuSseEnumeratorMap::Enumerate(void) {
-    patternNumber_ = 0;
     Print();
+    return Count();
+}
 
-    sudokuXmmRightBottomElement = rightBottomElement_;
+// Counts solutions without printing the puzzle
+SudokuPatternCount SudokuSseEnumeratorMap::Count(void) {
+    patternNumber_ = 0;
+    context_.rightBottomElement = rightBottomElement_;
+    context_.allPatternCnt = 0;
 
 #ifndef __clang__
     static_assert((alignof(xmmRegSet_) % alignof(xmmRegister)) == 0, "Unexpected xmmRegSet_ alignment");
 #endif
     Sudoku::LoadXmmRegistersFromMem(reinterpret_cast<const xmmRegister *>(xmmRegSet_.regVal_));
+    // sudokuXmmCountFromCell writes the number of solutions to context_ and destroys RAX and RDX
+    gRegister firstCell = firstCell_;
+    SudokuSseEnumeratorContext* pContext = &context_;
     asm volatile (
         "call sudokuXmmCountFromCell\n\t"
-        ::"a"(firstCell_):"rbx", "rcx", "rdx", "rsi", "rdi", "r8", "r9", "r10", "r11", "r12", "r13", "r14", "r15");
+        :"+a"(firstCell),"+d"(pContext)::"rbx", "rcx", "rsi", "rdi", "r8", "r9", "r10", "r11", "r12", "r13", "r14", "r15", "memory");
     Sudoku::SaveXmmRegistersToMem(reinterpret_cast<xmmRegister *>(xmmRegSet_.regVal_));
 
-    rightBottomElement_ = static_cast<decltype(rightBottomElement_)>(sudokuXmmRightBottomElement);
-    return sudokuXmmAllPatternCnt;
-}
-
-SudokuSseEnumeratorMap* SudokuSseEnumeratorMap::GetInstance(void) {
-    return pInstance_;
+    rightBottomElement_ = static_cast<decltype(rightBottomElement_)>(context_.rightBottomElement);
+    return context_.allPatternCnt;
 }
 
 size_t SudokuSseEnumeratorMap::powerOfTwoPlusOne(SudokuSseElement regValue) const {
@@ -1158,24 +1889,241 @@ size_t SudokuSseEnumeratorMap::powerOfTwoPlusOne(SudokuSseElement regValue) cons
     return 0;
 }
 
-void SudokuSseEnumeratorMap::presetCell(SudokuLoopIndex index, int num) {
-    SudokuSseElement candidate = static_cast<decltype(candidate)>(num);
+SudokuSseMapEnumerator::SudokuSseMapEnumerator(std::ostream* pSudokuOutStream, SudokuPatternCount printAllCandidate)
+    : printAllCandidate_(printAllCandidate), patternNumber_(0), patternCount_(0),
+      maxPatternCount_(std::numeric_limits<SudokuPatternCount>::max()), pSudokuOutStream_(pSudokuOutStream) {
+    return;
+}
 
-    if ((candidate == 0) || (index >= Sudoku::SizeOfAllCells)) {
-        return;
+// Stops counting solutions when it finds maxCount solutions
+void SudokuSseMapEnumerator::SetMaxCount(SudokuPatternCount maxCount) {
+    maxPatternCount_ = maxCount;
+    return;
+}
+
+SudokuPatternCount SudokuSseMapEnumerator::Enumerate(const SudokuSseMap& map) {
+    patternNumber_ = 0;
+    patternCount_ = 0;
+    if (maxPatternCount_ > 0) {
+        SudokuSseMap newMap = map;
+        count(newMap);
     }
+    return patternCount_;
+}
 
-    if ((index + 1) == Sudoku::SizeOfAllCells) {
-        rightBottomElement_ = 1 << (candidate - 1);
-        return;
+// Returns true if this is faster than SudokuSseEnumeratorMap to count solutions of a puzzle.
+// SudokuSseEnumeratorMap fills cells from the top-left corner so it is fast when preset cells
+// are packed at the top-left corner but it is slow and cannot run on packed cells builds otherwise.
+// sudokuXmmCountFromCell does not check diagonal bars and this keeps its results in diagonal Sudoku.
+bool SudokuSseMapEnumerator::IsSuitable(const SudokuSseMap& map) {
+    if (DiagonalSudokuMode) {
+        return false;
     }
 
-    size_t pos = 0;
-    size_t shift = 0;
-    if ((index % Sudoku::SizeOfCellsPerGroup) + 1 == Sudoku::SizeOfCellsPerGroup) {
-        pos = index / Sudoku::SizeOfCellsPerGroup;
-        shift = pos % 2;
-        pos /= 2;
+    auto foundEmpty = false;
+    for(SudokuLoopIndex i=0; i<Sudoku::SizeOfAllCells; ++i) {
+        const auto candidates = getCandidates(map, i);
+        if (candidates & (candidates - 1)) {
+            foundEmpty = true;
+        } else if (foundEmpty) {
+            // Found a preset cell after a blank cell
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void SudokuSseMapEnumerator::count(SudokuSseMap& map) {
+    // Solves forward until we cannot reduce candidates anymore
+    SudokuSseMapResult result;
+    map.FillCrossing(false, result);
+    if (result.aborted) {
+        return;
+    }
+
+    if (result.elementCnt == Sudoku::SizeOfAllCells) {
+        printSolution(map);
+        ++patternCount_;
+        return;
+    }
+
+    // Guesses each candidate of a cell which has the fewest candidates
+    SudokuSseCandidateCell cell;
+    if (!map.GetNextCell(result, cell)) {
+        return;
+    }
+
+    // Stops searching when it finds enough solutions
+    auto candidates = map.GetCandidates(cell);
+    while(candidates && (patternCount_ < maxPatternCount_)) {
+        const SudokuSseElement candidate = candidates & (~candidates + 1);
+        candidates ^= candidate;
+        SudokuSseMap newMap = map;
+        newMap.SetUniqueCell(cell, candidate);
+        count(newMap);
+    }
+
+    return;
+}
+
+// Prints a solution in the same format as SudokuSseEnumeratorMap
+void SudokuSseMapEnumerator::printSolution(const SudokuSseMap& map) {
+    if ((pSudokuOutStream_ == nullptr) || (patternNumber_ >= printAllCandidate_)) {
+        return;
+    }
+
+    ++patternNumber_;
+    (*pSudokuOutStream_) << "[Solution " << patternNumber_ << "]\n";
+    for(SudokuLoopIndex i=0; i<Sudoku::SizeOfAllCells; ++i) {
+        const auto candidates = getCandidates(map, i);
+        (*pSudokuOutStream_) << (candidates ? (__builtin_ctz(candidates) + 1) : 0);
+        (*pSudokuOutStream_) << ((((i + 1) % Sudoku::SizeOfCellsPerGroup) != 0) ? ":" : "\n");
+    }
+
+    return;
+}
+
+// Returns candidates of a cell in the order of cells in a preset string
+SudokuSseElement SudokuSseMapEnumerator::getCandidates(const SudokuSseMap& map, SudokuLoopIndex cellIndex) {
+    const auto row = cellIndex / Sudoku::SizeOfCellsPerGroup;
+    const auto column = cellIndex % Sudoku::SizeOfCellsPerGroup;
+    // The leftmost box is at the highest word and the leftmost cell is at the highest bits in a word
+    const size_t regIndex = (SudokuSseMap::InitialRegisterNum + row) * SudokuSse::RegisterWordCnt +
+        Sudoku::SizeOfBoxesOnEdge - 1 - column / Sudoku::SizeOfCellsOnBoxEdge;
+    const auto shift = (Sudoku::SizeOfCellsOnBoxEdge - 1 - column % Sudoku::SizeOfCellsOnBoxEdge) * Sudoku::SizeOfCandidates;
+    return (map.xmmRegSet_.regVal_[regIndex] >> shift) & Sudoku::AllCandidates;
+}
+
+SudokuSseParallelEnumerator::SudokuSseParallelEnumerator(const std::string& presetStr, SudokuIndex splitDepth)
+    : inAnyOrder_(false) {
+    SudokuSseMap map;
+    map.Preset(presetStr);
+    inAnyOrder_ = SudokuSseMapEnumerator::IsSuitable(map);
+
+    // Cells out of presetStr are blank
+    std::string puzzle(Sudoku::SizeOfAllCells, BlankCell);
+    for(SudokuLoopIndex i=0; (i<Sudoku::SizeOfAllCells) && (i<presetStr.length()); ++i) {
+#if __cplusplus >= 201703L
+        const auto [converted, num] = Sudoku::ConvertCharToSudokuCandidate(Sudoku::MinCandidatesNumber,
+                                                                           Sudoku::MaxCandidatesNumber, presetStr[i]);
+        if (converted)
+#else
+        int num = 0;
+        if (Sudoku::ConvertCharToSudokuCandidate(Sudoku::MinCandidatesNumber,
+                                                 Sudoku::MaxCandidatesNumber, presetStr[i], num))
+#endif
+        {
+            puzzle[i] = static_cast<char>('0' + num);
+        }
+    }
+
+    split(puzzle, 0, splitDepth);
+    return;
+}
+
+// Counts solutions in subtrees on threads and sums them
+SudokuPatternCount SudokuSseParallelEnumerator::Enumerate(Sudoku::BaseParallelRunner& parallelRunner,
+                                                          NumberOfCores numberOfThreads) {
+    const NumberOfCores numberOfWorkers = (numberOfThreads > 1) ? numberOfThreads : 1;
+    std::vector<SudokuPatternCount> countSet(numberOfWorkers, 0);
+    std::atomic<SudokuPuzzleCount> nextSubtree(0);
+
+    // Numbers of solutions in subtrees differ widely so each worker
+    // takes a next subtree when it finishes its current subtree.
+    for(auto& count : countSet) {
+        Sudoku::BaseParallelRunner::Evaluator evaluator = [this, &nextSubtree, &count] {
+            for(;;) {
+                const auto index = nextSubtree.fetch_add(1);
+                if (index >= subtreeSet_.size()) {
+                    break;
+                }
+                // Filling first blank cells keeps whether preset cells are packed
+                if (inAnyOrder_) {
+                    SudokuSseMap map;
+                    map.Preset(subtreeSet_[index]);
+                    SudokuSseMapEnumerator enumerator(nullptr, 0);
+                    count += enumerator.Enumerate(map);
+                } else {
+                    SudokuSseEnumeratorMap map(nullptr);
+                    map.Preset(subtreeSet_[index]);
+                    count += map.Count();
+                }
+            }
+            return false;
+        };
+        parallelRunner.Add(evaluator);
+    }
+
+    parallelRunner.Run(numberOfWorkers);
+    return std::accumulate(countSet.begin(), countSet.end(), static_cast<SudokuPatternCount>(0));
+}
+
+SudokuPuzzleCount SudokuSseParallelEnumerator::GetSubtreeCount(void) const {
+    return subtreeSet_.size();
+}
+
+// Fills 'depth' blank cells from 'cellIndex' with all candidates that can be set
+void SudokuSseParallelEnumerator::split(std::string& puzzle, SudokuLoopIndex cellIndex, SudokuIndex depth) {
+    while((cellIndex < Sudoku::SizeOfAllCells) && (puzzle[cellIndex] != BlankCell)) {
+        ++cellIndex;
+    }
+
+    if ((depth == 0) || (cellIndex >= Sudoku::SizeOfAllCells)) {
+        subtreeSet_.push_back(puzzle);
+        return;
+    }
+
+    for(SudokuNumber num=Sudoku::MinCandidatesNumber; num<=Sudoku::MaxCandidatesNumber; ++num) {
+        const char cell = static_cast<char>('0' + num);
+        if (canSetCell(puzzle, cellIndex, cell)) {
+            puzzle[cellIndex] = cell;
+            split(puzzle, cellIndex + 1, depth - 1);
+        }
+    }
+
+    puzzle[cellIndex] = BlankCell;
+    return;
+}
+
+// Returns true if no cells in the row, column and box of a cell have the same number
+// Diagonal bars are not checked because sudokuXmmCountFromCell does not check them.
+bool SudokuSseParallelEnumerator::canSetCell(const std::string& puzzle, SudokuLoopIndex cellIndex, char cell) const {
+    constexpr SudokuLoopIndex boxSize = 3;
+    const SudokuLoopIndex row = cellIndex / Sudoku::SizeOfCellsPerGroup;
+    const SudokuLoopIndex column = cellIndex % Sudoku::SizeOfCellsPerGroup;
+    const SudokuLoopIndex boxRow = row - row % boxSize;
+    const SudokuLoopIndex boxColumn = column - column % boxSize;
+
+    for(SudokuLoopIndex i=0; i<Sudoku::SizeOfCellsPerGroup; ++i) {
+        if ((puzzle[row * Sudoku::SizeOfCellsPerGroup + i] == cell) ||
+            (puzzle[i * Sudoku::SizeOfCellsPerGroup + column] == cell) ||
+            (puzzle[(boxRow + i / boxSize) * Sudoku::SizeOfCellsPerGroup + boxColumn + i % boxSize] == cell)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void SudokuSseEnumeratorMap::presetCell(SudokuLoopIndex index, int num) {
+    SudokuSseElement candidate = static_cast<decltype(candidate)>(num);
+
+    if ((candidate == 0) || (index >= Sudoku::SizeOfAllCells)) {
+        return;
+    }
+
+    if ((index + 1) == Sudoku::SizeOfAllCells) {
+        rightBottomElement_ = 1 << (candidate - 1);
+        return;
+    }
+
+    size_t pos = 0;
+    size_t shift = 0;
+    if ((index % Sudoku::SizeOfCellsPerGroup) + 1 == Sudoku::SizeOfCellsPerGroup) {
+        pos = index / Sudoku::SizeOfCellsPerGroup;
+        shift = pos % 2;
+        pos /= 2;
         pos += (RightColumnRegisterNum * (sizeof(xmmRegSet_.regXmmVal_[0]) / sizeof(xmmRegSet_.regVal_[0])));
     } else {
         pos += index % Sudoku::SizeOfCellsPerGroup;
@@ -1185,27 +2133,1300 @@ void SudokuSseEnumeratorMap::presetCell(SudokuLoopIndex index, int num) {
             * (sizeof(xmmRegSet_.regXmmVal_[0]) / sizeof(xmmRegSet_.regVal_[0]));
     }
 
-    xmmRegSet_.regVal_[pos] |= (1 << (shift * CellBitWidth + candidate - 1));
-    return;
+    xmmRegSet_.regVal_[pos] |= (1 << (shift * CellBitWidth + candidate - 1));
+    return;
+}
+
+SudokuSolver::SudokuSolver(const std::string& presetStr, SudokuIndex seed, std::ostream* pSudokuOutStream)
+    : SudokuBaseSolver(pSudokuOutStream) {
+    // Actually, it is good to set always 0 to seed
+    map_.Preset(presetStr, 0);
+    map_.SetTrail(&trail_);
+    return;
+}
+
+SudokuSolver::SudokuSolver(const std::string& presetStr, SudokuIndex seed, std::ostream* pSudokuOutStream, SudokuPatternCount printAllCandidate)
+    : SudokuBaseSolver(pSudokuOutStream) {
+    // 'printAllCandidate' is not used, just for interface compatibility with the SSE solver
+    map_.Preset(presetStr, 0);
+    map_.SetTrail(&trail_);
+    return;
+}
+
+// Solves a puzzle and writes its solution
+bool SudokuSolver::Exec(bool silent, bool verbose) {
+    const auto result = solve(map_, true, verbose);
+    if (silent == false) {
+        map_.Print(pSudokuOutStream_);
+    }
+    return result;
+}
+
+// Prints this solver type
+void SudokuSolver::PrintType(void) {
+    SudokuBaseSolver::printType("C++", pSudokuOutStream_);
+    return;
+}
+
+// Preset() leaves candidates of blank cells which the previous puzzle changed
+void SudokuSolver::Reset(const std::string& presetStr) {
+    clearCount();
+    trail_.Clear();
+    map_ = SudokuMap();
+    map_.Preset(presetStr, 0);
+    map_.SetTrail(&trail_);
+    return;
+}
+
+// 'topLevel' is not used, just for interface compatibility with the SSE solver
+bool SudokuSolver::solve(SudokuMap& map, bool topLevel, bool verbose) {
+    // Start backtracking before filling cells for Sudoku-X puzzles
+    for(;;) {
+        if (fillCells(map, topLevel, verbose) == false) {
+            return false;
+        }
+        if (verbose) {
+            map.Print(pSudokuOutStream_);
+        }
+        if (map.IsFilled()) {
+            if (!map.IsConsistent()) {
+                // Aborts backtracking
+                return false;
+            }
+            // Solved!
+            return true;
+        }
+
+        // Filling cells stalls here. Fills cells again if the locked candidates
+        // method or subsets reduce candidates.
+        if (!map.FindLockedCandidates() &&
+            !(canFindSubsets(map.CountFilledCells()) && map.FindSubsets())) {
+            break;
+        }
+    }
+
+    // We start backtracking because we cannot reduce candidates anymore
+    const auto cellIndex = map.SelectBacktrackedCellIndex();
+    // Guesses candidates in the cell in the value order
+    SudokuCellCandidates orderedSet[Sudoku::SizeOfCandidates];
+    const auto size = map.OrderCandidates(cellIndex, orderedSet);
+    for(SudokuLoopIndex i=0;i<size;++i) {
+        ++guessCount_;
+        // Rewinds only cells which the guess changed instead of copying the whole map
+        const auto mark = trail_.GetMark();
+        map.SetUniqueCell(cellIndex, orderedSet[i]);
+        if (solve(map, false, verbose)) {
+            // Solved!
+            return true;
+        }
+        map.Rewind(mark);
+    }
+
+    return false;
+}
+
+// 'topLevel' is not used, just for interface compatibility with the SSE solver
+bool SudokuSolver::fillCells(SudokuMap& map, bool topLevel, bool verbose) {
+    ++count_;
+    if (verbose) {
+        if (pSudokuOutStream_ != nullptr) {
+            (*pSudokuOutStream_) << "Step " << count_ << "\n";
+        }
+    }
+    return (map.Propagate() == false);
+}
+
+// --------------- the C++ solver with AVX2 intrinsics ---------------
+#if defined(SUDOKU_SOA_MAP)
+namespace {
+    // Lanes 0..8 of a YMM register hold cells
+    INLINE __m256i soaCellLanes(void) {
+        return _mm256_setr_epi16(-1, -1, -1, -1, -1, -1, -1, -1, -1, 0, 0, 0, 0, 0, 0, 0);
+    }
+
+    INLINE __m256i soaAllOnes(void) {
+        return _mm256_set1_epi16(-1);
+    }
+
+    // Returns all ones in lanes which hold one candidate
+    INLINE __m256i soaUniqueLanes(__m256i cells) {
+        const auto zero = _mm256_setzero_si256();
+        const auto lowerBits = _mm256_and_si256(cells, _mm256_sub_epi16(cells, _mm256_set1_epi16(1)));
+        return _mm256_andnot_si256(_mm256_cmpeq_epi16(cells, zero), _mm256_cmpeq_epi16(lowerBits, zero));
+    }
+
+    // Returns all ones in lanes which hold two or more candidates
+    INLINE __m256i soaMultipleLanes(__m256i cells) {
+        const auto lowerBits = _mm256_and_si256(cells, _mm256_sub_epi16(cells, _mm256_set1_epi16(1)));
+        return _mm256_xor_si256(_mm256_cmpeq_epi16(lowerBits, _mm256_setzero_si256()), soaAllOnes());
+    }
+
+    // Returns all ones in lanes 0..8 if a group lacks any candidates
+    INLINE __m256i soaMissingLanes(__m256i allCandidatesInGroup) {
+        const auto cellLanes = soaCellLanes();
+        const auto expected = _mm256_and_si256(cellLanes, _mm256_set1_epi16(Sudoku::AllCandidates));
+        return _mm256_xor_si256(_mm256_and_si256(allCandidatesInGroup, cellLanes), expected);
+    }
+
+    // Merges candidates in two sets of lanes.
+    // 'twice' collects candidates which two or more lanes hold.
+    INLINE void soaMergeLanes(__m256i& once, __m256i& twice, __m256i otherOnce, __m256i otherTwice) {
+        twice = _mm256_or_si256(_mm256_or_si256(twice, otherTwice), _mm256_and_si256(once, otherOnce));
+        once = _mm256_or_si256(once, otherOnce);
+        return;
+    }
+
+    // Broadcasts candidates which four lanes in each 64-bit word hold once or more
+    // and twice or more to the four lanes
+    INLINE void soaReduceLanesInWord(__m256i& once, __m256i& twice) {
+        soaMergeLanes(once, twice, _mm256_shuffle_epi32(once, _MM_SHUFFLE(2, 3, 0, 1)),
+                      _mm256_shuffle_epi32(twice, _MM_SHUFFLE(2, 3, 0, 1)));
+        soaMergeLanes(once, twice,
+                      _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(once, _MM_SHUFFLE(2, 3, 0, 1)), _MM_SHUFFLE(2, 3, 0, 1)),
+                      _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(twice, _MM_SHUFFLE(2, 3, 0, 1)), _MM_SHUFFLE(2, 3, 0, 1)));
+        return;
+    }
+
+    // Broadcasts candidates which lanes hold once or more and twice or more to all lanes
+    INLINE void soaReduceLanes(__m256i& once, __m256i& twice) {
+        soaMergeLanes(once, twice, _mm256_permute2x128_si256(once, once, 1),
+                      _mm256_permute2x128_si256(twice, twice, 1));
+        soaMergeLanes(once, twice, _mm256_shuffle_epi32(once, _MM_SHUFFLE(1, 0, 3, 2)),
+                      _mm256_shuffle_epi32(twice, _MM_SHUFFLE(1, 0, 3, 2)));
+        soaReduceLanesInWord(once, twice);
+        return;
+    }
+
+    // Broadcasts candidates in all lanes to all lanes
+    INLINE __m256i soaOrLanes(__m256i cells) {
+        auto once = _mm256_or_si256(cells, _mm256_permute2x128_si256(cells, cells, 1));
+        once = _mm256_or_si256(once, _mm256_shuffle_epi32(once, _MM_SHUFFLE(1, 0, 3, 2)));
+        once = _mm256_or_si256(once, _mm256_shuffle_epi32(once, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm256_or_si256(once, _mm256_shufflehi_epi16(
+                                   _mm256_shufflelo_epi16(once, _MM_SHUFFLE(2, 3, 0, 1)), _MM_SHUFFLE(2, 3, 0, 1)));
+    }
+
+    // Returns a mask to restrict cells to their candidates which no other cells
+    // in a group hold (hidden singles) and all ones if a cell has no such candidates.
+    // 'inconsistent' gets all ones in lanes which have two or more such candidates.
+    INLINE __m256i soaHiddenSingleMask(__m256i cells, __m256i twice, __m256i& inconsistent) {
+        const auto exclusive = _mm256_andnot_si256(twice, cells);
+        inconsistent = _mm256_or_si256(inconsistent, soaMultipleLanes(exclusive));
+        return _mm256_blendv_epi8(exclusive, soaAllOnes(), _mm256_cmpeq_epi16(exclusive, _mm256_setzero_si256()));
+    }
+
+    // Returns a mask to remove unique candidates in a group from cells
+    // which have multiple candidates (naked singles)
+    INLINE __m256i soaNakedSingleMask(__m256i isUnique, __m256i uniqueCandidates) {
+        return _mm256_or_si256(_mm256_xor_si256(uniqueCandidates, soaAllOnes()), isUnique);
+    }
+
+    // Returns the number of candidates in each lane and all ones in lanes which
+    // do not have multiple candidates
+    INLINE __m256i soaCountMultipleCandidates(__m256i cells) {
+        // The number of bits in nibbles
+        const auto popCountTable = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                                    0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+        const auto nibbleMask = _mm256_set1_epi8(0xf);
+        const auto byteMask = _mm256_set1_epi16(0xff);
+        const auto lowerCount = _mm256_shuffle_epi8(popCountTable, _mm256_and_si256(cells, nibbleMask));
+        const auto upperCount = _mm256_shuffle_epi8(popCountTable,
+                                                    _mm256_and_si256(_mm256_srli_epi16(cells, 4), nibbleMask));
+        const auto byteCount = _mm256_add_epi8(lowerCount, upperCount);
+        const auto count = _mm256_add_epi16(_mm256_and_si256(byteCount, byteMask), _mm256_srli_epi16(byteCount, 8));
+        return _mm256_or_si256(count, _mm256_xor_si256(soaMultipleLanes(cells), soaAllOnes()));
+    }
+
+    // Finds the least count in 16 lanes and returns it and its lane in the same manner as PHMINPOSUW.
+    // PHMINPOSUW finds the least count and its lane in lanes 0..7 and 8..15.
+    INLINE void soaFindLeastLane(__m256i countSet, unsigned int& leastCount, SudokuIndex& lane) {
+        constexpr unsigned int laneMask = std::numeric_limits<uint16_t>::max();
+        const __m128i halfSet[] {_mm256_castsi256_si128(countSet), _mm256_extracti128_si256(countSet, 1)};
+        SudokuIndex laneOffset = 0;
+        for(const auto& half : halfSet) {
+            const unsigned int minPos = _mm_cvtsi128_si32(_mm_minpos_epu16(half));
+            const auto count = minPos & laneMask;
+            if (count < leastCount) {
+                leastCount = count;
+                lane = static_cast<SudokuIndex>(laneOffset + (minPos >> 16));
+            }
+            laneOffset += 8;
+        }
+        return;
+    }
+}
+
+SudokuSoaMap::SudokuSoaMap(void) {
+    for(SudokuLoopIndex row=0;row<Sudoku::SizeOfGroupsPerMap;++row) {
+        for(SudokuLoopIndex column=0;column<SudokuLaneCnt;++column) {
+            rows_[row][column] = (column < Sudoku::SizeOfCellsPerGroup) ? Sudoku::AllCandidates : 0;
+        }
+    }
+
+    copyRowsToBoxes();
+    return;
+}
+
+// Presets numbers in a given puzzle to cells
+void SudokuSoaMap::Preset(const std::string& presetStr) {
+    for(SudokuLoopIndex i=0;i<Sudoku::SizeOfAllCells;++i) {
+        SudokuCell cell;
+        // Pad with white spaces
+        cell.Preset((i < presetStr.length()) ? presetStr.at(i) : ' ');
+        rows_[i / Sudoku::SizeOfCellsPerGroup][i % Sudoku::SizeOfCellsPerGroup] = cell.GetCandidates();
+    }
+
+    copyRowsToBoxes();
+    return;
+}
+
+// Print all candidates in cells
+void SudokuSoaMap::Print(std::ostream* pSudokuOutStream) const {
+    if (pSudokuOutStream == nullptr) {
+        return;
+    }
+
+    for(SudokuLoopIndex row=0;row<Sudoku::SizeOfGroupsPerMap;++row) {
+        for(SudokuLoopIndex column=0;column<Sudoku::SizeOfCellsPerGroup;++column) {
+            Sudoku::PrintSudokuElement<SudokuCellCandidates>(
+                rows_[row][column], Sudoku::UniqueCandidates, Sudoku::EmptyCandidates, pSudokuOutStream);
+            (*pSudokuOutStream) << ":";
+        }
+        (*pSudokuOutStream) << "\n";
+    }
+    (*pSudokuOutStream) << "\n";
+
+    return;
+}
+
+// Fills cells until no cells get fewer candidates
+// and returns true if finding a cell that cannot be filled.
+bool SudokuSoaMap::FillCrossing(void) {
+    for(;;) {
+        bool changed = false;
+        if (fillCrossingOnce(changed)) {
+            return true;
+        }
+        if (!changed) {
+            break;
+        }
+    }
+
+    return false;
+}
+
+// Finds naked and hidden singles in all rows, columns, and boxes at once
+// and returns true if finding a cell or a group that cannot be filled.
+// A box is a row of boxes_ and a column is a lane of all rows of rows_,
+// so that we need no shuffles across rows to collect candidates in groups.
+// Use unaligned loads and stores because operator new in C++11 and C++14
+// does not align this map to 32 bytes.
+bool SudokuSoaMap::fillCrossingOnce(bool& changed) {
+    const auto zero = _mm256_setzero_si256();
+    auto inconsistent = zero;
+
+    // Masks for cells in boxes
+    alignas(32) Lane boxMaskSet[Sudoku::SizeOfGroupsPerMap][SudokuLaneCnt];
+    for(SudokuLoopIndex i=0;i<Sudoku::SizeOfGroupsPerMap;++i) {
+        const auto box = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(boxes_[i]));
+        const auto isUnique = soaUniqueLanes(box);
+        auto uniqueOnce = _mm256_and_si256(box, isUnique);
+        auto uniqueTwice = zero;
+        soaReduceLanes(uniqueOnce, uniqueTwice);
+        auto once = box;
+        auto twice = zero;
+        soaReduceLanes(once, twice);
+        inconsistent = _mm256_or_si256(inconsistent, _mm256_or_si256(uniqueTwice, soaMissingLanes(once)));
+        const auto mask = _mm256_and_si256(soaNakedSingleMask(isUnique, uniqueOnce),
+                                           soaHiddenSingleMask(box, twice, inconsistent));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(boxMaskSet[i]), mask);
+    }
+
+    // Arranges the masks for boxes in rows
+    alignas(32) Lane maskSet[Sudoku::SizeOfGroupsPerMap][SudokuLaneCnt];
+    for(SudokuLoopIndex row=0;row<Sudoku::SizeOfGroupsPerMap;++row) {
+        for(SudokuLoopIndex column=0;column<SudokuLaneCnt;++column) {
+            maskSet[row][column] = (column < Sudoku::SizeOfCellsPerGroup) ?
+                boxMaskSet[getBoxIndex(row, column)][getBoxPosition(row, column)] : 0;
+        }
+    }
+
+    if CPP17_IF_CONSTEXPR (DiagonalSudokuMode) {
+        if (maskDiagonalBars(maskSet)) {
+            return true;
+        }
+    }
+
+    // Masks for cells in rows and collects candidates in columns
+    __m256i rowSet[Sudoku::SizeOfGroupsPerMap];
+    __m256i rowMaskSet[Sudoku::SizeOfGroupsPerMap];
+    auto columnUniqueOnce = zero;
+    auto columnUniqueTwice = zero;
+    auto columnOnce = zero;
+    auto columnTwice = zero;
+    for(SudokuLoopIndex i=0;i<Sudoku::SizeOfGroupsPerMap;++i) {
+        const auto row = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rows_[i]));
+        const auto isUnique = soaUniqueLanes(row);
+        const auto unique = _mm256_and_si256(row, isUnique);
+        soaMergeLanes(columnUniqueOnce, columnUniqueTwice, unique, zero);
+        soaMergeLanes(columnOnce, columnTwice, row, zero);
+
+        auto uniqueOnce = unique;
+        auto uniqueTwice = zero;
+        soaReduceLanes(uniqueOnce, uniqueTwice);
+        auto once = row;
+        auto twice = zero;
+        soaReduceLanes(once, twice);
+        inconsistent = _mm256_or_si256(inconsistent, _mm256_or_si256(uniqueTwice, soaMissingLanes(once)));
+        rowSet[i] = row;
+        rowMaskSet[i] = _mm256_and_si256(soaNakedSingleMask(isUnique, uniqueOnce),
+                                         soaHiddenSingleMask(row, twice, inconsistent));
+    }
+    inconsistent = _mm256_or_si256(inconsistent, _mm256_or_si256(columnUniqueTwice, soaMissingLanes(columnOnce)));
+
+    // Applies all masks to cells
+    auto diff = zero;
+    for(SudokuLoopIndex i=0;i<Sudoku::SizeOfGroupsPerMap;++i) {
+        const auto row = rowSet[i];
+        const auto columnMask = _mm256_and_si256(soaNakedSingleMask(soaUniqueLanes(row), columnUniqueOnce),
+                                                 soaHiddenSingleMask(row, columnTwice, inconsistent));
+        const auto boxMask = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(maskSet[i]));
+        const auto newRow = _mm256_and_si256(_mm256_and_si256(row, rowMaskSet[i]),
+                                             _mm256_and_si256(columnMask, boxMask));
+        // Cells which have no candidates
+        inconsistent = _mm256_or_si256(inconsistent, _mm256_and_si256(
+                                           _mm256_cmpeq_epi16(newRow, zero), soaCellLanes()));
+        diff = _mm256_or_si256(diff, _mm256_xor_si256(newRow, row));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(rows_[i]), newRow);
+    }
+
+    copyRowsToBoxes();
+    changed = (_mm256_testz_si256(diff, diff) == 0);
+    return (_mm256_testz_si256(inconsistent, inconsistent) == 0);
+}
+
+// Finds naked and hidden singles in the two diagonal bars and restricts masks of their cells.
+// Returns true if finding a diagonal bar that cannot be filled.
+bool SudokuSoaMap::maskDiagonalBars(Lane (&maskSet)[Sudoku::SizeOfGroupsPerMap][SudokuLaneCnt]) const {
+    for(SudokuLoopIndex bar=0;bar<2;++bar) {
+        auto uniqueOnce = SudokuCell::GetEmptyCandidates();
+        auto uniqueTwice = SudokuCell::GetEmptyCandidates();
+        auto once = SudokuCell::GetEmptyCandidates();
+        auto twice = SudokuCell::GetEmptyCandidates();
+        for(SudokuLoopIndex row=0;row<Sudoku::SizeOfGroupsPerMap;++row) {
+            const SudokuCellCandidates cell = rows_[row][getDiagonalColumn(bar, row)];
+            if (SudokuCell::IsUniqueCandidate(cell)) {
+                uniqueTwice |= uniqueOnce & cell;
+                uniqueOnce |= cell;
+            }
+            twice |= once & cell;
+            once |= cell;
+        }
+
+        if ((uniqueTwice != SudokuCell::GetEmptyCandidates()) || (once != Sudoku::AllCandidates)) {
+            return true;
+        }
+
+        for(SudokuLoopIndex row=0;row<Sudoku::SizeOfGroupsPerMap;++row) {
+            const auto column = getDiagonalColumn(bar, row);
+            const SudokuCellCandidates cell = rows_[row][column];
+            const auto exclusive = cell & ~twice;
+            auto mask = SudokuCell::IsUniqueCandidate(cell) ? cell : SudokuCell::FlipCandidates(uniqueOnce);
+            if (exclusive != SudokuCell::GetEmptyCandidates()) {
+                if (!SudokuCell::IsUniqueCandidate(exclusive)) {
+                    return true;
+                }
+                mask &= exclusive;
+            }
+            maskSet[row][column] &= static_cast<Lane>(mask);
+        }
+    }
+
+    return false;
+}
+
+// Returns whether all cells are filled
+bool SudokuSoaMap::IsFilled(void) const {
+    for(SudokuLoopIndex i=0;i<Sudoku::SizeOfGroupsPerMap;++i) {
+        const auto row = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rows_[i]));
+        if (_mm256_testc_si256(soaUniqueLanes(row), soaCellLanes()) == 0) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Returns whether all groups hold all numbers after filling all cells
+bool SudokuSoaMap::IsConsistent(void) const {
+    if (!IsFilled()) {
+        return false;
+    }
+
+    auto missing = _mm256_setzero_si256();
+    auto columnOnce = _mm256_setzero_si256();
+    for(SudokuLoopIndex i=0;i<Sudoku::SizeOfGroupsPerMap;++i) {
+        const auto row = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rows_[i]));
+        const auto box = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(boxes_[i]));
+        missing = _mm256_or_si256(missing, _mm256_or_si256(soaMissingLanes(soaOrLanes(row)),
+                                                           soaMissingLanes(soaOrLanes(box))));
+        columnOnce = _mm256_or_si256(columnOnce, row);
+    }
+    missing = _mm256_or_si256(missing, soaMissingLanes(columnOnce));
+    if (_mm256_testz_si256(missing, missing) == 0) {
+        return false;
+    }
+
+    if CPP17_IF_CONSTEXPR (DiagonalSudokuMode) {
+        for(SudokuLoopIndex bar=0;bar<2;++bar) {
+            auto allCandidates = SudokuCell::GetEmptyCandidates();
+            for(SudokuLoopIndex row=0;row<Sudoku::SizeOfGroupsPerMap;++row) {
+                allCandidates |= rows_[row][getDiagonalColumn(bar, row)];
+            }
+            if (allCandidates != Sudoku::AllCandidates) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+SudokuIndex SudokuSoaMap::CountFilledCells(void) const {
+    SudokuIndex count = 0;
+    for(SudokuLoopIndex i=0;i<Sudoku::SizeOfGroupsPerMap;++i) {
+        const auto row = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rows_[i]));
+        // Two bits for each lane
+        count += __builtin_popcount(_mm256_movemask_epi8(soaUniqueLanes(row))) / 2;
+    }
+    return count;
+}
+
+// Returns the index of a cell which has the fewest candidates of all cells
+// which have multiple candidates (the first cell if there are two or more such cells).
+SudokuIndex SudokuSoaMap::SelectBacktrackedCellIndex(void) const {
+    // Lanes which do not have multiple candidates hold this count
+    unsigned int leastCount = std::numeric_limits<Lane>::max();
+    SudokuIndex resultCellIndex = 0;
+
+    for(SudokuLoopIndex i=0;i<Sudoku::SizeOfGroupsPerMap;++i) {
+        const auto row = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rows_[i]));
+        const auto previousCount = leastCount;
+        SudokuIndex lane = 0;
+        soaFindLeastLane(soaCountMultipleCandidates(row), leastCount, lane);
+        if (leastCount < previousCount) {
+            resultCellIndex = static_cast<SudokuIndex>(i * Sudoku::SizeOfCellsPerGroup + lane);
+        }
+    }
+
+    return resultCellIndex;
+}
+
+INLINE SudokuCellCandidates SudokuSoaMap::GetCandidates(SudokuIndex cellIndex) const {
+    return rows_[cellIndex / Sudoku::SizeOfCellsPerGroup][cellIndex % Sudoku::SizeOfCellsPerGroup];
+}
+
+INLINE void SudokuSoaMap::SetUniqueCell(SudokuIndex cellIndex, SudokuCellCandidates candidate) {
+    const SudokuIndex row = cellIndex / Sudoku::SizeOfCellsPerGroup;
+    const SudokuIndex column = cellIndex % Sudoku::SizeOfCellsPerGroup;
+    rows_[row][column] = static_cast<Lane>(candidate);
+    boxes_[getBoxIndex(row, column)][getBoxPosition(row, column)] = static_cast<Lane>(candidate);
+    return;
+}
+
+void SudokuSoaMap::copyRowsToBoxes(void) {
+    for(SudokuLoopIndex row=0;row<Sudoku::SizeOfGroupsPerMap;++row) {
+        for(SudokuLoopIndex column=0;column<SudokuLaneCnt;++column) {
+            if (column < Sudoku::SizeOfCellsPerGroup) {
+                boxes_[getBoxIndex(row, column)][getBoxPosition(row, column)] = rows_[row][column];
+            } else {
+                boxes_[row][column] = 0;
+            }
+        }
+    }
+    return;
+}
+
+INLINE SudokuIndex SudokuSoaMap::getBoxIndex(SudokuIndex row, SudokuIndex column) {
+    return (row / Sudoku::SizeOfCellsOnBoxEdge) * Sudoku::SizeOfBoxesOnEdge + column / Sudoku::SizeOfCellsOnBoxEdge;
+}
+
+INLINE SudokuIndex SudokuSoaMap::getBoxPosition(SudokuIndex row, SudokuIndex column) {
+    return (row % Sudoku::SizeOfCellsOnBoxEdge) * Sudoku::SizeOfCellsOnBoxEdge + column % Sudoku::SizeOfCellsOnBoxEdge;
+}
+
+// Returns the column of a cell in a row on the diagonal bar {to the right from 0, to the left from 8}
+INLINE SudokuIndex SudokuSoaMap::getDiagonalColumn(SudokuIndex bar, SudokuIndex row) {
+    return bar ? (Sudoku::SizeOfCellsPerGroup - 1 - row) : row;
+}
+
+SudokuSoaSolver::SudokuSoaSolver(const std::string& presetStr, std::ostream* pSudokuOutStream)
+    : SudokuBaseSolver(pSudokuOutStream) {
+    map_.Preset(presetStr);
+    return;
+}
+
+// Solves a puzzle and writes its solution
+bool SudokuSoaSolver::Exec(bool silent, bool verbose) {
+    const auto result = solve(map_, verbose);
+    if (silent == false) {
+        map_.Print(pSudokuOutStream_);
+    }
+    return result;
+}
+
+// Prints this solver type
+void SudokuSoaSolver::PrintType(void) {
+    SudokuBaseSolver::printType("C++ with AVX2", pSudokuOutStream_);
+    return;
+}
+
+void SudokuSoaSolver::Reset(const std::string& presetStr) {
+    clearCount();
+    map_.Preset(presetStr);
+    return;
+}
+
+bool SudokuSoaSolver::solve(SudokuSoaMap& map, bool verbose) {
+    ++count_;
+    if (verbose) {
+        if (pSudokuOutStream_ != nullptr) {
+            (*pSudokuOutStream_) << "Step " << count_ << "\n";
+        }
+    }
+
+    if (map.FillCrossing()) {
+        return false;
+    }
+    if (verbose) {
+        map.Print(pSudokuOutStream_);
+    }
+    if (map.IsFilled()) {
+        return map.IsConsistent();
+    }
+
+    // Guesses a number in a cell which has the fewest candidates
+    const auto cellIndex = map.SelectBacktrackedCellIndex();
+    auto candidates = map.GetCandidates(cellIndex);
+    while(candidates != SudokuCell::GetEmptyCandidates()) {
+        // The lowest candidate
+        const auto candidate = candidates & (~candidates + 1);
+        candidates ^= candidate;
+        ++guessCount_;
+        // Copying the map is cheaper than rewinding it because it is small
+        SudokuSoaMap guessedMap = map;
+        guessedMap.SetUniqueCell(cellIndex, candidate);
+        if (solve(guessedMap, verbose)) {
+            // Solved!
+            map = guessedMap;
+            return true;
+        }
+    }
+
+    return false;
+}
+#endif
+
+// --------------- the bitplane solver ---------------
+SudokuBitplaneMap::SudokuBitplaneMap(void) {
+    for(SudokuLoopIndex number=0;number<Sudoku::SizeOfCandidates;++number) {
+        for(SudokuLoopIndex band=0;band<SizeOfBands;++band) {
+            planes_[number][band] = AllCellsInBand;
+        }
+    }
+
+    for(SudokuLoopIndex band=0;band<SizeOfBands;++band) {
+        placed_[band] = 0;
+    }
+    return;
+}
+
+// Presets numbers in a given puzzle to cells
+void SudokuBitplaneMap::Preset(const std::string& presetStr) {
+    for(SudokuLoopIndex i=0;i<Sudoku::SizeOfAllCells;++i) {
+        SudokuCell cell;
+        // Pad with white spaces
+        cell.Preset((i < presetStr.length()) ? presetStr.at(i) : ' ');
+        SetUniqueCell(i, cell.GetCandidates());
+    }
+
+    for(SudokuLoopIndex band=0;band<SizeOfBands;++band) {
+        placed_[band] = 0;
+    }
+    return;
+}
+
+// Print all candidates in cells
+void SudokuBitplaneMap::Print(std::ostream* pSudokuOutStream) const {
+    if (pSudokuOutStream == nullptr) {
+        return;
+    }
+
+    for(SudokuLoopIndex row=0;row<Sudoku::SizeOfGroupsPerMap;++row) {
+        for(SudokuLoopIndex column=0;column<Sudoku::SizeOfCellsPerGroup;++column) {
+            Sudoku::PrintSudokuElement<SudokuCellCandidates>(
+                GetCandidates(row * Sudoku::SizeOfCellsPerGroup + column),
+                Sudoku::UniqueCandidates, Sudoku::EmptyCandidates, pSudokuOutStream);
+            (*pSudokuOutStream) << ":";
+        }
+        (*pSudokuOutStream) << "\n";
+    }
+    (*pSudokuOutStream) << "\n";
+
+    return;
+}
+
+// Fills cells until no cells get fewer candidates
+// and returns true if finding a cell that cannot be filled.
+bool SudokuBitplaneMap::FillCrossing(void) {
+    for(;;) {
+        bool changed = false;
+        if (fillNakedSingles(changed)) {
+            return true;
+        }
+        if (changed) {
+            continue;
+        }
+
+        // Finds hidden singles after naked singles because they are more expensive
+        if (fillHiddenSingles(changed)) {
+            return true;
+        }
+        if (!changed) {
+            break;
+        }
+    }
+
+    return false;
+}
+
+// Places numbers in cells which have one candidate
+// and returns true if finding a cell that has no candidates.
+bool SudokuBitplaneMap::fillNakedSingles(bool& changed) {
+    for(SudokuLoopIndex band=0;band<SizeOfBands;++band) {
+        Band once = 0;
+        Band twice = 0;
+        for(SudokuLoopIndex number=0;number<Sudoku::SizeOfCandidates;++number) {
+            twice |= once & planes_[number][band];
+            once |= planes_[number][band];
+        }
+        if (once != AllCellsInBand) {
+            return true;
+        }
+
+        auto singles = once & ~twice & ~placed_[band];
+        while(singles) {
+            const Band cell = singles & (~singles + 1);
+            singles ^= cell;
+
+            // Placing other cells may remove the candidate of this cell
+            SudokuLoopIndex number = 0;
+            while((number < Sudoku::SizeOfCandidates) && !(planes_[number][band] & cell)) {
+                ++number;
+            }
+            if (number >= Sudoku::SizeOfCandidates) {
+                return true;
+            }
+
+            place(number, band, cell);
+            changed = true;
+        }
+    }
+
+    return false;
+}
+
+// Places numbers which only a cell in a row, column, box or diagonal bar can hold
+// and returns true if finding a group that cannot hold a number.
+bool SudokuBitplaneMap::fillHiddenSingles(bool& changed) {
+    for(SudokuLoopIndex number=0;number<Sudoku::SizeOfCandidates;++number) {
+        auto& plane = planes_[number];
+
+        // Placing a number changes the plane, so read it for each group
+        for(SudokuLoopIndex band=0;band<SizeOfBands;++band) {
+            for(SudokuLoopIndex i=0;i<Sudoku::SizeOfCellsOnBoxEdge;++i) {
+                const Band row = plane[band] & (RowInBand << (i * Sudoku::SizeOfCellsPerGroup));
+                if (!row) {
+                    return true;
+                }
+                if (!(row & (row - 1)) && !(row & placed_[band])) {
+                    place(number, band, row);
+                    changed = true;
+                }
+            }
+
+            for(SudokuLoopIndex i=0;i<Sudoku::SizeOfBoxesOnEdge;++i) {
+                const Band box = plane[band] & (BoxInBand << (i * Sudoku::SizeOfCellsOnBoxEdge));
+                if (!box) {
+                    return true;
+                }
+                if (!(box & (box - 1)) && !(box & placed_[band])) {
+                    place(number, band, box);
+                    changed = true;
+                }
+            }
+        }
+
+        // Folds three rows in each band to find columns
+        Band once = 0;
+        Band twice = 0;
+        for(SudokuLoopIndex band=0;band<SizeOfBands;++band) {
+            for(SudokuLoopIndex i=0;i<Sudoku::SizeOfCellsOnBoxEdge;++i) {
+                const Band row = (plane[band] >> (i * Sudoku::SizeOfCellsPerGroup)) & RowInBand;
+                twice |= once & row;
+                once |= row;
+            }
+        }
+        if (once != RowInBand) {
+            return true;
+        }
+
+        auto columns = once & ~twice;
+        while(columns) {
+            const Band column = (columns & (~columns + 1)) * ColumnInBand;
+            columns &= columns - 1;
+            SudokuLoopIndex band = 0;
+            while((band < SizeOfBands) && !(plane[band] & column)) {
+                ++band;
+            }
+            if (band >= SizeOfBands) {
+                return true;
+            }
+
+            const Band cell = plane[band] & column;
+            if (!(cell & placed_[band])) {
+                place(number, band, cell);
+                changed = true;
+            }
+        }
+
+        if CPP17_IF_CONSTEXPR (DiagonalSudokuMode) {
+            for(SudokuLoopIndex bar=0;bar<2;++bar) {
+                SudokuIndex count = 0;
+                SudokuIndex cellBand = 0;
+                Band cell = 0;
+                for(SudokuLoopIndex band=0;band<SizeOfBands;++band) {
+                    const Band bandCells = plane[band] & getDiagonalBand(bar, band);
+                    if (bandCells) {
+                        count += static_cast<SudokuIndex>(__builtin_popcount(bandCells));
+                        cellBand = band;
+                        cell = bandCells;
+                    }
+                }
+                if (!count) {
+                    return true;
+                }
+                if ((count == 1) && !(cell & placed_[cellBand])) {
+                    place(number, cellBand, cell);
+                    changed = true;
+                }
+            }
+        }
+    }
+
+    return false;
+}
+
+// Places a number in a cell and removes it from other cells in its groups
+void SudokuBitplaneMap::place(SudokuIndex number, SudokuIndex band, Band cell) {
+    const SudokuIndex position = static_cast<SudokuIndex>(__builtin_ctz(cell));
+    const SudokuIndex row = position / Sudoku::SizeOfCellsPerGroup;
+    const SudokuIndex column = position % Sudoku::SizeOfCellsPerGroup;
+    auto& plane = planes_[number];
+
+    const Band columnMask = ColumnInBand << column;
+    for(SudokuLoopIndex i=0;i<SizeOfBands;++i) {
+        plane[i] &= ~columnMask;
+    }
+    plane[band] &= ~((RowInBand << (row * Sudoku::SizeOfCellsPerGroup)) |
+                     (BoxInBand << ((column / Sudoku::SizeOfCellsOnBoxEdge) * Sudoku::SizeOfCellsOnBoxEdge)));
+
+    if CPP17_IF_CONSTEXPR (DiagonalSudokuMode) {
+        const SudokuIndex rowInPuzzle = band * Sudoku::SizeOfCellsOnBoxEdge + row;
+        for(SudokuLoopIndex bar=0;bar<2;++bar) {
+            const SudokuIndex diagonalColumn = bar ? (Sudoku::SizeOfCellsPerGroup - 1 - rowInPuzzle) : rowInPuzzle;
+            if (column == diagonalColumn) {
+                for(SudokuLoopIndex i=0;i<SizeOfBands;++i) {
+                    plane[i] &= ~getDiagonalBand(bar, i);
+                }
+            }
+        }
+    }
+
+    for(SudokuLoopIndex i=0;i<Sudoku::SizeOfCandidates;++i) {
+        planes_[i][band] &= ~cell;
+    }
+    plane[band] |= cell;
+    placed_[band] |= cell;
+    return;
+}
+
+// Returns whether all cells are filled
+bool SudokuBitplaneMap::IsFilled(void) const {
+    return (CountFilledCells() == Sudoku::SizeOfAllCells);
+}
+
+SudokuIndex SudokuBitplaneMap::CountFilledCells(void) const {
+    SudokuIndex count = 0;
+    for(SudokuLoopIndex band=0;band<SizeOfBands;++band) {
+        Band once = 0;
+        Band twice = 0;
+        for(SudokuLoopIndex number=0;number<Sudoku::SizeOfCandidates;++number) {
+            twice |= once & planes_[number][band];
+            once |= planes_[number][band];
+        }
+        count += static_cast<SudokuIndex>(__builtin_popcount(once & ~twice));
+    }
+    return count;
+}
+
+// Returns the index of a cell which has the fewest candidates of all cells
+// which have multiple candidates (the first cell if there are two or more such cells).
+SudokuIndex SudokuBitplaneMap::SelectBacktrackedCellIndex(void) const {
+    // Most puzzles have cells which have two candidates
+    for(SudokuLoopIndex band=0;band<SizeOfBands;++band) {
+        Band once = 0;
+        Band twice = 0;
+        Band threeTimes = 0;
+        for(SudokuLoopIndex number=0;number<Sudoku::SizeOfCandidates;++number) {
+            const auto cells = planes_[number][band];
+            threeTimes |= twice & cells;
+            twice |= once & cells;
+            once |= cells;
+        }
+
+        const auto pairs = twice & ~threeTimes;
+        if (pairs) {
+            return static_cast<SudokuIndex>(band * SizeOfCellsPerBand + __builtin_ctz(pairs));
+        }
+    }
+
+    SudokuIndex leastCount = Sudoku::SizeOfCandidates + 1;
+    SudokuIndex resultCellIndex = 0;
+    for(SudokuLoopIndex i=0;i<Sudoku::SizeOfAllCells;++i) {
+        const auto count = static_cast<SudokuIndex>(__builtin_popcount(GetCandidates(i)));
+        if ((count > Sudoku::SizeOfUniqueCandidate) && (count < leastCount)) {
+            leastCount = count;
+            resultCellIndex = i;
+        }
+    }
+
+    return resultCellIndex;
+}
+
+INLINE SudokuCellCandidates SudokuBitplaneMap::GetCandidates(SudokuIndex cellIndex) const {
+    const SudokuIndex band = cellIndex / SizeOfCellsPerBand;
+    const SudokuIndex position = cellIndex % SizeOfCellsPerBand;
+    SudokuCellCandidates candidates = 0;
+    for(SudokuLoopIndex number=0;number<Sudoku::SizeOfCandidates;++number) {
+        candidates |= ((planes_[number][band] >> position) & 1) << number;
+    }
+    return candidates;
+}
+
+INLINE void SudokuBitplaneMap::SetUniqueCell(SudokuIndex cellIndex, SudokuCellCandidates candidate) {
+    const SudokuIndex band = cellIndex / SizeOfCellsPerBand;
+    const Band cell = static_cast<Band>(1) << (cellIndex % SizeOfCellsPerBand);
+    for(SudokuLoopIndex number=0;number<Sudoku::SizeOfCandidates;++number) {
+        if ((candidate >> number) & 1) {
+            planes_[number][band] |= cell;
+        } else {
+            planes_[number][band] &= ~cell;
+        }
+    }
+    return;
+}
+
+// Returns cells in a band on the diagonal bar {to the right from 0, to the left from 8}
+INLINE SudokuBitplaneMap::Band SudokuBitplaneMap::getDiagonalBand(SudokuIndex bar, SudokuIndex band) {
+    Band cells = 0;
+    for(SudokuLoopIndex row=0;row<Sudoku::SizeOfCellsOnBoxEdge;++row) {
+        const SudokuIndex rowInPuzzle = band * Sudoku::SizeOfCellsOnBoxEdge + row;
+        const SudokuIndex column = bar ? (Sudoku::SizeOfCellsPerGroup - 1 - rowInPuzzle) : rowInPuzzle;
+        cells |= static_cast<Band>(1) << (row * Sudoku::SizeOfCellsPerGroup + column);
+    }
+    return cells;
+}
+
+SudokuBitplaneSolver::SudokuBitplaneSolver(const std::string& presetStr, std::ostream* pSudokuOutStream)
+    : SudokuBaseSolver(pSudokuOutStream) {
+    map_.Preset(presetStr);
+    return;
+}
+
+// Solves a puzzle and writes its solution
+bool SudokuBitplaneSolver::Exec(bool silent, bool verbose) {
+    const auto result = solve(map_, verbose);
+    if (silent == false) {
+        map_.Print(pSudokuOutStream_);
+    }
+    return result;
+}
+
+// Prints this solver type
+void SudokuBitplaneSolver::PrintType(void) {
+    SudokuBaseSolver::printType("Bitplane", pSudokuOutStream_);
+    return;
+}
+
+void SudokuBitplaneSolver::Reset(const std::string& presetStr) {
+    clearCount();
+    map_.Preset(presetStr);
+    return;
+}
+
+bool SudokuBitplaneSolver::solve(SudokuBitplaneMap& map, bool verbose) {
+    ++count_;
+    if (verbose) {
+        if (pSudokuOutStream_ != nullptr) {
+            (*pSudokuOutStream_) << "Step " << count_ << "\n";
+        }
+    }
+
+    if (map.FillCrossing()) {
+        return false;
+    }
+    if (verbose) {
+        map.Print(pSudokuOutStream_);
+    }
+    // Filling a cell removes its number from other cells in its groups, so all filled cells are consistent
+    if (map.IsFilled()) {
+        return true;
+    }
+
+    // Guesses a number in a cell which has the fewest candidates
+    const auto cellIndex = map.SelectBacktrackedCellIndex();
+    auto candidates = map.GetCandidates(cellIndex);
+    while(candidates != SudokuCell::GetEmptyCandidates()) {
+        // The lowest candidate
+        const auto candidate = candidates & (~candidates + 1);
+        candidates ^= candidate;
+        ++guessCount_;
+        SudokuBitplaneMap guessedMap = map;
+        guessedMap.SetUniqueCell(cellIndex, candidate);
+        if (solve(guessedMap, verbose)) {
+            // Solved!
+            map = guessedMap;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// --------------- the solver for puzzles in any size ---------------
+template <SudokuIndex BoxSize>
+SudokuGridMap<BoxSize>::SudokuGridMap(void) {
+    for(SudokuLoopIndex i=0;i<Geometry::SizeOfAllCells;++i) {
+        cells_[i] = Geometry::AllCandidates;
+        placed_[i] = false;
+    }
+    return;
+}
+
+// Reads 1..9 and A..P (A is 10) as preset numbers and others as blank cells
+template <SudokuIndex BoxSize>
+void SudokuGridMap<BoxSize>::Preset(const std::string& presetStr) {
+    for(SudokuLoopIndex i=0;i<Geometry::SizeOfAllCells;++i) {
+        // Pad with white spaces
+        const auto candidate = ConvertCharToCandidate((i < presetStr.length()) ? presetStr.at(i) : ' ');
+        cells_[i] = (candidate != Sudoku::EmptyCandidates) ? candidate : Geometry::AllCandidates;
+        placed_[i] = false;
+    }
+    return;
+}
+
+// Print all candidates in cells
+template <SudokuIndex BoxSize>
+void SudokuGridMap<BoxSize>::Print(std::ostream* pSudokuOutStream) const {
+    if (pSudokuOutStream == nullptr) {
+        return;
+    }
+
+    SudokuLoopIndex cellIndex = 0;
+    for(SudokuLoopIndex row=0;row<Geometry::SizeOfGroupsPerMap;++row) {
+        for(SudokuLoopIndex column=0;column<Geometry::SizeOfCellsPerGroup;++column) {
+            const auto candidates = cells_[cellIndex++];
+            for(SudokuIndex number=1;number<=Geometry::SizeOfCandidates;++number) {
+                if (candidates & (1u << (number - 1))) {
+                    (*pSudokuOutStream) << ConvertNumberToChar(number);
+                }
+            }
+            (*pSudokuOutStream) << ":";
+        }
+        (*pSudokuOutStream) << "\n";
+    }
+    (*pSudokuOutStream) << "\n";
+
+    return;
+}
+
+// Returns true if this puzzle has no solution
+template <SudokuIndex BoxSize>
+bool SudokuGridMap<BoxSize>::FillCrossing(void) {
+    for(;;) {
+        bool changed = false;
+        if (fillNakedSingles(changed)) {
+            return true;
+        }
+        if (changed) {
+            continue;
+        }
+        if (fillHiddenSingles(changed)) {
+            return true;
+        }
+        if (!changed) {
+            break;
+        }
+    }
+
+    return false;
+}
+
+template <SudokuIndex BoxSize>
+bool SudokuGridMap<BoxSize>::IsFilled(void) const {
+    for(SudokuLoopIndex i=0;i<Geometry::SizeOfAllCells;++i) {
+        if (!isUniqueCandidate(cells_[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Returns true if all groups hold all numbers and preset cells are preserved
+template <SudokuIndex BoxSize>
+bool SudokuGridMap<BoxSize>::IsSolutionOf(const std::string& presetStr) const {
+    if (!IsFilled()) {
+        return false;
+    }
+
+    constexpr SudokuLoopIndex sizeOfGroups = Geometry::SizeOfGroupsPerCell * Geometry::SizeOfGroupsPerMap;
+    for(SudokuLoopIndex group=0;group<sizeOfGroups;++group) {
+        SudokuCellCandidates candidates = Sudoku::EmptyCandidates;
+        for(SudokuLoopIndex position=0;position<Geometry::SizeOfCellsPerGroup;++position) {
+            candidates |= cells_[Group_[group * Geometry::SizeOfCellsPerGroup + position]];
+        }
+        if (candidates != Geometry::AllCandidates) {
+            return false;
+        }
+    }
+
+    if CPP17_IF_CONSTEXPR (DiagonalSudokuMode) {
+        for(SudokuLoopIndex bar=0;bar<2;++bar) {
+            SudokuCellCandidates candidates = Sudoku::EmptyCandidates;
+            for(SudokuLoopIndex position=0;position<Geometry::SizeOfCellsPerGroup;++position) {
+                candidates |= cells_[Diagonal_[bar * Geometry::SizeOfCellsPerGroup + position]];
+            }
+            if (candidates != Geometry::AllCandidates) {
+                return false;
+            }
+        }
+    }
+
+    const auto length = std::min(presetStr.length(), static_cast<size_t>(Geometry::SizeOfAllCells));
+    for(size_t i=0;i<length;++i) {
+        const auto candidate = ConvertCharToCandidate(presetStr.at(i));
+        if ((candidate != Sudoku::EmptyCandidates) && (candidate != cells_[i])) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+template <SudokuIndex BoxSize>
+SudokuIndex SudokuGridMap<BoxSize>::CountFilledCells(void) const {
+    SudokuIndex count = 0;
+    for(SudokuLoopIndex i=0;i<Geometry::SizeOfAllCells;++i) {
+        count += isUniqueCandidate(cells_[i]) ? 1 : 0;
+    }
+    return count;
+}
+
+// Returns the first cell of all cells which have the fewest candidates
+template <SudokuIndex BoxSize>
+SudokuIndex SudokuGridMap<BoxSize>::SelectBacktrackedCellIndex(void) const {
+    SudokuIndex cellIndex = 0;
+    SudokuIndex leastCount = Geometry::SizeOfCandidates + 1;
+
+    for(SudokuLoopIndex i=0;i<Geometry::SizeOfAllCells;++i) {
+        const auto count = static_cast<SudokuIndex>(__builtin_popcount(cells_[i]));
+        if ((count > Sudoku::SizeOfUniqueCandidate) && (count < leastCount)) {
+            leastCount = count;
+            cellIndex = static_cast<SudokuIndex>(i);
+            // No cells have fewer candidates
+            if (count <= Sudoku::MinSubsetSize) {
+                break;
+            }
+        }
+    }
+
+    return cellIndex;
+}
+
+template <SudokuIndex BoxSize>
+INLINE SudokuCellCandidates SudokuGridMap<BoxSize>::GetCandidates(SudokuIndex cellIndex) const {
+    return cells_[cellIndex];
+}
+
+template <SudokuIndex BoxSize>
+INLINE void SudokuGridMap<BoxSize>::SetUniqueCell(SudokuIndex cellIndex, SudokuCellCandidates candidate) {
+    cells_[cellIndex] = candidate;
+    return;
+}
+
+// Returns a candidate of a preset number or no candidates for a blank cell
+template <SudokuIndex BoxSize>
+SudokuCellCandidates SudokuGridMap<BoxSize>::ConvertCharToCandidate(char c) {
+    int number = 0;
+    if ((c >= '1') && (c <= '9')) {
+        number = c - '0';
+    } else if ((c >= 'A') && (c <= 'Z')) {
+        number = c - 'A' + 10;
+    } else if ((c >= 'a') && (c <= 'z')) {
+        number = c - 'a' + 10;
+    }
+
+    if ((number < Sudoku::MinCandidatesNumber) || (number > Geometry::SizeOfCandidates)) {
+        return Sudoku::EmptyCandidates;
+    }
+    return 1u << (number - 1);
+}
+
+template <SudokuIndex BoxSize>
+char SudokuGridMap<BoxSize>::ConvertNumberToChar(SudokuIndex number) {
+    return static_cast<char>((number <= Sudoku::MaxCandidatesNumber) ? ('0' + number) : ('A' + number - 10));
+}
+
+// Removes unique candidates of cells from their neighbours
+template <SudokuIndex BoxSize>
+bool SudokuGridMap<BoxSize>::fillNakedSingles(bool& changed) {
+    for(SudokuLoopIndex i=0;i<Geometry::SizeOfAllCells;++i) {
+        if (placed_[i] || !isUniqueCandidate(cells_[i])) {
+            continue;
+        }
+
+        placed_[i] = true;
+        changed = true;
+        if (removeCandidateFromNeighbours(static_cast<SudokuIndex>(i))) {
+            return true;
+        }
+    }
+
+    return false;
 }
 
-SudokuSolver::SudokuSolver(const std::string& presetStr, SudokuIndex seed, std::ostream* pSudokuOutStream)
-    : SudokuBaseSolver(pSudokuOutStream) {
-    // Actually, it is good to set always 0 to seed
-    map_.Preset(presetStr, 0);
-    return;
+// Fills cells which can hold a number that no other cells in their groups can hold
+template <SudokuIndex BoxSize>
+bool SudokuGridMap<BoxSize>::fillHiddenSingles(bool& changed) {
+    constexpr SudokuLoopIndex sizeOfGroups = Geometry::SizeOfGroupsPerCell * Geometry::SizeOfGroupsPerMap;
+    for(SudokuLoopIndex group=0;group<sizeOfGroups;++group) {
+        if (findHiddenSingles(&Group_.value[group * Geometry::SizeOfCellsPerGroup], changed)) {
+            return true;
+        }
+    }
+
+    if CPP17_IF_CONSTEXPR (DiagonalSudokuMode) {
+        for(SudokuLoopIndex bar=0;bar<2;++bar) {
+            if (findHiddenSingles(&Diagonal_.value[bar * Geometry::SizeOfCellsPerGroup], changed)) {
+                return true;
+            }
+        }
+    }
+
+    return false;
 }
 
-SudokuSolver::SudokuSolver(const std::string& presetStr, SudokuIndex seed, std::ostream* pSudokuOutStream, SudokuPatternCount printAllCandidate)
+// Returns true if a neighbour loses all candidates
+template <SudokuIndex BoxSize>
+INLINE bool SudokuGridMap<BoxSize>::removeCandidateFromNeighbours(SudokuIndex cellIndex) {
+    const auto mask = ~cells_[cellIndex];
+    bool aborted = false;
+
+    auto removeCandidate = [this, cellIndex, mask, &aborted](const SudokuIndex* pGroup) {
+        auto removeFromCell = [this, cellIndex, mask, &aborted, pGroup](SudokuIndex position) {
+            const auto index = pGroup[position];
+            if (index != cellIndex) {
+                cells_[index] &= mask;
+                aborted |= (cells_[index] == Sudoku::EmptyCandidates);
+            }
+        };
+        Sudoku::UnrolledLoop<0, Geometry::SizeOfCellsPerGroup>::Run(removeFromCell);
+    };
+
+    for(SudokuLoopIndex groupId=0;groupId<Geometry::SizeOfGroupsPerCell;++groupId) {
+        const auto groupIndex = ReverseGroup_[cellIndex * Geometry::SizeOfGroupsPerCell + groupId];
+        removeCandidate(&Group_.value[(groupId * Geometry::SizeOfGroupsPerMap + groupIndex) * Geometry::SizeOfCellsPerGroup]);
+    }
+
+    if CPP17_IF_CONSTEXPR (DiagonalSudokuMode) {
+        for(SudokuIndex bar=0;bar<2;++bar) {
+            if (Geometry::IsOnDiagonal(bar, cellIndex)) {
+                removeCandidate(&Diagonal_.value[bar * Geometry::SizeOfCellsPerGroup]);
+            }
+        }
+    }
+
+    return aborted;
+}
+
+// Returns true if a group lacks a number or a cell must hold two numbers
+template <SudokuIndex BoxSize>
+INLINE bool SudokuGridMap<BoxSize>::findHiddenSingles(const SudokuIndex* pCellIndexes, bool& changed) {
+    // Numbers which one cell at least holds and two cells at least hold
+    SudokuCellCandidates once = Sudoku::EmptyCandidates;
+    SudokuCellCandidates twice = Sudoku::EmptyCandidates;
+    auto collect = [this, pCellIndexes, &once, &twice](SudokuIndex position) {
+        const auto candidates = cells_[pCellIndexes[position]];
+        twice |= once & candidates;
+        once |= candidates;
+    };
+    Sudoku::UnrolledLoop<0, Geometry::SizeOfCellsPerGroup>::Run(collect);
+
+    if (once != Geometry::AllCandidates) {
+        return true;
+    }
+
+    const auto hidden = once & ~twice;
+    if (hidden == Sudoku::EmptyCandidates) {
+        return false;
+    }
+
+    bool aborted = false;
+    auto fill = [this, pCellIndexes, hidden, &aborted, &changed](SudokuIndex position) {
+        auto& cell = cells_[pCellIndexes[position]];
+        const auto candidates = cell & hidden;
+        if (candidates == Sudoku::EmptyCandidates) {
+            return;
+        }
+        if (!isUniqueCandidate(candidates)) {
+            aborted = true;
+        } else if (candidates != cell) {
+            cell = candidates;
+            changed = true;
+        }
+    };
+    Sudoku::UnrolledLoop<0, Geometry::SizeOfCellsPerGroup>::Run(fill);
+
+    return aborted;
+}
+
+template <SudokuIndex BoxSize>
+INLINE bool SudokuGridMap<BoxSize>::isUniqueCandidate(SudokuCellCandidates candidates) {
+    return (candidates != Sudoku::EmptyCandidates) && ((candidates & (candidates - 1)) == 0);
+}
+
+template <SudokuIndex BoxSize>
+SudokuGridSolver<BoxSize>::SudokuGridSolver(const std::string& presetStr, std::ostream* pSudokuOutStream)
     : SudokuBaseSolver(pSudokuOutStream) {
-    // 'printAllCandidate' is not used, just for interface compatibility with the SSE solver
-    map_.Preset(presetStr, 0);
+    map_.Preset(presetStr);
     return;
 }
 
 // Solves a puzzle and writes its solution
-bool SudokuSolver::Exec(bool silent, bool verbose) {
-    const auto result = solve(map_, true, verbose);
+template <SudokuIndex BoxSize>
+bool SudokuGridSolver<BoxSize>::Exec(bool silent, bool verbose) {
+    const auto result = solve(map_, verbose);
     if (silent == false) {
         map_.Print(pSudokuOutStream_);
     }
@@ -1213,59 +3434,149 @@ bool SudokuSolver::Exec(bool silent, bool verbose) {
 }
 
 // Prints this solver type
-void SudokuSolver::PrintType(void) {
-    SudokuBaseSolver::printType("C++", pSudokuOutStream_);
+template <SudokuIndex BoxSize>
+void SudokuGridSolver<BoxSize>::PrintType(void) {
+    const auto size = std::to_string(SudokuGridMap<BoxSize>::Geometry::SizeOfCellsPerGroup);
+    SudokuBaseSolver::printType("C++ " + size + "x" + size, pSudokuOutStream_);
     return;
 }
 
-// 'topLevel' is not used, just for interface compatibility with the SSE solver
-bool SudokuSolver::solve(SudokuMap& map, bool topLevel, bool verbose) {
-    auto oldCount = map.CountFilledCells();
+template <SudokuIndex BoxSize>
+void SudokuGridSolver<BoxSize>::Reset(const std::string& presetStr) {
+    clearCount();
+    map_.Preset(presetStr);
+    return;
+}
 
-    // Start backtracking before filling cells for Sudoku-X puzzles
-    for(;;) {
-        if (fillCells(map, topLevel, verbose) == false) {
-            return false;
-        }
-        if (verbose) {
-            map.Print(pSudokuOutStream_);
+// Counts solutions of a puzzle and stops when it finds maxCount solutions
+template <SudokuIndex BoxSize>
+SudokuPatternCount SudokuGridSolver<BoxSize>::CountUpTo(SudokuPatternCount maxCount) {
+    SudokuPatternCount patternCount = 0;
+    SudokuGridMap<BoxSize> map = map_;
+    count(map, maxCount, patternCount);
+    return patternCount;
+}
+
+template <SudokuIndex BoxSize>
+bool SudokuGridSolver<BoxSize>::IsSolutionOf(const std::string& presetStr) const {
+    return map_.IsSolutionOf(presetStr);
+}
+
+template <SudokuIndex BoxSize>
+bool SudokuGridSolver<BoxSize>::solve(SudokuGridMap<BoxSize>& map, bool verbose) {
+    ++count_;
+    if (verbose) {
+        if (pSudokuOutStream_ != nullptr) {
+            (*pSudokuOutStream_) << "Step " << count_ << "\n";
         }
-        if (map.IsFilled()) {
-            if (!map.IsConsistent()) {
-                // Aborts backtracking
-                return false;
-            }
+    }
+
+    if (map.FillCrossing()) {
+        return false;
+    }
+    if (verbose) {
+        map.Print(pSudokuOutStream_);
+    }
+    // Filling a cell removes its number from its neighbours, so all filled cells are consistent
+    if (map.IsFilled()) {
+        return true;
+    }
+
+    // Guesses a number in a cell which has the fewest candidates
+    const auto cellIndex = map.SelectBacktrackedCellIndex();
+    auto candidates = map.GetCandidates(cellIndex);
+    while(candidates != Sudoku::EmptyCandidates) {
+        // The lowest candidate
+        const auto candidate = candidates & (~candidates + 1);
+        candidates ^= candidate;
+        ++guessCount_;
+        SudokuGridMap<BoxSize> guessedMap = map;
+        guessedMap.SetUniqueCell(cellIndex, candidate);
+        if (solve(guessedMap, verbose)) {
             // Solved!
+            map = guessedMap;
             return true;
         }
+    }
 
-        const auto newCount = map.CountFilledCells();
-        if (oldCount == newCount) {
-            break;
-        }
-        oldCount = newCount;
+    return false;
+}
+
+template <SudokuIndex BoxSize>
+void SudokuGridSolver<BoxSize>::count(SudokuGridMap<BoxSize>& map, SudokuPatternCount maxCount,
+                                      SudokuPatternCount& patternCount) {
+    ++count_;
+    if (map.FillCrossing()) {
+        return;
+    }
+    if (map.IsFilled()) {
+        ++patternCount;
+        return;
     }
 
-    // We start backtracking because we cannot reduce candidates anymore
     const auto cellIndex = map.SelectBacktrackedCellIndex();
-    // Guesses a number of 1..9 in the cell in a solution
-    auto candidate = SudokuCell::GetInitialCandidate();
+    auto candidates = map.GetCandidates(cellIndex);
+    while((candidates != Sudoku::EmptyCandidates) && (patternCount < maxCount)) {
+        const auto candidate = candidates & (~candidates + 1);
+        candidates ^= candidate;
+        SudokuGridMap<BoxSize> guessedMap = map;
+        guessedMap.SetUniqueCell(cellIndex, candidate);
+        count(guessedMap, maxCount, patternCount);
+    }
+
+    return;
+}
+
+// 9x9, 16x16 and 25x25 puzzles
+template class SudokuGridMap<3>;
+template class SudokuGridMap<4>;
+template class SudokuGridMap<5>;
+template class SudokuGridSolver<3>;
+template class SudokuGridSolver<4>;
+template class SudokuGridSolver<5>;
+
+// --------------- the 16x16 solver with AVX2 intrinsics ---------------
+#if defined(SUDOKU_SOA_MAP)
+SudokuSoa16Map::SudokuSoa16Map(void) {
+    for(SudokuLoopIndex row=0;row<Geometry::SizeOfGroupsPerMap;++row) {
+        for(SudokuLoopIndex column=0;column<SudokuLaneCnt;++column) {
+            rows_[row][column] = static_cast<Lane>(Geometry::AllCandidates);
+        }
+    }
+    return;
+}
+
+// Reads 1..9 and A..G (A is 10) as preset numbers and others as blank cells
+void SudokuSoa16Map::Preset(const std::string& presetStr) {
+    for(SudokuLoopIndex i=0;i<Geometry::SizeOfAllCells;++i) {
+        // Pad with white spaces
+        const auto candidate = SudokuGridMap<4>::ConvertCharToCandidate((i < presetStr.length()) ? presetStr.at(i) : ' ');
+        rows_[i / Geometry::SizeOfCellsPerGroup][i % Geometry::SizeOfCellsPerGroup] =
+            static_cast<Lane>((candidate != Sudoku::EmptyCandidates) ? candidate : Geometry::AllCandidates);
+    }
+    return;
+}
+
+// Print all candidates in cells
+void SudokuSoa16Map::Print(std::ostream* pSudokuOutStream) const {
+    toGridMap().Print(pSudokuOutStream);
+    return;
+}
+
+// Fills cells until no cells get fewer candidates
+// and returns true if finding a cell that cannot be filled.
+bool SudokuSoa16Map::FillCrossing(void) {
     for(;;) {
-        // We continue to solve the puzzle if we can set a valid candidate to the cell
-        if (map.CanSetUniqueCell(cellIndex, candidate)) {
-            auto newMap = map;
-            newMap.SetUniqueCell(cellIndex, candidate);
-            if (solve(newMap, false, verbose)) {
-                // We can get a solution via trivial copy
-                map = newMap;
-                // Solved!
+        bool changed = false;
+        if (fillCrossingOnce(changed)) {
+            return true;
+        }
+        if CPP17_IF_CONSTEXPR (DiagonalSudokuMode) {
+            if (fillDiagonalBars(changed)) {
                 return true;
             }
         }
-
-        // Try next candidate to a guess
-        candidate = SudokuCell::GetNextCandidate(candidate);
-        if (SudokuCell::IsEmptyCandidates(candidate) != false) {
+        if (!changed) {
             break;
         }
     }
@@ -1273,16 +3584,295 @@ bool SudokuSolver::solve(SudokuMap& map, bool topLevel, bool verbose) {
     return false;
 }
 
-// 'topLevel' is not used, just for interface compatibility with the SSE solver
-bool SudokuSolver::fillCells(SudokuMap& map, bool topLevel, bool verbose) {
+// Returns whether all cells are filled
+bool SudokuSoa16Map::IsFilled(void) const {
+    for(SudokuLoopIndex i=0;i<Geometry::SizeOfGroupsPerMap;++i) {
+        const auto row = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rows_[i]));
+        if (_mm256_testc_si256(soaUniqueLanes(row), soaAllOnes()) == 0) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool SudokuSoa16Map::IsSolutionOf(const std::string& presetStr) const {
+    return toGridMap().IsSolutionOf(presetStr);
+}
+
+SudokuIndex SudokuSoa16Map::CountFilledCells(void) const {
+    SudokuIndex count = 0;
+    for(SudokuLoopIndex i=0;i<Geometry::SizeOfGroupsPerMap;++i) {
+        const auto row = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rows_[i]));
+        // Two bits for each lane
+        count += __builtin_popcount(_mm256_movemask_epi8(soaUniqueLanes(row))) / 2;
+    }
+    return count;
+}
+
+// Returns the index of a cell which has the fewest candidates of all cells
+// which have multiple candidates (the first cell if there are two or more such cells).
+SudokuIndex SudokuSoa16Map::SelectBacktrackedCellIndex(void) const {
+    // Lanes which do not have multiple candidates hold this count
+    unsigned int leastCount = std::numeric_limits<Lane>::max();
+    SudokuIndex resultCellIndex = 0;
+
+    for(SudokuLoopIndex i=0;i<Geometry::SizeOfGroupsPerMap;++i) {
+        const auto row = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rows_[i]));
+        const auto previousCount = leastCount;
+        SudokuIndex lane = 0;
+        soaFindLeastLane(soaCountMultipleCandidates(row), leastCount, lane);
+        if (leastCount < previousCount) {
+            resultCellIndex = static_cast<SudokuIndex>(i * Geometry::SizeOfCellsPerGroup + lane);
+        }
+    }
+
+    return resultCellIndex;
+}
+
+INLINE SudokuCellCandidates SudokuSoa16Map::GetCandidates(SudokuIndex cellIndex) const {
+    return rows_[cellIndex / Geometry::SizeOfCellsPerGroup][cellIndex % Geometry::SizeOfCellsPerGroup];
+}
+
+INLINE void SudokuSoa16Map::SetUniqueCell(SudokuIndex cellIndex, SudokuCellCandidates candidate) {
+    rows_[cellIndex / Geometry::SizeOfCellsPerGroup][cellIndex % Geometry::SizeOfCellsPerGroup] = static_cast<Lane>(candidate);
+    return;
+}
+
+// Finds naked and hidden singles in all rows, columns, and boxes at once
+// and returns true if finding a cell or a group that cannot be filled.
+// All lanes are cells, so that a group lacks candidates if its lanes are not all ones.
+bool SudokuSoa16Map::fillCrossingOnce(bool& changed) {
+    const auto zero = _mm256_setzero_si256();
+    const auto allOnes = soaAllOnes();
+    auto inconsistent = zero;
+
+    // Collects candidates in columns
+    __m256i rowSet[Geometry::SizeOfGroupsPerMap];
+    auto columnUniqueOnce = zero;
+    auto columnUniqueTwice = zero;
+    auto columnOnce = zero;
+    auto columnTwice = zero;
+    for(SudokuLoopIndex i=0;i<Geometry::SizeOfGroupsPerMap;++i) {
+        const auto row = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rows_[i]));
+        soaMergeLanes(columnUniqueOnce, columnUniqueTwice, _mm256_and_si256(row, soaUniqueLanes(row)), zero);
+        soaMergeLanes(columnOnce, columnTwice, row, zero);
+        rowSet[i] = row;
+    }
+    inconsistent = _mm256_or_si256(inconsistent, _mm256_or_si256(columnUniqueTwice, _mm256_xor_si256(columnOnce, allOnes)));
+
+    auto diff = zero;
+    for(SudokuLoopIndex band=0;band<Geometry::SizeOfCellsOnBoxEdge;++band) {
+        const SudokuLoopIndex topRow = band * Geometry::SizeOfCellsOnBoxEdge;
+
+        // Collects candidates in four boxes in rows of a band
+        auto boxUniqueOnce = zero;
+        auto boxUniqueTwice = zero;
+        auto boxOnce = zero;
+        auto boxTwice = zero;
+        for(SudokuLoopIndex i=topRow;i<(topRow + Geometry::SizeOfCellsOnBoxEdge);++i) {
+            const auto row = rowSet[i];
+            soaMergeLanes(boxUniqueOnce, boxUniqueTwice, _mm256_and_si256(row, soaUniqueLanes(row)), zero);
+            soaMergeLanes(boxOnce, boxTwice, row, zero);
+        }
+        soaReduceLanesInWord(boxUniqueOnce, boxUniqueTwice);
+        soaReduceLanesInWord(boxOnce, boxTwice);
+        inconsistent = _mm256_or_si256(inconsistent, _mm256_or_si256(boxUniqueTwice, _mm256_xor_si256(boxOnce, allOnes)));
+
+        // Applies masks for rows, columns and boxes to cells
+        for(SudokuLoopIndex i=topRow;i<(topRow + Geometry::SizeOfCellsOnBoxEdge);++i) {
+            const auto row = rowSet[i];
+            const auto isUnique = soaUniqueLanes(row);
+            auto uniqueOnce = _mm256_and_si256(row, isUnique);
+            auto uniqueTwice = zero;
+            soaReduceLanes(uniqueOnce, uniqueTwice);
+            auto once = row;
+            auto twice = zero;
+            soaReduceLanes(once, twice);
+            inconsistent = _mm256_or_si256(inconsistent, _mm256_or_si256(uniqueTwice, _mm256_xor_si256(once, allOnes)));
+
+            const auto rowMask = _mm256_and_si256(soaNakedSingleMask(isUnique, uniqueOnce),
+                                                  soaHiddenSingleMask(row, twice, inconsistent));
+            const auto columnMask = _mm256_and_si256(soaNakedSingleMask(isUnique, columnUniqueOnce),
+                                                     soaHiddenSingleMask(row, columnTwice, inconsistent));
+            const auto boxMask = _mm256_and_si256(soaNakedSingleMask(isUnique, boxUniqueOnce),
+                                                  soaHiddenSingleMask(row, boxTwice, inconsistent));
+            const auto newRow = _mm256_and_si256(_mm256_and_si256(row, rowMask), _mm256_and_si256(columnMask, boxMask));
+            // Cells which have no candidates
+            inconsistent = _mm256_or_si256(inconsistent, _mm256_cmpeq_epi16(newRow, zero));
+            diff = _mm256_or_si256(diff, _mm256_xor_si256(newRow, row));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(rows_[i]), newRow);
+        }
+    }
+
+    changed |= (_mm256_testz_si256(diff, diff) == 0);
+    return (_mm256_testz_si256(inconsistent, inconsistent) == 0);
+}
+
+// Finds naked and hidden singles in the two diagonal bars
+// and returns true if finding a diagonal bar that cannot be filled.
+bool SudokuSoa16Map::fillDiagonalBars(bool& changed) {
+    // CellLookUp_ covers 9 candidates only
+    auto isUnique = [](SudokuCellCandidates candidates) {
+        return (candidates != Sudoku::EmptyCandidates) && ((candidates & (candidates - 1)) == 0);
+    };
+
+    for(SudokuLoopIndex bar=0;bar<2;++bar) {
+        SudokuCellCandidates uniqueOnce = Sudoku::EmptyCandidates;
+        SudokuCellCandidates uniqueTwice = Sudoku::EmptyCandidates;
+        SudokuCellCandidates once = Sudoku::EmptyCandidates;
+        SudokuCellCandidates twice = Sudoku::EmptyCandidates;
+        for(SudokuLoopIndex row=0;row<Geometry::SizeOfGroupsPerMap;++row) {
+            const SudokuCellCandidates cell = GetCandidates(Geometry::GetDiagonalCell(bar, row));
+            if (isUnique(cell)) {
+                uniqueTwice |= uniqueOnce & cell;
+                uniqueOnce |= cell;
+            }
+            twice |= once & cell;
+            once |= cell;
+        }
+
+        if ((uniqueTwice != Sudoku::EmptyCandidates) || (once != Geometry::AllCandidates)) {
+            return true;
+        }
+
+        for(SudokuLoopIndex row=0;row<Geometry::SizeOfGroupsPerMap;++row) {
+            const auto cellIndex = Geometry::GetDiagonalCell(bar, row);
+            const SudokuCellCandidates cell = GetCandidates(cellIndex);
+            if (isUnique(cell)) {
+                continue;
+            }
+
+            auto newCell = cell & ~uniqueOnce;
+            const auto exclusive = cell & ~twice;
+            if (exclusive != Sudoku::EmptyCandidates) {
+                if (!isUnique(exclusive)) {
+                    return true;
+                }
+                newCell &= exclusive;
+            }
+            if (newCell == Sudoku::EmptyCandidates) {
+                return true;
+            }
+            if (newCell != cell) {
+                SetUniqueCell(cellIndex, newCell);
+                changed = true;
+            }
+        }
+    }
+
+    return false;
+}
+
+SudokuGridMap<4> SudokuSoa16Map::toGridMap(void) const {
+    SudokuGridMap<4> map;
+    for(SudokuIndex i=0;i<Geometry::SizeOfAllCells;++i) {
+        map.SetUniqueCell(i, GetCandidates(i));
+    }
+    return map;
+}
+
+SudokuSoa16Solver::SudokuSoa16Solver(const std::string& presetStr, std::ostream* pSudokuOutStream)
+    : SudokuBaseSolver(pSudokuOutStream) {
+    map_.Preset(presetStr);
+    return;
+}
+
+// Solves a puzzle and writes its solution
+bool SudokuSoa16Solver::Exec(bool silent, bool verbose) {
+    const auto result = solve(map_, verbose);
+    if (silent == false) {
+        map_.Print(pSudokuOutStream_);
+    }
+    return result;
+}
+
+// Prints this solver type
+void SudokuSoa16Solver::PrintType(void) {
+    SudokuBaseSolver::printType("C++ 16x16 with AVX2", pSudokuOutStream_);
+    return;
+}
+
+void SudokuSoa16Solver::Reset(const std::string& presetStr) {
+    clearCount();
+    map_.Preset(presetStr);
+    return;
+}
+
+// Counts solutions of a puzzle and stops when it finds maxCount solutions
+SudokuPatternCount SudokuSoa16Solver::CountUpTo(SudokuPatternCount maxCount) {
+    SudokuPatternCount patternCount = 0;
+    SudokuSoa16Map map = map_;
+    count(map, maxCount, patternCount);
+    return patternCount;
+}
+
+bool SudokuSoa16Solver::IsSolutionOf(const std::string& presetStr) const {
+    return map_.IsSolutionOf(presetStr);
+}
+
+bool SudokuSoa16Solver::solve(SudokuSoa16Map& map, bool verbose) {
     ++count_;
     if (verbose) {
         if (pSudokuOutStream_ != nullptr) {
             (*pSudokuOutStream_) << "Step " << count_ << "\n";
         }
     }
-    return (map.FillCrossing() == false);
+
+    if (map.FillCrossing()) {
+        return false;
+    }
+    if (verbose) {
+        map.Print(pSudokuOutStream_);
+    }
+    // FillCrossing() finds the same unique candidates in a group, so all filled cells are consistent
+    if (map.IsFilled()) {
+        return true;
+    }
+
+    // Guesses a number in a cell which has the fewest candidates
+    const auto cellIndex = map.SelectBacktrackedCellIndex();
+    auto candidates = map.GetCandidates(cellIndex);
+    while(candidates != Sudoku::EmptyCandidates) {
+        // The lowest candidate
+        const auto candidate = candidates & (~candidates + 1);
+        candidates ^= candidate;
+        ++guessCount_;
+        SudokuSoa16Map guessedMap = map;
+        guessedMap.SetUniqueCell(cellIndex, candidate);
+        if (solve(guessedMap, verbose)) {
+            // Solved!
+            map = guessedMap;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void SudokuSoa16Solver::count(SudokuSoa16Map& map, SudokuPatternCount maxCount, SudokuPatternCount& patternCount) {
+    ++count_;
+    if (map.FillCrossing()) {
+        return;
+    }
+    if (map.IsFilled()) {
+        ++patternCount;
+        return;
+    }
+
+    const auto cellIndex = map.SelectBacktrackedCellIndex();
+    auto candidates = map.GetCandidates(cellIndex);
+    while((candidates != Sudoku::EmptyCandidates) && (patternCount < maxCount)) {
+        const auto candidate = candidates & (~candidates + 1);
+        candidates ^= candidate;
+        SudokuSoa16Map guessedMap = map;
+        guessedMap.SetUniqueCell(cellIndex, candidate);
+        count(guessedMap, maxCount, patternCount);
+    }
+
+    return;
 }
+#endif
 
 // --------------- the SSE 4.2 solver ---------------
 SudokuSseCell::SudokuSseCell(void) {
@@ -1362,6 +3952,29 @@ void SudokuSseMap::Preset(const std::string& presetStr) {
     return;
 }
 
+// Same as Preset but reads cells in a SudokuPuzzleRecord without decoding it to a string
+void SudokuSseMap::PresetRecord(const uint8_t* pPuzzleRecord) {
+    SudokuIndex cellIndex = 0;
+    size_t index = InitialRegisterNum * SudokuSse::RegisterWordCnt + 2;
+
+    for(size_t i=0; i<Sudoku::SizeOfGroupsPerMap; ++i) {
+        for(size_t j=0; j<Sudoku::SizeOfBoxesOnEdge; ++j) {
+            SudokuSseElement regVal = 0;
+            for(size_t k=0; k<Sudoku::SizeOfCellsOnBoxEdge; ++k) {
+                const auto num = SudokuPuzzleRecord::GetNumber(pPuzzleRecord, cellIndex++);
+                const SudokuSseElement oneElementVal = (num > 0) ?
+                    (static_cast<SudokuSseElement>(Sudoku::UniqueCandidates) << (num - 1)) : SudokuSseCell::AllCandidates;
+                regVal = (regVal << Sudoku::SizeOfCandidates) | oneElementVal;
+            }
+            xmmRegSet_.regVal_[index--] = regVal;
+        }
+        index += 7;
+    }
+
+    assert(index <= (sizeof(xmmRegSet_.regVal_)/sizeof(xmmRegSet_.regVal_[0])));
+    return;
+}
+
 // Solves a puzzle
 void SudokuSseMap::FillCrossing(bool loadXmm, SudokuSseMapResult& result) {
     Sudoku::LoadXmmRegistersFromMem(xmmRegSet_.regXmmVal_);
@@ -1375,6 +3988,73 @@ void SudokuSseMap::FillCrossing(bool loadXmm, SudokuSseMapResult& result) {
     return;
 }
 
+// Solves a puzzle with backtracking without copying this map
+void SudokuSseMap::SearchCrossing(SudokuSseSearchResult& result) {
+    Sudoku::LoadXmmRegistersFromMem(xmmRegSet_.regXmmVal_);
+
+    // Do not forget to list destroyed registers
+    asm volatile (
+        "call searchSudokuAsm\n\t"
+        :"=a"(result.aborted),"=b"(result.elementCnt),"=c"(result.stepCnt)::"rdx", "rsi", "rdi", "r8", "r9", "r10", "r11", "r12", "r13", "r14", "r15");
+
+    Sudoku::SaveXmmRegistersToMem(xmmRegSet_.regXmmVal_);
+    return;
+}
+
+// Removes candidates with naked and hidden subsets in the same manner as the C++ solver
+bool SudokuSseMap::FindSubsets(void) {
+    SudokuCellCandidates candidateSet[Sudoku::SizeOfAllCells];
+    SudokuSseCandidateCell cell;
+    for(SudokuLoopIndex i=0; i<Sudoku::SizeOfAllCells; ++i) {
+        getCell(i, cell);
+        candidateSet[i] = GetCandidates(cell);
+    }
+
+    if (!SudokuMap::FindSubsets(candidateSet)) {
+        return false;
+    }
+
+    for(SudokuLoopIndex i=0; i<Sudoku::SizeOfAllCells; ++i) {
+        getCell(i, cell);
+        xmmRegSet_.regVal_[cell.regIndex] &= ~cell.mask;
+        xmmRegSet_.regVal_[cell.regIndex] |= candidateSet[i] << cell.shift;
+    }
+    return true;
+}
+
+// Solves two or four puzzles at once
+void SudokuSseMap::FillCrossingInLanes(SudokuSseMap* const mapSet[], size_t laneCnt, SudokuSseLaneResult& result) {
+    XmmRegisterSet* regSetPtrSet[SudokuSse::MaxLaneCnt];
+    for(size_t i=0; i<laneCnt; ++i) {
+        regSetPtrSet[i] = &(mapSet[i]->xmmRegSet_);
+    }
+
+    // Do not forget to list destroyed registers.
+    // Skip the red zone because the compiler regards this function as a leaf function.
+    if (laneCnt == SudokuSse::MaxLaneCnt) {
+        asm volatile (
+            "sub rsp, 128\n\t"
+            "call fillFourSudokuAsm\n\t"
+            "add rsp, 128\n\t"
+            :"=a"(result.aborted)
+            :"S"(regSetPtrSet),"D"(result.elementCnt)
+            :"rdx", "r8", "r9", "r10", "r11", "r12", "r13", "r14", "r15", "memory",
+             "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6", "xmm7",
+             "xmm8", "xmm9", "xmm10", "xmm11", "xmm12", "xmm13", "xmm14", "xmm15");
+    } else {
+        asm volatile (
+            "sub rsp, 128\n\t"
+            "call fillTwoSudokuAsm\n\t"
+            "add rsp, 128\n\t"
+            :"=a"(result.aborted)
+            :"S"(regSetPtrSet),"D"(result.elementCnt)
+            :"rdx", "r8", "r9", "r10", "r11", "r12", "r13", "r14", "r15", "memory",
+             "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6", "xmm7",
+             "xmm8", "xmm9", "xmm10", "xmm11", "xmm12", "xmm13", "xmm14", "xmm15");
+    }
+    return;
+}
+
 void SudokuSseMap::Print(std::ostream* pSudokuOutStream) const {
     size_t index = InitialRegisterNum * SudokuSse::RegisterWordCnt + 2;
 
@@ -1407,6 +4087,11 @@ void SudokuSseMap::Print(std::ostream* pSudokuOutStream) const {
 
 // Find a cell to guess in backtracking in the same manner as the C++ solver
 INLINE bool SudokuSseMap::GetNextCell(const SudokuSseMapResult& result, SudokuSseCandidateCell& cell) {
+    // The assembly code finds a cell in rows only
+    if (Sudoku::GetBranchPolicy() != SudokuBranchPolicy::FIXED_GROUP) {
+        return FindNextCell(cell);
+    }
+
     const bool found = (result.nextCellFound != 0);
 
     if (found) {
@@ -1418,6 +4103,107 @@ INLINE bool SudokuSseMap::GetNextCell(const SudokuSseMapResult& result, SudokuSs
     return found;
 }
 
+// Find a cell to guess in backtracking with the branch policy
+INLINE bool SudokuSseMap::FindNextCell(SudokuSseCandidateCell& cell) const {
+    const auto policy = Sudoku::GetBranchPolicy();
+    if (policy == SudokuBranchPolicy::FIXED_GROUP) {
+        return findNextCellInRows(cell);
+    }
+
+    SudokuBranchSelector::CountSet countSet;
+    for(SudokuLoopIndex i=0;i<Sudoku::SizeOfAllCells;++i) {
+        SudokuSseCandidateCell target;
+        getCell(i, target);
+        countSet[i] = static_cast<SudokuIndex>(__builtin_popcount(xmmRegSet_.regVal_[target.regIndex] & target.mask));
+    }
+
+    SudokuIndex cellIndex = 0;
+    if (!SudokuBranchSelector::Select(policy, countSet, cellIndex)) {
+        return false;
+    }
+
+    getCell(cellIndex, cell);
+    return true;
+}
+
+// Find a cell to guess in backtracking in the same manner as solveSudokuAsm
+INLINE bool SudokuSseMap::findNextCellInRows(SudokuSseCandidateCell& cell) const {
+    constexpr SudokuSseElement CandidatesTooMany = Sudoku::SizeOfCandidates + 1;
+    constexpr size_t CountShift = 16;
+    SudokuSseElement minCount = CandidatesTooMany;
+    SudokuSseElement minRowPopCount = 0;
+    bool found = false;
+
+    for(size_t row=0; row<Sudoku::SizeOfGroupsPerMap; ++row) {
+        const size_t rowIndex = (InitialRegisterNum + row) * SudokuSse::RegisterWordCnt;
+        SudokuSseElement rowMinCount = minCount;
+        SudokuSseElement rowPopCount = 0;
+        size_t outBoxIndex = Sudoku::SizeOfBoxesOnEdge;
+        size_t inBoxIndex = 0;
+
+        // Choose the last cell which has least candidates in the row
+        for(size_t outBox=0; outBox<Sudoku::SizeOfBoxesOnEdge; ++outBox) {
+            const auto regVal = xmmRegSet_.regVal_[rowIndex + outBox];
+            for(size_t inBox=0; inBox<Sudoku::SizeOfCellsOnBoxEdge; ++inBox) {
+                const SudokuSseElement popCount = __builtin_popcount(
+                    (regVal >> (inBox * Sudoku::SizeOfCandidates)) & Sudoku::AllCandidates);
+                rowPopCount += popCount;
+                const auto count = (popCount > Sudoku::SizeOfUniqueCandidate) ? popCount : CandidatesTooMany;
+                if (count <= rowMinCount) {
+                    rowMinCount = count;
+                    outBoxIndex = outBox;
+                    inBoxIndex = inBox;
+                }
+            }
+        }
+
+        // Prefer a row which has less candidates
+        if ((outBoxIndex >= Sudoku::SizeOfBoxesOnEdge) ||
+            (((minCount << CountShift) | minRowPopCount) <= ((rowMinCount << CountShift) | rowPopCount))) {
+            continue;
+        }
+
+        found = true;
+        cell.regIndex = rowIndex + outBoxIndex;
+        cell.shift = inBoxIndex * Sudoku::SizeOfCandidates;
+        cell.mask = Sudoku::AllCandidates << cell.shift;
+        minCount = rowMinCount;
+        minRowPopCount = rowPopCount;
+        if (rowPopCount == (Sudoku::SizeOfCandidates + 2)) {
+            break;
+        }
+    }
+
+    return found;
+}
+
+INLINE SudokuSseElement SudokuSseMap::GetCandidates(const SudokuSseCandidateCell& cell) const {
+    return (xmmRegSet_.regVal_[cell.regIndex] & cell.mask) >> cell.shift;
+}
+
+// Orders candidates of a cell to guess with the value order
+INLINE SudokuIndex SudokuSseMap::OrderCandidates(const SudokuSseCandidateCell& cell,
+                                                 SudokuCellCandidates (&orderedSet)[Sudoku::SizeOfCandidates]) const {
+    const auto order = Sudoku::GetValueOrder();
+    SudokuBranchSelector::CandidatesSet candidatesSet;
+    SudokuIndex cellIndex = 0;
+    if (order == SudokuValueOrder::ASCENDING) {
+        // Other cells do not matter
+        candidatesSet[cellIndex] = GetCandidates(cell);
+    } else {
+        for(SudokuLoopIndex i=0;i<Sudoku::SizeOfAllCells;++i) {
+            SudokuSseCandidateCell target;
+            getCell(i, target);
+            candidatesSet[i] = GetCandidates(target);
+            if ((target.regIndex == cell.regIndex) && (target.shift == cell.shift)) {
+                cellIndex = static_cast<SudokuIndex>(i);
+            }
+        }
+    }
+
+    return SudokuBranchSelector::Order(order, candidatesSet, cellIndex, orderedSet);
+}
+
 // Forces a cell to have one candidate in backtracking
 INLINE bool SudokuSseMap::CanSetUniqueCell(const SudokuSseCandidateCell& cell, SudokuCellCandidates candidate) const {
     auto original = (xmmRegSet_.regVal_[cell.regIndex] & cell.mask) >> cell.shift;
@@ -1430,24 +4216,31 @@ INLINE void SudokuSseMap::SetUniqueCell(const SudokuSseCandidateCell& cell, Sudo
     return;
 }
 
+// The leftmost box is at the highest word and the leftmost cell is at the highest bits in a word
+INLINE void SudokuSseMap::getCell(SudokuLoopIndex cellIndex, SudokuSseCandidateCell& cell) {
+    const auto row = cellIndex / Sudoku::SizeOfCellsPerGroup;
+    const auto column = cellIndex % Sudoku::SizeOfCellsPerGroup;
+    cell.regIndex = (InitialRegisterNum + row) * SudokuSse::RegisterWordCnt +
+        Sudoku::SizeOfBoxesOnEdge - 1 - column / Sudoku::SizeOfCellsOnBoxEdge;
+    cell.shift = (Sudoku::SizeOfCellsOnBoxEdge - 1 - column % Sudoku::SizeOfCellsOnBoxEdge) * Sudoku::SizeOfCandidates;
+    cell.mask = Sudoku::AllCandidates << cell.shift;
+    return;
+}
+
 SudokuSseSolver::SudokuSseSolver(const std::string& presetStr, std::ostream* pSudokuOutStream,
                                  SudokuPatternCount printAllCandidate)
-    : SudokuBaseSolver(pSudokuOutStream), enumeratorMap_(pSudokuOutStream), printAllCandidate_(printAllCandidate) {
-    initialize(presetStr, pSudokuOutStream);
+    : SudokuBaseSolver(pSudokuOutStream), enumeratorMap_(pSudokuOutStream), printAllCandidate_(printAllCandidate),
+      presetStr_(presetStr) {
+    map_.Preset(presetStr);
     return;
 }
 
 // 'seed' is not used, just for interface compatibility with the C++ solver
 SudokuSseSolver::SudokuSseSolver(const std::string& presetStr, SudokuIndex seed,
                                  std::ostream* pSudokuOutStream, SudokuPatternCount printAllCandidate)
-    : SudokuBaseSolver(pSudokuOutStream), enumeratorMap_(pSudokuOutStream), printAllCandidate_(printAllCandidate) {
-    initialize(presetStr, pSudokuOutStream);
-    return;
-}
-
-void SudokuSseSolver::initialize(const std::string& presetStr, std::ostream* pSudokuOutStream) {
+    : SudokuBaseSolver(pSudokuOutStream), enumeratorMap_(pSudokuOutStream), printAllCandidate_(printAllCandidate),
+      presetStr_(presetStr) {
     map_.Preset(presetStr);
-    enumeratorMap_.Preset(presetStr);
     return;
 }
 
@@ -1461,10 +4254,37 @@ bool SudokuSseSolver::Exec(bool silent, bool verbose) {
 
 // Enumrates solutions
 void SudokuSseSolver::Enumerate(void) {
-    if (printAllCandidate_) {
-        enumeratorMap_.SetToPrint(printAllCandidate_);
+    enumeratorMap_.Preset(presetStr_);
+    SudokuPatternCount result = 0;
+    if (SudokuSseMapEnumerator::IsSuitable(map_)) {
+        enumeratorMap_.Print();
+        SudokuSseMapEnumerator enumerator(pSudokuOutStream_, printAllCandidate_);
+        result = enumerator.Enumerate(map_);
+    } else {
+        if (printAllCandidate_) {
+            enumeratorMap_.SetToPrint(printAllCandidate_);
+        }
+        result = enumeratorMap_.Enumerate();
     }
-    const auto result = enumeratorMap_.Enumerate();
+    (*pSudokuOutStream_) << "Number of solutions : " << result << "\n";
+    return;
+}
+
+// Counts solutions up to maxCount and stops searching when it finds maxCount solutions.
+// CountUpTo(2) tells whether a puzzle has no, a unique or multiple solutions.
+SudokuPatternCount SudokuSseSolver::CountUpTo(SudokuPatternCount maxCount) {
+    SudokuSseMapEnumerator enumerator(pSudokuOutStream_, printAllCandidate_);
+    enumerator.SetMaxCount(maxCount);
+    return enumerator.Enumerate(map_);
+}
+
+// Enumrates solutions on multiple threads without printing them
+void SudokuSseSolver::Enumerate(const std::string& presetStr, Sudoku::BaseParallelRunner& parallelRunner,
+                                SudokuSseParallelEnumerator::NumberOfCores numberOfThreads, SudokuIndex splitDepth) {
+    enumeratorMap_.Preset(presetStr_);
+    enumeratorMap_.Print();
+    SudokuSseParallelEnumerator enumerator(presetStr, splitDepth);
+    const auto result = enumerator.Enumerate(parallelRunner, numberOfThreads);
     (*pSudokuOutStream_) << "Number of solutions : " << result << "\n";
     return;
 }
@@ -1475,7 +4295,37 @@ void SudokuSseSolver::PrintType(void) {
     return;
 }
 
+// Copies the puzzle to preset enumeratorMap_ later because solving it does not need the map
+// (Preset() leaves candidates of blank cells which the previous puzzle changed)
+void SudokuSseSolver::Reset(const std::string& presetStr) {
+    clearCount();
+    map_ = SudokuSseMap();
+    map_.Preset(presetStr);
+    presetStr_ = presetStr;
+    return;
+}
+
 bool SudokuSseSolver::solve(SudokuSseMap& map, bool topLevel, bool verbose) {
+    // Prints each step in recursive calls only.
+    // The assembly code guesses cells in rows and numbers from 1, so recursive calls apply other policies.
+    if (!verbose && (Sudoku::GetBranchPolicy() == SudokuBranchPolicy::FIXED_GROUP) &&
+        (Sudoku::GetValueOrder() == SudokuValueOrder::ASCENDING)) {
+        // Reduces candidates with subsets before searching in the assembly code
+        if (Sudoku::UsesSubsetElimination()) {
+            SudokuSseMapResult result;
+            do {
+                fillCells(map, topLevel, verbose, result);
+                if (result.aborted) {
+                    return false;
+                }
+                if (result.elementCnt == Sudoku::SizeOfAllCells) {
+                    return true;
+                }
+            } while (canFindSubsets(static_cast<SudokuIndex>(result.elementCnt)) && map.FindSubsets());
+        }
+        return searchCells(map);
+    }
+
     for(;;) {
         // Solves forward until we cannot reduce candidates anymore
         SudokuSseMapResult result;
@@ -1490,6 +4340,11 @@ bool SudokuSseSolver::solve(SudokuSseMap& map, bool topLevel, bool verbose) {
             return true;
         }
 
+        // Fills cells again if subsets reduce candidates
+        if (canFindSubsets(static_cast<SudokuIndex>(result.elementCnt)) && map.FindSubsets()) {
+            continue;
+        }
+
         // We start backtracking because we cannot reduce candidates anymore
         SudokuSseCandidateCell cell;
         auto found = map.GetNextCell(result, cell);
@@ -1497,56 +4352,599 @@ bool SudokuSseSolver::solve(SudokuSseMap& map, bool topLevel, bool verbose) {
             return false;
         }
 
-        // Guesses a number of 1..9 in a cell in a solution
-        auto candidate = SudokuCell::GetInitialCandidate();
-        for(;;) {
-            const auto canSet = map.CanSetUniqueCell(cell, candidate);
-
-            // We continue to solve the puzzle if we can set a valid candidate to the cell
-            if (canSet) {
-                SudokuSseMap newMap = map;
-                newMap.SetUniqueCell(cell, candidate);
-                if (verbose) {
-                    map.Print(pSudokuOutStream_);
-                }
+        // Guesses candidates in the cell in the value order
+        SudokuCellCandidates orderedSet[Sudoku::SizeOfCandidates];
+        const auto size = map.OrderCandidates(cell, orderedSet);
+        for(SudokuLoopIndex i=0;i<size;++i) {
+            ++guessCount_;
+            SudokuSseMap newMap = map;
+            newMap.SetUniqueCell(cell, orderedSet[i]);
+            if (verbose) {
+                map.Print(pSudokuOutStream_);
+            }
+
+            // Starts backtracking
+            const auto result = solve(newMap, false, verbose);
+            if (result) {
+                // We can get a solution via trivial copy
+                map = newMap;
+                // Solved!
+                return true;
+            }
+        }
+
+        break;
+    }
+
+    return false;
+}
+
+bool SudokuSseSolver::fillCells(SudokuSseMap& map, bool topLevel, bool verbose, SudokuSseMapResult& result) {
+    ++count_;
+    if (verbose) {
+        if (pSudokuOutStream_ != nullptr) {
+            (*pSudokuOutStream_) << "Step " << count_ << "\n";
+        }
+    }
+    map.FillCrossing(topLevel, result);
+    return true;
+}
+
+bool SudokuSseSolver::searchCells(SudokuSseMap& map) {
+    SudokuSseSearchResult result;
+    map.SearchCrossing(result);
+    count_ += static_cast<decltype(count_)>(result.stepCnt);
+    // searchSudokuAsm fills cells once at first and once after each guess
+    guessCount_ += (result.stepCnt > 0) ? static_cast<decltype(guessCount_)>(result.stepCnt - 1) : 0;
+    return ((result.aborted == 0) && (result.elementCnt == Sudoku::SizeOfAllCells));
+}
+
+SudokuSseLaneSolver::SudokuSseLaneSolver(void) : laneCnt_(GetLaneCount()), stepCnt_(0), guessCnt_(0) {
+    return;
+}
+
+// Requires AVX2 and does not support diagonal Sudoku
+bool SudokuSseLaneSolver::CanSolve(void) {
+    return ((sudokuXmmUseAvx != 0) && !DiagonalSudokuMode);
+}
+
+// Four puzzles in ZMM registers with AVX-512, two puzzles in YMM registers otherwise
+size_t SudokuSseLaneSolver::GetLaneCount(void) {
+    return (sudokuXmmUseAvx512 != 0) ? SudokuSse::MaxLaneCnt : 2;
+}
+
+// Solves puzzles and overwrites them with their solutions.
+// Returns the number of solved puzzles.
+SudokuPuzzleCount SudokuSseLaneSolver::Solve(std::vector<SudokuSseMap>& mapSet) {
+    SudokuPuzzleCount solvedCnt = 0;
+    size_t nextMapIndex = 0;
+    SudokuSseMap* lanePtrSet[SudokuSse::MaxLaneCnt];
+    for(size_t i=0; i<laneCnt_; ++i) {
+        assign(laneSet_[i], nextMapIndex, mapSet);
+        lanePtrSet[i] = &laneSet_[i].map;
+    }
+
+    size_t activeCnt = std::min(laneCnt_, mapSet.size());
+    while(activeCnt > 0) {
+        SudokuSseLaneResult result;
+        SudokuSseMap::FillCrossingInLanes(lanePtrSet, laneCnt_, result);
+        const auto& elementCntSet = result.elementCnt;
+
+        for(size_t i=0; i<laneCnt_; ++i) {
+            auto& lane = laneSet_[i];
+            if (!lane.active) {
+                continue;
+            }
+
+            ++stepCnt_;
+            // Leave a puzzle which has no solution as the C++ solver does
+            if (!lane.started) {
+                lane.started = true;
+                mapSet.at(lane.mapIndex) = lane.map;
+            }
+
+            const bool aborted = ((result.aborted >> i) & 1);
+            if (!aborted && (elementCntSet[i] == Sudoku::SizeOfAllCells)) {
+                mapSet.at(lane.mapIndex) = lane.map;
+                ++solvedCnt;
+                activeCnt -= assign(lane, nextMapIndex, mapSet) ? 0 : 1;
+                continue;
+            }
+
+            SudokuSseCandidateCell cell;
+            if (!aborted && lane.map.FindNextCell(cell)) {
+                lane.frameSet.push_back(Frame{lane.map, cell, lane.map.GetCandidates(cell)});
+            }
+
+            if (!guess(lane)) {
+                activeCnt -= assign(lane, nextMapIndex, mapSet) ? 0 : 1;
+            }
+        }
+    }
+
+    return solvedCnt;
+}
+
+// Returns how many times lanes filled cells of puzzles
+SudokuPatternCount SudokuSseLaneSolver::GetStepCount(void) const {
+    return stepCnt_;
+}
+
+// Returns how many times lanes guessed candidates of puzzles
+SudokuPatternCount SudokuSseLaneSolver::GetGuessCount(void) const {
+    return guessCnt_;
+}
+
+// Sets a next puzzle to a lane or leaves it idle.
+// Returns whether the lane is active.
+bool SudokuSseLaneSolver::assign(Lane& lane, size_t& nextMapIndex, const std::vector<SudokuSseMap>& mapSet) {
+    lane.frameSet.clear();
+    lane.started = false;
+    lane.active = (nextMapIndex < mapSet.size());
+    if (lane.active) {
+        lane.mapIndex = nextMapIndex++;
+        lane.map = mapSet.at(lane.mapIndex);
+    }
+    return lane.active;
+}
+
+// Guesses the smallest candidate as the C++ solver does.
+// Returns false if no candidates are left.
+bool SudokuSseLaneSolver::guess(Lane& lane) {
+    if (lane.frameSet.empty()) {
+        return false;
+    }
+
+    ++guessCnt_;
+    auto& frame = lane.frameSet.back();
+    const SudokuSseElement candidate = frame.candidates & (~frame.candidates + 1);
+    frame.candidates ^= candidate;
+    lane.map = frame.map;
+    lane.map.SetUniqueCell(frame.cell, candidate);
+    if (frame.candidates == 0) {
+        lane.frameSet.pop_back();
+    }
+
+    return true;
+}
+
+// --------------- the SSE 4.2 solver with intrinsics ---------------
+namespace {
+    // Words 0..2 of a row hold three cells each and word 3 is zero as in sudokusse.s
+    INLINE __m128i sseRowConstant(SudokuSseElement value) {
+        return _mm_set_epi32(0, static_cast<int>(value), static_cast<int>(value), static_cast<int>(value));
+    }
+
+    INLINE __m128i sseCellMask(void) {
+        return sseRowConstant(Sudoku::AllCandidates);
+    }
+
+    INLINE __m128i sseRowPartMask(void) {
+        return sseRowConstant(Sudoku::AllThreeCandidates);
+    }
+
+    // Sets all bits of cells which hold any candidates
+    INLINE __m128i sseNonZeroCells(__m128i cells) {
+        const auto lower8 = sseRowConstant(0x3fdfeff);
+        auto highest = _mm_add_epi32(_mm_and_si128(cells, lower8), lower8);
+        highest = _mm_and_si128(_mm_or_si128(highest, cells), sseRowConstant(0x4020100));
+        return _mm_or_si128(highest, _mm_sub_epi32(highest, _mm_srli_epi32(highest, 8)));
+    }
+
+    // Sets all bits of cells which hold two or more candidates
+    INLINE __m128i sseMultipleCells(__m128i cells) {
+        // Fill empty cells to keep them from borrowing bits of their next cells
+        const auto nonZero = sseNonZeroCells(cells);
+        const auto filled = _mm_or_si128(cells, _mm_andnot_si128(nonZero, sseRowPartMask()));
+        return _mm_and_si128(nonZero, sseNonZeroCells(_mm_and_si128(filled, _mm_sub_epi32(filled, sseRowConstant(0x40201)))));
+    }
+
+    // Merges candidates of cells at the same positions.
+    // 'twice' collects candidates which two or more cells hold.
+    INLINE void sseMergeCells(__m128i& once, __m128i& twice, __m128i otherOnce, __m128i otherTwice) {
+        twice = _mm_or_si128(_mm_or_si128(twice, otherTwice), _mm_and_si128(once, otherOnce));
+        once = _mm_or_si128(once, otherOnce);
+        return;
+    }
+
+    // Merges three cells in each word into its rightmost cell
+    INLINE void sseFoldCells(__m128i& once, __m128i& twice) {
+        const auto cellMask = sseCellMask();
+        const auto once2 = _mm_srli_epi32(once, Sudoku::SizeOfCandidates * 2);
+        const auto twice2 = _mm_srli_epi32(twice, Sudoku::SizeOfCandidates * 2);
+        sseMergeCells(once, twice, _mm_srli_epi32(once, Sudoku::SizeOfCandidates),
+                      _mm_srli_epi32(twice, Sudoku::SizeOfCandidates));
+        sseMergeCells(once, twice, once2, twice2);
+        once = _mm_and_si128(once, cellMask);
+        twice = _mm_and_si128(twice, cellMask);
+        return;
+    }
+
+    // Merges words 0..2 and sets it to them
+    INLINE void sseFoldRow(__m128i& once, __m128i& twice) {
+        const auto once1 = _mm_shuffle_epi32(once, 0xc9);
+        const auto twice1 = _mm_shuffle_epi32(twice, 0xc9);
+        const auto once2 = _mm_shuffle_epi32(once, 0xd2);
+        const auto twice2 = _mm_shuffle_epi32(twice, 0xd2);
+        sseMergeCells(once, twice, once1, twice1);
+        sseMergeCells(once, twice, once2, twice2);
+        return;
+    }
+
+    // Copies the rightmost cell in each word to other two cells
+    INLINE __m128i sseBroadcastCell(__m128i cells) {
+        return _mm_or_si128(cells, _mm_or_si128(_mm_slli_epi32(cells, Sudoku::SizeOfCandidates),
+                                                _mm_slli_epi32(cells, Sudoku::SizeOfCandidates * 2)));
+    }
+
+    // Merges other two cells in each word into each cell
+    INLINE __m128i sseOtherCells(__m128i cells) {
+        const auto lower = _mm_or_si128(_mm_srli_epi32(cells, Sudoku::SizeOfCandidates),
+                                        _mm_srli_epi32(cells, Sudoku::SizeOfCandidates * 2));
+        const auto upper = _mm_or_si128(_mm_slli_epi32(cells, Sudoku::SizeOfCandidates),
+                                        _mm_slli_epi32(cells, Sudoku::SizeOfCandidates * 2));
+        return _mm_and_si128(_mm_or_si128(lower, upper), sseRowPartMask());
+    }
+
+    // Merges other two words of 0..2 into each word
+    INLINE __m128i sseOtherWords(__m128i cells) {
+        return _mm_or_si128(_mm_shuffle_epi32(cells, 0xc9), _mm_shuffle_epi32(cells, 0xd2));
+    }
+
+    INLINE void sseRemoveCandidates(__m128i& row, __m128i mask, bool& changed) {
+        changed |= !_mm_testz_si128(row, mask);
+        row = _mm_andnot_si128(mask, row);
+        return;
+    }
+
+    // Removes unique candidates from other cells in their rows, columns and boxes (naked singles)
+    // and fills cells which have a candidate that no other cells in a group have (hidden singles).
+    // Returns false if the rows have no solution.
+    bool sseFillRows(__m128i (&rowSet)[Sudoku::SizeOfGroupsPerMap], bool& changed) {
+        const auto zero = _mm_setzero_si128();
+        const auto cellMask = sseCellMask();
+        const auto rowPartMask = sseRowPartMask();
+        __m128i invalid = zero;
+        __m128i uniqueSet[Sudoku::SizeOfGroupsPerMap];
+        __m128i rowUniqueSet[Sudoku::SizeOfGroupsPerMap];
+        __m128i boxOnceSet[Sudoku::SizeOfBoxesOnEdge];
+        __m128i boxTwiceSet[Sudoku::SizeOfBoxesOnEdge];
+        __m128i columnUnique = zero;
+        __m128i columnTwice = zero;
+
+        // Collects unique candidates and a group has the same unique candidate twice if unsolvable
+        for(size_t row=0; row<Sudoku::SizeOfGroupsPerMap; ++row) {
+            const auto cells = rowSet[row];
+            const auto unique = _mm_andnot_si128(sseMultipleCells(cells), cells);
+            invalid = _mm_or_si128(invalid, _mm_andnot_si128(sseNonZeroCells(cells), rowPartMask));
+            uniqueSet[row] = unique;
+            sseMergeCells(columnUnique, columnTwice, unique, zero);
+
+            const auto band = row / Sudoku::SizeOfCellsOnBoxEdge;
+            auto once = unique;
+            auto twice = zero;
+            sseFoldCells(once, twice);
+            if ((row % Sudoku::SizeOfCellsOnBoxEdge) == 0) {
+                boxOnceSet[band] = once;
+                boxTwiceSet[band] = twice;
+            } else {
+                sseMergeCells(boxOnceSet[band], boxTwiceSet[band], once, twice);
+            }
+            sseFoldRow(once, twice);
+            invalid = _mm_or_si128(invalid, twice);
+            rowUniqueSet[row] = once;
+        }
+
+        invalid = _mm_or_si128(invalid, columnTwice);
+        for(size_t band=0; band<Sudoku::SizeOfBoxesOnEdge; ++band) {
+            invalid = _mm_or_si128(invalid, boxTwiceSet[band]);
+        }
+        if (!_mm_testz_si128(invalid, invalid)) {
+            return false;
+        }
+
+        __m128i previousSet[Sudoku::SizeOfGroupsPerMap];
+        for(size_t row=0; row<Sudoku::SizeOfGroupsPerMap; ++row) {
+            const auto band = row / Sudoku::SizeOfCellsOnBoxEdge;
+            const auto mask = _mm_or_si128(columnUnique, sseBroadcastCell(_mm_or_si128(boxOnceSet[band], rowUniqueSet[row])));
+            previousSet[row] = rowSet[row];
+            rowSet[row] = _mm_or_si128(_mm_andnot_si128(mask, rowSet[row]), uniqueSet[row]);
+        }
+
+        // Counts candidates in columns, boxes and rows after removing unique candidates
+        __m128i rowTwiceSet[Sudoku::SizeOfGroupsPerMap];
+        __m128i columnOnce = zero;
+        columnTwice = zero;
+        for(size_t row=0; row<Sudoku::SizeOfGroupsPerMap; ++row) {
+            const auto cells = rowSet[row];
+            sseMergeCells(columnOnce, columnTwice, cells, zero);
+
+            const auto band = row / Sudoku::SizeOfCellsOnBoxEdge;
+            auto once = cells;
+            auto twice = zero;
+            sseFoldCells(once, twice);
+            if ((row % Sudoku::SizeOfCellsOnBoxEdge) == 0) {
+                boxOnceSet[band] = once;
+                boxTwiceSet[band] = twice;
+            } else {
+                sseMergeCells(boxOnceSet[band], boxTwiceSet[band], once, twice);
+            }
+            sseFoldRow(once, twice);
+            invalid = _mm_or_si128(invalid, _mm_andnot_si128(once, cellMask));
+            rowTwiceSet[row] = twice;
+        }
+
+        // A group lacks a candidate if unsolvable
+        invalid = _mm_or_si128(invalid, _mm_andnot_si128(columnOnce, rowPartMask));
+        for(size_t band=0; band<Sudoku::SizeOfBoxesOnEdge; ++band) {
+            invalid = _mm_or_si128(invalid, _mm_andnot_si128(boxOnceSet[band], cellMask));
+        }
+
+        __m128i diff = zero;
+        for(size_t row=0; row<Sudoku::SizeOfGroupsPerMap; ++row) {
+            const auto band = row / Sudoku::SizeOfCellsOnBoxEdge;
+            const auto cells = rowSet[row];
+            const auto twice = _mm_and_si128(columnTwice, sseBroadcastCell(_mm_and_si128(boxTwiceSet[band], rowTwiceSet[row])));
+            const auto hidden = _mm_andnot_si128(twice, cells);
+            // A cell cannot have two candidates which only it has in its groups
+            invalid = _mm_or_si128(invalid, sseMultipleCells(hidden));
+            const auto filled = _mm_or_si128(hidden, _mm_andnot_si128(sseNonZeroCells(hidden), cells));
+            diff = _mm_or_si128(diff, _mm_xor_si128(filled, previousSet[row]));
+            rowSet[row] = filled;
+        }
+
+        changed |= !_mm_testz_si128(diff, diff);
+        return _mm_testz_si128(invalid, invalid);
+    }
+
+    // Locked candidates (pointing and claiming) in the same manner as FindLockedCandidates.
+    // Returns true if it removes any candidates.
+    bool sseFindLockedCandidates(__m128i (&rowSet)[Sudoku::SizeOfGroupsPerMap]) {
+        bool changed = false;
+        __m128i bandSet[Sudoku::SizeOfBoxesOnEdge];
+
+        for(size_t band=0; band<Sudoku::SizeOfBoxesOnEdge; ++band) {
+            __m128i* rows = &rowSet[band * Sudoku::SizeOfCellsOnBoxEdge];
+            __m128i partSet[Sudoku::SizeOfCellsOnBoxEdge];
+            for(size_t i=0; i<Sudoku::SizeOfCellsOnBoxEdge; ++i) {
+                auto twice = _mm_setzero_si128();
+                partSet[i] = rows[i];
+                sseFoldCells(partSet[i], twice);
+            }
+
+            // Pointing: a number in a box only in a row cannot be in the row out of the box
+            for(size_t i=0; i<Sudoku::SizeOfCellsOnBoxEdge; ++i) {
+                const auto other = _mm_or_si128(partSet[(i + 1) % Sudoku::SizeOfCellsOnBoxEdge],
+                                                partSet[(i + 2) % Sudoku::SizeOfCellsOnBoxEdge]);
+                const auto pointing = _mm_andnot_si128(other, partSet[i]);
+                sseRemoveCandidates(rows[i], sseBroadcastCell(sseOtherWords(pointing)), changed);
+            }
+
+            // Claiming: a number in a row only in a box cannot be in other rows in the box
+            for(size_t i=0; i<Sudoku::SizeOfCellsOnBoxEdge; ++i) {
+                const auto claiming = sseBroadcastCell(_mm_andnot_si128(sseOtherWords(partSet[i]), partSet[i]));
+                sseRemoveCandidates(rows[(i + 1) % Sudoku::SizeOfCellsOnBoxEdge], claiming, changed);
+                sseRemoveCandidates(rows[(i + 2) % Sudoku::SizeOfCellsOnBoxEdge], claiming, changed);
+            }
+        }
+
+        for(size_t band=0; band<Sudoku::SizeOfBoxesOnEdge; ++band) {
+            const __m128i* rows = &rowSet[band * Sudoku::SizeOfCellsOnBoxEdge];
+            bandSet[band] = _mm_or_si128(rows[0], _mm_or_si128(rows[1], rows[2]));
+        }
+
+        // Claiming: a number in a column only in a box cannot be in other columns in the box
+        __m128i pointingSet[Sudoku::SizeOfBoxesOnEdge];
+        for(size_t band=0; band<Sudoku::SizeOfBoxesOnEdge; ++band) {
+            __m128i* rows = &rowSet[band * Sudoku::SizeOfCellsOnBoxEdge];
+            const auto other = _mm_or_si128(bandSet[(band + 1) % Sudoku::SizeOfBoxesOnEdge],
+                                            bandSet[(band + 2) % Sudoku::SizeOfBoxesOnEdge]);
+            const auto claiming = sseOtherCells(_mm_andnot_si128(other, bandSet[band]));
+            for(size_t i=0; i<Sudoku::SizeOfCellsOnBoxEdge; ++i) {
+                sseRemoveCandidates(rows[i], claiming, changed);
+            }
+            pointingSet[band] = _mm_andnot_si128(sseOtherCells(bandSet[band]), bandSet[band]);
+        }
+
+        // Pointing: a number in a box only in a column cannot be in the column out of the box
+        for(size_t band=0; band<Sudoku::SizeOfBoxesOnEdge; ++band) {
+            __m128i* rows = &rowSet[band * Sudoku::SizeOfCellsOnBoxEdge];
+            const auto pointing = _mm_or_si128(pointingSet[(band + 1) % Sudoku::SizeOfBoxesOnEdge],
+                                               pointingSet[(band + 2) % Sudoku::SizeOfBoxesOnEdge]);
+            for(size_t i=0; i<Sudoku::SizeOfCellsOnBoxEdge; ++i) {
+                sseRemoveCandidates(rows[i], pointing, changed);
+            }
+        }
+
+        return changed;
+    }
+}
+
+// Solves a puzzle in the same manner as FillCrossing with intrinsics instead of the assembly
+void SudokuSseMap::FillCrossingWithIntrinsics(SudokuSseMapResult& result) {
+    __m128i rowSet[Sudoku::SizeOfGroupsPerMap];
+    for(size_t row=0; row<Sudoku::SizeOfGroupsPerMap; ++row) {
+        rowSet[row] = _mm_castps_si128(xmmRegSet_.regXmmVal_[InitialRegisterNum + row]);
+    }
+
+    // Each iteration removes at least one candidate
+    bool aborted = false;
+    for(;;) {
+        bool changed = false;
+        if (!sseFillRows(rowSet, changed)) {
+            aborted = true;
+            break;
+        }
+
+        if CPP17_IF_CONSTEXPR (DiagonalSudokuMode) {
+            for(size_t row=0; row<Sudoku::SizeOfGroupsPerMap; ++row) {
+                xmmRegSet_.regXmmVal_[InitialRegisterNum + row] = _mm_castsi128_ps(rowSet[row]);
+            }
+            if (!fillDiagonalCells(changed)) {
+                aborted = true;
+                break;
+            }
+            for(size_t row=0; row<Sudoku::SizeOfGroupsPerMap; ++row) {
+                rowSet[row] = _mm_castps_si128(xmmRegSet_.regXmmVal_[InitialRegisterNum + row]);
+            }
+        }
+
+        // Keep filling cells if the locked candidates method reduces candidates
+        if (!changed && !sseFindLockedCandidates(rowSet)) {
+            break;
+        }
+    }
+
+    SudokuSseElement elementCnt = 0;
+    for(size_t row=0; row<Sudoku::SizeOfGroupsPerMap; ++row) {
+        xmmRegSet_.regXmmVal_[InitialRegisterNum + row] = _mm_castsi128_ps(rowSet[row]);
+        const auto unique = _mm_and_si128(sseNonZeroCells(_mm_andnot_si128(sseMultipleCells(rowSet[row]), rowSet[row])),
+                                          sseRowConstant(0x40201));
+        elementCnt += static_cast<SudokuSseElement>(__builtin_popcountll(static_cast<uint64_t>(_mm_cvtsi128_si64(unique))) +
+                                                    __builtin_popcountll(static_cast<uint64_t>(_mm_extract_epi64(unique, 1))));
+    }
+
+    result.aborted = aborted;
+    result.elementCnt = (aborted) ? 0 : elementCnt;
+    result.nextCellFound = 0;
+    result.nextOutBoxIndex = 0;
+    result.nextInBoxIndex = 0;
+    result.nextRowNumber = 0;
+
+    // GetNextCell() finds a cell with other branch policies
+    SudokuSseCandidateCell cell;
+    if (!aborted && (elementCnt < Sudoku::SizeOfAllCells) &&
+        (Sudoku::GetBranchPolicy() == SudokuBranchPolicy::FIXED_GROUP) && findNextCellInRows(cell)) {
+        result.nextCellFound = 1;
+        result.nextRowNumber = cell.regIndex / SudokuSse::RegisterWordCnt - InitialRegisterNum;
+        result.nextOutBoxIndex = cell.regIndex % SudokuSse::RegisterWordCnt;
+        result.nextInBoxIndex = cell.shift / Sudoku::SizeOfCandidates;
+    }
 
-                // Starts backtracking
-                const auto result = solve(newMap, false, verbose);
-                if (result) {
-                    // We can get a solution via trivial copy
-                    map = newMap;
-                    // Solved!
-                    return true;
-                }
+    return;
+}
+
+// Removes unique candidates from other cells in the two diagonal bars (naked singles)
+// as FindUnusedAllDiagonalElements does. Returns false if they have no solution.
+bool SudokuSseMap::fillDiagonalCells(bool& changed) {
+    for(size_t bar=0; bar<2; ++bar) {
+        SudokuSseCandidateCell cellSet[Sudoku::SizeOfCellsPerGroup];
+        SudokuSseElement uniqueOnce = 0;
+        SudokuSseElement uniqueTwice = 0;
+        for(SudokuLoopIndex i=0; i<Sudoku::SizeOfCellsPerGroup; ++i) {
+            const SudokuLoopIndex column = (bar == 0) ? i : (Sudoku::SizeOfCellsPerGroup - 1 - i);
+            getCell(i * Sudoku::SizeOfCellsPerGroup + column, cellSet[i]);
+            const auto candidates = GetCandidates(cellSet[i]);
+            if (__builtin_popcount(candidates) == Sudoku::SizeOfUniqueCandidate) {
+                uniqueTwice |= uniqueOnce & candidates;
+                uniqueOnce |= candidates;
             }
+        }
+        if (uniqueTwice) {
+            return false;
+        }
 
-            // Try next candidate to a guess
-            candidate = SudokuCell::GetNextCandidate(candidate);
-            if (SudokuCell::IsEmptyCandidates(candidate) != false) {
-                break;
+        SudokuSseElement allCandidates = 0;
+        for(SudokuLoopIndex i=0; i<Sudoku::SizeOfCellsPerGroup; ++i) {
+            auto candidates = GetCandidates(cellSet[i]);
+            if ((__builtin_popcount(candidates) != Sudoku::SizeOfUniqueCandidate) && (candidates & uniqueOnce)) {
+                changed = true;
+                candidates &= ~uniqueOnce;
+                SetUniqueCell(cellSet[i], candidates);
             }
+            allCandidates |= candidates;
+        }
+        if (allCandidates != Sudoku::AllCandidates) {
+            return false;
         }
+    }
 
-        break;
+    return true;
+}
+
+SudokuSseIntrinsicsSolver::SudokuSseIntrinsicsSolver(const std::string& presetStr, std::ostream* pSudokuOutStream)
+    : SudokuBaseSolver(pSudokuOutStream) {
+    map_.Preset(presetStr);
+    return;
+}
+
+// Solves a puzzle and writes its solution
+bool SudokuSseIntrinsicsSolver::Exec(bool silent, bool verbose) {
+    const auto result = solve(map_, verbose);
+    if (silent == false) {
+        map_.Print(pSudokuOutStream_);
     }
+    return result;
+}
 
-    return false;
+// Prints this solver type
+void SudokuSseIntrinsicsSolver::PrintType(void) {
+    SudokuBaseSolver::printType("SSE 4.2 intrinsics", pSudokuOutStream_);
+    return;
 }
 
-bool SudokuSseSolver::fillCells(SudokuSseMap& map, bool topLevel, bool verbose, SudokuSseMapResult& result) {
+// Preset() writes cells only and leaves other words
+void SudokuSseIntrinsicsSolver::Reset(const std::string& presetStr) {
+    clearCount();
+    map_ = SudokuSseMap();
+    map_.Preset(presetStr);
+    return;
+}
+
+bool SudokuSseIntrinsicsSolver::solve(SudokuSseMap& map, bool verbose) {
     ++count_;
     if (verbose) {
         if (pSudokuOutStream_ != nullptr) {
             (*pSudokuOutStream_) << "Step " << count_ << "\n";
         }
     }
-    map.FillCrossing(topLevel, result);
-    return true;
+
+    SudokuSseMapResult result;
+    map.FillCrossingWithIntrinsics(result);
+    if (result.aborted) {
+        return false;
+    }
+    if (verbose) {
+        map.Print(pSudokuOutStream_);
+    }
+    if (result.elementCnt == Sudoku::SizeOfAllCells) {
+        return true;
+    }
+
+    SudokuSseCandidateCell cell;
+    if (!map.GetNextCell(result, cell)) {
+        return false;
+    }
+
+    // Guesses the smallest candidate first as searchSudokuAsm does unless the value order is set
+    SudokuCellCandidates orderedSet[Sudoku::SizeOfCandidates];
+    const auto size = map.OrderCandidates(cell, orderedSet);
+    for(SudokuLoopIndex i=0;i<size;++i) {
+        ++guessCount_;
+        SudokuSseMap guessedMap = map;
+        guessedMap.SetUniqueCell(cell, orderedSet[i]);
+        if (solve(guessedMap, verbose)) {
+            // Solved!
+            map = guessedMap;
+            return true;
+        }
+    }
+
+    return false;
 }
 
 SudokuChecker::SudokuChecker(const std::string& puzzle, const std::string& solution,
                              SudokuSolverPrint printSolution, std::ostream* pSudokuOutStream)
-    : valid_(parse(puzzle, solution, printSolution, pSudokuOutStream)) {
+    : valid_(false) {
+    Buffer buffer;
+    valid_ = parse(puzzle, solution, printSolution, pSudokuOutStream, buffer);
+    return;
+}
+
+// Reuses strings in the buffer to check solutions one after another
+SudokuChecker::SudokuChecker(const std::string& puzzle, const std::string& solution,
+                             SudokuSolverPrint printSolution, std::ostream* pSudokuOutStream, Buffer& buffer)
+    : valid_(parse(puzzle, solution, printSolution, pSudokuOutStream, buffer)) {
     return;
 }
 
@@ -1555,20 +4953,28 @@ bool SudokuChecker::Valid() const {
 }
 
 bool SudokuChecker::parse(const std::string& puzzle, const std::string& solution,
-                          SudokuSolverPrint printSolution, std::ostream* pSudokuOutStream) {
+                          SudokuSolverPrint printSolution, std::ostream* pSudokuOutStream, Buffer& buffer) {
     Grid grid {{{{0,0,0,0,0,0,0,0,0}}, {{0,0,0,0,0,0,0,0,0}}, {{0,0,0,0,0,0,0,0,0}},
                 {{0,0,0,0,0,0,0,0,0}}, {{0,0,0,0,0,0,0,0,0}}, {{0,0,0,0,0,0,0,0,0}},
                 {{0,0,0,0,0,0,0,0,0}}, {{0,0,0,0,0,0,0,0,0}}, {{0,0,0,0,0,0,0,0,0}}}};
     bool valid = true;
-    std::string solutionLine;
+    auto& solutionLine = buffer.solutionLine;
+    auto& rowLine = buffer.rowLine;
+    solutionLine.clear();
     solutionLine.reserve(Sudoku::CacheGuardSize);
+    rowLine.reserve(Sudoku::CacheGuardSize);
 
-    std::istringstream is(solution);
+    // Reads rows without std::istringstream which copies the solution
+    size_t rowPos = 0;
     for(SudokuIndex row = 0; valid && (row < Sudoku::SizeOfGroupsPerMap); ++row) {
-        std::string rowLine;
-        rowLine.reserve(Sudoku::CacheGuardSize);
+        rowLine.clear();
+        if (rowPos < solution.size()) {
+            const auto newlinePos = solution.find('\n', rowPos);
+            const auto rowEnd = (newlinePos == std::string::npos) ? solution.size() : newlinePos;
+            rowLine.assign(solution, rowPos, rowEnd - rowPos);
+            rowPos = rowEnd + 1;
+        }
 
-        getline(is, rowLine);
         if (rowLine.empty()) {
             valid = false;
             break;
@@ -1647,12 +5053,11 @@ bool SudokuChecker::compare(const std::string& puzzle, const std::string& soluti
         return false;
     }
 
-    std::string fullPuzzle = puzzle;
-    fullPuzzle.resize(solution.size(), '.');
     bool valid = true;
 
     for(SudokuIndex i=0; valid && (i < Sudoku::SizeOfAllCells); ++i) {
-        const char c = fullPuzzle.at(i);
+        // Pads a short puzzle with blank cells
+        const char c = (i < puzzle.size()) ? puzzle.at(i) : '.';
 #if __cplusplus >= 201703L
         const auto [converted, num] = Sudoku::ConvertCharToSudokuCandidate(
             Sudoku::MinCandidatesNumber, Sudoku::MaxCandidatesNumber, c);
@@ -1792,55 +5197,553 @@ bool SudokuChecker::checkUnique(const Group& line) {
         if (cellMap.at(n)) {
             return false;
         }
-        cellMap.at(n) = 1;
+        cellMap.at(n) = 1;
+    }
+
+    return true;
+}
+
+// Define static constexpr members to refer them before C++17
+constexpr size_t SudokuPuzzleChunkQueue::MinChunkSize;
+constexpr size_t SudokuPuzzleChunkQueue::ChunkDivisor;
+
+// Splits puzzles into contiguous chunks for workers
+SudokuPuzzleChunkQueue::SudokuPuzzleChunkQueue(size_t sizeOfPuzzle, size_t numberOfWorkers) {
+    numberOfWorkers = std::max(numberOfWorkers, static_cast<size_t>(1));
+    for(size_t i=0; i<numberOfWorkers; ++i) {
+        std::unique_ptr<Worker> pWorker(new Worker);
+        const auto begin = sizeOfPuzzle * i / numberOfWorkers;
+        const auto end = sizeOfPuzzle * (i + 1) / numberOfWorkers;
+        if (begin < end) {
+            pWorker->chunkSet.push_back(Chunk(begin, end));
+        }
+        workerSet_.push_back(std::move(pWorker));
+    }
+    return;
+}
+
+bool SudokuPuzzleChunkQueue::Pop(size_t workerIndex, Chunk& chunk) {
+    auto& worker = *workerSet_.at(workerIndex);
+    if (popFront(worker, chunk)) {
+        return true;
+    }
+
+    Chunk stolenChunk;
+    if (!steal(workerIndex, stolenChunk)) {
+        return false;
+    }
+
+    // Other workers can steal a part of the stolen chunk in turn
+    {
+        LockGuard lock(worker.mutex);
+        worker.chunkSet.push_back(stolenChunk);
+    }
+    return popFront(worker, chunk);
+}
+
+// Takes a part of the front chunk of a worker
+bool SudokuPuzzleChunkQueue::popFront(Worker& worker, Chunk& chunk) {
+    LockGuard lock(worker.mutex);
+    if (worker.chunkSet.empty()) {
+        return false;
+    }
+
+    auto& front = worker.chunkSet.front();
+    const auto size = front.second - front.first;
+    const auto takenSize = std::min(size, std::max(MinChunkSize, size / ChunkDivisor));
+    chunk = Chunk(front.first, front.first + takenSize);
+    front.first += takenSize;
+    if (front.first >= front.second) {
+        worker.chunkSet.pop_front();
+    }
+    return true;
+}
+
+// Steals the latter half of the largest back chunk in other workers
+bool SudokuPuzzleChunkQueue::steal(size_t workerIndex, Chunk& chunk) {
+    for(;;) {
+        size_t victimIndex = workerIndex;
+        size_t largestSize = 0;
+        for(size_t i=1; i<workerSet_.size(); ++i) {
+            const auto index = (workerIndex + i) % workerSet_.size();
+            auto& worker = *workerSet_.at(index);
+            LockGuard lock(worker.mutex);
+            if (!worker.chunkSet.empty()) {
+                const auto& back = worker.chunkSet.back();
+                const auto size = back.second - back.first;
+                if (largestSize < size) {
+                    largestSize = size;
+                    victimIndex = index;
+                }
+            }
+        }
+
+        if (victimIndex == workerIndex) {
+            return false;
+        }
+
+        // The victim may have taken the chunk after the scan above
+        auto& victim = *workerSet_.at(victimIndex);
+        LockGuard lock(victim.mutex);
+        if (victim.chunkSet.empty()) {
+            continue;
+        }
+
+        auto& back = victim.chunkSet.back();
+        const auto size = back.second - back.first;
+        if (size <= MinChunkSize) {
+            chunk = back;
+            victim.chunkSet.pop_back();
+        } else {
+            const auto middle = back.first + size / 2;
+            chunk = Chunk(middle, back.second);
+            back.second = middle;
+        }
+        return true;
+    }
+}
+
+const std::string& SudokuReusableStringBuffer::GetString(void) const {
+    return str_;
+}
+
+void SudokuReusableStringBuffer::Clear(void) {
+    str_.clear();
+    return;
+}
+
+SudokuReusableStringBuffer::int_type SudokuReusableStringBuffer::overflow(int_type c) {
+    if (!traits_type::eq_int_type(c, traits_type::eof())) {
+        str_.push_back(traits_type::to_char_type(c));
+    }
+    return traits_type::not_eof(c);
+}
+
+std::streamsize SudokuReusableStringBuffer::xsputn(const char_type* s, std::streamsize n) {
+    str_.append(s, static_cast<size_t>(n));
+    return n;
+}
+
+SudokuDispatcherWorkspace::SudokuDispatcherWorkspace(void)
+    : solutionStream_(&solutionBuffer_), messageStream_(&messageBuffer_),
+      solver_("", 0, &solutionStream_, 0), sseSolver_("", &solutionStream_, 0),
+#if defined(SUDOKU_SOA_MAP)
+      soaSolver_("", &solutionStream_),
+#endif
+      sseIntrinsicsSolver_("", &solutionStream_), bitplaneSolver_("", &solutionStream_) {
+    return;
+}
+
+// Returns a solver of the type which writes its solution to solutionStream_
+SudokuBaseSolver& SudokuDispatcherWorkspace::resetSolver(SudokuSolverType solverType, const std::string& puzzleLine) {
+    SudokuBaseSolver* pSolver = &solver_;
+    switch(solverType) {
+    case SudokuSolverType::SOLVER_SSE_4_2:
+        pSolver = &sseSolver_;
+        break;
+#if defined(SUDOKU_SOA_MAP)
+    case SudokuSolverType::SOLVER_SOA:
+        pSolver = &soaSolver_;
+        break;
+#endif
+    case SudokuSolverType::SOLVER_SSE_INTRINSICS:
+        pSolver = &sseIntrinsicsSolver_;
+        break;
+    case SudokuSolverType::SOLVER_BITPLANE:
+        pSolver = &bitplaneSolver_;
+        break;
+    default:
+        break;
+    }
+
+    pSolver->Reset(puzzleLine);
+    return *pSolver;
+}
+
+SudokuDispatcher::SudokuDispatcher(SudokuSolverType solverType, SudokuSolverCheck check, SudokuSolverPrint print,
+                                   SudokuPatternCount printAllCandidate, SudokuPuzzleCount puzzleNum,
+                                   const std::string& puzzleLine)
+    : solverType_(solverType), check_(check), print_(print),
+      printAllCandidate_(printAllCandidate), puzzleNum_(puzzleNum), pPuzzleLine_(nullptr), pPuzzleRecord_(nullptr),
+      sizeOfPuzzleLine_(puzzleLine.size()), puzzleLine_(puzzleLine), stepCount_(0), guessCount_(0) {
+    return;
+}
+
+SudokuDispatcher::SudokuDispatcher(SudokuSolverType solverType, SudokuSolverCheck check, SudokuSolverPrint print,
+                                   SudokuPatternCount printAllCandidate, SudokuPuzzleCount puzzleNum,
+                                   const char* pPuzzleLine, size_t sizeOfPuzzleLine)
+    : solverType_(solverType), check_(check), print_(print),
+      printAllCandidate_(printAllCandidate), puzzleNum_(puzzleNum), pPuzzleLine_(pPuzzleLine), pPuzzleRecord_(nullptr),
+      sizeOfPuzzleLine_(sizeOfPuzzleLine), stepCount_(0), guessCount_(0) {
+    return;
+}
+
+SudokuDispatcher::SudokuDispatcher(SudokuSolverType solverType, SudokuSolverCheck check, SudokuSolverPrint print,
+                                   SudokuPatternCount printAllCandidate, SudokuPuzzleCount puzzleNum,
+                                   const uint8_t* pPuzzleRecord)
+    : solverType_(solverType), check_(check), print_(print),
+      printAllCandidate_(printAllCandidate), puzzleNum_(puzzleNum), pPuzzleLine_(nullptr), pPuzzleRecord_(pPuzzleRecord),
+      sizeOfPuzzleLine_(Sudoku::SizeOfAllCells), stepCount_(0), guessCount_(0) {
+    return;
+}
+
+bool SudokuDispatcher::Exec(void) {
+    SudokuDispatcherWorkspace workspace;
+    return Exec(workspace);
+}
+
+// Solves a 9x9 puzzle with a solver in the workspace
+bool SudokuDispatcher::Exec(SudokuDispatcherWorkspace& workspace) {
+    const auto& puzzleLine = getPuzzleLine(workspace.puzzleLine_);
+    switch(GetBoxSize()) {
+    case 4:
+#if defined(SUDOKU_SOA_MAP)
+        // All solvers except the C++ solver use AVX2 to solve 16x16 puzzles
+        if (solverType_ != SudokuSolverType::SOLVER_GENERAL) {
+            return execGrid<SudokuSoa16Solver>(puzzleLine);
+        }
+#endif
+        return execGrid<SudokuGridSolver<4>>(puzzleLine);
+    case 5:
+        return execGrid<SudokuGridSolver<5>>(puzzleLine);
+    default:
+        break;
+    }
+
+    if (check_ == SudokuSolverCheck::CHECK_UNIQUE) {
+        // Counts solutions with the SSE solver of any solver type
+        auto& solver = workspace.sseSolver_;
+        solver.Reset(puzzleLine);
+        return checkUnique(solver, puzzleLine);
+    }
+
+    return exec(workspace.resetSolver(solverType_, puzzleLine), puzzleLine, workspace);
+}
+
+void SudokuDispatcher::Preset(SudokuSseMap& map, SudokuDispatcherWorkspace& workspace) {
+    if (pPuzzleRecord_ != nullptr) {
+        map.PresetRecord(pPuzzleRecord_);
+        return;
+    }
+
+    map.Preset(getPuzzleLine(workspace.puzzleLine_));
+    return;
+}
+
+// Checks a puzzle solved by SudokuSseLaneSolver
+bool SudokuDispatcher::Exec(const SudokuSseMap& map, SudokuDispatcherWorkspace& workspace) {
+    workspace.solutionBuffer_.Clear();
+    map.Print(&workspace.solutionStream_);
+    return check(getPuzzleLine(workspace.puzzleLine_), workspace);
+}
+
+// Returns 4 for 16x16 and 5 for 25x25 puzzles in lines longer than 9x9 puzzles
+SudokuIndex SudokuDispatcher::GetBoxSize(void) const {
+    if (sizeOfPuzzleLine_ >= SudokuGeometry<5>::SizeOfAllCells) {
+        return 5;
+    }
+    if (sizeOfPuzzleLine_ >= SudokuGeometry<4>::SizeOfAllCells) {
+        return 4;
+    }
+    return Sudoku::SizeOfCellsOnBoxEdge;
+}
+
+// Returns how many times a solver filled cells of this puzzle
+// (zero if this dispatcher did not solve it by itself).
+SudokuPatternCount SudokuDispatcher::GetStepCount(void) const {
+    return stepCount_;
+}
+
+// Returns how many times a solver guessed candidates of the puzzle
+SudokuPatternCount SudokuDispatcher::GetGuessCount(void) const {
+    return guessCount_;
+}
+
+// Solves a puzzle larger than 9x9 and checks its solution without SudokuChecker
+template <typename Solver>
+bool SudokuDispatcher::execGrid(const std::string& puzzleLine) {
+    std::ostringstream ss;
+    Solver solver(puzzleLine, &ss);
+    if (check_ == SudokuSolverCheck::CHECK_UNIQUE) {
+        return checkUnique(solver, puzzleLine);
+    }
+
+    solver.Exec(false, false);
+    stepCount_ = static_cast<SudokuPatternCount>(solver.GetStepCount());
+    guessCount_ = static_cast<SudokuPatternCount>(solver.GetGuessCount());
+    bool failed = false;
+
+    if ((check_ == SudokuSolverCheck::CHECK) || (print_ == SudokuSolverPrint::PRINT)) {
+        std::ostringstream os;
+        if (!solver.IsSolutionOf(puzzleLine)) {
+            os << "Error in case " << puzzleNum_ << "\n" << puzzleLine << "\n" << ss.str();
+            failed = true;
+        } else if (print_ == SudokuSolverPrint::PRINT) {
+            // Writes cells in a line without separators
+            auto solution = ss.str();
+            solution.erase(std::remove_if(solution.begin(), solution.end(),
+                                          [](char c) { return (c == ':') || (c == '\n'); }), solution.end());
+            os << solution << "\n";
+        }
+        message_ = os.str();
+    }
+
+    return failed;
+}
+
+// The solver writes its solution to the solution stream in the workspace
+bool SudokuDispatcher::exec(SudokuBaseSolver& solver, const std::string& puzzleLine,
+                            SudokuDispatcherWorkspace& workspace) {
+    workspace.solutionBuffer_.Clear();
+    solver.Exec(false, false);
+    stepCount_ = static_cast<SudokuPatternCount>(solver.GetStepCount());
+    guessCount_ = static_cast<SudokuPatternCount>(solver.GetGuessCount());
+    return check(puzzleLine, workspace);
+}
+
+// Copies the message only if it is not empty
+bool SudokuDispatcher::check(const std::string& puzzleLine, SudokuDispatcherWorkspace& workspace) {
+    bool failed = false;
+
+    if ((check_ == SudokuSolverCheck::CHECK) || (print_ == SudokuSolverPrint::PRINT)) {
+        const auto& solution = workspace.solutionBuffer_.GetString();
+        auto& os = workspace.messageStream_;
+        workspace.messageBuffer_.Clear();
+        SudokuChecker checker(puzzleLine, solution, print_, &os, workspace.checkerBuffer_);
+        if (!checker.Valid()) {
+            os << "Error in case " << puzzleNum_ << "\n" << puzzleLine << "\n" << solution;
+            failed = true;
+        }
+        message_ = workspace.messageBuffer_.GetString();
+    }
+
+    return failed;
+}
+
+// Writes a puzzle and whether it has no, a unique or multiple solutions in a line
+template <typename Solver>
+bool SudokuDispatcher::checkUnique(Solver& solver, const std::string& puzzleLine) {
+    constexpr SudokuPatternCount maxCount = 2;
+    static_assert(arraySizeof(SudokuOption::UniquenessVerdictSet) == (maxCount + 1), "Unexpected verdicts");
+
+    // Allocates the line at once
+    const auto patternCount = solver.CountUpTo(maxCount);
+    const auto verdict = SudokuOption::UniquenessVerdictSet[patternCount];
+    message_.reserve(puzzleLine.size() + std::strlen(verdict) + 2);
+    message_ = puzzleLine;
+    message_ += " ";
+    message_ += verdict;
+    message_ += "\n";
+    return false;
+}
+
+const std::string& SudokuDispatcher::GetMessage(void) const {
+    return message_;
+}
+
+// Copies a puzzle in a mapped file to the buffer in a thread that solves it,
+// not in a thread that finds it, and returns the copied or held puzzle
+const std::string& SudokuDispatcher::getPuzzleLine(std::string& buffer) const {
+    if (pPuzzleLine_ != nullptr) {
+        buffer.assign(pPuzzleLine_, sizeOfPuzzleLine_);
+        return buffer;
+    }
+
+    if (pPuzzleRecord_ != nullptr) {
+        SudokuPuzzleRecord::Decode(pPuzzleRecord_, buffer);
+        return buffer;
+    }
+
+    return puzzleLine_;
+}
+
+// Define static constexpr members to refer them before C++17
+constexpr size_t SudokuPuzzleRecord::SizeOfHeader;
+constexpr size_t SudokuPuzzleRecord::SizeOfRecord;
+constexpr uint16_t SudokuPuzzleRecord::Version;
+constexpr char SudokuPuzzleRecord::Magic[];
+constexpr size_t SudokuPuzzleRecord::SizeOfMagic;
+
+bool SudokuPuzzleRecord::IsRecordFile(const char* pData, size_t size) {
+    return (pData != nullptr) && (size >= SizeOfMagic) && (std::memcmp(pData, Magic, SizeOfMagic) == 0);
+}
+
+// Takes characters only while they match the magic and the rest of the first line otherwise
+bool SudokuPuzzleRecord::IsRecordStream(std::istream& is, std::string& firstLine) {
+    firstLine.clear();
+    while((firstLine.size() < SizeOfMagic) && (is.peek() == Magic[firstLine.size()])) {
+        firstLine.push_back(static_cast<char>(is.get()));
+    }
+
+    if (firstLine.size() == SizeOfMagic) {
+        return true;
+    }
+
+    std::string lineStr;
+    getline(is, lineStr);
+    firstLine += lineStr;
+    return false;
+}
+
+// The header holds the magic, version, cells per record and number of records in little endian
+bool SudokuPuzzleRecord::GetSize(const char* pData, size_t size, SudokuPuzzleCount& sizeOfRecords) {
+    sizeOfRecords = 0;
+    if (!IsRecordFile(pData, size) || (size < SizeOfHeader)) {
+        return false;
+    }
+
+    auto readValue = [pData](size_t offset, size_t sizeOfValue) {
+        uint64_t value = 0;
+        for(size_t i = sizeOfValue; i > 0; --i) {
+            value = (value << 8) | static_cast<uint8_t>(pData[offset + i - 1]);
+        }
+        return value;
+    };
+
+    const auto sizeInHeader = readValue(8, 8);
+    if ((readValue(4, 2) != Version) || (readValue(6, 2) != Sudoku::SizeOfAllCells) ||
+        (sizeInHeader > ((size - SizeOfHeader) / SizeOfRecord))) {
+        return false;
+    }
+
+    sizeOfRecords = static_cast<SudokuPuzzleCount>(sizeInHeader);
+    return true;
+}
+
+const uint8_t* SudokuPuzzleRecord::GetRecord(const char* pData, SudokuPuzzleCount index) {
+    return reinterpret_cast<const uint8_t*>(pData + SizeOfHeader + index * SizeOfRecord);
+}
+
+// A record holds a cell with an even index in the lower four bits of a byte
+SudokuIndex SudokuPuzzleRecord::GetNumber(const uint8_t* pRecord, SudokuIndex cellIndex) {
+    const auto byte = pRecord[cellIndex / 2];
+    const SudokuIndex num = ((cellIndex % 2) == 0) ? (byte & 0xf) : (byte >> 4);
+    return (num <= Sudoku::SizeOfCandidates) ? num : 0;
+}
+
+void SudokuPuzzleRecord::WriteHeader(SudokuPuzzleCount sizeOfRecords, std::string& header) {
+    header.assign(Magic, SizeOfMagic);
+    auto writeValue = [&header](uint64_t value, size_t sizeOfValue) {
+        for(size_t i = 0; i < sizeOfValue; ++i) {
+            header.push_back(static_cast<char>(value & 0xff));
+            value >>= 8;
+        }
+    };
+
+    writeValue(Version, 2);
+    writeValue(Sudoku::SizeOfAllCells, 2);
+    writeValue(sizeOfRecords, 8);
+    return;
+}
+
+bool SudokuPuzzleRecord::Encode(const std::string& puzzleLine, Record& record) {
+    record.assign(SizeOfRecord, 0);
+    if (puzzleLine.size() >= SudokuGeometry<4>::SizeOfAllCells) {
+        return false;
+    }
+
+    for(SudokuIndex i = 0; (i < Sudoku::SizeOfAllCells) && (i < puzzleLine.size()); ++i) {
+        const auto c = puzzleLine.at(i);
+        if ((c >= '1') && (c <= '9')) {
+            const auto num = static_cast<uint8_t>(c - '0');
+            record.at(i / 2) |= ((i % 2) == 0) ? num : static_cast<uint8_t>(num << 4);
+        }
     }
 
     return true;
 }
 
-SudokuDispatcher::SudokuDispatcher(SudokuSolverType solverType, SudokuSolverCheck check, SudokuSolverPrint print,
-                                   SudokuPatternCount printAllCandidate, SudokuPuzzleCount puzzleNum,
-                                   const std::string& puzzleLine)
-    : solverType_(solverType), check_(check), print_(print),
-      printAllCandidate_(printAllCandidate), puzzleNum_(puzzleNum), puzzleLine_(puzzleLine) {
+void SudokuPuzzleRecord::Decode(const uint8_t* pRecord, std::string& puzzleLine) {
+    puzzleLine.resize(Sudoku::SizeOfAllCells);
+    for(SudokuIndex i = 0; i < Sudoku::SizeOfAllCells; ++i) {
+        const auto num = GetNumber(pRecord, i);
+        puzzleLine.at(i) = (num > 0) ? static_cast<char>('0' + num) : '.';
+    }
     return;
 }
 
-bool SudokuDispatcher::Exec(void) {
-    std::ostringstream ss;
-    if (solverType_ == SudokuSolverType::SOLVER_SSE_4_2) {
-        SudokuSseSolver solver(puzzleLine_, &ss, printAllCandidate_);
-        return exec(solver, ss);
-    }
-
-    SudokuSolver solver(puzzleLine_, 0, &ss, printAllCandidate_);
-    return exec(solver, ss);
+SudokuPuzzleLineParser::SudokuPuzzleLineParser(const char* pData, size_t size)
+    : pData_(pData), size_((pData == nullptr) ? 0 : size), offset_(0) {
+    return;
 }
 
-bool SudokuDispatcher::exec(SudokuBaseSolver& solver, std::ostringstream& ss) {
-    bool failed = false;
-    solver.Exec(false, false);
+// Finds lines in a window that starts at the end of the previous window and ends at a newline
+// after sizeOfWindow bytes
+bool SudokuPuzzleLineParser::Parse(size_t sizeOfWindow, size_t numberOfRanges,
+                                   Sudoku::BaseParallelRunner& runner, LineSet& lineSet) {
+    lineSet.clear();
+    if (offset_ >= size_) {
+        return false;
+    }
 
-    if ((check_ == SudokuSolverCheck::CHECK) || (print_ == SudokuSolverPrint::PRINT)) {
-        std::ostringstream os;
-        SudokuChecker checker(puzzleLine_, ss.str(), print_, &os);
-        if (!checker.Valid()) {
-            os << "Error in case " << puzzleNum_ << "\n" << puzzleLine_ << "\n" << ss.str();
-            failed = true;
+    const char* pBegin = pData_ + offset_;
+    const char* pDataEnd = pData_ + size_;
+    const char* pEnd = pBegin + std::min(std::max(sizeOfWindow, static_cast<size_t>(1)), size_ - offset_);
+    if ((pEnd < pDataEnd) && (*(pEnd - 1) != '\n')) {
+        const auto pNewline = static_cast<const char*>(std::memchr(pEnd, '\n', pDataEnd - pEnd));
+        pEnd = (pNewline != nullptr) ? (pNewline + 1) : pDataEnd;
+    }
+
+    numberOfRanges = std::max(numberOfRanges, static_cast<size_t>(1));
+    const size_t sizeOfBytes = pEnd - pBegin;
+    const size_t sizeOfRange = (sizeOfBytes + numberOfRanges - 1) / numberOfRanges;
+    rangeLineSet_.resize(numberOfRanges);
+
+    for(size_t i = 0; i < numberOfRanges; ++i) {
+        const char* pRangeBegin = pBegin + std::min(sizeOfBytes, sizeOfRange * i);
+        const char* pRangeEnd = pBegin + std::min(sizeOfBytes, sizeOfRange * (i + 1));
+        auto& rangeLineSet = rangeLineSet_.at(i);
+        Sudoku::BaseParallelRunner::Evaluator evaluator = [pBegin, pRangeBegin, pRangeEnd, pEnd, &rangeLineSet] {
+            findLines(pBegin, pRangeBegin, pRangeEnd, pEnd, rangeLineSet);
+            return false;
+        };
+        runner.Add(evaluator);
+    }
+    runner.Run(static_cast<Sudoku::BaseParallelRunner::NumberOfCores>(numberOfRanges));
+
+    offset_ = pEnd - pData_;
+    for(const auto& rangeLineSet : rangeLineSet_) {
+        for(const auto& line : rangeLineSet) {
+            // Stops at an empty line as reading lines from a stream
+            if (line.second == 0) {
+                offset_ = size_;
+                return false;
+            }
+            lineSet.push_back(line);
         }
-        message_ = os.str();
     }
 
-    return failed;
+    return (offset_ < size_);
 }
 
-const std::string& SudokuDispatcher::GetMessage(void) const {
-    return message_;
+// Finds lines whose first bytes are in [pRangeBegin, pRangeEnd) of a window [pBegin, pEnd)
+void SudokuPuzzleLineParser::findLines(const char* pBegin, const char* pRangeBegin, const char* pRangeEnd,
+                                       const char* pEnd, LineSet& lineSet) {
+    lineSet.clear();
+    const char* pLine = pRangeBegin;
+
+    // Skips a line that starts in the previous range
+    if ((pLine != pBegin) && (pLine < pRangeEnd) && (*(pLine - 1) != '\n')) {
+        const auto pNewline = static_cast<const char*>(std::memchr(pLine, '\n', pRangeEnd - pLine));
+        pLine = (pNewline != nullptr) ? (pNewline + 1) : pRangeEnd;
+    }
+
+    while(pLine < pRangeEnd) {
+        const auto pNewline = static_cast<const char*>(std::memchr(pLine, '\n', pEnd - pLine));
+        if (pNewline == nullptr) {
+            lineSet.push_back(Line(pLine, pEnd - pLine));
+            break;
+        }
+        lineSet.push_back(Line(pLine, pNewline - pLine));
+        pLine = pNewline + 1;
+    }
+
+    return;
 }
 
 SudokuMultiDispatcher::SudokuMultiDispatcher(SudokuSolverType solverType, SudokuSolverCheck check, SudokuSolverPrint print,
                                              SudokuPatternCount printAllCandidate)
-    : solverType_(solverType), check_(check), print_(print), printAllCandidate_(printAllCandidate) {
+    : laneStepCount_(0), laneGuessCount_(0), solverType_(solverType), check_(check), print_(print), printAllCandidate_(printAllCandidate) {
     return;
 }
 
@@ -1849,11 +5752,83 @@ void SudokuMultiDispatcher::AddPuzzle(SudokuPuzzleCount puzzleNum, const std::st
     return;
 }
 
+// The puzzle must live until solving it
+void SudokuMultiDispatcher::AddPuzzle(SudokuPuzzleCount puzzleNum, const char* pPuzzleLine, size_t sizeOfPuzzleLine) {
+    dipatcherSet_.push_back(SudokuDispatcher(solverType_, check_, print_, printAllCandidate_, puzzleNum,
+                                             pPuzzleLine, sizeOfPuzzleLine));
+    return;
+}
+
+// The record must live until solving it
+void SudokuMultiDispatcher::AddRecord(SudokuPuzzleCount puzzleNum, const uint8_t* pPuzzleRecord) {
+    dipatcherSet_.push_back(SudokuDispatcher(solverType_, check_, print_, printAllCandidate_, puzzleNum, pPuzzleRecord));
+    return;
+}
+
 bool SudokuMultiDispatcher::ExecAll(void) {
+    return ExecRange(0, dipatcherSet_.size());
+}
+
+// Solves puzzles in [begin, end)
+bool SudokuMultiDispatcher::ExecRange(size_t begin, size_t end) {
+    SudokuDispatcherWorkspace workspace;
+    return ExecRange(begin, end, workspace);
+}
+
+// A thread passes its own workspace to solve puzzles without allocating memory for each puzzle
+bool SudokuMultiDispatcher::ExecRange(size_t begin, size_t end, SudokuDispatcherWorkspace& workspace) {
+    end = std::min(end, dipatcherSet_.size());
+    if ((solverType_ == SudokuSolverType::SOLVER_SSE_4_2) && (check_ != SudokuSolverCheck::CHECK_UNIQUE) &&
+        !Sudoku::UsesSubsetElimination() && (Sudoku::GetValueOrder() == SudokuValueOrder::ASCENDING) &&
+        SudokuSseLaneSolver::CanSolve()) {
+        return execLanes(begin, end, workspace);
+    }
+
+    bool failed = false;
+
+    for(size_t i=begin; i<end; ++i) {
+        failed |= dipatcherSet_.at(i).Exec(workspace);
+    }
+
+    return failed;
+}
+
+// Returns the number of puzzles
+size_t SudokuMultiDispatcher::GetSize(void) const {
+    return dipatcherSet_.size();
+}
+
+// Solves multiple puzzles at once and checks them
+bool SudokuMultiDispatcher::execLanes(size_t begin, size_t end, SudokuDispatcherWorkspace& workspace) {
+    // Solves puzzles larger than 9x9 one by one
     bool failed = false;
+    auto& laneIndexSet = workspace.laneIndexSet_;
+    laneIndexSet.clear();
+    for(size_t i=begin; i<end; ++i) {
+        if (dipatcherSet_.at(i).GetBoxSize() != Sudoku::SizeOfCellsOnBoxEdge) {
+            failed |= dipatcherSet_.at(i).Exec(workspace);
+        } else {
+            laneIndexSet.push_back(i);
+        }
+    }
 
-    for(auto& dipatcher : dipatcherSet_) {
-        failed |= dipatcher.Exec();
+    // Keeps the capacity of the vector and resets maps that previous puzzles changed
+    auto& mapSet = workspace.mapSet_;
+    mapSet.assign(laneIndexSet.size(), SudokuSseMap());
+    for(size_t i=0; i<laneIndexSet.size(); ++i) {
+        dipatcherSet_.at(laneIndexSet.at(i)).Preset(mapSet.at(i), workspace);
+    }
+
+    // The solver counts steps and guesses of previous ranges
+    auto& solver = workspace.laneSolver_;
+    const auto stepCount = solver.GetStepCount();
+    const auto guessCount = solver.GetGuessCount();
+    solver.Solve(mapSet);
+    laneStepCount_ += solver.GetStepCount() - stepCount;
+    laneGuessCount_ += solver.GetGuessCount() - guessCount;
+
+    for(size_t i=0; i<laneIndexSet.size(); ++i) {
+        failed |= dipatcherSet_.at(laneIndexSet.at(i)).Exec(mapSet.at(i), workspace);
     }
 
     return failed;
@@ -1864,15 +5839,38 @@ const std::string& SudokuMultiDispatcher::GetMessage(size_t index) const {
     return dipatcherSet_.at(index).GetMessage();
 }
 
+// Returns how many times solvers filled cells of all puzzles
+SudokuPatternCount SudokuMultiDispatcher::GetStepCount(void) const {
+    SudokuPatternCount stepCount = laneStepCount_;
+    for(const auto& dipatcher : dipatcherSet_) {
+        stepCount += dipatcher.GetStepCount();
+    }
+    return stepCount;
+}
+
+// Returns how many times solvers guessed candidates of all puzzles
+SudokuPatternCount SudokuMultiDispatcher::GetGuessCount(void) const {
+    SudokuPatternCount guessCount = laneGuessCount_;
+    for(const auto& dipatcher : dipatcherSet_) {
+        guessCount += dipatcher.GetGuessCount();
+    }
+    return guessCount;
+}
+
+// Define static constexpr members to refer them before C++17
+constexpr SudokuPuzzleCount SudokuLoader::InitialWindowSize;
+constexpr SudokuPuzzleCount SudokuLoader::MaxWindowSize;
+
 const SudokuLoader::ExitStatusCode SudokuLoader::ExitStatusPassed = 0;
 const SudokuLoader::ExitStatusCode SudokuLoader::ExitStatusFailed = 1;
 
 SudokuLoader::SudokuLoader(int argc, const char * const argv[], std::istream* pSudokuInStream,
                            std::ostream* pSudokuOutStream)
     : pParallelRunner_(Sudoku::CreateParallelRunner()), numberOfThreads_(DefaultNumberOfThreads),
+      splitDepth_(SudokuSseParallelEnumerator::DefaultSplitDepth),
       solverType_(SudokuSolverType::SOLVER_GENERAL), check_(SudokuSolverCheck::CHECK),
-      print_(SudokuSolverPrint::DO_NOT_PRINT),
-      isBenchmark_(false), verbose_(true), measureCount_(1), printAllCandidate_(0), pSudokuOutStream_(nullptr) {
+      print_(SudokuSolverPrint::DO_NOT_PRINT), isa_(Sudoku::GetFastestIsa()), isaSpecified_(false), findSubsets_(false),
+      branchPolicy_(SudokuBranchPolicy::FIXED_GROUP), valueOrder_(SudokuValueOrder::ASCENDING), printSteps_(false), isBenchmark_(false), verbose_(true), measureCount_(1), printAllCandidate_(0), pSudokuInStream_(pSudokuInStream), pSudokuOutStream_(nullptr) {
     static_assert(std::is_convertible<NumberOfCores, size_t>::value == true, "Too narrow");
 
     if (pSudokuOutStream == nullptr) {
@@ -1893,10 +5891,21 @@ SudokuLoader::SudokuLoader(int argc, const char * const argv[], std::istream* pS
         setSingleMode(argc, argv, pSudokuInStream);
     }
 
+    selectIsa();
+    Sudoku::SetSubsetElimination(findSubsets_);
+    Sudoku::SetBranchPolicy(branchPolicy_);
+    Sudoku::SetValueOrder(valueOrder_);
     return;
 }
 
 int SudokuLoader::Exec(void) {
+    if (!invalidArg_.empty()) {
+        if (pSudokuOutStream_ != nullptr) {
+            *pSudokuOutStream_ << "Invalid argument " << invalidArg_ << "\n";
+        }
+        return ExitStatusFailed;
+    }
+
     return (multiLineFilename_.empty()) ? execSingle() : execMulti();
 }
 
@@ -1940,11 +5949,20 @@ void SudokuLoader::setSingleMode(int argc, const char * const argv[], std::istre
             }
         }
 
-        if (argc > 2) {
+        // Options to count solutions on multiple threads can follow the count
+        auto foundCount = false;
+        for(int argIndex = 2; argc > argIndex; ++argIndex) {
+            if (setNumberOfThreads(argc, argv, argIndex) || setSplitDepth(argc, argv, argIndex) ||
+                setIsa(argc, argv, argIndex) || setSubsets(argc, argv, argIndex) ||
+                setBranchPolicy(argc, argv, argIndex) || setValueOrder(argc, argv, argIndex) || foundCount) {
+                continue;
+            }
+
             int patternCount = 0;
-            std::istringstream candidateStream(argv[2]);
+            std::istringstream candidateStream(argv[argIndex]);
             candidateStream >> patternCount;
             printAllCandidate_ = (patternCount >= 0) ? patternCount : 0;
+            foundCount = true;
         }
     }
 
@@ -1973,9 +5991,12 @@ bool SudokuLoader::setMultiMode(int argc, const char * const argv[]) {
         return result;
     }
 
-    std::ifstream is(argv[1]);
-    if (!is.good()) {
-        return result;
+    // Reads puzzles from stdin or pipes
+    if ((argv[1] == nullptr) || (std::string(argv[1]) != SudokuOption::CommandLineArgStdin)) {
+        std::ifstream is(argv[1]);
+        if (!is.good()) {
+            return result;
+        }
     }
 
     multiLineFilename_ = argv[1];
@@ -1984,7 +6005,9 @@ bool SudokuLoader::setMultiMode(int argc, const char * const argv[]) {
     int argIndex = 2;
     int valueIndex = 2;
     for(;argc > argIndex; ++argIndex) {
-        if (setNumberOfThreads(argc, argv, argIndex)) {
+        if (setNumberOfThreads(argc, argv, argIndex) || setIsa(argc, argv, argIndex) ||
+            setSubsets(argc, argv, argIndex) || setBranchPolicy(argc, argv, argIndex) ||
+            setValueOrder(argc, argv, argIndex) || setSteps(argc, argv, argIndex)) {
             continue;
         }
 
@@ -1992,12 +6015,22 @@ bool SudokuLoader::setMultiMode(int argc, const char * const argv[]) {
         case 2:
             SudokuOption::setMode(argc, argv, argIndex, SudokuOption::CommandLineArgSseSolver,
                                   solverType_, SudokuSolverType::SOLVER_SSE_4_2);
+#if defined(SUDOKU_SOA_MAP)
+            SudokuOption::setMode(argc, argv, argIndex, SudokuOption::CommandLineArgSoaSolver,
+                                  solverType_, SudokuSolverType::SOLVER_SOA);
+#endif
+            SudokuOption::setMode(argc, argv, argIndex, SudokuOption::CommandLineArgSseIntrinsicsSolver,
+                                  solverType_, SudokuSolverType::SOLVER_SSE_INTRINSICS);
+            SudokuOption::setMode(argc, argv, argIndex, SudokuOption::CommandLineArgBitplaneSolver,
+                                  solverType_, SudokuSolverType::SOLVER_BITPLANE);
             break;
         case 3:
             SudokuOption::setMode(argc, argv, argIndex, SudokuOption::CommandLineNoChecking,
                                   check_, SudokuSolverCheck::DO_NOT_CHECK);
             SudokuOption::setMode(argc, argv, argIndex, SudokuOption::CommandLinePrint,
                                   print_, SudokuSolverPrint::PRINT);
+            SudokuOption::setMode(argc, argv, argIndex, SudokuOption::CommandLineCheckUnique,
+                                  check_, SudokuSolverCheck::CHECK_UNIQUE);
             break;
         default:
             break;
@@ -2025,6 +6058,148 @@ bool SudokuLoader::setNumberOfThreads(int argc, const char * const argv[], int a
     return true;
 }
 
+// Returns true if an argument designates how many blank cells are filled before counting solutions in parallel
+bool SudokuLoader::setSplitDepth(int argc, const char * const argv[], int argIndex) {
+    if ((argc <= argIndex) || (argv[argIndex] == nullptr)) {
+        return false;
+    }
+
+    const std::string header = SudokuOption::CommandLineArgSplitDepth;
+    std::string arg = argv[argIndex];
+    if (arg.find(header) != 0) {
+        return false;
+    }
+
+    const char* pStr = arg.c_str() + header.size();
+    int num = ::atoi(pStr);
+    splitDepth_ = ((num >= 0) && (*pStr != '\0')) ? static_cast<SudokuIndex>(num) : SudokuSseParallelEnumerator::DefaultSplitDepth;
+    return true;
+}
+
+// Returns true if an argument designates an instruction set for the assembly code
+bool SudokuLoader::setIsa(int argc, const char * const argv[], int argIndex) {
+    if ((argc <= argIndex) || (argv[argIndex] == nullptr)) {
+        return false;
+    }
+
+    const std::string header = SudokuOption::CommandLineArgIsa;
+    std::string arg = argv[argIndex];
+    if (arg.find(header) != 0) {
+        return false;
+    }
+
+    const std::string name = arg.substr(header.size());
+    SudokuLoopIndex index = 0;
+    for(auto& pName : SudokuOption::CommandLineIsaSet) {
+        if (name == pName) {
+            isa_ = static_cast<SudokuIsa>(index);
+            isaSpecified_ = true;
+            return true;
+        }
+        ++index;
+    }
+
+    // Takes an unknown name to reject it instead of parsing it as another argument
+    invalidArg_ = arg;
+    return true;
+}
+
+// Uses the instruction set that a command line argument designates or the fastest one
+void SudokuLoader::selectIsa(void) {
+    if (Sudoku::SelectIsa(isa_)) {
+        return;
+    }
+
+    // Warns only when a user designates the instruction set
+    if (isaSpecified_) {
+        std::cerr << Sudoku::GetIsaName(isa_) << " is not available.\n";
+    }
+    isa_ = Sudoku::GetFastestIsa();
+    Sudoku::SelectIsa(isa_);
+    return;
+}
+
+// Returns true if an argument enables finding naked and hidden subsets
+bool SudokuLoader::setSubsets(int argc, const char * const argv[], int argIndex) {
+    if ((argc <= argIndex) || (argv[argIndex] == nullptr)) {
+        return false;
+    }
+
+    const std::string arg = argv[argIndex];
+    if (arg != SudokuOption::CommandLineArgSubsets) {
+        return false;
+    }
+
+    findSubsets_ = true;
+    return true;
+}
+
+// Returns true if an argument designates how to select a cell to guess
+bool SudokuLoader::setBranchPolicy(int argc, const char * const argv[], int argIndex) {
+    if ((argc <= argIndex) || (argv[argIndex] == nullptr)) {
+        return false;
+    }
+
+    const std::string header = SudokuOption::CommandLineArgBranch;
+    std::string arg = argv[argIndex];
+    if (arg.find(header) != 0) {
+        return false;
+    }
+
+    const std::string name = arg.substr(header.size());
+    SudokuLoopIndex index = 0;
+    for(auto& pName : SudokuOption::CommandLineBranchSet) {
+        if (name == pName) {
+            branchPolicy_ = static_cast<SudokuBranchPolicy>(index);
+            return true;
+        }
+        ++index;
+    }
+
+    invalidArg_ = arg;
+    return true;
+}
+
+// Returns true if an argument designates how to order candidates to guess
+bool SudokuLoader::setValueOrder(int argc, const char * const argv[], int argIndex) {
+    if ((argc <= argIndex) || (argv[argIndex] == nullptr)) {
+        return false;
+    }
+
+    const std::string header = SudokuOption::CommandLineArgValueOrder;
+    std::string arg = argv[argIndex];
+    if (arg.find(header) != 0) {
+        return false;
+    }
+
+    const std::string name = arg.substr(header.size());
+    SudokuLoopIndex index = 0;
+    for(auto& pName : SudokuOption::CommandLineValueOrderSet) {
+        if (name == pName) {
+            valueOrder_ = static_cast<SudokuValueOrder>(index);
+            return true;
+        }
+        ++index;
+    }
+
+    invalidArg_ = arg;
+    return true;
+}
+
+bool SudokuLoader::setSteps(int argc, const char * const argv[], int argIndex) {
+    if ((argc <= argIndex) || (argv[argIndex] == nullptr)) {
+        return false;
+    }
+
+    const std::string arg = argv[argIndex];
+    if (arg != SudokuOption::CommandLineArgSteps) {
+        return false;
+    }
+
+    printSteps_ = true;
+    return true;
+}
+
 SudokuLoader::ExitStatusCode SudokuLoader::execSingle(void) {
     auto pProcessorBinder = Sudoku::CreateProcessorBinder();
 
@@ -2033,11 +6208,22 @@ SudokuLoader::ExitStatusCode SudokuLoader::execSingle(void) {
     }
 
     // The SSE code does not solve Sudoku-X puzzles
+    printHeader(SudokuSolverType::SOLVER_SSE_4_2, pSudokuOutStream_);
     measureTimeToSolve(SudokuSolverType::SOLVER_SSE_4_2);
     return ExitStatusPassed;
 }
 
 SudokuLoader::ExitStatusCode SudokuLoader::execMulti(void) {
+    if (multiLineFilename_ == SudokuOption::CommandLineArgStdin) {
+        return execMulti(pSudokuInStream_);
+    }
+
+    // Finds puzzles in a mapped file without copying them
+    auto pMappedFile = Sudoku::CreateMappedFile(multiLineFilename_);
+    if (pMappedFile->GetData() != nullptr) {
+        return execMulti(pMappedFile->GetData(), pMappedFile->GetSize());
+    }
+
     std::ifstream is(multiLineFilename_);
     return execMulti(&is);
 }
@@ -2050,24 +6236,225 @@ SudokuLoader::ExitStatusCode SudokuLoader::execMulti(std::istream* pSudokuInStre
         return ExitStatusFailed;
     }
 
+    // Threads read records at any index in a mapped file but a stream cannot seek
+    std::string firstLine;
+    if (SudokuPuzzleRecord::IsRecordStream(*pSudokuInStream, firstLine)) {
+        *pSudokuOutStream_ << "Invalid puzzle records (records cannot be read from stdin)\n";
+        return ExitStatusFailed;
+    }
+
+    printHeader(solverType_, pSudokuOutStream_);
+
+    // Reads, solves and writes puzzles in windows to keep memory flat for large inputs.
+    // Windows grow to write first results early and to keep threads busy.
+    SudokuPuzzleCount lineNum = 1;
+    auto windowSize = InitialWindowSize;
+    WindowReader reader = [this, pSudokuInStream, &firstLine, &lineNum, &windowSize](SudokuMultiDispatcher& dispatcher) {
+        // The first window starts with the line that was read to find the magic
+        SudokuPuzzleCount sizeOfWindow = 0;
+        if (lineNum == 1) {
+            if (firstLine.empty()) {
+                return false;
+            }
+            dispatcher.AddPuzzle(lineNum, firstLine);
+            ++sizeOfWindow;
+        }
+
+        sizeOfWindow += readLines(pSudokuInStream, dispatcher, lineNum + sizeOfWindow, windowSize - sizeOfWindow);
+        lineNum += sizeOfWindow;
+
+        // Stops at the end of the input or an empty line
+        const auto continues = (sizeOfWindow == windowSize);
+        windowSize = std::min(windowSize * 2, MaxWindowSize);
+        return continues;
+    };
+
+    SudokuPuzzleCount sizeOfPuzzle = 0;
+    SudokuPatternCount stepCount = 0;
+    SudokuPatternCount guessCount = 0;
+    const auto result = execWindows(reader, sizeOfPuzzle, stepCount, guessCount);
+    writeSummary(result, sizeOfPuzzle, stepCount, guessCount);
+    return result;
+}
+
+SudokuLoader::ExitStatusCode SudokuLoader::execMulti(const char* pData, size_t size) {
+    if (pData == nullptr) {
+        return ExitStatusFailed;
+    }
+
+    if (SudokuPuzzleRecord::IsRecordFile(pData, size)) {
+        SudokuPuzzleCount sizeOfRecords = 0;
+        if (!SudokuPuzzleRecord::GetSize(pData, size, sizeOfRecords)) {
+            *pSudokuOutStream_ << "Invalid puzzle records\n";
+            return ExitStatusFailed;
+        }
+        return execRecords(pData, sizeOfRecords);
+    }
+
+    printHeader(solverType_, pSudokuOutStream_);
+
+    // Threads find puzzles in a window and solve them as execMulti(std::istream*) does.
+    // The parser has its own runner because solvers use pParallelRunner_ at the same time.
+    const NumberOfCores numberOfRanges = (numberOfThreads_ > 1) ? numberOfThreads_ : 1;
+    auto pParserRunner = Sudoku::CreateParallelRunner();
+    SudokuPuzzleLineParser parser(pData, size);
+    SudokuPuzzleLineParser::LineSet lineSet;
+    SudokuPuzzleCount lineNum = 0;
+    auto windowSize = InitialWindowSize;
+    WindowReader reader = [numberOfRanges, &pParserRunner, &parser, &lineSet, &lineNum, &windowSize]
+        (SudokuMultiDispatcher& dispatcher) {
+        // A window holds windowSize 9x9 puzzles and their newlines
+        const auto continues = parser.Parse(windowSize * (Sudoku::SizeOfAllCells + 1),
+                                            numberOfRanges, *pParserRunner, lineSet);
+        for(const auto& line : lineSet) {
+            ++lineNum;
+            dispatcher.AddPuzzle(lineNum, line.first, line.second);
+        }
+
+        windowSize = std::min(windowSize * 2, MaxWindowSize);
+        return continues;
+    };
+
+    SudokuPuzzleCount sizeOfPuzzle = 0;
+    SudokuPatternCount stepCount = 0;
+    SudokuPatternCount guessCount = 0;
+    const auto result = execWindows(reader, sizeOfPuzzle, stepCount, guessCount);
+    writeSummary(result, sizeOfPuzzle, stepCount, guessCount);
+    return result;
+}
+
+// Records need no parsing and threads read them at any index
+SudokuLoader::ExitStatusCode SudokuLoader::execRecords(const char* pData, SudokuPuzzleCount sizeOfRecords) {
     printHeader(solverType_, pSudokuOutStream_);
 
-    DispatcherPtrSet dispatcherSet;
-    for(decltype(numberOfThreads_) i=0; i<numberOfThreads_; ++i) {
-        dispatcherSet.push_back(DispatcherPtr(
-                                    new SudokuMultiDispatcher(solverType_, check_, print_, printAllCandidate_)));
+    SudokuPuzzleCount sizeOfRead = 0;
+    auto windowSize = InitialWindowSize;
+    WindowReader reader = [pData, sizeOfRecords, &sizeOfRead, &windowSize](SudokuMultiDispatcher& dispatcher) {
+        const auto sizeOfWindow = std::min(windowSize, sizeOfRecords - sizeOfRead);
+        for(SudokuPuzzleCount i = 0; i < sizeOfWindow; ++i) {
+            dispatcher.AddRecord(sizeOfRead + i + 1, SudokuPuzzleRecord::GetRecord(pData, sizeOfRead + i));
+        }
+
+        sizeOfRead += sizeOfWindow;
+        windowSize = std::min(windowSize * 2, MaxWindowSize);
+        return (sizeOfRead < sizeOfRecords);
+    };
+
+    SudokuPuzzleCount sizeOfPuzzle = 0;
+    SudokuPatternCount stepCount = 0;
+    SudokuPatternCount guessCount = 0;
+    const auto result = execWindows(reader, sizeOfPuzzle, stepCount, guessCount);
+    writeSummary(result, sizeOfPuzzle, stepCount, guessCount);
+    return result;
+}
+
+// Reads, solves and writes windows in order of their puzzles
+SudokuLoader::ExitStatusCode SudokuLoader::execWindows(WindowReader& reader, SudokuPuzzleCount& sizeOfPuzzle,
+                                                       SudokuPatternCount& stepCount, SudokuPatternCount& guessCount) {
+    auto result = ExitStatusPassed;
+    auto continues = true;
+
+#ifdef NO_PARALLEL
+    while(continues) {
+        SudokuMultiDispatcher dispatcher(solverType_, check_, print_, printAllCandidate_);
+        continues = reader(dispatcher);
+        if (dispatcher.GetSize() == 0) {
+            continue;
+        }
+
+        if (execWindow(dispatcher, stepCount, guessCount) != ExitStatusPassed) {
+            result = ExitStatusFailed;
+        }
+        sizeOfPuzzle += dispatcher.GetSize();
+    }
+#else
+    // Double-buffered windows: a thread reads the next window and another writes the previous
+    // window while workers solve the current window. Windows move to their next stages
+    // after all the stages finish.
+    using Window = std::unique_ptr<SudokuMultiDispatcher>;
+    const NumberOfCores numberOfWorkers = (numberOfThreads_ > 1) ? numberOfThreads_ : 1;
+    Window pSolvingWindow;
+    Window pWritingWindow;
+
+    while(continues || pSolvingWindow || pWritingWindow) {
+        Window pReadingWindow;
+        if (continues) {
+            pReadingWindow.reset(new SudokuMultiDispatcher(solverType_, check_, print_, printAllCandidate_));
+            auto& window = *pReadingWindow;
+            Sudoku::BaseParallelRunner::Evaluator evaluator = [&reader, &window, &continues] {
+                continues = reader(window);
+                return false;
+            };
+            pParallelRunner_->Add(evaluator);
+        }
+
+        SudokuPuzzleChunkQueue chunkQueue((pSolvingWindow) ? pSolvingWindow->GetSize() : 0, numberOfWorkers);
+        if (pSolvingWindow) {
+            addSolvers(numberOfWorkers, *pSolvingWindow, chunkQueue);
+        }
+
+        if (pWritingWindow) {
+            auto& window = *pWritingWindow;
+            Sudoku::BaseParallelRunner::Evaluator evaluator = [this, &window] {
+                writeMessage(window.GetSize(), window, pSudokuOutStream_);
+                pSudokuOutStream_->flush();
+                return false;
+            };
+            pParallelRunner_->Add(evaluator);
+        }
+
+        // The reader and writer run besides workers
+        if (pParallelRunner_->Run(numberOfWorkers + 2)) {
+            result = ExitStatusFailed;
+        }
+
+        if (pSolvingWindow) {
+            stepCount += pSolvingWindow->GetStepCount();
+            guessCount += pSolvingWindow->GetGuessCount();
+        }
+
+        pWritingWindow = std::move(pSolvingWindow);
+        if (pReadingWindow && (pReadingWindow->GetSize() > 0)) {
+            sizeOfPuzzle += pReadingWindow->GetSize();
+            pSolvingWindow = std::move(pReadingWindow);
+        }
     }
+#endif
+
+    return result;
+}
 
-    auto sizeOfPuzzle = readLines(numberOfThreads_, pSudokuInStream, dispatcherSet);
-    auto result = execAll(numberOfThreads_, dispatcherSet);
-    writeMessage(numberOfThreads_, sizeOfPuzzle, dispatcherSet, pSudokuOutStream_);
+// Solves puzzles in a window and writes their results in order of the puzzles
+SudokuLoader::ExitStatusCode SudokuLoader::execWindow(SudokuMultiDispatcher& dispatcher, SudokuPatternCount& stepCount,
+                                                      SudokuPatternCount& guessCount) {
+    const auto result = execAll(numberOfThreads_, dispatcher);
+    writeMessage(dispatcher.GetSize(), dispatcher, pSudokuOutStream_);
+    pSudokuOutStream_->flush();
+    stepCount += dispatcher.GetStepCount();
+    guessCount += dispatcher.GetGuessCount();
+    return result;
+}
 
-    std::string message = (check_ == SudokuSolverCheck::DO_NOT_CHECK) ? "solved" : "passed";
+void SudokuLoader::writeSummary(ExitStatusCode result, SudokuPuzzleCount sizeOfPuzzle,
+                                SudokuPatternCount stepCount, SudokuPatternCount guessCount) {
+    std::string message = (check_ == SudokuSolverCheck::DO_NOT_CHECK) ? "solved" :
+        ((check_ == SudokuSolverCheck::CHECK_UNIQUE) ? "checked" : "passed");
     if (result == ExitStatusPassed) {
         *pSudokuOutStream_ << "All " << sizeOfPuzzle << " cases " << message << ".\n";
     }
 
-    return result;
+    if (printSteps_) {
+        *pSudokuOutStream_ << "Steps : " << stepCount << "\n";
+
+        // Average guesses per puzzle compare value orders
+        std::ostringstream os;
+        const auto average = (sizeOfPuzzle > 0) ?
+            (static_cast<double>(guessCount) / static_cast<double>(sizeOfPuzzle)) : 0.0;
+        os << "Guesses : " << guessCount << " (" << std::fixed << std::setprecision(2) << average << " per puzzle)\n";
+        *pSudokuOutStream_ << os.str();
+    }
+
+    return;
 }
 
 void SudokuLoader::printHeader(SudokuSolverType solverType, std::ostream* pSudokuOutStream) {
@@ -2077,7 +6464,16 @@ void SudokuLoader::printHeader(SudokuSolverType solverType, std::ostream* pSudok
 
     switch(solverType) {
     case SudokuSolverType::SOLVER_SSE_4_2:
-        *pSudokuOutStream << "Solving with SSE/AVX\n";
+        *pSudokuOutStream << "Solving with SSE/AVX (" << Sudoku::GetIsaName(Sudoku::GetIsa()) << ")\n";
+        break;
+    case SudokuSolverType::SOLVER_SOA:
+        *pSudokuOutStream << "Solving in C++ with AVX2 intrinsics\n";
+        break;
+    case SudokuSolverType::SOLVER_SSE_INTRINSICS:
+        *pSudokuOutStream << "Solving with SSE 4.2 intrinsics\n";
+        break;
+    case SudokuSolverType::SOLVER_BITPLANE:
+        *pSudokuOutStream << "Solving in C++ with bitplanes\n";
         break;
     case SudokuSolverType::SOLVER_GENERAL:
     default:
@@ -2088,54 +6484,62 @@ void SudokuLoader::printHeader(SudokuSolverType solverType, std::ostream* pSudok
     return;
 }
 
-SudokuPuzzleCount SudokuLoader::readLines(NumberOfCores numberOfCores, std::istream* pSudokuInStream,
-                                          DispatcherPtrSet& dispatcherSet) {
+SudokuPuzzleCount SudokuLoader::readLines(std::istream* pSudokuInStream, SudokuMultiDispatcher& dispatcher,
+                                          SudokuPuzzleCount firstLineNum, SudokuPuzzleCount maxSizeOfPuzzle) {
     SudokuPuzzleCount sizeOfPuzzle = 0;
-    SudokuPuzzleCount lineNum = 1;
-    decltype(numberOfCores) indexOfCore = 0;
+    SudokuPuzzleCount lineNum = firstLineNum;
 
-    for(;;) {
+    while(sizeOfPuzzle < maxSizeOfPuzzle) {
         std::string lineStr;
         getline(*pSudokuInStream, lineStr);
         if (lineStr.empty()) {
             break;
         }
 
-        dispatcherSet.at(indexOfCore)->AddPuzzle(lineNum, lineStr);
+        dispatcher.AddPuzzle(lineNum, lineStr);
         ++sizeOfPuzzle;
         ++lineNum;
-        ++indexOfCore;
-        indexOfCore = (indexOfCore >= numberOfCores) ? 0 : indexOfCore;
     }
 
     return sizeOfPuzzle;
 }
 
-SudokuLoader::ExitStatusCode SudokuLoader::execAll(NumberOfCores numberOfCores, DispatcherPtrSet& dispatcherSet) {
-    for(auto& dispatcher : dispatcherSet) {
-        Sudoku::BaseParallelRunner::Evaluator evaluator = [&dispatcher] { return dispatcher->ExecAll(); };
+// Threads share puzzles with work stealing because some puzzles take much longer time than others
+SudokuLoader::ExitStatusCode SudokuLoader::execAll(NumberOfCores numberOfCores, SudokuMultiDispatcher& dispatcher) {
+    const NumberOfCores numberOfWorkers = (numberOfCores > 1) ? numberOfCores : 1;
+    SudokuPuzzleChunkQueue chunkQueue(dispatcher.GetSize(), numberOfWorkers);
+    addSolvers(numberOfWorkers, dispatcher, chunkQueue);
+    return pParallelRunner_->Run(numberOfWorkers) ? ExitStatusFailed : ExitStatusPassed;
+}
+
+// Adds workers that take chunks of puzzles in a dispatcher to the parallel runner
+void SudokuLoader::addSolvers(NumberOfCores numberOfWorkers, SudokuMultiDispatcher& dispatcher,
+                              SudokuPuzzleChunkQueue& chunkQueue) {
+    for(NumberOfCores workerIndex = 0; workerIndex < numberOfWorkers; ++workerIndex) {
+        Sudoku::BaseParallelRunner::Evaluator evaluator = [&chunkQueue, &dispatcher, workerIndex] {
+            // Each worker reuses its solvers and buffers for all puzzles in its chunks
+            SudokuDispatcherWorkspace workspace;
+            bool failed = false;
+            SudokuPuzzleChunkQueue::Chunk chunk;
+            while(chunkQueue.Pop(workerIndex, chunk)) {
+                failed |= dispatcher.ExecRange(chunk.first, chunk.second, workspace);
+            }
+            return failed;
+        };
         pParallelRunner_->Add(evaluator);
     }
 
-    return pParallelRunner_->Run(numberOfCores) ? ExitStatusFailed : ExitStatusPassed;
+    return;
 }
 
-void SudokuLoader::writeMessage(NumberOfCores numberOfCores, SudokuPuzzleCount sizeOfPuzzle,
-                                DispatcherPtrSet& dispatcherSet, std::ostream* pSudokuOutStream) {
+void SudokuLoader::writeMessage(SudokuPuzzleCount sizeOfPuzzle, const SudokuMultiDispatcher& dispatcher,
+                                std::ostream* pSudokuOutStream) {
     if (pSudokuOutStream == nullptr) {
         return;
     }
 
-    decltype(numberOfCores) indexOfCore = 0;
-    size_t indexInDispatcher = 0;
-
     for(decltype(sizeOfPuzzle) i = 0; i < sizeOfPuzzle; ++i) {
-        *pSudokuOutStream << dispatcherSet.at(indexOfCore)->GetMessage(indexInDispatcher);
-        ++indexOfCore;
-        if (indexOfCore >= numberOfCores) {
-            indexOfCore = 0;
-            ++indexInDispatcher;
-        }
+        *pSudokuOutStream << dispatcher.GetMessage(i);
     }
 
     return;
@@ -2216,7 +6620,12 @@ SudokuTime SudokuLoader::enumerateSudoku(void) {
 
     std::unique_ptr<Sudoku::ITimer> pTimer(Sudoku::CreateTimerInstance());
     pTimer->StartClock();
-    sseSolver.Enumerate();
+    // Printing solutions must keep their order and runs on a single thread
+    if ((numberOfThreads_ > 1) && (printAllCandidate_ == 0)) {
+        sseSolver.Enumerate(sudokuStr_, *pParallelRunner_, numberOfThreads_, splitDepth_);
+    } else {
+        sseSolver.Enumerate();
+    }
     pTimer->StopClock();
     return pTimer->GetClockInterval();
 }
@@ -4,13 +4,35 @@
 #ifndef SUDOKU_H_INCLUDED
 #define SUDOKU_H_INCLUDED
 
+#include <stddef.h>
 #include <stdint.h>
 #include <array>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <ostream>
+#include <streambuf>
 #include <string>
 #include <vector>
 #include <utility>
 #include <nmmintrin.h>
 
+// Threads share puzzles with a lock for each worker
+#ifndef NO_PARALLEL
+#ifdef SOLVE_PARALLEL_WITH_BOOST_THREAD
+#include <boost/thread/lock_guard.hpp>
+#include <boost/thread/mutex.hpp>
+#else
+#include <mutex>
+#endif
+#endif
+
+// The C++ solver with AVX2 intrinsics is available if the compiler generates AVX2 code
+#if defined(__AVX2__)
+#define SUDOKU_SOA_MAP (1)
+#include <immintrin.h>
+#endif
+
 // Undefine this macro if we use virtual functions.
 // Normally we avoid virtual functions to make this solver run fast.
 #define NO_DESTRUCTOR_AND_VTABLE (1)
@@ -62,9 +84,24 @@ constexpr size_t arraySizeof(const T (&)[n]) {
 // Command line arguments
 namespace SudokuOption {
     const char * const CommandLineArgParallel = "-N";
+    const char * const CommandLineArgSplitDepth = "-D";
+    const char * const CommandLineArgIsa = "-I";
+    const char * const CommandLineArgSubsets = "-S";
+    const char * const CommandLineArgBranch = "-B";
+    const char * const CommandLineArgSteps = "-R";
+    const char * const CommandLineArgValueOrder = "-V";
+    const char * const CommandLineArgStdin = "-";  // reads puzzles in lines from stdin instead of a file
+    const char * const CommandLineIsaSet[] = {"sse", "avx2", "avx512"};  // in order of SudokuIsa
+    const char * const CommandLineBranchSet[] = {"fixed", "groups", "mrv"};  // in order of SudokuBranchPolicy
+    const char * const CommandLineValueOrderSet[] = {"ascending", "lcv", "places"};  // in order of SudokuValueOrder
     const char * const CommandLineArgSseSolver[] = {"1", "sse", "avx"};
+    const char * const CommandLineArgSoaSolver[] = {"2", "soa"};
+    const char * const CommandLineArgSseIntrinsicsSolver[] = {"3", "intrinsics"};
+    const char * const CommandLineArgBitplaneSolver[] = {"4", "bitplane"};
     const char * const CommandLineNoChecking[] = {"1", "off"};
     const char * const CommandLinePrint[] = {"2", "print"};
+    const char * const CommandLineCheckUnique[] = {"3", "unique"};
+    const char * const UniquenessVerdictSet[] = {"none", "unique", "multiple"};  // in order of numbers of solutions
 
     // This function sets a value of a command line argument to arg 'target' if it is valid.
     template <typename T, size_t n>
@@ -107,6 +144,7 @@ static_assert((alignof(xmmRegister) % 16) == 0, "Unexpected xmmRegister alignmen
 namespace SudokuSse {
     constexpr size_t RegisterCnt = 16;    // the number of XMM registers
     constexpr size_t RegisterWordCnt = 4; // the number of words in an XMM register
+    constexpr size_t MaxLaneCnt = 4;      // the number of 128-bit lanes in a ZMM register
 }
 
 // All XMM registers (128-bit * 16 registers)
@@ -137,13 +175,60 @@ namespace Sudoku {
     constexpr short MaxCandidatesNumber = 9;          // a maximum preset number of a cell
     // Allocate larger memory than the cache line size to prevent false sharing in heap memory.
     constexpr uint32_t CacheGuardSize = 128;
+    // Solvers find naked and hidden subsets only in their first steps near the root of a search tree
+    constexpr int SubsetStepBudget = 16;
+    // and when this number of cells or fewer are filled, because easy puzzles do not pay for finding them.
+    constexpr SudokuIndex MaxFilledCellsToFindSubsets = 40;
+    constexpr SudokuIndex MinSubsetSize = 2;  // pairs
+    constexpr SudokuIndex MaxSubsetSize = 3;  // triples
 }
 
+// Instruction sets that the assembly code uses
+enum class SudokuIsa {
+    SSE_4_2,  // SSE4.2 and POPCNT
+    AVX2,     // AVX2 and BMI1 in addition to SSE4.2
+    AVX512,   // AVX-512F/VL and BMI2 in addition to AVX2
+};
+
+// Selecting a cell to guess in backtracking
+enum class SudokuBranchPolicy {
+    FIXED_GROUP,    // a cell which has the fewest candidates in rows as the assembly code does
+    ALL_GROUPS,     // a cell which has the fewest candidates in rows, columns, and boxes
+    MIN_REMAINING,  // a cell which has the fewest candidates and the most blank cells in its groups in ties
+};
+
+// Ordering candidates of a cell to guess in backtracking
+enum class SudokuValueOrder {
+    ASCENDING,           // 1..9 as the assembly code does
+    LEAST_CONSTRAINING,  // a number which the fewest cells in the row, column, and box of the cell hold first
+    FEWEST_PLACES,       // a number which has the fewest cells to place it in a group of the cell first
+};
+
 // Common functions
 namespace Sudoku {
     void LoadXmmRegistersFromMem(const xmmRegister *pData);  // loads XMM registers from main memory
     void SaveXmmRegistersToMem(xmmRegister *pData);          // saves XMM registers to main memory
 
+    // Selecting an instruction set at run time
+    // An executable has code for one or all instruction sets. Call SelectIsa() before running on multi-threading.
+    bool CanUseIsa(SudokuIsa isa);  // returns whether both this executable and the CPU support an instruction set
+    SudokuIsa GetFastestIsa(void);  // returns the fastest instruction set that both support
+    SudokuIsa GetIsa(void);         // returns the instruction set that the assembly code uses now
+    bool SelectIsa(SudokuIsa isa);  // uses an instruction set if available
+    const char* GetIsaName(SudokuIsa isa);
+
+    // Finding naked and hidden subsets is optional. Call SetSubsetElimination() before running on multi-threading.
+    void SetSubsetElimination(bool enabled);
+    bool UsesSubsetElimination(void);
+
+    // Selecting a cell to guess in backtracking. Call SetBranchPolicy() before running on multi-threading.
+    void SetBranchPolicy(SudokuBranchPolicy policy);
+    SudokuBranchPolicy GetBranchPolicy(void);
+
+    // Ordering candidates to guess in backtracking. Call SetValueOrder() before running on multi-threading.
+    void SetValueOrder(SudokuValueOrder order);
+    SudokuValueOrder GetValueOrder(void);
+
     // Sets a number to a cell if valid
 #if __cplusplus >= 201703L
     template <typename SudokuNumberType>
@@ -162,12 +247,16 @@ namespace Sudoku {
 enum class SudokuSolverType {
     SOLVER_GENERAL,  // C++ template metaprogramming without assembly
     SOLVER_SSE_4_2,  // SSE4.2 or AVX assembly
+    SOLVER_SOA,      // C++ with AVX2 intrinsics (the C++ solver substitutes it without AVX2)
+    SOLVER_SSE_INTRINSICS,  // SSE4.2 intrinsics in the same manner as the assembly
+    SOLVER_BITPLANE, // C++ with a plane of cells for each number
 };
 
 // Selecting whether to check solutions
 enum class SudokuSolverCheck {
     CHECK,         // Check solutions
     DO_NOT_CHECK,  // Do not check solutions
+    CHECK_UNIQUE,  // Check whether puzzles have unique solutions instead of solving them
 };
 
 // Selecting whether to print solutions when solving puzzles
@@ -182,12 +271,19 @@ public:
     virtual ~SudokuBaseSolver() = default;
     virtual bool Exec(bool silent, bool verbose) = 0;
     virtual void PrintType(void) = 0;
+    // Solves another puzzle with this solver as if constructing a new solver
+    virtual void Reset(const std::string& presetStr) = 0;
+    int GetStepCount(void) const;
+    int GetGuessCount(void) const;
 protected:
     SudokuBaseSolver(std::ostream* pSudokuOutStream);
     SudokuBaseSolver(const SudokuBaseSolver&) = delete;
     SudokuBaseSolver& operator =(const SudokuBaseSolver&) = delete;
     virtual void printType(const std::string& presetStr, std::ostream* pSudokuOutStream);
+    void clearCount(void);
+    bool canFindSubsets(SudokuIndex filledCellCnt) const;
     int            count_;             // counts how many times it repeats to solve a puzzle
+    int            guessCount_;        // counts how many times it guesses a candidate in backtracking
     std::ostream*  pSudokuOutStream_;  // destination to print results
 };
 
@@ -228,6 +324,7 @@ public:
     INLINE bool HasCandidate(SudokuCellCandidates candidate) const;
     INLINE bool HasNoCandidates(void) const;
     INLINE void SetCandidates(SudokuCellCandidates candidates);
+    INLINE void RestoreCandidates(SudokuCellCandidates candidates);
     INLINE SudokuCellCandidates GetCandidates(void) const;
     INLINE SudokuCellCandidates GetUniqueCandidate(void) const;
     INLINE SudokuIndex CountCandidates(void) const;
@@ -257,10 +354,41 @@ private:
     static constexpr SudokuNumber SudokuMaxCandidatesNumber = Sudoku::MaxCandidatesNumber;
 };
 
+// An undo log of candidates of cells that a solver changes.
+// A cell loses one candidate at least on each change and it has nine candidates at most,
+// so the log cannot hold more entries than nine for each cell.
+class SudokuMapTrail {
+    // unit tests
+    friend class SudokuMapTest;
+public:
+    using Mark = SudokuLoopIndex;  // the number of entries before a guess
+    struct Entry {
+        SudokuIndex          cellIndex;
+        SudokuCellCandidates candidates;  // before a change
+    };
+
+    SudokuMapTrail(void);
+#ifndef NO_DESTRUCTOR
+    ALLOW_VIRTUAL ~SudokuMapTrail() = default;
+#endif
+    SudokuMapTrail(const SudokuMapTrail&) = delete;
+    SudokuMapTrail& operator =(const SudokuMapTrail&) = delete;
+    void Clear(void);
+    INLINE void Record(SudokuIndex cellIndex, SudokuCellCandidates candidates);
+    INLINE Mark GetMark(void) const;
+    INLINE const Entry& Pop(void);
+private:
+    static constexpr size_t MaxEntryCnt = Sudoku::SizeOfAllCells * Sudoku::SizeOfCandidates;
+    Entry entrySet_[MaxEntryCnt];
+    Mark  size_;
+};
+
 // All cells in solving C++ template metaprogramming without assembly
 class SudokuMap {
     // unit tests
     friend class SudokuMapTest;
+    friend class SudokuGridMapTest;
+    friend class SudokuBranchSelectorTest;
     friend class SudokuSolverTest;
     template <class TestedT, class CandidatesT> friend class SudokuSolverCommonTest;
 
@@ -274,20 +402,56 @@ public:
     void Print(std::ostream* pSudokuOutStream) const;
     // Solving a puzzle
     INLINE bool IsFilled(void) const;
+    void SetTrail(SudokuMapTrail* pTrail);
+    INLINE void Rewind(SudokuMapTrail::Mark mark);
     bool FillCrossing(void);
+    bool Propagate(void);
+    bool FindLockedCandidates(void);
+    bool FindSubsets(void);
+    static bool FindSubsets(SudokuCellCandidates (&candidateSet)[Sudoku::SizeOfAllCells]);
     INLINE bool CanSetUniqueCell(SudokuIndex cellIndex, SudokuCellCandidates candidate) const;
     INLINE void SetUniqueCell(SudokuIndex cellIndex, SudokuCellCandidates candidate);
     INLINE SudokuIndex CountFilledCells(void) const;
     INLINE SudokuIndex SelectBacktrackedCellIndex(void) const;
+    INLINE SudokuIndex OrderCandidates(SudokuIndex cellIndex, SudokuCellCandidates (&orderedSet)[Sudoku::SizeOfCandidates]) const;
     bool IsConsistent(void) const;
 private:
-    bool findUnusedCandidate(SudokuCell& targetCell) const;
-    bool findUniqueCandidate(SudokuCell& targetCell) const;
+    bool findUnusedCandidate(SudokuCell& targetCell);
+    bool findUniqueCandidate(SudokuCell& targetCell);
     bool areDiagonalBarsConsistent(void) const;
+    INLINE void setCandidates(SudokuCell& targetCell, SudokuCellCandidates candidates);
+    INLINE void collectPlacedCandidates(void);
+    INLINE void addPlacedCandidate(SudokuIndex cellIndex, SudokuCellCandidates candidate);
+    INLINE void clearPendingCells(void);
+    INLINE void addPendingCell(SudokuIndex cellIndex, SudokuCellCandidates candidates);
+    INLINE bool removeCandidateFromNeighbours(SudokuIndex cellIndex);
+    INLINE bool removeCandidateFromCell(SudokuIndex cellIndex, SudokuCellCandidates candidate);
+    INLINE bool findHiddenSingles(SudokuIndex groupId, SudokuIndex groupIndex);
+    INLINE bool removeCandidates(SudokuIndex cellIndex, SudokuCellCandidates candidates);
+    static bool findNakedSubsets(SudokuCellCandidates* pCells, SudokuLoopIndex cellCnt);
+    static bool findHiddenSubsets(SudokuCellCandidates* pCells, SudokuLoopIndex cellCnt, SudokuCellCandidates filledCandidates);
+    static bool restrictCandidates(SudokuCellCandidates* pCells, SudokuLoopIndex cellCnt,
+                                   SudokuLoopIndex cellBits, SudokuCellCandidates candidates);
     // All cells in a puzzle
     SudokuCell cells_[Sudoku::SizeOfAllCells];
     // determines which cell in columns, rows, or boxes do we select in backtracking.
     SudokuIndex backtrackedGroup_;
+    // records changed cells to rewind them (not owned and can be null)
+    SudokuMapTrail* pTrail_;
+    // Unique candidates that cells hold in each row, column, and box
+    // and in the two diagonal bars {to the right from 0, to the left from 8}.
+    // FillCrossing() collects them and they follow cells getting unique candidates.
+    SudokuCellCandidates placedCandidates_[Sudoku::SizeOfGroupsPerCell][Sudoku::SizeOfGroupsPerMap];
+    SudokuCellCandidates placedDiagonalCandidates_[2];
+    // Cells which got unique candidates but their neighbours still hold the candidates
+    // (n-th bit of the words is n-th cell) and groups which lost candidates after
+    // Propagate() found hidden singles in them (n-th bit is groupId * 9 + groupIndex).
+    uint64_t pendingCells_[2];
+    uint32_t pendingGroups_;
+    // Propagate() masks all cells by preset cells at first instead of visiting their neighbours
+    bool     presetPending_;
+    // The number of cells which hold unique candidates and Propagate() stops if all cells do
+    SudokuIndex filledCellCnt_;
 
     // Cells in all columns, all rows, and all boxes
     static const SudokuIndex Group_[Sudoku::SizeOfGroupsPerCell][Sudoku::SizeOfGroupsPerMap][Sudoku::SizeOfCellsPerGroup];
@@ -297,25 +461,18 @@ private:
 
     // The serial number of a box in 9-cells groups {rows:0, columns:1, box:3}.
     static constexpr SudokuIndex SudokuBoxGroupId = 2;
+    // The number of cells in a word of pending cells
+    static constexpr SudokuIndex SudokuCellsPerPendingWord = 64;
 
     // Use inlining and unrolling to solve puzzles faster.
     template <SudokuIndex index> INLINE SudokuIndex unrolledCountFilledCells
         (SudokuIndex accumCount) const;
     template <SudokuIndex columnIndex> INLINE bool unrolledAreDiagonalBarsConsistentInner
         (SudokuCellCandidates allCandidatesToLeft, SudokuCellCandidates allCandidatesToRight) const;
-    template <SudokuIndex innerIndex> INLINE SudokuCellCandidates unrolledFindUnusedCandidateInner
-        (SudokuIndex targetCellIndex, SudokuIndex outerIndex, SudokuIndex groupIndex, SudokuCellCandidates candidates) const;
-    template <SudokuIndex outerIndex> INLINE SudokuCellCandidates unrolledFindUnusedCandidateOuter
-        (SudokuIndex targetCellIndex, SudokuCellCandidates candidates) const;
     template <SudokuIndex innerIndex> INLINE SudokuCellCandidates unrolledFindUniqueCandidateInner
         (SudokuIndex targetCellIndex, SudokuIndex outerIndex, SudokuIndex groupIndex, SudokuCellCandidates candidates) const;
     template <SudokuIndex innerIndex> INLINE SudokuIndex unrolledSelectBacktrackedCellIndexInner
         (SudokuIndex outerIndex, SudokuIndex& leastCountOfGroup, SudokuIndex& candidateCellIndex) const;
-    INLINE SudokuCellCandidates unrolledFindUnusedCandidateInnerCommon
-        (SudokuIndex targetCellIndex, SudokuIndex outerIndex, SudokuIndex groupIndex, SudokuIndex innerIndex,
-         SudokuCellCandidates candidates) const;
-    INLINE SudokuCellCandidates unrolledFindUnusedCandidateOuterCommon
-        (SudokuIndex targetCellIndex, SudokuIndex outerIndex, SudokuCellCandidates candidates) const;
     INLINE SudokuCellCandidates unrolledFindUniqueCandidateInnerCommon
         (SudokuIndex targetCellIndex, SudokuIndex outerIndex, SudokuIndex groupIndex, SudokuIndex innerIndex,
          SudokuCellCandidates candidates) const;
@@ -335,13 +492,402 @@ public:
     virtual ~SudokuSolver() = default;
     virtual bool Exec(bool silent, bool verbose) override;
     virtual void PrintType(void) override;
+    virtual void Reset(const std::string& presetStr) override;
 private:
     bool solve(SudokuMap& map, bool topLevel, bool verbose);
     bool fillCells(SudokuMap& map, bool topLevel, bool verbose);
 
-    SudokuMap map_;  // A sudoku puzzle (we allocate copies of this in backtracking)
+    SudokuMap map_;         // A sudoku puzzle (we rewind it instead of copying in backtracking)
+    SudokuMapTrail trail_;  // cells which map_ changed after guesses
+};
+
+#if defined(SUDOKU_SOA_MAP)
+// All cells in solving C++ with AVX2 intrinsics
+// This map holds candidates of cells in 16-bit lanes of YMM registers.
+// It stores the same cells twice in rows and in boxes to reduce candidates
+// in all groups of cells in a puzzle with few shuffles.
+class SudokuSoaMap {
+    // unit tests
+    friend class SudokuSoaMapTest;
+
+public:
+    SudokuSoaMap(void);
+#ifndef NO_DESTRUCTOR
+    ALLOW_VIRTUAL ~SudokuSoaMap() = default;
+#endif
+    // Initializing and output
+    void Preset(const std::string& presetStr);
+    void Print(std::ostream* pSudokuOutStream) const;
+    // Solving a puzzle
+    bool FillCrossing(void);
+    bool IsFilled(void) const;
+    bool IsConsistent(void) const;
+    SudokuIndex CountFilledCells(void) const;
+    SudokuIndex SelectBacktrackedCellIndex(void) const;
+    INLINE SudokuCellCandidates GetCandidates(SudokuIndex cellIndex) const;
+    INLINE void SetUniqueCell(SudokuIndex cellIndex, SudokuCellCandidates candidate);
+private:
+    using Lane = uint16_t;
+    // The number of 16-bit lanes in a YMM register. Lanes 0..8 hold cells and other lanes are 0.
+    static constexpr SudokuIndex SudokuLaneCnt = 16;
+
+    bool fillCrossingOnce(bool& changed);
+    bool maskDiagonalBars(Lane (&maskSet)[Sudoku::SizeOfGroupsPerMap][SudokuLaneCnt]) const;
+    void copyRowsToBoxes(void);
+    INLINE static SudokuIndex getBoxIndex(SudokuIndex row, SudokuIndex column);
+    INLINE static SudokuIndex getBoxPosition(SudokuIndex row, SudokuIndex column);
+    INLINE static SudokuIndex getDiagonalColumn(SudokuIndex bar, SudokuIndex row);
+
+    // Cells in rows (rows_[row][column]) and in boxes (boxes_[box][position in a box])
+    alignas(32) Lane rows_[Sudoku::SizeOfGroupsPerMap][SudokuLaneCnt];
+    alignas(32) Lane boxes_[Sudoku::SizeOfGroupsPerMap][SudokuLaneCnt];
+};
+
+// A Sudoku solver with C++ and AVX2 intrinsics
+class SudokuSoaSolver : public SudokuBaseSolver {
+    // unit tests
+    friend class SudokuSoaMapTest;
+public:
+    SudokuSoaSolver(const std::string& presetStr, std::ostream* pSudokuOutStream);
+    virtual ~SudokuSoaSolver() = default;
+    virtual bool Exec(bool silent, bool verbose) override;
+    virtual void PrintType(void) override;
+    virtual void Reset(const std::string& presetStr) override;
+private:
+    bool solve(SudokuSoaMap& map, bool verbose);
+
+    SudokuSoaMap map_;  // A sudoku puzzle (we copy it in backtracking because it is small)
+};
+#endif
+
+// All cells in planes for each number
+// A plane holds a bit for each cell which can hold its number and splits 81 cells
+// into three bands of 27 bits (three rows), so that filling a cell removes the number
+// from its row, column and box with a few bitwise operations on the planes.
+class SudokuBitplaneMap {
+    // unit tests
+    friend class SudokuBitplaneMapTest;
+
+public:
+    SudokuBitplaneMap(void);
+#ifndef NO_DESTRUCTOR
+    ALLOW_VIRTUAL ~SudokuBitplaneMap() = default;
+#endif
+    // Initializing and output
+    void Preset(const std::string& presetStr);
+    void Print(std::ostream* pSudokuOutStream) const;
+    // Solving a puzzle
+    bool FillCrossing(void);
+    bool IsFilled(void) const;
+    SudokuIndex CountFilledCells(void) const;
+    SudokuIndex SelectBacktrackedCellIndex(void) const;
+    INLINE SudokuCellCandidates GetCandidates(SudokuIndex cellIndex) const;
+    INLINE void SetUniqueCell(SudokuIndex cellIndex, SudokuCellCandidates candidate);
+private:
+    using Band = uint32_t;
+    static constexpr SudokuIndex SizeOfBands = 3;           // the number of bands in a plane
+    static constexpr SudokuIndex SizeOfCellsPerBand = 27;   // the number of cells in a band
+    static constexpr Band AllCellsInBand = 0x7ffffff;       // indicates that all cells in a band hold a number
+    static constexpr Band RowInBand = 0x1ff;                // the top row in a band
+    static constexpr Band ColumnInBand = 0x40201;           // the leftmost column in a band
+    static constexpr Band BoxInBand = 0x1c0e07;             // the leftmost box in a band
+
+    bool fillNakedSingles(bool& changed);
+    bool fillHiddenSingles(bool& changed);
+    void place(SudokuIndex number, SudokuIndex band, Band cell);
+    INLINE static Band getDiagonalBand(SudokuIndex bar, SudokuIndex band);
+
+    Band planes_[Sudoku::SizeOfCandidates][SizeOfBands];  // planes_[number][band]
+    Band placed_[SizeOfBands];  // cells that removed their number from other cells
+};
+
+// A Sudoku solver with planes for each number
+class SudokuBitplaneSolver : public SudokuBaseSolver {
+    // unit tests
+    friend class SudokuBitplaneMapTest;
+public:
+    SudokuBitplaneSolver(const std::string& presetStr, std::ostream* pSudokuOutStream);
+    virtual ~SudokuBitplaneSolver() = default;
+    virtual bool Exec(bool silent, bool verbose) override;
+    virtual void PrintType(void) override;
+    virtual void Reset(const std::string& presetStr) override;
+private:
+    bool solve(SudokuBitplaneMap& map, bool verbose);
+
+    SudokuBitplaneMap map_;  // A sudoku puzzle (we copy it in backtracking because it is small)
+};
+
+namespace Sudoku {
+    // A sequence of indexes 0..n-1 to expand tables in compilation time (std::index_sequence in C++14).
+    // MakeIndexSequence splits a sequence into halves to keep the depth of template recursion low.
+    template <size_t... indexes> struct IndexSequence {
+        using type = IndexSequence;
+    };
+
+    template <typename Left, typename Right> struct ConcatIndexSequence;
+    template <size_t... left, size_t... right>
+    struct ConcatIndexSequence<IndexSequence<left...>, IndexSequence<right...>>
+        : IndexSequence<left..., (sizeof...(left) + right)...> {};
+
+    template <size_t n> struct MakeIndexSequence
+        : ConcatIndexSequence<typename MakeIndexSequence<n / 2>::type, typename MakeIndexSequence<n - n / 2>::type> {};
+    template <> struct MakeIndexSequence<0> : IndexSequence<> {};
+    template <> struct MakeIndexSequence<1> : IndexSequence<0> {};
+
+    // A table of indexes that compilers build from a constexpr function
+    template <size_t n> struct IndexTable {
+        SudokuIndex value[n];
+        constexpr SudokuIndex operator[](size_t index) const {
+            return value[index];
+        }
+    };
+
+    template <SudokuIndex (*func)(size_t), size_t... indexes>
+    constexpr IndexTable<sizeof...(indexes)> MakeIndexTable(IndexSequence<indexes...>) {
+        return IndexTable<sizeof...(indexes)> {{func(indexes)...}};
+    }
+
+    // Calls func(index) for index = [first..last) with loops unrolled in compilation time
+    template <SudokuIndex first, SudokuIndex last> struct UnrolledLoop {
+        template <typename Func> INLINE static void Run(Func& func) {
+            func(first);
+            UnrolledLoop<first + 1, last>::Run(func);
+        }
+    };
+
+    template <SudokuIndex last> struct UnrolledLoop<last, last> {
+        template <typename Func> INLINE static void Run(Func&) {
+            return;
+        }
+    };
+}
+
+// Sizes of a puzzle which has BoxSize * BoxSize boxes of BoxSize * BoxSize cells
+// (BoxSize is 3 for 9x9, 4 for 16x16 and 5 for 25x25 puzzles)
+template <SudokuIndex BoxSize>
+class SudokuGeometry {
+public:
+    static_assert((BoxSize >= 2) && (BoxSize <= 5), "Candidates of a cell must fit in SudokuCellCandidates");
+    static constexpr SudokuIndex SizeOfCellsOnBoxEdge = BoxSize;  // a box has BoxSize rows and columns
+    static constexpr SudokuIndex SizeOfCellsPerGroup = BoxSize * BoxSize;  // cells in a column, row, and box
+    static constexpr SudokuIndex SizeOfGroupsPerMap = SizeOfCellsPerGroup;  // columns, rows, and boxes in a puzzle
+    static constexpr SudokuIndex SizeOfAllCells = SizeOfCellsPerGroup * SizeOfCellsPerGroup;
+    static constexpr SudokuIndex SizeOfCandidates = SizeOfCellsPerGroup;
+    static constexpr SudokuIndex SizeOfGroupsPerCell = 3;  // a cell belongs to a row, column, and box
+    static constexpr SudokuCellCandidates AllCandidates = (1u << SizeOfCandidates) - 1;
+
+    // The index of a cell at a position in a group {row:0, column:1, box:2} (cells in a box are column-major)
+    static constexpr SudokuIndex GetGroupCell(SudokuIndex groupId, SudokuIndex groupIndex, SudokuIndex position) {
+        return (groupId == 0) ? (groupIndex * SizeOfCellsPerGroup + position) :
+            ((groupId == 1) ? (position * SizeOfCellsPerGroup + groupIndex) :
+             (((groupIndex / BoxSize) * BoxSize + position % BoxSize) * SizeOfCellsPerGroup +
+              (groupIndex % BoxSize) * BoxSize + position / BoxSize));
+    }
+
+    // The index of a group {row:0, column:1, box:2} which a cell belongs to
+    static constexpr SudokuIndex GetCellGroup(SudokuIndex cellIndex, SudokuIndex groupId) {
+        return (groupId == 0) ? (cellIndex / SizeOfCellsPerGroup) :
+            ((groupId == 1) ? (cellIndex % SizeOfCellsPerGroup) :
+             ((cellIndex / SizeOfCellsPerGroup / BoxSize) * BoxSize + (cellIndex % SizeOfCellsPerGroup) / BoxSize));
+    }
+
+    // The index of a cell at a position on the diagonal bar {to the right from 0, to the left from N-1}
+    static constexpr SudokuIndex GetDiagonalCell(SudokuIndex bar, SudokuIndex position) {
+        return position * SizeOfCellsPerGroup + ((bar == 0) ? position : (SizeOfCellsPerGroup - 1 - position));
+    }
+
+    static constexpr bool IsOnDiagonal(SudokuIndex bar, SudokuIndex cellIndex) {
+        return (bar == 0) ? ((cellIndex / SizeOfCellsPerGroup) == (cellIndex % SizeOfCellsPerGroup)) :
+            (((cellIndex / SizeOfCellsPerGroup) + (cellIndex % SizeOfCellsPerGroup) + 1) == SizeOfCellsPerGroup);
+    }
+
+    // Elements of flattened Group_[groupId][groupIndex][position], ReverseGroup_[cellIndex][groupId]
+    // and Diagonal_[bar][position]
+    static constexpr SudokuIndex GetGroupElement(size_t index) {
+        return GetGroupCell(static_cast<SudokuIndex>(index / SizeOfAllCells),
+                            static_cast<SudokuIndex>((index / SizeOfCellsPerGroup) % SizeOfGroupsPerMap),
+                            static_cast<SudokuIndex>(index % SizeOfCellsPerGroup));
+    }
+
+    static constexpr SudokuIndex GetReverseGroupElement(size_t index) {
+        return GetCellGroup(static_cast<SudokuIndex>(index / SizeOfGroupsPerCell),
+                            static_cast<SudokuIndex>(index % SizeOfGroupsPerCell));
+    }
+
+    static constexpr SudokuIndex GetDiagonalElement(size_t index) {
+        return GetDiagonalCell(static_cast<SudokuIndex>(index / SizeOfCellsPerGroup),
+                               static_cast<SudokuIndex>(index % SizeOfCellsPerGroup));
+    }
+};
+
+// Selecting a cell to guess in backtracking from numbers of candidates of all cells of a 9x9 puzzle
+// with a policy except FIXED_GROUP, which each solver implements in its own manner.
+class SudokuBranchSelector {
+    // unit tests
+    friend class SudokuBranchSelectorTest;
+public:
+    using Geometry = SudokuGeometry<3>;
+    using CountSet = SudokuIndex[Geometry::SizeOfAllCells];
+    using CandidatesSet = SudokuCellCandidates[Geometry::SizeOfAllCells];
+    using OrderedSet = SudokuCellCandidates[Geometry::SizeOfCandidates];
+    // Returns false if no cells have multiple candidates
+    static bool Select(SudokuBranchPolicy policy, const CountSet& countSet, SudokuIndex& cellIndex);
+    // Sets candidates of a cell one by one in the order and returns the number of them
+    static SudokuIndex Order(SudokuValueOrder order, const CandidatesSet& candidatesSet,
+                             SudokuIndex cellIndex, OrderedSet& orderedSet);
+private:
+    using GroupTable = Sudoku::IndexTable<Geometry::SizeOfGroupsPerCell * Geometry::SizeOfAllCells>;
+    static bool selectInGroups(const CountSet& countSet, SudokuIndex& cellIndex);
+    static bool selectInCells(const CountSet& countSet, SudokuIndex& cellIndex);
+    static SudokuIndex orderAscending(SudokuCellCandidates candidates, OrderedSet& orderedSet);
+    static SudokuIndex countPeers(const CandidatesSet& candidatesSet, SudokuIndex cellIndex, SudokuCellCandidates candidate);
+    static SudokuIndex countPlaces(const CandidatesSet& candidatesSet, SudokuIndex cellIndex, SudokuCellCandidates candidate);
+    static constexpr SudokuIndex TooManyCandidates = Geometry::SizeOfCandidates + 1;
+    // Same as SudokuGridMap<3>
+    static constexpr GroupTable Group_ = Sudoku::MakeIndexTable<&Geometry::GetGroupElement>(
+        typename Sudoku::MakeIndexSequence<Geometry::SizeOfGroupsPerCell * Geometry::SizeOfAllCells>::type {});
+    static constexpr GroupTable ReverseGroup_ = Sudoku::MakeIndexTable<&Geometry::GetReverseGroupElement>(
+        typename Sudoku::MakeIndexSequence<Geometry::SizeOfGroupsPerCell * Geometry::SizeOfAllCells>::type {});
+};
+
+// All cells of a puzzle in any size
+// This holds candidates of each cell in a word and finds naked and hidden singles.
+// Cells of 9x9 puzzles have their look-up table CellLookUp_ but 16x16 and 25x25 puzzles
+// have too many patterns of candidates to look up, so this counts candidates with POPCNT.
+template <SudokuIndex BoxSize>
+class SudokuGridMap {
+    // unit tests
+    friend class SudokuGridMapTest;
+
+public:
+    using Geometry = SudokuGeometry<BoxSize>;
+    SudokuGridMap(void);
+#ifndef NO_DESTRUCTOR
+    ALLOW_VIRTUAL ~SudokuGridMap() = default;
+#endif
+    // Initializing and output
+    void Preset(const std::string& presetStr);
+    void Print(std::ostream* pSudokuOutStream) const;
+    // Solving a puzzle
+    bool FillCrossing(void);
+    bool IsFilled(void) const;
+    bool IsSolutionOf(const std::string& presetStr) const;
+    SudokuIndex CountFilledCells(void) const;
+    SudokuIndex SelectBacktrackedCellIndex(void) const;
+    INLINE SudokuCellCandidates GetCandidates(SudokuIndex cellIndex) const;
+    INLINE void SetUniqueCell(SudokuIndex cellIndex, SudokuCellCandidates candidate);
+    static SudokuCellCandidates ConvertCharToCandidate(char c);
+    static char ConvertNumberToChar(SudokuIndex number);
+private:
+    using GroupTable = Sudoku::IndexTable<Geometry::SizeOfGroupsPerCell * Geometry::SizeOfAllCells>;
+    using DiagonalTable = Sudoku::IndexTable<2 * Geometry::SizeOfCellsPerGroup>;
+    bool fillNakedSingles(bool& changed);
+    bool fillHiddenSingles(bool& changed);
+    INLINE bool removeCandidateFromNeighbours(SudokuIndex cellIndex);
+    INLINE bool findHiddenSingles(const SudokuIndex* pCellIndexes, bool& changed);
+    INLINE static bool isUniqueCandidate(SudokuCellCandidates candidates);
+
+    SudokuCellCandidates cells_[Geometry::SizeOfAllCells];  // candidates (each of 1..N matches bit 0..N-1)
+    bool placed_[Geometry::SizeOfAllCells];  // cells that removed their number from their neighbours
+
+    // Cells in all columns, all rows, and all boxes (Group_[groupId][groupIndex][position] flattened)
+    static constexpr GroupTable Group_ = Sudoku::MakeIndexTable<&Geometry::GetGroupElement>(
+        typename Sudoku::MakeIndexSequence<Geometry::SizeOfGroupsPerCell * Geometry::SizeOfAllCells>::type {});
+    // Columns, rows, and boxes which all cells belong to (ReverseGroup_[cellIndex][groupId] flattened)
+    static constexpr GroupTable ReverseGroup_ = Sudoku::MakeIndexTable<&Geometry::GetReverseGroupElement>(
+        typename Sudoku::MakeIndexSequence<Geometry::SizeOfGroupsPerCell * Geometry::SizeOfAllCells>::type {});
+    // Cells on the two diagonal bars (Diagonal_[bar][position] flattened)
+    static constexpr DiagonalTable Diagonal_ = Sudoku::MakeIndexTable<&Geometry::GetDiagonalElement>(
+        typename Sudoku::MakeIndexSequence<2 * Geometry::SizeOfCellsPerGroup>::type {});
+};
+
+// Define static constexpr members to refer them before C++17
+template <SudokuIndex BoxSize>
+constexpr typename SudokuGridMap<BoxSize>::GroupTable SudokuGridMap<BoxSize>::Group_;
+template <SudokuIndex BoxSize>
+constexpr typename SudokuGridMap<BoxSize>::GroupTable SudokuGridMap<BoxSize>::ReverseGroup_;
+template <SudokuIndex BoxSize>
+constexpr typename SudokuGridMap<BoxSize>::DiagonalTable SudokuGridMap<BoxSize>::Diagonal_;
+
+// A Sudoku solver for puzzles in any size
+template <SudokuIndex BoxSize>
+class SudokuGridSolver : public SudokuBaseSolver {
+    // unit tests
+    friend class SudokuGridMapTest;
+public:
+    SudokuGridSolver(const std::string& presetStr, std::ostream* pSudokuOutStream);
+    virtual ~SudokuGridSolver() = default;
+    virtual bool Exec(bool silent, bool verbose) override;
+    virtual void PrintType(void) override;
+    virtual void Reset(const std::string& presetStr) override;
+    SudokuPatternCount CountUpTo(SudokuPatternCount maxCount);
+    bool IsSolutionOf(const std::string& presetStr) const;
+private:
+    bool solve(SudokuGridMap<BoxSize>& map, bool verbose);
+    void count(SudokuGridMap<BoxSize>& map, SudokuPatternCount maxCount, SudokuPatternCount& patternCount);
+
+    SudokuGridMap<BoxSize> map_;  // A sudoku puzzle (we copy it in backtracking)
 };
 
+#if defined(SUDOKU_SOA_MAP)
+// All cells of a 16x16 puzzle in solving C++ with AVX2 intrinsics
+// A row of 16 cells fills a YMM register and all rows fit in 16 YMM registers.
+// A column is a lane of all rows and a box is a 64-bit word of four rows,
+// so that this map needs no copies of cells in boxes unlike SudokuSoaMap.
+class SudokuSoa16Map {
+    // unit tests
+    friend class SudokuSoa16MapTest;
+
+public:
+    using Geometry = SudokuGeometry<4>;
+    SudokuSoa16Map(void);
+#ifndef NO_DESTRUCTOR
+    ALLOW_VIRTUAL ~SudokuSoa16Map() = default;
+#endif
+    // Initializing and output
+    void Preset(const std::string& presetStr);
+    void Print(std::ostream* pSudokuOutStream) const;
+    // Solving a puzzle
+    bool FillCrossing(void);
+    bool IsFilled(void) const;
+    bool IsSolutionOf(const std::string& presetStr) const;
+    SudokuIndex CountFilledCells(void) const;
+    SudokuIndex SelectBacktrackedCellIndex(void) const;
+    INLINE SudokuCellCandidates GetCandidates(SudokuIndex cellIndex) const;
+    INLINE void SetUniqueCell(SudokuIndex cellIndex, SudokuCellCandidates candidate);
+private:
+    using Lane = uint16_t;
+    static constexpr SudokuIndex SudokuLaneCnt = 16;
+    static_assert(SudokuLaneCnt == Geometry::SizeOfCellsPerGroup, "A row must fill a YMM register");
+
+    bool fillCrossingOnce(bool& changed);
+    bool fillDiagonalBars(bool& changed);
+    SudokuGridMap<4> toGridMap(void) const;
+
+    // Cells in rows (rows_[row][column])
+    alignas(32) Lane rows_[Geometry::SizeOfGroupsPerMap][SudokuLaneCnt];
+};
+
+// A Sudoku solver for 16x16 puzzles with C++ and AVX2 intrinsics
+class SudokuSoa16Solver : public SudokuBaseSolver {
+    // unit tests
+    friend class SudokuSoa16MapTest;
+public:
+    SudokuSoa16Solver(const std::string& presetStr, std::ostream* pSudokuOutStream);
+    virtual ~SudokuSoa16Solver() = default;
+    virtual bool Exec(bool silent, bool verbose) override;
+    virtual void PrintType(void) override;
+    virtual void Reset(const std::string& presetStr) override;
+    SudokuPatternCount CountUpTo(SudokuPatternCount maxCount);
+    bool IsSolutionOf(const std::string& presetStr) const;
+private:
+    bool solve(SudokuSoa16Map& map, bool verbose);
+    void count(SudokuSoa16Map& map, SudokuPatternCount maxCount, SudokuPatternCount& patternCount);
+
+    SudokuSoa16Map map_;  // A sudoku puzzle (we copy it in backtracking because it is small)
+};
+#endif
+
 // A cell in solving assembly
 class SudokuSseCell {
     // unit tests
@@ -367,22 +913,41 @@ private:
     SudokuSseElement candidates_;   // Candidates (each of 1..9 matches bit 0..8)
 };
 
+class SudokuSseEnumeratorMap;
+
+// Variables to count solutions of a puzzle in assembly.
+// Each SudokuSseEnumeratorMap has its own block and passes it to sudokuXmmCountFromCell
+// so threads can count solutions of their puzzles at the same time.
+// The assembly code accesses members with their offsets (enumContext* in sudokusse.s).
+struct SudokuSseEnumeratorContext {
+    uint64_t printAllCandidate;  // Non-zero if printing candidates of a puzzle
+    uint64_t rightBottomElement; // Initial candidates of the bottom-right cell in a puzzle
+    uint64_t rightBottomSolved;  // Solved candidate of the bottom-right cell in a puzzle
+    uint64_t allPatternCnt;      // Number of solutions in a puzzle
+    uint64_t stackPointer;       // RSP register value before calling sudokuXmmPrintFunc
+    uint64_t returnAddr;         // Address to return after counting solutions
+    SudokuSseEnumeratorMap* pInstance;  // PrintPattern() -> SudokuSseEnumeratorMap::PrintFromAsm
+    uint64_t reserved;           // Aligns xmmToPrint on 16 bytes boundary
+    XmmRegisterSet xmmToPrint;   // XMM registers that hold a solution
+};
+
+static_assert(offsetof(SudokuSseEnumeratorContext, printAllCandidate) == 0, "Unexpected offset");
+static_assert(offsetof(SudokuSseEnumeratorContext, rightBottomElement) == 8, "Unexpected offset");
+static_assert(offsetof(SudokuSseEnumeratorContext, rightBottomSolved) == 16, "Unexpected offset");
+static_assert(offsetof(SudokuSseEnumeratorContext, allPatternCnt) == 24, "Unexpected offset");
+static_assert(offsetof(SudokuSseEnumeratorContext, stackPointer) == 32, "Unexpected offset");
+static_assert(offsetof(SudokuSseEnumeratorContext, returnAddr) == 40, "Unexpected offset");
+static_assert(offsetof(SudokuSseEnumeratorContext, xmmToPrint) == 64, "Unexpected offset");
+
 // Define these variables in assembly .s files.
 extern "C" {
-    // Member functions of SudokuSseEnumeratorMap
-    // These are variables global and are not for multi-threading.
-    extern volatile uint64_t sudokuXmmPrintAllCandidate;
-    extern volatile uint64_t sudokuXmmRightBottomElement;
-    extern volatile uint64_t sudokuXmmRightBottomSolved;
-    extern volatile uint64_t sudokuXmmAllPatternCnt;
-    // PrintPattern() -> SudokuSseEnumeratorMap::PrintFromAsm
-    extern XmmRegisterSet sudokuXmmToPrint;
-
     // These variables are set before running on multi-threading and
     // are read-only from threads. So it is allowed they are non-thread-local variables.
     extern volatile uint64_t sudokuXmmPrintFunc;  // main()
     extern volatile uint64_t sudokuXmmAssumeCellsPacked; // SudokuLoader::CanLaunch()
-    extern volatile uint64_t sudokuXmmUseAvx;     // unused
+    extern volatile uint64_t sudokuXmmUseAvx;     // SudokuSseLaneSolver::CanSolve()
+    extern volatile uint64_t sudokuXmmUseAvx512;  // SudokuSseLaneSolver::GetLaneCount()
+    extern volatile uint64_t sudokuXmmIsaSet;     // Sudoku::CanUseIsa()
 
     // sudokuXmmDebug is used for debugging only and not suitable for multi-threading.
     extern volatile uint64_t sudokuXmmDebug;
@@ -405,10 +970,27 @@ struct SudokuSseMapResult {
     gRegister nextRowNumber;
 };
 
+// Results for solving with backtracking in sudokusse.s
+struct SudokuSseSearchResult {
+    gRegister aborted;
+    gRegister elementCnt;
+    gRegister stepCnt;
+};
+
+// Results for solving multiple puzzles at once in sudokusse.s
+struct SudokuSseLaneResult {
+    gRegister aborted;  // n-th bit is set if a puzzle in n-th lane has no solution
+    gRegister elementCnt[SudokuSse::MaxLaneCnt];
+};
+
 // All cells in solving assembly
 class SudokuSseMap {
+    // prints solutions
+    friend class SudokuSseMapEnumerator;
     // unit tests
     friend class SudokuSseMapTest;
+    friend class SudokuSseSolverTest;
+    friend class SudokuBranchSelectorTest;
     template <class TestedT, class CandidatesT> friend class SudokuSolverCommonTest;
 private:
     static constexpr size_t InitialRegisterNum = 1;  // The number of an XMM register which holds the top row
@@ -419,11 +1001,23 @@ public:
     ALLOW_VIRTUAL ~SudokuSseMap() = default;
 #endif
     void Preset(const std::string& presetStr);
+    void PresetRecord(const uint8_t* pPuzzleRecord);
     void Print(std::ostream* pSudokuOutStream) const;
     void FillCrossing(bool loadXmm, SudokuSseMapResult& result);
+    void SearchCrossing(SudokuSseSearchResult& result);
+    void FillCrossingWithIntrinsics(SudokuSseMapResult& result);
+    bool FindSubsets(void);
+    static void FillCrossingInLanes(SudokuSseMap* const mapSet[], size_t laneCnt, SudokuSseLaneResult& result);
     INLINE bool GetNextCell(const SudokuSseMapResult& result, SudokuSseCandidateCell& cell);
+    INLINE bool FindNextCell(SudokuSseCandidateCell& cell) const;
+    INLINE SudokuSseElement GetCandidates(const SudokuSseCandidateCell& cell) const;
+    INLINE SudokuIndex OrderCandidates(const SudokuSseCandidateCell& cell, SudokuCellCandidates (&orderedSet)[Sudoku::SizeOfCandidates]) const;
     INLINE bool CanSetUniqueCell(const SudokuSseCandidateCell& cell, SudokuCellCandidates candidate) const;
     INLINE void SetUniqueCell(const SudokuSseCandidateCell& cell, SudokuCellCandidates candidate);
+private:
+    bool fillDiagonalCells(bool& changed);
+    INLINE bool findNextCellInRows(SudokuSseCandidateCell& cell) const;
+    INLINE static void getCell(SudokuLoopIndex cellIndex, SudokuSseCandidateCell& cell);
 };
 
 // All cells to counting solutions of a puzzle in assembly
@@ -438,8 +1032,8 @@ private:
     SudokuCellCandidates rightBottomElement_;
     gRegister firstCell_;
     SudokuPatternCount patternNumber_;
-    static SudokuSseEnumeratorMap* pInstance_;
     XmmRegisterSet xmmRegSet_;
+    SudokuSseEnumeratorContext context_;  // owned by this object and not shared with other threads
 public:
     SudokuSseEnumeratorMap(std::ostream* pSudokuOutStream);
     virtual ~SudokuSseEnumeratorMap();
@@ -450,13 +1044,62 @@ public:
     void Print(bool solved, const XmmRegisterSet& xmmRegSet) const;
     void PrintFromAsm(const XmmRegisterSet& xmmRegSet);
     SudokuPatternCount Enumerate(void);
-    static SudokuSseEnumeratorMap* GetInstance(void);
+    SudokuPatternCount Count(void);
 private:
     void presetCell(SudokuLoopIndex index, int num);
     size_t powerOfTwoPlusOne(SudokuSseElement regValue) const;
     std::ostream* pSudokuOutStream_;
 };
 
+// Counting solutions of a puzzle in any order of cells
+// This fills cells with the assembly code, guesses a cell which has the fewest candidates,
+// and counts solutions recursively. It does not assume preset cells are packed at the
+// top-left corner of a puzzle unlike SudokuSseEnumeratorMap.
+class SudokuSseMapEnumerator {
+    // unit tests
+    friend class SudokuSseMapEnumeratorTest;
+public:
+    SudokuSseMapEnumerator(std::ostream* pSudokuOutStream, SudokuPatternCount printAllCandidate);
+    virtual ~SudokuSseMapEnumerator() = default;
+    SudokuSseMapEnumerator(const SudokuSseMapEnumerator&) = delete;
+    SudokuSseMapEnumerator& operator =(const SudokuSseMapEnumerator&) = delete;
+    void SetMaxCount(SudokuPatternCount maxCount);
+    SudokuPatternCount Enumerate(const SudokuSseMap& map);
+    static bool IsSuitable(const SudokuSseMap& map);
+private:
+    void count(SudokuSseMap& map);
+    void printSolution(const SudokuSseMap& map);
+    static SudokuSseElement getCandidates(const SudokuSseMap& map, SudokuLoopIndex cellIndex);
+    SudokuPatternCount printAllCandidate_;  // how many solutions to print
+    SudokuPatternCount patternNumber_;      // how many solutions printed
+    SudokuPatternCount patternCount_;       // how many solutions found
+    SudokuPatternCount maxPatternCount_;    // stops searching when it finds this number of solutions
+    std::ostream* pSudokuOutStream_;
+};
+
+// Counting solutions of a puzzle on multiple threads
+// This fills blank cells from the top-left corner to split the search tree into
+// subtrees and counts solutions in each subtree with a SudokuSseEnumeratorMap.
+class SudokuSseParallelEnumerator {
+    // unit tests
+    friend class SudokuSseParallelEnumeratorTest;
+public:
+    using NumberOfCores = Sudoku::BaseParallelRunner::NumberOfCores;
+    static constexpr SudokuIndex DefaultSplitDepth = 3;  // the number of blank cells to fill before splitting
+    SudokuSseParallelEnumerator(const std::string& presetStr, SudokuIndex splitDepth);
+    virtual ~SudokuSseParallelEnumerator() = default;
+    SudokuSseParallelEnumerator(const SudokuSseParallelEnumerator&) = delete;
+    SudokuSseParallelEnumerator& operator =(const SudokuSseParallelEnumerator&) = delete;
+    SudokuPatternCount Enumerate(Sudoku::BaseParallelRunner& parallelRunner, NumberOfCores numberOfThreads);
+    SudokuPuzzleCount GetSubtreeCount(void) const;
+private:
+    static constexpr char BlankCell = '.';
+    void split(std::string& puzzle, SudokuLoopIndex cellIndex, SudokuIndex depth);
+    bool canSetCell(const std::string& puzzle, SudokuLoopIndex cellIndex, char cell) const;
+    std::vector<std::string> subtreeSet_;  // puzzles that have filled cells in addition to a preset puzzle
+    bool inAnyOrder_;  // true if counting solutions with SudokuSseMapEnumerator
+};
+
 // A Sudoku solver with assembly
 class SudokuSseSolver : public SudokuBaseSolver {
     // unit tests
@@ -469,15 +1112,75 @@ public:
     virtual ~SudokuSseSolver() = default;
     virtual bool Exec(bool silent, bool verbose) override;
     virtual void Enumerate(void);
+    virtual SudokuPatternCount CountUpTo(SudokuPatternCount maxCount);
+    virtual void Enumerate(const std::string& presetStr, Sudoku::BaseParallelRunner& parallelRunner,
+                           SudokuSseParallelEnumerator::NumberOfCores numberOfThreads, SudokuIndex splitDepth);
     virtual void PrintType(void) override;
+    virtual void Reset(const std::string& presetStr) override;
 private:
-    void initialize(const std::string& presetStr, std::ostream* pSudokuOutStream);
     bool solve(SudokuSseMap& map, bool topLevel, bool verbose);
     bool fillCells(SudokuSseMap& map, bool topLevel, bool verbose, SudokuSseMapResult& result);
+    bool searchCells(SudokuSseMap& map);
 
     SudokuSseMap map_;    // a sudoku puzzle (we allocate copies of this in backtracking)
-    SudokuSseEnumeratorMap enumeratorMap_;
+    SudokuSseEnumeratorMap enumeratorMap_;  // preset only when enumerating solutions
     SudokuPatternCount printAllCandidate_;
+    std::string presetStr_;  // a puzzle to preset enumeratorMap_
+};
+
+// A Sudoku solver with SSE 4.2 intrinsics
+// This applies the same rules as solveSudokuAsm to the same registers layout and
+// guesses cells in the same order as searchSudokuAsm, so compilers can inline it.
+class SudokuSseIntrinsicsSolver : public SudokuBaseSolver {
+    // unit tests
+    friend class SudokuSseSolverTest;
+public:
+    SudokuSseIntrinsicsSolver(const std::string& presetStr, std::ostream* pSudokuOutStream);
+    virtual ~SudokuSseIntrinsicsSolver() = default;
+    virtual bool Exec(bool silent, bool verbose) override;
+    virtual void PrintType(void) override;
+    virtual void Reset(const std::string& presetStr) override;
+private:
+    bool solve(SudokuSseMap& map, bool verbose);
+
+    SudokuSseMap map_;  // a sudoku puzzle (we copy it in backtracking as searchSudokuAsm does)
+};
+
+// Solving puzzles at once in 128-bit lanes of YMM (two puzzles) or ZMM (four puzzles) registers
+class SudokuSseLaneSolver {
+    // unit tests
+    friend class SudokuSseSolverTest;
+public:
+    SudokuSseLaneSolver(void);
+    virtual ~SudokuSseLaneSolver() = default;
+    SudokuSseLaneSolver(const SudokuSseLaneSolver&) = delete;
+    SudokuSseLaneSolver& operator =(const SudokuSseLaneSolver&) = delete;
+    static bool CanSolve(void);
+    static size_t GetLaneCount(void);
+    SudokuPuzzleCount Solve(std::vector<SudokuSseMap>& mapSet);
+    SudokuPatternCount GetStepCount(void) const;
+    SudokuPatternCount GetGuessCount(void) const;
+private:
+    // A guessed cell and its candidates not guessed yet
+    struct Frame {
+        SudokuSseMap           map;
+        SudokuSseCandidateCell cell;
+        SudokuSseElement       candidates;
+    };
+    // A puzzle in a half of YMM registers
+    struct Lane {
+        bool   active;
+        bool   started;
+        size_t mapIndex;
+        SudokuSseMap map;
+        std::vector<Frame> frameSet;
+    };
+    bool assign(Lane& lane, size_t& nextMapIndex, const std::vector<SudokuSseMap>& mapSet);
+    bool guess(Lane& lane);
+    size_t laneCnt_;
+    SudokuPatternCount stepCnt_;   // counts how many times lanes fill cells
+    SudokuPatternCount guessCnt_;  // counts how many times lanes guess candidates
+    Lane laneSet_[SudokuSse::MaxLaneCnt];
 };
 
 // Checking solutions are correct and meet constraints for Sudoku
@@ -486,7 +1189,14 @@ class SudokuChecker {
     // unit tests
     friend class SudokuCheckerTest;
 public:
+    // Strings to parse a solution which a caller reuses for other solutions
+    struct Buffer {
+        std::string rowLine;
+        std::string solutionLine;
+    };
     SudokuChecker(const std::string& puzzle, const std::string& solution, SudokuSolverPrint printSolution, std::ostream* pSudokuOutStream);
+    SudokuChecker(const std::string& puzzle, const std::string& solution, SudokuSolverPrint printSolution,
+                  std::ostream* pSudokuOutStream, Buffer& buffer);
     virtual ~SudokuChecker() = default;
     SudokuChecker(const SudokuChecker&) = delete;
     SudokuChecker& operator =(const SudokuChecker&) = delete;
@@ -495,7 +1205,8 @@ private:
     // Allocate these arrays on stack to avoid false sharing on heap.
     using Group = std::array<SudokuNumber, Sudoku::SizeOfCellsPerGroup>;
     using Grid = std::array<Group, Sudoku::SizeOfGroupsPerMap>;
-    bool parse(const std::string& puzzle, const std::string& solution, SudokuSolverPrint printSolution, std::ostream* pSudokuOutStream);
+    bool parse(const std::string& puzzle, const std::string& solution, SudokuSolverPrint printSolution,
+               std::ostream* pSudokuOutStream, Buffer& buffer);
     bool parseRow(SudokuIndex row, const std::string& rowLine, Grid& grid, std::string& solutionLine);
     bool compare(const std::string& puzzle, const std::string& solution, std::ostream* pSudokuOutStream);
     bool check(const Grid& grid, std::ostream* pSudokuOutStream);
@@ -507,9 +1218,92 @@ private:
     bool valid_;
 };
 
+// Puzzles in a binary file (see sudokusse.md). A 16-byte header is followed by
+// fixed-size records of 9x9 puzzles that hold a cell in four bits, so that a thread
+// finds the N-th puzzle without parsing preceding ones.
+class SudokuPuzzleRecord {
+public:
+    static constexpr size_t SizeOfHeader = 16;
+    static constexpr size_t SizeOfRecord = (Sudoku::SizeOfAllCells + 1) / 2;
+    static constexpr uint16_t Version = 1;
+    using Record = std::vector<uint8_t>;
+    static bool IsRecordFile(const char* pData, size_t size);
+    // Reads the magic or the first line from a stream which cannot rewind
+    static bool IsRecordStream(std::istream& is, std::string& firstLine);
+    // Returns false if the header is invalid or records are truncated
+    static bool GetSize(const char* pData, size_t size, SudokuPuzzleCount& sizeOfRecords);
+    static const uint8_t* GetRecord(const char* pData, SudokuPuzzleCount index);
+    // Returns 0 for a blank cell
+    static SudokuIndex GetNumber(const uint8_t* pRecord, SudokuIndex cellIndex);
+    static void WriteHeader(SudokuPuzzleCount sizeOfRecords, std::string& header);
+    // Returns false for puzzles larger than 9x9
+    static bool Encode(const std::string& puzzleLine, Record& record);
+    static void Decode(const uint8_t* pRecord, std::string& puzzleLine);
+private:
+    static constexpr char Magic[] = "SDKB";
+    static constexpr size_t SizeOfMagic = 4;
+};
+
 class SudokuDispatcherTest;
 class SudokuMultiDispatcherTest;
 
+// A stream buffer which keeps its capacity after cleared.
+// std::ostringstream copies its string to read it.
+class SudokuReusableStringBuffer : public std::streambuf {
+public:
+    SudokuReusableStringBuffer(void) = default;
+    virtual ~SudokuReusableStringBuffer() = default;
+    SudokuReusableStringBuffer(const SudokuReusableStringBuffer&) = delete;
+    SudokuReusableStringBuffer& operator =(const SudokuReusableStringBuffer&) = delete;
+    const std::string& GetString(void) const;
+    void Clear(void);
+protected:
+    virtual int_type overflow(int_type c) override;
+    virtual std::streamsize xsputn(const char_type* s, std::streamsize n) override;
+private:
+    std::string str_;
+};
+
+class SudokuDispatcher;
+class SudokuMultiDispatcher;
+
+// Solvers and buffers which a thread reuses to solve puzzles one after another.
+// Dispatchers reset them for each puzzle instead of constructing them, so that
+// solving 9x9 puzzles does not allocate memory after the buffers grow enough.
+// Solvers in this object may be aligned to 32 bytes, so allocate it on a stack.
+class SudokuDispatcherWorkspace final {
+    friend class SudokuDispatcher;
+    friend class SudokuMultiDispatcher;
+    // unit tests
+    friend class SudokuDispatcherTest;
+    friend class SudokuMultiDispatcherTest;
+public:
+    SudokuDispatcherWorkspace(void);
+    ~SudokuDispatcherWorkspace() = default;
+    SudokuDispatcherWorkspace(const SudokuDispatcherWorkspace&) = delete;
+    SudokuDispatcherWorkspace& operator =(const SudokuDispatcherWorkspace&) = delete;
+private:
+    SudokuBaseSolver& resetSolver(SudokuSolverType solverType, const std::string& puzzleLine);
+    std::string puzzleLine_;  // a puzzle copied from a mapped file
+    SudokuReusableStringBuffer solutionBuffer_;
+    SudokuReusableStringBuffer messageBuffer_;
+    std::ostream solutionStream_;  // solvers write solutions to solutionBuffer_
+    std::ostream messageStream_;   // checkers write results to messageBuffer_
+    SudokuChecker::Buffer checkerBuffer_;
+    // Exec() does not refer printAllCandidate of solvers
+    SudokuSolver solver_;
+    SudokuSseSolver sseSolver_;
+#if defined(SUDOKU_SOA_MAP)
+    SudokuSoaSolver soaSolver_;
+#endif
+    SudokuSseIntrinsicsSolver sseIntrinsicsSolver_;
+    SudokuBitplaneSolver bitplaneSolver_;
+    // Puzzles in lanes
+    std::vector<size_t> laneIndexSet_;
+    std::vector<SudokuSseMap> mapSet_;
+    SudokuSseLaneSolver laneSolver_;
+};
+
 // Reading and solving a puzzle in a thread.
 // This class is movable and cannot be inherited to be pushed to a vector.
 class SudokuDispatcher final {
@@ -520,21 +1314,107 @@ class SudokuDispatcher final {
 public:
     SudokuDispatcher(SudokuSolverType solverType, SudokuSolverCheck check, SudokuSolverPrint print,
                      SudokuPatternCount printAllCandidate, SudokuPuzzleCount puzzleNum, const std::string& puzzleLine);
+    // Refers a puzzle in a mapped file and copies it when solving it
+    SudokuDispatcher(SudokuSolverType solverType, SudokuSolverCheck check, SudokuSolverPrint print,
+                     SudokuPatternCount printAllCandidate, SudokuPuzzleCount puzzleNum,
+                     const char* pPuzzleLine, size_t sizeOfPuzzleLine);
+    // Refers a SudokuPuzzleRecord in a mapped file and decodes it when solving it in C++
+    SudokuDispatcher(SudokuSolverType solverType, SudokuSolverCheck check, SudokuSolverPrint print,
+                     SudokuPatternCount printAllCandidate, SudokuPuzzleCount puzzleNum, const uint8_t* pPuzzleRecord);
     // Do not define a destructor to make this movable.
     bool Exec(void);
+    bool Exec(SudokuDispatcherWorkspace& workspace);
+    void Preset(SudokuSseMap& map, SudokuDispatcherWorkspace& workspace);
+    bool Exec(const SudokuSseMap& map, SudokuDispatcherWorkspace& workspace);
     const std::string& GetMessage(void) const;
+    SudokuIndex GetBoxSize(void) const;
+    SudokuPatternCount GetStepCount(void) const;
+    SudokuPatternCount GetGuessCount(void) const;
 private:
-    bool exec(SudokuBaseSolver& solver, std::ostringstream& ss);
+    template <typename Solver> bool execGrid(const std::string& puzzleLine);
+    bool exec(SudokuBaseSolver& solver, const std::string& puzzleLine, SudokuDispatcherWorkspace& workspace);
+    bool check(const std::string& puzzleLine, SudokuDispatcherWorkspace& workspace);
+    template <typename Solver> bool checkUnique(Solver& solver, const std::string& puzzleLine);
+    const std::string& getPuzzleLine(std::string& buffer) const;
     SudokuSolverType   solverType_;   // How to solve Sudoku puzzles in lines
     SudokuSolverCheck  check_;        // Whether or not checking solutions
     SudokuSolverPrint  print_;        // Whether or not printing results
     SudokuPatternCount printAllCandidate_;
     SudokuPuzzleCount  puzzleNum_;
+    const char* pPuzzleLine_;   // a puzzle in a mapped file copied to a workspace when solving it
+    const uint8_t* pPuzzleRecord_; // a puzzle record in a mapped file decoded to a workspace
+    size_t sizeOfPuzzleLine_;
     std::string puzzleLine_;
     std::string message_;  // written to an output stream
+    SudokuPatternCount stepCount_;   // how many times a solver filled cells
+    SudokuPatternCount guessCount_;  // how many times a solver guessed candidates
+};
+
+// Sharing puzzles in a file among threads with work stealing.
+// Each worker has a deque of chunks (ranges of puzzle indexes) and takes a part of the front chunk
+// in proportion to its size, so chunks shrink as puzzles run out. A worker whose deque is empty
+// steals the latter half of the largest chunk from the back of another deque.
+class SudokuPuzzleChunkQueue {
+    // unit tests
+    friend class SudokuPuzzleChunkQueueTest;
+public:
+    using Chunk = std::pair<size_t, size_t>;  // [begin, end)
+    SudokuPuzzleChunkQueue(size_t sizeOfPuzzle, size_t numberOfWorkers);
+    virtual ~SudokuPuzzleChunkQueue() = default;
+    SudokuPuzzleChunkQueue(const SudokuPuzzleChunkQueue&) = delete;
+    SudokuPuzzleChunkQueue& operator =(const SudokuPuzzleChunkQueue&) = delete;
+    // Returns false if no puzzles are left
+    bool Pop(size_t workerIndex, Chunk& chunk);
+private:
+#if defined(NO_PARALLEL)
+    // One thread takes all chunks without locks
+    struct Mutex {};
+    struct LockGuard {
+        explicit LockGuard(Mutex&) {}
+    };
+#elif defined(SOLVE_PARALLEL_WITH_BOOST_THREAD)
+    using Mutex = boost::mutex;
+    using LockGuard = boost::lock_guard<Mutex>;
+#else
+    using Mutex = std::mutex;
+    using LockGuard = std::lock_guard<Mutex>;
+#endif
+    struct Worker {
+        Mutex mutex;
+        std::deque<Chunk> chunkSet;
+    };
+    bool popFront(Worker& worker, Chunk& chunk);
+    bool steal(size_t workerIndex, Chunk& chunk);
+    std::vector<std::unique_ptr<Worker>> workerSet_;
+    static constexpr size_t MinChunkSize = 16;  // the lane solver needs some puzzles to fill its lanes
+    static constexpr size_t ChunkDivisor = 4;   // takes a quarter of a chunk at once
+};
+
+// Finding puzzles in lines of a mapped file without copying them.
+// A window of the file is split into byte ranges and threads find lines in the ranges at once.
+// A line belongs to the range that holds its first byte.
+class SudokuPuzzleLineParser {
+    // unit tests
+    friend class SudokuPuzzleLineParserTest;
+public:
+    using Line = std::pair<const char*, size_t>;  // a head and length without a newline
+    using LineSet = std::vector<Line>;
+    SudokuPuzzleLineParser(const char* pData, size_t size);
+    virtual ~SudokuPuzzleLineParser() = default;
+    SudokuPuzzleLineParser(const SudokuPuzzleLineParser&) = delete;
+    SudokuPuzzleLineParser& operator =(const SudokuPuzzleLineParser&) = delete;
+    // Returns false at the end of the data or an empty line
+    bool Parse(size_t sizeOfWindow, size_t numberOfRanges, Sudoku::BaseParallelRunner& runner, LineSet& lineSet);
+private:
+    static void findLines(const char* pBegin, const char* pRangeBegin, const char* pRangeEnd,
+                          const char* pEnd, LineSet& lineSet);
+    const char* pData_;
+    size_t size_;
+    size_t offset_;  // the head of the next window
+    std::vector<LineSet> rangeLineSet_;  // reused in windows
 };
 
-// Reading and solving puzzles in a thread
+// Reading and solving puzzles in threads
 class SudokuMultiDispatcher {
 public:
     // unit tests
@@ -546,10 +1426,21 @@ public:
     SudokuMultiDispatcher(const SudokuMultiDispatcher&) = delete;
     SudokuMultiDispatcher& operator =(const SudokuMultiDispatcher&) = delete;
     virtual void AddPuzzle(SudokuPuzzleCount puzzleNum, const std::string& puzzleLine);
+    virtual void AddPuzzle(SudokuPuzzleCount puzzleNum, const char* pPuzzleLine, size_t sizeOfPuzzleLine);
+    virtual void AddRecord(SudokuPuzzleCount puzzleNum, const uint8_t* pPuzzleRecord);
     virtual bool ExecAll(void);
+    // Threads can solve puzzles in distinct ranges at once
+    virtual bool ExecRange(size_t begin, size_t end);
+    virtual bool ExecRange(size_t begin, size_t end, SudokuDispatcherWorkspace& workspace);
+    virtual size_t GetSize(void) const;
     virtual const std::string& GetMessage(size_t index) const;
+    virtual SudokuPatternCount GetStepCount(void) const;
+    virtual SudokuPatternCount GetGuessCount(void) const;
 private:
+    bool execLanes(size_t begin, size_t end, SudokuDispatcherWorkspace& workspace);
     std::vector<SudokuDispatcher> dipatcherSet_;
+    std::atomic<SudokuPatternCount> laneStepCount_;   // steps of puzzles solved in lanes
+    std::atomic<SudokuPatternCount> laneGuessCount_;  // guesses of puzzles solved in lanes
     // Same as SudokuDispatcher
     SudokuSolverType   solverType_;
     SudokuSolverCheck  check_;
@@ -576,20 +1467,37 @@ public:
 private:
     using ExitStatusCode = int;
     using NumberOfCores = Sudoku::BaseParallelRunner::NumberOfCores;
-    using DispatcherPtr = std::unique_ptr<SudokuMultiDispatcher>;
-    using DispatcherPtrSet = std::vector<DispatcherPtr>;
 
     static int getMeasureCount(const char *arg);
     void setSingleMode(int argc, const char * const argv[], std::istream* pSudokuInStream);
     bool setMultiMode(int argc, const char * const argv[]);
     bool setNumberOfThreads(int argc, const char * const argv[], int argIndex);
+    bool setSplitDepth(int argc, const char * const argv[], int argIndex);
+    bool setIsa(int argc, const char * const argv[], int argIndex);
+    void selectIsa(void);
+    bool setSubsets(int argc, const char * const argv[], int argIndex);
+    bool setBranchPolicy(int argc, const char * const argv[], int argIndex);
+    bool setValueOrder(int argc, const char * const argv[], int argIndex);
+    bool setSteps(int argc, const char * const argv[], int argIndex);
     ExitStatusCode execSingle(void);
     ExitStatusCode execMulti(void);
     ExitStatusCode execMulti(std::istream* pSudokuInStream);
+    ExitStatusCode execMulti(const char* pData, size_t size);
+    ExitStatusCode execRecords(const char* pData, SudokuPuzzleCount sizeOfRecords);
+    // Fills a window with puzzles and returns false after the last window
+    using WindowReader = std::function<bool(SudokuMultiDispatcher& dispatcher)>;
+    ExitStatusCode execWindows(WindowReader& reader, SudokuPuzzleCount& sizeOfPuzzle,
+                               SudokuPatternCount& stepCount, SudokuPatternCount& guessCount);
+    ExitStatusCode execWindow(SudokuMultiDispatcher& dispatcher, SudokuPatternCount& stepCount,
+                              SudokuPatternCount& guessCount);
+    void writeSummary(ExitStatusCode result, SudokuPuzzleCount sizeOfPuzzle,
+                      SudokuPatternCount stepCount, SudokuPatternCount guessCount);
     void printHeader(SudokuSolverType solverType, std::ostream* pSudokuOutStream);
-    SudokuPuzzleCount readLines(NumberOfCores numberOfCores, std::istream* pSudokuInStream, DispatcherPtrSet& dispatcherSet);
-    ExitStatusCode execAll(NumberOfCores numberOfCores, DispatcherPtrSet& dispatcherSet);
-    void writeMessage(NumberOfCores numberOfCores, SudokuPuzzleCount sizeOfPuzzle, DispatcherPtrSet& dispatcherSet, std::ostream* pSudokuOutStream);
+    SudokuPuzzleCount readLines(std::istream* pSudokuInStream, SudokuMultiDispatcher& dispatcher,
+                                SudokuPuzzleCount firstLineNum, SudokuPuzzleCount maxSizeOfPuzzle);
+    ExitStatusCode execAll(NumberOfCores numberOfCores, SudokuMultiDispatcher& dispatcher);
+    void addSolvers(NumberOfCores numberOfWorkers, SudokuMultiDispatcher& dispatcher, SudokuPuzzleChunkQueue& chunkQueue);
+    void writeMessage(SudokuPuzzleCount sizeOfPuzzle, const SudokuMultiDispatcher& dispatcher, std::ostream* pSudokuOutStream);
     void measureTimeToSolve(SudokuSolverType solverType);
     SudokuTime solveSudoku(SudokuSolverType solverType, int count, bool warmup);
     SudokuTime enumerateSudoku(void);
@@ -598,22 +1506,34 @@ private:
     std::string multiLineFilename_;      // name of a file that holds Sudoku puzzles in lines.
     std::unique_ptr<Sudoku::BaseParallelRunner> pParallelRunner_;  // set of parallel runners of solvers
     NumberOfCores     numberOfThreads_;  // How many threads solving puzzles
+    SudokuIndex       splitDepth_;       // How many blank cells are filled before counting solutions in parallel
     SudokuSolverType  solverType_;  // How to solve Sudoku puzzles
     SudokuSolverCheck check_;       // Whether or not checking solutions
     SudokuSolverPrint print_;       // Whether or not printing results
+    SudokuIsa         isa_;         // Which instruction set the assembly code uses
+    bool              isaSpecified_; // true if a command line argument designates an instruction set
+    std::string       invalidArg_;  // a command line argument with an unknown name, which stops solving puzzles
+    bool              findSubsets_; // Whether or not finding naked and hidden subsets
+    SudokuBranchPolicy branchPolicy_; // How to select a cell to guess
+    SudokuValueOrder  valueOrder_;  // How to order candidates to guess
+    bool              printSteps_;  // Whether or not printing how many times solvers filled cells and guessed
     bool   isBenchmark_;    // true when it runs for benchmarking
     bool   verbose_;        // true if printing steps to solving a puzzle
     int    measureCount_;   // how many times it solves a puzzle
     SudokuPatternCount printAllCandidate_;
+    std::istream* pSudokuInStream_;   // supplies puzzles in lines when reading from stdin
     std::ostream* pSudokuOutStream_;  // receives strings to write
     static constexpr NumberOfCores DefaultNumberOfThreads = 1;  // the default number of threads
+    // Solves puzzles in windows to keep memory flat and write first results early
+    static constexpr SudokuPuzzleCount InitialWindowSize = 64;
+    static constexpr SudokuPuzzleCount MaxWindowSize = 16384;
     // Exit status set that is passed to make
     static const ExitStatusCode ExitStatusPassed;
     static const ExitStatusCode ExitStatusFailed;
 };
 
 extern "C" {
-    void PrintPattern(void);
+    void PrintPattern(SudokuSseEnumeratorContext* pContext);
 }
 
 #endif // SUDOKU_H_INCLUDED
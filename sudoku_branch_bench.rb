@@ -0,0 +1,94 @@
+#!/usr/bin/ruby
+# -*- coding: utf-8 -*-
+#
+# Comparing policies to select a cell and its candidate to guess in backtracking
+#
+# usage : ruby sudoku_branch_bench.rb [puzzleFilename ...]
+# This script solves puzzles in each file with each solver, branch policy and value order,
+# and prints how many times the solver filled cells, guesses per puzzle and the shortest elapsed time.
+
+require 'rbconfig'
+
+# Detect MinGW
+RUN_ON_MINGW = RbConfig::CONFIG['host_os'].include?("mswin") || RbConfig::CONFIG['host_os'].include?("mingw")
+
+# SudokuSSE executable name
+DEFAULT_EXEC_FILENAME = RUN_ON_MINGW ? "bin\\sudokusse.exe" : "bin/sudokusse"
+
+# Solvers and their descriptions
+SOLVER_ARGUMENT_SET = ["c++", "avx", "intrinsics"]
+SOLVER_DESCRIPTION_SET = ["C++", "SIMD", "Intrinsics"]
+
+# Branch policies in order of SudokuBranchPolicy
+BRANCH_ARGUMENT_SET = ["fixed", "groups", "mrv"]
+BRANCH_OPTION = "-B"
+
+# Value orders in order of SudokuValueOrder
+VALUE_ORDER_ARGUMENT_SET = ["ascending", "lcv", "places"]
+VALUE_ORDER_OPTION = "-V"
+STEPS_OPTION = "-R"
+
+# Puzzle files if no files are given
+DEFAULT_PUZZLE_FILENAME_SET = ["data/sudoku17.txt", "data/sudoku_example.txt"]
+
+# Takes the shortest time of these trials
+NUMBER_OF_TRIALS = 3
+
+# Report an error
+class SudokuSolverError < StandardError
+end
+
+class BranchBenchmark
+  def initialize(execFilename, puzzleFilename)
+    raise SudokuSolverError, "#{puzzleFilename} not found" unless File.exist?(puzzleFilename)
+    raise SudokuSolverError, "#{execFilename} not found" unless File.exist?(execFilename)
+    @execFilename = execFilename
+    @puzzleFilename = puzzleFilename
+    @descriptionMap = Hash[SOLVER_ARGUMENT_SET.zip(SOLVER_DESCRIPTION_SET)]
+    @descriptionWidth = SOLVER_DESCRIPTION_SET.map(&:length).max
+    @policyWidth = BRANCH_ARGUMENT_SET.map(&:length).max
+    @orderWidth = VALUE_ORDER_ARGUMENT_SET.map(&:length).max
+  end
+
+  def execAll
+    puts "Solving #{@puzzleFilename} with #{@execFilename} (steps, guesses per puzzle, time in seconds)"
+    SOLVER_ARGUMENT_SET.each do |solver|
+      BRANCH_ARGUMENT_SET.each do |policy|
+        VALUE_ORDER_ARGUMENT_SET.each do |order|
+          steps, guesses, time = exec(solver, policy, order)
+          desc = [@descriptionMap[solver].ljust(@descriptionWidth), policy.ljust(@policyWidth),
+                  order.ljust(@orderWidth)].join(" / ")
+          puts "#{desc} : #{steps.to_s.rjust(10)} #{guesses.to_s.rjust(8)} #{sprintf("%8.5f", time)}"
+        end
+      end
+    end
+  end
+
+  def exec(solver, policy, order)
+    command = [@execFilename, @puzzleFilename, solver, BRANCH_OPTION + policy,
+               VALUE_ORDER_OPTION + order, STEPS_OPTION].join(" ")
+    steps = nil
+    guesses = nil
+    leastTime = nil
+
+    NUMBER_OF_TRIALS.times do
+      startTime = Time.now
+      log = `#{command}`
+      stopTime = Time.now
+      raise SudokuSolverError, "Failed #{command}" unless $?.success? && log.include?("passed")
+
+      steps = log.lines.grep(/^Steps/).map { |line| line.split(":")[1].to_i }.first
+      guesses = log.lines.grep(/^Guesses/).map { |line| line[/\(([\d.]+) per puzzle\)/, 1] }.first
+      time = stopTime - startTime
+      leastTime = time if leastTime.nil? || (time < leastTime)
+    end
+
+    [steps, guesses, leastTime]
+  end
+end
+
+puzzleFilenameSet = ARGV.empty? ? DEFAULT_PUZZLE_FILENAME_SET.select { |filename| File.exist?(filename) } : ARGV
+puzzleFilenameSet.each do |puzzleFilename|
+  BranchBenchmark.new(DEFAULT_EXEC_FILENAME, puzzleFilename).execAll
+end
+0
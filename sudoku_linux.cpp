@@ -4,6 +4,10 @@
 
 #include <time.h>
 #include <sched.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #include "sudoku_os_dependent.h"
 
 namespace Sudoku {
@@ -55,6 +59,36 @@ namespace Sudoku {
         return;
     }
 
+    template <> MappedFile<TimerPlatform::LINUX>::MappedFile(const std::string& filename) {
+        const int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return;
+        }
+
+        // Pipes and empty files cannot be mapped
+        struct stat fileStat;
+        if ((::fstat(fd, &fileStat) == 0) && S_ISREG(fileStat.st_mode) && (fileStat.st_size > 0)) {
+            const size_t size = static_cast<size_t>(fileStat.st_size);
+            void* pData = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (pData != MAP_FAILED) {
+                ::madvise(pData, size, MADV_SEQUENTIAL);
+                pData_ = static_cast<const char*>(pData);
+                size_ = size;
+            }
+        }
+
+        // The mapping remains after closing its file
+        ::close(fd);
+        return;
+    }
+
+    template <> MappedFile<TimerPlatform::LINUX>::~MappedFile(void) {
+        if (pData_ != nullptr) {
+            ::munmap(const_cast<char*>(pData_), size_);
+        }
+        return;
+    }
+
     std::unique_ptr<ITimer> CreateTimerInstance(void) {
         std::unique_ptr<ITimer> pObj(new Timer<TimerPlatform::LINUX, timespec>);
         return pObj;
@@ -64,6 +98,11 @@ namespace Sudoku {
         std::unique_ptr<IProcessorBinder> pObj(new ProcessorBinder<TimerPlatform::LINUX>);
         return pObj;
     }
+
+    std::unique_ptr<IMappedFile> CreateMappedFile(const std::string& filename) {
+        std::unique_ptr<IMappedFile> pObj(new MappedFile<TimerPlatform::LINUX>(filename));
+        return pObj;
+    }
 }
 
 /*
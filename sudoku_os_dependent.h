@@ -10,6 +10,7 @@
 #include <iomanip>
 #include <functional>
 #include <memory>
+#include <string>
 #include <vector>
 
 using SudokuTime = unsigned long long;   // time (timestamp and duration)
@@ -185,6 +186,29 @@ namespace Sudoku {
         bool failed_ {false};  // true if initialization failed
     };
 
+    // Mapping a whole file into memory to read it without copying
+    class IMappedFile {
+    public:
+        IMappedFile(void) = default;
+        virtual ~IMappedFile(void) = default;
+        virtual const char* GetData(void) const = 0;  // nullptr if failed or the file is empty
+        virtual size_t GetSize(void) const = 0;
+    };
+
+    template <TimerPlatform timerPlatform>
+    class MappedFile : public IMappedFile {
+    public:
+        explicit MappedFile(const std::string& filename);
+        virtual ~MappedFile(void);  // unmaps the file
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator =(const MappedFile&) = delete;
+        virtual const char* GetData(void) const override { return pData_; }
+        virtual size_t GetSize(void) const override { return size_; }
+    private:
+        const char* pData_ {nullptr};
+        size_t size_ {0};
+    };
+
     // This runs "bool f(void)" parallel and reduces their results.
     class BaseParallelRunner {
         // unit test
@@ -253,6 +277,7 @@ namespace Sudoku {
     // Create an instance for using Windows or Linux
     extern std::unique_ptr<ITimer> CreateTimerInstance(void);
     extern std::unique_ptr<IProcessorBinder> CreateProcessorBinder(void);
+    extern std::unique_ptr<IMappedFile> CreateMappedFile(const std::string& filename);
 
     // Create an instance for using C++11 or Boost C++ Libraries
     extern std::unique_ptr<BaseParallelRunner> CreateParallelRunner(void);
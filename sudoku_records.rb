@@ -0,0 +1,77 @@
+#!/usr/bin/ruby
+# -*- coding: utf-8 -*-
+#
+# Converting Sudoku puzzles and solutions between text lines and binary records
+#
+# usage : ruby sudoku_records.rb encode inputTextFilename outputRecordFilename
+#         ruby sudoku_records.rb decode inputRecordFilename outputTextFilename
+# A record file holds a 16-byte header and 41-byte records of 9x9 puzzles (see sudokusse.md).
+# Encoding stops at the first empty line as SudokuSSE does.
+
+# Header in little endian
+MAGIC = "SDKB"
+VERSION = 1
+SIZE_OF_ALL_CELLS = 81
+HEADER_FORMAT = "a4vvQ<"
+SIZE_OF_HEADER = 16
+
+# Each byte holds two cells and the lower four bits hold the former cell
+SIZE_OF_RECORD = (SIZE_OF_ALL_CELLS + 1) / 2
+
+# Puzzles larger than 9x9 cannot be encoded
+MIN_SIZE_OF_LARGE_PUZZLE = 256
+
+BLANK_CELL = "."
+
+def encode_line(line)
+  raise "#{line.size} cells are too many" if line.size >= MIN_SIZE_OF_LARGE_PUZZLE
+  cells = line.chars.take(SIZE_OF_ALL_CELLS).map { |c| ("1".."9").include?(c) ? c.to_i : 0 }
+  cells.fill(0, cells.size, SIZE_OF_ALL_CELLS + 1 - cells.size)
+  cells.each_slice(2).map { |lower, upper| lower | (upper << 4) }.pack("C*")
+end
+
+def decode_record(record)
+  record.unpack("C*").flat_map { |byte| [byte & 0xf, byte >> 4] }.take(SIZE_OF_ALL_CELLS).map do |num|
+    (num > 0 && num <= 9) ? num.to_s : BLANK_CELL
+  end.join
+end
+
+def encode(input_filename, output_filename)
+  records = []
+  File.foreach(input_filename) do |line|
+    line = line.chomp
+    break if line.empty?
+    records << encode_line(line)
+  end
+
+  File.open(output_filename, "wb") do |file|
+    file.write([MAGIC, VERSION, SIZE_OF_ALL_CELLS, records.size].pack(HEADER_FORMAT))
+    records.each { |record| file.write(record) }
+  end
+  records.size
+end
+
+def decode(input_filename, output_filename)
+  data = File.binread(input_filename)
+  raise "Too short header" if data.size < SIZE_OF_HEADER
+  magic, version, size_of_cells, size_of_records = data.unpack(HEADER_FORMAT)
+  raise "Not a record file" if magic != MAGIC
+  raise "Unsupported version #{version}" if version != VERSION
+  raise "Unsupported #{size_of_cells} cells" if size_of_cells != SIZE_OF_ALL_CELLS
+  raise "Truncated records" if data.size < SIZE_OF_HEADER + size_of_records * SIZE_OF_RECORD
+
+  File.open(output_filename, "wb") do |file|
+    size_of_records.times do |i|
+      file.write(decode_record(data.byteslice(SIZE_OF_HEADER + i * SIZE_OF_RECORD, SIZE_OF_RECORD)) + "\n")
+    end
+  end
+  size_of_records
+end
+
+if ARGV.size != 3 || !["encode", "decode"].include?(ARGV[0])
+  puts "usage : ruby sudoku_records.rb encode|decode inputFilename outputFilename"
+  exit(1)
+end
+
+count = (ARGV[0] == "encode") ? encode(ARGV[1], ARGV[2]) : decode(ARGV[1], ARGV[2])
+puts "Converted #{count} puzzles"
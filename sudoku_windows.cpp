@@ -53,6 +53,39 @@ namespace Sudoku {
         return;
     }
 
+    template <> MappedFile<TimerPlatform::WINDOWS>::MappedFile(const std::string& filename) {
+        HANDLE hFile = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+                                   OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+        if (hFile == INVALID_HANDLE_VALUE) {
+            return;
+        }
+
+        // Empty files cannot be mapped
+        LARGE_INTEGER fileSize;
+        if (GetFileSizeEx(hFile, &fileSize) && (fileSize.QuadPart > 0)) {
+            HANDLE hMapping = CreateFileMappingA(hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+            if (hMapping != NULL) {
+                LPVOID pData = MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+                if (pData != NULL) {
+                    pData_ = static_cast<const char*>(pData);
+                    size_ = static_cast<size_t>(fileSize.QuadPart);
+                }
+                CloseHandle(hMapping);
+            }
+        }
+
+        // The view remains after closing its handles
+        CloseHandle(hFile);
+        return;
+    }
+
+    template <> MappedFile<TimerPlatform::WINDOWS>::~MappedFile(void) {
+        if (pData_ != nullptr) {
+            UnmapViewOfFile(pData_);
+        }
+        return;
+    }
+
     std::unique_ptr<ITimer> CreateTimerInstance(void) {
         std::unique_ptr<ITimer> pObj(new Timer<TimerPlatform::WINDOWS, FILETIME>);
         return pObj;
@@ -62,6 +95,11 @@ namespace Sudoku {
         std::unique_ptr<IProcessorBinder> pObj(new ProcessorBinder<TimerPlatform::WINDOWS>);
         return pObj;
     }
+
+    std::unique_ptr<IMappedFile> CreateMappedFile(const std::string& filename) {
+        std::unique_ptr<IMappedFile> pObj(new MappedFile<TimerPlatform::WINDOWS>(filename));
+        return pObj;
+    }
 }
 
 /*
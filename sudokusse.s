@@ -11,6 +11,12 @@
         # Set EnableAvx to 1 for using AVX, 0 for SSE
         # .set    EnableAvx, 1
 
+        # Set EnableAvx512 to 1 for using AVX-512 in addition to AVX.
+        # It is 0 unless Makefile designates it.
+        .ifndef EnableAvx512
+        .set    EnableAvx512, 0
+        .endif
+
         # Set CellsPacked to 1 to assume that initial cells in a
         # sudoku puzzle are packed in its top-left.
         # .set    CellsPacked, 0
@@ -27,16 +33,12 @@
         .set    UseReg64Most, 1
 
         # Variables that this assembly and C++ code share
-        .global sudokuXmmPrintAllCandidate
-        .global sudokuXmmRightBottomElement
-        .global sudokuXmmRightBottomSolved
-        .global sudokuXmmAllPatternCnt
-        .global sudokuXmmReturnAddr
         .global sudokuXmmPrintFunc
         .global sudokuXmmAssumeCellsPacked
         .global sudokuXmmUseAvx
+        .global sudokuXmmUseAvx512
+        .global sudokuXmmIsaSet
         .global sudokuXmmDebug
-        .global sudokuXmmToPrint
 
         # Variables that this assembly and unit tests share
         .global testSearchRowPartElementsPreRowPart
@@ -71,32 +73,29 @@
 # Solving puzzles can run on multiple threads so these global
 # variables must not be used for multiple writes and readers.
 #
-# Counting solutions can run on a single thread only.
-# These variables are not thread-safe for multiple writes and readers.
+# Counting solutions keeps its variables in a context block that a caller passes
+# and each thread has its own block (see SudokuSseEnumeratorContext in sudoku.h).
 
 .set  sudokuMaxLoopcnt,         81         # The upper limit of number of iterations in filling cells
-sudokuXmmPrintAllCandidate:     .quad 0    # Non-zero if printing candidates of a puzzle
-sudokuXmmRightBottomElement:    .quad 0    # Initial candidates of the bottom-right cell in a puzzle
-sudokuXmmRightBottomSolved:     .quad 0    # Solved candidate of the bottom-right cell in a puzzle
-sudokuXmmAllPatternCnt:         .quad 0    # Number of solutions in a puzzle
-sudokuXmmStackPointer:          .quad 0    # RSP register value before calling sudokuXmmPrintFunc
-sudokuXmmReturnAddr:            .quad 0    # Address to return after counting solutions
+.set  enumContextPrintAllCandidate,  0     # Non-zero if printing candidates of a puzzle
+.set  enumContextRightBottomElement, 8     # Initial candidates of the bottom-right cell in a puzzle
+.set  enumContextRightBottomSolved,  16    # Solved candidate of the bottom-right cell in a puzzle
+.set  enumContextAllPatternCnt,      24    # Number of solutions in a puzzle
+.set  enumContextStackPointer,       32    # RSP register value before calling sudokuXmmPrintFunc
+.set  enumContextReturnAddr,         40    # Address to return after counting solutions
+.set  enumContextToPrint,            64    # XMM registers to print (aligned on 16 bytes boundary)
 
 # These variables are set by a thread before multiple threads read
 sudokuXmmPrintFunc:             .quad 0    # Address of a C++ function to print a puzzle
 sudokuXmmAssumeCellsPacked:     .quad CellsPacked
 sudokuXmmUseAvx:                .quad EnableAvx
+sudokuXmmUseAvx512:             .quad EnableAvx512
+# Bit 0:SSE4.2, 1:AVX2, 2:AVX-512 set if this executable contains code for the instruction set
+sudokuXmmIsaSet:                .quad (1 << (EnableAvx + EnableAvx512))
 
 # Value for debugging assembly macros that run on a single thread
 sudokuXmmDebug:                 .quad 0
 
-# Candidates of 81 cells
-.set  arrayElementByteSize, 8
-.align 16
-sudokuXmmCandidateArray:  .quad 0,0,0,0,0,0,0,0,0, 0,0,0,0,0,0,0,0,0, 0,0,0,0,0,0,0,0,0
-                          .quad 0,0,0,0,0,0,0,0,0, 0,0,0,0,0,0,0,0,0, 0,0,0,0,0,0,0,0,0
-                          .quad 0,0,0,0,0,0,0,0,0, 0,0,0,0,0,0,0,0,0, 0,0,0,0,0,0,0,0,0 ,0
-
 # Symbol table to count candidates at each cell
 .set  funcPtrByteSize, 8        # Size in bytes of address to jump
 .set  funcPtrByteSizeLog2, 3    # Log2 of funcPtrByteSize (i.e. number of left bit-shift)
@@ -113,9 +112,19 @@ sudokuXmmCountFuncTable:
     .quad countAt70, countAt71, countAt72, countAt73, countAt74, countAt75, countAt76, countAt77, countAt78, countAt79
     .quad countAt80, countAt81
 
-.align 16
-sudokuXmmToPrint:
-        .quad 0,0,0,0, 0,0,0,0, 0,0,0,0, 0,0,0,0, 0,0,0,0, 0,0,0,0, 0,0,0,0, 0,0,0,0
+# Constants to solve multiple puzzles at once in YMM and ZMM registers.
+# Each 128-bit lane holds a row of a puzzle and its highest 32 bits are 0.
+.macro LaneConstant name, value
+\name:  .long \value, \value, \value, 0, \value, \value, \value, 0
+        .long \value, \value, \value, 0, \value, \value, \value, 0
+.endm
+
+.align 64
+        LaneConstant sudokuLaneOnes,     0x40201    # 1 in each cell
+        LaneConstant sudokuLaneLow8,     0x3fdfeff  # Lower 8 bits in each cell
+        LaneConstant sudokuLaneBit8,     0x4020100  # The highest bit in each cell
+        LaneConstant sudokuLaneCellMask, 0x1ff      # The rightmost cell
+        LaneConstant sudokuLaneRowPartMask, 0x7ffffff  # Three cells
 
 # Variables that this assembly and unit tests share
 .align 16
@@ -325,6 +334,38 @@ sudokuXmmDummyToAlign:  .quad 0
 .endif
 .endm
 
+.macro MacroPsrld regX, count
+.if (EnableAvx != 0)
+    vpsrld \regX, \regX, \count
+.else
+    psrld  \regX, \count
+.endif
+.endm
+
+.macro MacroPslld regX, count
+.if (EnableAvx != 0)
+    vpslld \regX, \regX, \count
+.else
+    pslld  \regX, \count
+.endif
+.endm
+
+.macro MacroPshufd regDstX, regSrcX, order
+.if (EnableAvx != 0)
+    vpshufd \regDstX, \regSrcX, \order
+.else
+    pshufd  \regDstX, \regSrcX, \order
+.endif
+.endm
+
+.macro MacroPtest regX, op2
+.if (EnableAvx != 0)
+    vptest \regX, \op2
+.else
+    ptest  \regX, \op2
+.endif
+.endm
+
 .macro MacroPhaddw regX, op2
 .if (EnableAvx != 0)
     vphaddw \regX, \regX, \op2
@@ -1849,6 +1890,70 @@ testCheckDiagonalNineCells:
         CheckDiagonalNineCells eax, r8d, xRegRow1, xRegRow2, xRegRow3, xRegRow4, xRegRow5, xRegRow6, xRegRow7, xRegRow8, xRegRow9, r9d, r10d, r11d
         ret
 
+# Merge three cells in each 32 bits of a ZMM register into its rightmost cell
+.macro FoldCellsAvx512 zRegTarget
+        vpsrld      zmm19, \zRegTarget, candidatesNum
+        vpsrld      zmm20, \zRegTarget, (candidatesNum * 2)
+        vpternlogd  \zRegTarget, zmm19, zmm20, 0xfe
+.endm
+
+# Merge 32-bit elements 0..2 in each 128-bit lane and set it to them
+.macro FoldRowPartsAvx512 zRegTarget
+        vpshufd     zmm19, \zRegTarget, 0xc9
+        vpshufd     zmm20, \zRegTarget, 0xd2
+        vpternlogd  \zRegTarget, zmm19, zmm20, 0xfe
+.endm
+
+# Check all rows, columns and boxes at once with ZMM16..21 and K1..K5 registers.
+# Set regInvalid to regResult if any of them lacks a candidate.
+.macro CheckConsistencyAvx512 regResultD, regInvalidD, regWorkD
+        OrThreeXmmRegs  xRegRow1to3, xRegRow1, xRegRow2, xRegRow3
+        OrThreeXmmRegs  xRegRow4to6, xRegRow4, xRegRow5, xRegRow6
+        OrThreeXmmRegs  xRegRow7to9, xRegRow7, xRegRow8, xRegRow9
+        OrThreeXmmRegs  xRegRowAll, xRegRow1to3, xRegRow4to6, xRegRow7to9
+
+        # Lanes of ZMM16..18 = rows 1..4, rows 5..8, and row 9 and three bands of boxes
+        vmovdqa32     xmm16, xRegRow1
+        vinserti32x4  zmm16, zmm16, xRegRow2, 1
+        vinserti32x4  zmm16, zmm16, xRegRow3, 2
+        vinserti32x4  zmm16, zmm16, xRegRow4, 3
+        vmovdqa32     xmm17, xRegRow5
+        vinserti32x4  zmm17, zmm17, xRegRow6, 1
+        vinserti32x4  zmm17, zmm17, xRegRow7, 2
+        vinserti32x4  zmm17, zmm17, xRegRow8, 3
+        vmovdqa32     xmm18, xRegRow9
+        vinserti32x4  zmm18, zmm18, xRegRow1to3, 1
+        vinserti32x4  zmm18, zmm18, xRegRow4to6, 2
+        vinserti32x4  zmm18, zmm18, xRegRow7to9, 3
+
+        FoldCellsAvx512  zmm16
+        FoldCellsAvx512  zmm17
+        FoldCellsAvx512  zmm18
+        FoldRowPartsAvx512  zmm16
+        FoldRowPartsAvx512  zmm17
+        # Boxes do not merge parts of a row
+        mov         \regWorkD, 0xf
+        kmovw       k1, \regWorkD
+        vpshufd     zmm19, zmm18, 0xc9
+        vpshufd     zmm20, zmm18, 0xd2
+        vpternlogd  zmm18{k1}, zmm19, zmm20, 0xfe
+
+        # Find missing candidates in rows, boxes, and columns
+        vmovdqa32   zmm21, zmmword ptr [rip + sudokuLaneCellMask]
+        vpandnd     zmm16, zmm16, zmm21
+        vptestmd    k2, zmm16, zmm16
+        vpandnd     zmm17, zmm17, zmm21
+        vptestmd    k3, zmm17, zmm17
+        vpandnd     zmm18, zmm18, zmm21
+        vptestmd    k4, zmm18, zmm18
+        vpandnd     xmm19, xRegRowAll, xmmword ptr [rip + sudokuLaneRowPartMask]
+        vptestmd    k5, xmm19, xmm19
+        korw        k2, k2, k3
+        korw        k4, k4, k5
+        kortestw    k2, k4
+        cmovnz      \regResultD, \regInvalidD
+.endm
+
 .macro CheckConsistency regResultD, regInvalidD, regWork1D, regWork2D, regWork3D, regWork4D, regWork5D
         xor  \regResultD, \regResultD
         mov  \regInvalidD, 1
@@ -1860,6 +1965,9 @@ testCheckDiagonalNineCells:
         jz   20001f
 .endif
 
+.if (EnableAvx512 != 0)
+        CheckConsistencyAvx512 \regResultD, \regInvalidD, \regWork1D
+.else
         CheckRowSet  \regResultD, \regInvalidD, \regWork1D, \regWork2D, \regWork3D, \regWork4D, \regWork5D
         cmp  \regResultD, \regInvalidD
         jz   20001f
@@ -1870,6 +1978,7 @@ testCheckDiagonalNineCells:
         OrThreeXmmRegs  xRegRowAll, xRegRow1to3, xRegRow4to6, xRegRow7to9
         CheckColumn  \regResultD, \regInvalidD, \regWork1D, \regWork2D, \regWork3D
         CheckSetBox  \regResultD, \regInvalidD, \regWork1D, \regWork2D, \regWork3D, \regWork4D, \regWork5D
+.endif
 20001:
 .endm
 
@@ -1880,6 +1989,146 @@ testCheckConsistency:
         CheckConsistency  eax, r8d, r9d, r10d, ebx, ecx, edx
         ret
 
+# Locked candidates (pointing and claiming) with rows in XMM registers.
+# Each macro removes candidates that box-line interactions exclude and keeps other candidates.
+# It sets regChangedD to regOneD if it removes any candidates.
+
+# Merge three cells in each 32-bit element into its rightmost cell
+.macro LockedFoldCells xRegDst, xRegSrc, xRegWork
+        MacroMovdqa \xRegDst,  \xRegSrc
+        MacroMovdqa \xRegWork, \xRegSrc
+        MacroPsrld  \xRegWork, candidatesNum
+        MacroOrps   \xRegDst,  \xRegWork
+        MacroPsrld  \xRegWork, candidatesNum
+        MacroOrps   \xRegDst,  \xRegWork
+        MacroAndps  \xRegDst,  (xmmword ptr [rip + sudokuLaneCellMask])
+.endm
+
+# Merge other two 32-bit elements of 0..2 into each element
+.macro LockedOtherParts xRegDst, xRegSrc, xRegWork
+        MacroPshufd \xRegDst,  \xRegSrc, 0xc9
+        MacroPshufd \xRegWork, \xRegSrc, 0xd2
+        MacroOrps   \xRegDst,  \xRegWork
+.endm
+
+# Merge other two cells in each 32-bit element into each cell
+.macro LockedOtherCells xRegDst, xRegSrc, xRegWork
+        MacroMovdqa \xRegDst,  \xRegSrc
+        MacroPsrld  \xRegDst,  candidatesNum
+        MacroMovdqa \xRegWork, \xRegSrc
+        MacroPsrld  \xRegWork, (candidatesNum * 2)
+        MacroOrps   \xRegDst,  \xRegWork
+        MacroMovdqa \xRegWork, \xRegSrc
+        MacroPslld  \xRegWork, candidatesNum
+        MacroOrps   \xRegDst,  \xRegWork
+        MacroPslld  \xRegWork, candidatesNum
+        MacroOrps   \xRegDst,  \xRegWork
+        MacroAndps  \xRegDst,  (xmmword ptr [rip + sudokuLaneRowPartMask])
+.endm
+
+# Copy the rightmost cell in each 32-bit element to other two cells
+.macro LockedSpreadCells xRegDst, xRegWork
+        MacroMovdqa \xRegWork, \xRegDst
+        MacroPslld  \xRegWork, candidatesNum
+        MacroOrps   \xRegDst,  \xRegWork
+        MacroPslld  \xRegWork, candidatesNum
+        MacroOrps   \xRegDst,  \xRegWork
+.endm
+
+.macro LockedRemoveCandidates xRegRow, xRegMask, xRegWork, regChangedD, regOneD
+        MacroPtest  \xRegRow,  \xRegMask
+        cmovnz      \regChangedD, \regOneD
+        MacroMovdqa \xRegWork, \xRegMask
+        MacroAndnps \xRegWork, \xRegRow
+        MacroMovdqa \xRegRow,  \xRegWork
+.endm
+
+# Pointing: a number in a box only in a row cannot be in the row out of the box
+.macro LockedRowPointing xRegTarget, xRegPartTarget, xRegPartOther1, xRegPartOther2, xRegWork1, xRegWork2, xRegWork3, regChangedD, regOneD
+        MacroOrps3op \xRegWork1, \xRegPartOther1, \xRegPartOther2
+        MacroAndnps  \xRegWork1, \xRegPartTarget
+        LockedOtherParts \xRegWork2, \xRegWork1, \xRegWork3
+        LockedSpreadCells \xRegWork2, \xRegWork3
+        LockedRemoveCandidates \xRegTarget, \xRegWork2, \xRegWork3, \regChangedD, \regOneD
+.endm
+
+# Claiming: a number in a row only in a box cannot be in other rows in the box
+.macro LockedRowClaiming xRegOther1, xRegOther2, xRegPartSrc, xRegWork1, xRegWork2, regChangedD, regOneD
+        LockedOtherParts \xRegWork1, \xRegPartSrc, \xRegWork2
+        MacroAndnps \xRegWork1, \xRegPartSrc
+        LockedSpreadCells \xRegWork1, \xRegWork2
+        LockedRemoveCandidates \xRegOther1, \xRegWork1, \xRegWork2, \regChangedD, \regOneD
+        LockedRemoveCandidates \xRegOther2, \xRegWork1, \xRegWork2, \regChangedD, \regOneD
+.endm
+
+.macro LockedRowsInBand xRegRowA, xRegRowB, xRegRowC, xRegPartA, xRegPartB, xRegPartC, xRegWork1, xRegWork2, xRegWork3, regChangedD, regOneD
+        LockedFoldCells  \xRegPartA, \xRegRowA, \xRegWork1
+        LockedFoldCells  \xRegPartB, \xRegRowB, \xRegWork1
+        LockedFoldCells  \xRegPartC, \xRegRowC, \xRegWork1
+        LockedRowPointing \xRegRowA, \xRegPartA, \xRegPartB, \xRegPartC, \xRegWork1, \xRegWork2, \xRegWork3, \regChangedD, \regOneD
+        LockedRowPointing \xRegRowB, \xRegPartB, \xRegPartA, \xRegPartC, \xRegWork1, \xRegWork2, \xRegWork3, \regChangedD, \regOneD
+        LockedRowPointing \xRegRowC, \xRegPartC, \xRegPartA, \xRegPartB, \xRegWork1, \xRegWork2, \xRegWork3, \regChangedD, \regOneD
+        LockedRowClaiming \xRegRowB, \xRegRowC, \xRegPartA, \xRegWork1, \xRegWork2, \regChangedD, \regOneD
+        LockedRowClaiming \xRegRowA, \xRegRowC, \xRegPartB, \xRegWork1, \xRegWork2, \regChangedD, \regOneD
+        LockedRowClaiming \xRegRowA, \xRegRowB, \xRegPartC, \xRegWork1, \xRegWork2, \regChangedD, \regOneD
+.endm
+
+# Claiming: a number in a column only in a box cannot be in other columns in the box
+.macro LockedColumnClaiming xRegRowA, xRegRowB, xRegRowC, xRegBandTarget, xRegBandOther1, xRegBandOther2, xRegWork1, xRegWork2, xRegWork3, regChangedD, regOneD
+        MacroOrps3op \xRegWork1, \xRegBandOther1, \xRegBandOther2
+        MacroAndnps  \xRegWork1, \xRegBandTarget
+        LockedOtherCells \xRegWork2, \xRegWork1, \xRegWork3
+        LockedRemoveCandidates \xRegRowA, \xRegWork2, \xRegWork3, \regChangedD, \regOneD
+        LockedRemoveCandidates \xRegRowB, \xRegWork2, \xRegWork3, \regChangedD, \regOneD
+        LockedRemoveCandidates \xRegRowC, \xRegWork2, \xRegWork3, \regChangedD, \regOneD
+.endm
+
+# Leave numbers in a box that are only in a column of the box
+.macro LockedColumnPointingCells xRegBand, xRegWork1, xRegWork2
+        LockedOtherCells \xRegWork1, \xRegBand, \xRegWork2
+        MacroAndnps \xRegWork1, \xRegBand
+        MacroMovdqa \xRegBand, \xRegWork1
+.endm
+
+# Pointing: a number in a box only in a column cannot be in the column out of the box
+.macro LockedColumnPointing xRegRowA, xRegRowB, xRegRowC, xRegBandOther1, xRegBandOther2, xRegWork1, xRegWork2, regChangedD, regOneD
+        MacroOrps3op \xRegWork1, \xRegBandOther1, \xRegBandOther2
+        LockedRemoveCandidates \xRegRowA, \xRegWork1, \xRegWork2, \regChangedD, \regOneD
+        LockedRemoveCandidates \xRegRowB, \xRegWork1, \xRegWork2, \regChangedD, \regOneD
+        LockedRemoveCandidates \xRegRowC, \xRegWork1, \xRegWork2, \regChangedD, \regOneD
+.endm
+
+# Removing candidates keeps all solutions, so each step can use candidates that former steps
+# already reduced or candidates before them.
+.macro FindLockedCandidates regChangedD, regOneD
+        xor  \regChangedD, \regChangedD
+        mov  \regOneD, 1
+        LockedRowsInBand xRegRow1, xRegRow2, xRegRow3, xRegRowAll, xRegRow1to3, xRegRow4to6, xRegRow7to9, xRegWork1, xRegWork2, \regChangedD, \regOneD
+        LockedRowsInBand xRegRow4, xRegRow5, xRegRow6, xRegRowAll, xRegRow1to3, xRegRow4to6, xRegRow7to9, xRegWork1, xRegWork2, \regChangedD, \regOneD
+        LockedRowsInBand xRegRow7, xRegRow8, xRegRow9, xRegRowAll, xRegRow1to3, xRegRow4to6, xRegRow7to9, xRegWork1, xRegWork2, \regChangedD, \regOneD
+
+        OrThreeXmmRegs  xRegRow1to3, xRegRow1, xRegRow2, xRegRow3
+        OrThreeXmmRegs  xRegRow4to6, xRegRow4, xRegRow5, xRegRow6
+        OrThreeXmmRegs  xRegRow7to9, xRegRow7, xRegRow8, xRegRow9
+        LockedColumnClaiming xRegRow1, xRegRow2, xRegRow3, xRegRow1to3, xRegRow4to6, xRegRow7to9, xRegRowAll, xRegWork1, xRegWork2, \regChangedD, \regOneD
+        LockedColumnClaiming xRegRow4, xRegRow5, xRegRow6, xRegRow4to6, xRegRow1to3, xRegRow7to9, xRegRowAll, xRegWork1, xRegWork2, \regChangedD, \regOneD
+        LockedColumnClaiming xRegRow7, xRegRow8, xRegRow9, xRegRow7to9, xRegRow1to3, xRegRow4to6, xRegRowAll, xRegWork1, xRegWork2, \regChangedD, \regOneD
+
+        LockedColumnPointingCells xRegRow1to3, xRegWork1, xRegWork2
+        LockedColumnPointingCells xRegRow4to6, xRegWork1, xRegWork2
+        LockedColumnPointingCells xRegRow7to9, xRegWork1, xRegWork2
+        LockedColumnPointing xRegRow1, xRegRow2, xRegRow3, xRegRow4to6, xRegRow7to9, xRegWork1, xRegWork2, \regChangedD, \regOneD
+        LockedColumnPointing xRegRow4, xRegRow5, xRegRow6, xRegRow1to3, xRegRow7to9, xRegWork1, xRegWork2, \regChangedD, \regOneD
+        LockedColumnPointing xRegRow7, xRegRow8, xRegRow9, xRegRow1to3, xRegRow4to6, xRegWork1, xRegWork2, \regChangedD, \regOneD
+        or   \regChangedD, \regChangedD
+.endm
+
+        .global testFindLockedCandidates
+testFindLockedCandidates:
+        InitMaskRegister
+        FindLockedCandidates eax, ebx
+        ret
+
 # Assign code (text) in a consecutive memory area which its tests do not divide.
 # The symbol that C++ code calls via inline assembly.
         .global solveSudokuAsm
@@ -1930,6 +2179,17 @@ countFilledElementsLabel:
         jnz     keepFilling
 
 exitFilling:
+        # Keep filling cells if the locked candidates method reduces candidates
+        cmp     regSolverElementCntD, regMaxPopcntD
+        jz      checkFilledCells
+        FindLockedCandidates r8d, r9d
+        jz      checkFilledCells
+        # Make the next iteration not to stop filling
+        mov     regPrevPopcntD, (maxElementNumber + 1)
+        MacroPinsrq xLoopPopCnt, regPrevPopcnt, 0
+        jmp     loopFilling
+
+checkFilledCells:
         CheckConsistency regSolverResultD, r8d, r9d, r10d, r11d, r12d, r13d
         xor     regSolverNextCellFoundD, regSolverNextCellFoundD
         cmp     regSolverElementCntD, regMaxPopcntD
@@ -1966,6 +2226,593 @@ findCandidatesLabel:
         FindCandidates r8, r9, r10, r11, r8d, r9d, r10d, r11d, r12d, r13d, r14d, eax, ebx, ecx, edx, esi, edi, xRegWork1, xRegWork2
         jmp loopFilling
 
+# Solves a puzzle with backtracking and does not return to C++ code until it is solved or fails.
+# Rows stay in XMM registers and a guess pushes them on a stack frame in the native stack.
+# The stack is cache-aligned and allocated once in this function, so it is safe for multi-threading.
+.set    cacheLineSize,        64
+.set    searchHeaderSavedRsp,  0   # RSP register value at entry
+.set    searchHeaderStepCnt,   8   # Number of calling solveSudokuAsm
+.set    searchHeaderSize,     cacheLineSize
+.set    searchFrameCellOffset, (numberOfRows * 16)      # Offset in a frame of 32 bits that holds a guessed cell
+.set    searchFrameShift,      (searchFrameCellOffset + 8)  # Bit position of the guessed cell in the 32 bits
+.set    searchFrameCandidates, (searchFrameCellOffset + 16) # Candidates of the cell not guessed yet
+.set    searchFrameSize,       (cacheLineSize * 3)
+.set    searchStackSize,       (searchHeaderSize + searchFrameSize * maxElementNumber + cacheLineSize)
+
+.macro SaveRowsToSearchFrame regFrame
+        MacroMovdqa (xmmword ptr [\regFrame]),     xRegRow1
+        MacroMovdqa (xmmword ptr [\regFrame+16]),  xRegRow2
+        MacroMovdqa (xmmword ptr [\regFrame+32]),  xRegRow3
+        MacroMovdqa (xmmword ptr [\regFrame+48]),  xRegRow4
+        MacroMovdqa (xmmword ptr [\regFrame+64]),  xRegRow5
+        MacroMovdqa (xmmword ptr [\regFrame+80]),  xRegRow6
+        MacroMovdqa (xmmword ptr [\regFrame+96]),  xRegRow7
+        MacroMovdqa (xmmword ptr [\regFrame+112]), xRegRow8
+        MacroMovdqa (xmmword ptr [\regFrame+128]), xRegRow9
+.endm
+
+.macro LoadRowsFromSearchFrame regFrame
+        MacroMovdqa xRegRow1, (xmmword ptr [\regFrame])
+        MacroMovdqa xRegRow2, (xmmword ptr [\regFrame+16])
+        MacroMovdqa xRegRow3, (xmmword ptr [\regFrame+32])
+        MacroMovdqa xRegRow4, (xmmword ptr [\regFrame+48])
+        MacroMovdqa xRegRow5, (xmmword ptr [\regFrame+64])
+        MacroMovdqa xRegRow6, (xmmword ptr [\regFrame+80])
+        MacroMovdqa xRegRow7, (xmmword ptr [\regFrame+96])
+        MacroMovdqa xRegRow8, (xmmword ptr [\regFrame+112])
+        MacroMovdqa xRegRow9, (xmmword ptr [\regFrame+128])
+.endm
+
+        .global searchSudokuAsm
+searchSudokuAsm:
+        # Set return value to rax (1 if no solution), rbx (number of filled cells) and rcx (steps)
+        .set    regSearchFrame, rbp
+        push    regSearchFrame
+        mov     rax, rsp
+        sub     rsp, searchStackSize
+        and     rsp, -cacheLineSize
+        mov     qword ptr [rsp + searchHeaderSavedRsp], rax
+        mov     qword ptr [rsp + searchHeaderStepCnt], 0
+        lea     regSearchFrame, [rsp + searchHeaderSize]
+
+loopSearching:
+        call    solveSudokuAsm
+        inc     qword ptr [rsp + searchHeaderStepCnt]
+        or      eax, eax
+        jnz     backtrackSearching
+        cmp     ebx, maxElementNumber
+        jz      exitSearching
+        or      ecx, ecx
+        jz      backtrackSearching
+
+        # Push all rows because propagation after a guess can change any of them.
+        # Other XMM registers are derived from the rows and solveSudokuAsm sets them.
+        SaveRowsToSearchFrame regSearchFrame
+        shl     edi, 4
+        lea     r8, [rdi + rdx * boxRowByteSize]
+        imul    ecx, esi, candidatesNum
+        mov     eax, dword ptr [regSearchFrame + r8]
+        shr     eax, cl
+        and     eax, elementBitMask
+        mov     qword ptr [regSearchFrame + searchFrameCellOffset], r8
+        mov     qword ptr [regSearchFrame + searchFrameShift], rcx
+
+guessSearching:
+        # Guess the smallest candidate in eax as the C++ solver does
+        lea     ebx, [eax - 1]
+        and     ebx, eax
+        xor     eax, ebx
+        mov     qword ptr [regSearchFrame + searchFrameCandidates], rbx
+        shl     eax, cl
+        mov     edx, elementBitMask
+        shl     edx, cl
+        not     edx
+        and     edx, dword ptr [regSearchFrame + r8]
+        or      eax, edx
+        mov     dword ptr [regSearchFrame + r8], eax
+        LoadRowsFromSearchFrame regSearchFrame
+
+        # Discard the frame when this is the last candidate in the cell
+        or      ebx, ebx
+        jz      loopSearching
+        add     regSearchFrame, searchFrameSize
+        jmp     loopSearching
+
+backtrackSearching:
+        lea     rax, [rsp + searchHeaderSize]
+        cmp     regSearchFrame, rax
+        jz      abortSearching
+        sub     regSearchFrame, searchFrameSize
+        mov     r8,  qword ptr [regSearchFrame + searchFrameCellOffset]
+        mov     rcx, qword ptr [regSearchFrame + searchFrameShift]
+        mov     rax, qword ptr [regSearchFrame + searchFrameCandidates]
+        jmp     guessSearching
+
+abortSearching:
+        mov     eax, 1
+exitSearching:
+        mov     rcx, qword ptr [rsp + searchHeaderStepCnt]
+        mov     rsp, qword ptr [rsp + searchHeaderSavedRsp]
+        pop     regSearchFrame
+        ret
+
+# Fills cells of multiple puzzles at once and returns to C++ code.
+# Each 128-bit lane of YMM or ZMM registers holds rows of a puzzle. This applies the same rules
+# as solveSudokuAsm to all puzzles in parallel until none of them changes, but does not find
+# a cell to guess next.
+# rsi points to an array of pointers to XMM registers of the puzzles, and rdi points to an array
+# that receives numbers of filled cells. rax is set its n-th bit if the n-th puzzle has no solution.
+.set    laneRowByteSizeYmm,    32
+.set    laneRowByteSizeZmm,    64
+.set    laneFrameUnique,       0   # Unique candidates in each row
+.set    laneFrameColumn,       numberOfRows        # Unique candidates in all rows
+.set    laneFrameHiddenColumn, (laneFrameColumn + 1)        # Candidates that only a cell in a column has
+.set    laneFrameHiddenBox,    (laneFrameHiddenColumn + 1)  # Candidates that only a cell in a box has
+.set    laneFrameSize,         (laneFrameHiddenBox + 3)     # in rows
+.set    laneMaxLoopcnt,        (maxElementNumber * candidatesNum)  # Each iteration removes at least one candidate
+
+# YMM registers use VEX-encoded instructions and ZMM registers use EVEX-encoded instructions
+.macro LaneOpDefine name, ymmOp, zmmOp
+.macro ymm\name dst, src1, src2
+        \ymmOp  \dst, \src1, \src2
+.endm
+.macro zmm\name dst, src1, src2
+        \zmmOp  \dst, \src1, \src2
+.endm
+.endm
+
+        LaneOpDefine Pand,  vpand,  vpandd
+        LaneOpDefine Pandn, vpandn, vpandnd
+        LaneOpDefine Por,   vpor,   vpord
+        LaneOpDefine Pxor,  vpxor,  vpxord
+
+.macro ymmMovdqa dst, src
+        vmovdqa    \dst, \src
+.endm
+.macro zmmMovdqa dst, src
+        vmovdqa32  \dst, \src
+.endm
+
+.macro LaneLoadRow vr, num
+        vmovdqa      xmm\num, xmmword ptr [r12 + \num * 16]
+.ifc \vr, ymm
+        vinserti128  ymm\num, ymm\num, xmmword ptr [r13 + \num * 16], 1
+.else
+        vinserti32x4 zmm\num, zmm\num, xmmword ptr [r13 + \num * 16], 1
+        vinserti32x4 zmm\num, zmm\num, xmmword ptr [r14 + \num * 16], 2
+        vinserti32x4 zmm\num, zmm\num, xmmword ptr [r15 + \num * 16], 3
+.endif
+.endm
+
+.macro LaneSaveRow vr, num
+        vmovdqa      xmmword ptr [r12 + \num * 16], xmm\num
+.ifc \vr, ymm
+        vextracti128 xmmword ptr [r13 + \num * 16], ymm\num, 1
+.else
+        vextracti32x4 xmmword ptr [r13 + \num * 16], zmm\num, 1
+        vextracti32x4 xmmword ptr [r14 + \num * 16], zmm\num, 2
+        vextracti32x4 xmmword ptr [r15 + \num * 16], zmm\num, 3
+.endif
+.endm
+
+.macro LaneFlags vr, regDst, regWork, numSrc, numWork
+        # Set n-th bit of regDst if n-th 128 bits of the source are not zero
+.ifc \vr, ymm
+        xor          \regDst\()d, \regDst\()d
+        xor          \regWork\()d, \regWork\()d
+        vptest       xmm\numSrc, xmm\numSrc
+        setnz        \regDst\()b
+        vextracti128 xmm\numWork, ymm\numSrc, 1
+        vptest       xmm\numWork, xmm\numWork
+        setnz        \regWork\()b
+        lea          \regDst, [\regDst + \regWork * 2]
+.else
+        vptestmq     k1, zmm\numSrc, zmm\numSrc
+        kmovw        \regDst\()d, k1
+        mov          \regWork\()d, \regDst\()d
+        shr          \regWork\()d, 1
+        or           \regDst\()d, \regWork\()d
+        mov          \regWork\()d, 0x55
+        pext         \regDst\()d, \regDst\()d, \regWork\()d
+.endif
+.endm
+
+.macro LaneCountFilled rb, lane
+        popcnt  rax, qword ptr [rsp + laneFrameColumn * \rb + \lane * 16]
+        popcnt  rdx, qword ptr [rsp + laneFrameColumn * \rb + \lane * 16 + 8]
+        add     rax, rdx
+        mov     qword ptr [rdi + \lane * 8], rax
+.endm
+
+.macro LaneOrTwo vr, dst, src1, src2
+        # dst |= src1 | src2
+.if (EnableAvx512 != 0)
+        vpternlogd  \vr\dst, \vr\src1, \vr\src2, 0xfe
+.else
+        \vr\()Por       \vr\dst, \vr\dst, \vr\src1
+        \vr\()Por       \vr\dst, \vr\dst, \vr\src2
+.endif
+.endm
+
+.macro LaneFoldCells vr, dst, src, work
+        # Merge three cells in each 32 bits into its rightmost cell
+        vpsrld   \vr\work, \vr\src, candidatesNum
+        \vr\()Por    \vr\dst, \vr\src, \vr\work
+        vpsrld   \vr\work, \vr\work, candidatesNum
+        \vr\()Por    \vr\dst, \vr\dst, \vr\work
+        \vr\()Pand   \vr\dst, \vr\dst, (\vr\()word ptr [rip + sudokuLaneCellMask])
+.endm
+
+.macro LaneFoldRow vr, reg, work1, work2
+        # Merge 32-bit elements 0..2 in each 128 bits and set it to them
+        vpshufd  \vr\work1, \vr\reg, 0xc9
+        vpshufd  \vr\work2, \vr\reg, 0xd2
+        LaneOrTwo \vr, \reg, \work1, \work2
+.endm
+
+.macro LaneBroadcastCell vr, reg, work1, work2
+        # Copy the rightmost cell to other cells in each 32 bits
+        vpslld   \vr\work1, \vr\reg, candidatesNum
+        vpslld   \vr\work2, \vr\reg, (candidatesNum * 2)
+        LaneOrTwo \vr, \reg, \work1, \work2
+.endm
+
+.macro LaneNonZeroCells vr, dst, src, work
+        # Set all bits of cells in dst which are not zero in src
+        \vr\()Pand   \vr\dst, \vr\src, (\vr\()word ptr [rip + sudokuLaneLow8])
+        vpaddd   \vr\dst, \vr\dst, \vr\()word ptr [rip + sudokuLaneLow8]
+        \vr\()Por    \vr\dst, \vr\dst, \vr\src
+        \vr\()Pand   \vr\dst, \vr\dst, (\vr\()word ptr [rip + sudokuLaneBit8])
+        vpsrld   \vr\work, \vr\dst, 8
+        vpsubd   \vr\work, \vr\dst, \vr\work
+        \vr\()Por    \vr\dst, \vr\dst, \vr\work
+.endm
+
+.macro LaneCollectUniqueCandidates vr, rb, num
+        # Set unique candidates to the frame and merge them to register 10
+        vpsubd   \vr\()13, \vr\num, \vr\()word ptr [rip + sudokuLaneOnes]
+        \vr\()Pand   \vr\()13, \vr\()13, \vr\num
+        vpsrld   \vr\()13, \vr\()13, 1
+        LaneNonZeroCells \vr, 14, 13, 15
+        \vr\()Pandn  \vr\()13, \vr\()14, \vr\num
+        \vr\()Movdqa (\vr\()word ptr [rsp + (laneFrameUnique + \num - 1) * \rb]), \vr\()13
+        \vr\()Por    \vr\()10, \vr\()10, \vr\()13
+        # Mark cells which have no candidates to register 11
+        \vr\()Pand   \vr\()14, \vr\num, (\vr\()word ptr [rip + sudokuLaneLow8])
+        vpaddd   \vr\()14, \vr\()14, \vr\()word ptr [rip + sudokuLaneLow8]
+        \vr\()Por    \vr\()14, \vr\()14, \vr\num
+        \vr\()Pandn  \vr\()14, \vr\()14, (\vr\()word ptr [rip + sudokuLaneBit8])
+        \vr\()Por    \vr\()11, \vr\()11, \vr\()14
+.endm
+
+.macro LaneFilterRow vr, rb, num
+        # Remove unique candidates in the column (register 10), box (register 12) and row of a row
+        \vr\()Movdqa \vr\()13, (\vr\()word ptr [rsp + (laneFrameUnique + \num - 1) * \rb])
+        LaneFoldCells \vr, 13, 13, 14
+        LaneFoldRow \vr, 13, 14, 15
+        \vr\()Por    \vr\()13, \vr\()13, \vr\()12
+        LaneBroadcastCell \vr, 13, 14, 15
+        \vr\()Por    \vr\()13, \vr\()13, \vr\()10
+        \vr\()Pandn  \vr\()14, \vr\()13, \vr\num
+        \vr\()Por    \vr\()14, \vr\()14, (\vr\()word ptr [rsp + (laneFrameUnique + \num - 1) * \rb])
+        \vr\()Pxor   \vr\()15, \vr\()14, \vr\num
+        \vr\()Por    \vr\()11, \vr\()11, \vr\()15
+        \vr\()Movdqa \vr\num, \vr\()14
+.endm
+
+.macro LaneFilterBand vr, rb, row1, row2, row3
+        \vr\()Movdqa \vr\()12, (\vr\()word ptr [rsp + (laneFrameUnique + \row1 - 1) * \rb])
+        \vr\()Por    \vr\()12, \vr\()12, (\vr\()word ptr [rsp + (laneFrameUnique + \row2 - 1) * \rb])
+        \vr\()Por    \vr\()12, \vr\()12, (\vr\()word ptr [rsp + (laneFrameUnique + \row3 - 1) * \rb])
+        LaneFoldCells \vr, 12, 12, 13
+        LaneFilterRow \vr, \rb, \row1
+        LaneFilterRow \vr, \rb, \row2
+        LaneFilterRow \vr, \rb, \row3
+.endm
+
+.macro LaneCountColumn vr, num
+        # Register 12 : candidates in the column, register 13 : candidates twice or more
+        \vr\()Pand   \vr\()14, \vr\()12, \vr\num
+        \vr\()Por    \vr\()13, \vr\()13, \vr\()14
+        \vr\()Por    \vr\()12, \vr\()12, \vr\num
+.endm
+
+.macro LaneFindBand vr, rb, band, row1, row2, row3
+        # Set candidates that only a cell in a box has to the frame
+        \vr\()Por    \vr\()10, \vr\row1, \vr\row2
+        \vr\()Pand   \vr\()12, \vr\row1, \vr\row2
+        \vr\()Pand   \vr\()13, \vr\row3, \vr\()10
+        \vr\()Por    \vr\()12, \vr\()12, \vr\()13
+        \vr\()Por    \vr\()10, \vr\()10, \vr\row3
+        vpsrld   \vr\()13, \vr\()12, candidatesNum
+        \vr\()Por    \vr\()12, \vr\()12, \vr\()13
+        vpsrld   \vr\()13, \vr\()12, candidatesNum
+        \vr\()Por    \vr\()12, \vr\()12, \vr\()13
+        vpsrld   \vr\()13, \vr\()10, candidatesNum
+        \vr\()Pand   \vr\()14, \vr\()10, \vr\()13
+        \vr\()Por    \vr\()12, \vr\()12, \vr\()14
+        \vr\()Por    \vr\()14, \vr\()10, \vr\()13
+        vpsrld   \vr\()13, \vr\()10, (candidatesNum * 2)
+        \vr\()Pand   \vr\()15, \vr\()13, \vr\()14
+        \vr\()Por    \vr\()12, \vr\()12, \vr\()15
+        \vr\()Por    \vr\()14, \vr\()14, \vr\()13
+        \vr\()Pand   \vr\()14, \vr\()14, (\vr\()word ptr [rip + sudokuLaneCellMask])
+        \vr\()Pxor   \vr\()15, \vr\()14, (\vr\()word ptr [rip + sudokuLaneCellMask])
+        \vr\()Por    \vr\()0, \vr\()0, \vr\()15
+        \vr\()Pandn  \vr\()12, \vr\()12, \vr\()14
+        \vr\()Movdqa (\vr\()word ptr [rsp + (laneFrameHiddenBox + \band) * \rb]), \vr\()12
+        LaneFindRow \vr, \rb, \band, \row1
+        LaneFindRow \vr, \rb, \band, \row2
+        LaneFindRow \vr, \rb, \band, \row3
+.endm
+
+.macro LaneFindRow vr, rb, band, num
+        # Candidates in the row and candidates in two or more cells in the row
+        vpsrld   \vr\()10, \vr\num, candidatesNum
+        vpsrld   \vr\()12, \vr\num, (candidatesNum * 2)
+        \vr\()Por    \vr\()13, \vr\num, \vr\()10
+        \vr\()Pand   \vr\()14, \vr\num, \vr\()10
+        \vr\()Pand   \vr\()15, \vr\()12, \vr\()13
+        \vr\()Por    \vr\()14, \vr\()14, \vr\()15
+        \vr\()Por    \vr\()13, \vr\()13, \vr\()12
+        \vr\()Pand   \vr\()13, \vr\()13, (\vr\()word ptr [rip + sudokuLaneCellMask])
+        \vr\()Pand   \vr\()14, \vr\()14, (\vr\()word ptr [rip + sudokuLaneCellMask])
+        vpshufd  \vr\()10, \vr\()13, 0xc9
+        vpshufd  \vr\()12, \vr\()13, 0xd2
+        vpshufd  \vr\()15, \vr\()14, 0xc9
+        \vr\()Por    \vr\()14, \vr\()14, \vr\()15
+        vpshufd  \vr\()15, \vr\()14, 0xd2
+        \vr\()Por    \vr\()14, \vr\()14, \vr\()15
+        \vr\()Pand   \vr\()15, \vr\()13, \vr\()10
+        \vr\()Por    \vr\()14, \vr\()14, \vr\()15
+        \vr\()Por    \vr\()15, \vr\()13, \vr\()10
+        \vr\()Pand   \vr\()10, \vr\()12, \vr\()15
+        \vr\()Por    \vr\()14, \vr\()14, \vr\()10
+        \vr\()Por    \vr\()15, \vr\()15, \vr\()12
+        \vr\()Pxor   \vr\()10, \vr\()15, (\vr\()word ptr [rip + sudokuLaneCellMask])
+        \vr\()Por    \vr\()0, \vr\()0, \vr\()10
+        \vr\()Pandn  \vr\()14, \vr\()14, \vr\()15
+        # Fill a cell which has a candidate that only it has in its row, column or box
+        \vr\()Por    \vr\()14, \vr\()14, (\vr\()word ptr [rsp + (laneFrameHiddenBox + \band) * \rb])
+        LaneBroadcastCell \vr, 14, 10, 15
+        \vr\()Por    \vr\()14, \vr\()14, (\vr\()word ptr [rsp + laneFrameHiddenColumn * \rb])
+        \vr\()Pand   \vr\()14, \vr\()14, \vr\num
+        LaneNonZeroCells \vr, 15, 14, 10
+        \vr\()Pandn  \vr\()15, \vr\()15, \vr\num
+        \vr\()Por    \vr\()15, \vr\()15, \vr\()14
+        \vr\()Pxor   \vr\()10, \vr\()15, \vr\num
+        \vr\()Por    \vr\()11, \vr\()11, \vr\()10
+        \vr\()Movdqa \vr\num, \vr\()15
+.endm
+
+# Locked candidates in lanes, which FindLockedCandidates applies to rows in XMM registers.
+# Register 15 collects candidates that they remove.
+.macro LaneLockedOtherParts vr, dst, src, work
+        # Merge other two 32-bit elements of 0..2 into each element
+        vpshufd  \vr\dst, \vr\src, 0xc9
+        vpshufd  \vr\work, \vr\src, 0xd2
+        \vr\()Por    \vr\dst, \vr\dst, \vr\work
+.endm
+
+.macro LaneLockedOtherCells vr, dst, src, work
+        # Merge other two cells in each 32 bits into each cell
+        vpsrld   \vr\dst, \vr\src, candidatesNum
+        vpsrld   \vr\work, \vr\src, (candidatesNum * 2)
+        \vr\()Por    \vr\dst, \vr\dst, \vr\work
+        vpslld   \vr\work, \vr\src, candidatesNum
+        \vr\()Por    \vr\dst, \vr\dst, \vr\work
+        vpslld   \vr\work, \vr\src, (candidatesNum * 2)
+        \vr\()Por    \vr\dst, \vr\dst, \vr\work
+        \vr\()Pand   \vr\dst, \vr\dst, (\vr\()word ptr [rip + sudokuLaneRowPartMask])
+.endm
+
+.macro LaneLockedRemoveCandidates vr, row, mask, work
+        \vr\()Pand   \vr\work, \vr\row, \vr\mask
+        \vr\()Por    \vr\()15, \vr\()15, \vr\work
+        \vr\()Pandn  \vr\row, \vr\mask, \vr\row
+.endm
+
+.macro LaneLockedRowPointing vr, target, partTarget, partOther1, partOther2, work1, work2, work3
+        \vr\()Por    \vr\work1, \vr\partOther1, \vr\partOther2
+        \vr\()Pandn  \vr\work1, \vr\work1, \vr\partTarget
+        LaneLockedOtherParts \vr, \work2, \work1, \work3
+        LaneBroadcastCell \vr, \work2, \work1, \work3
+        LaneLockedRemoveCandidates \vr, \target, \work2, \work3
+.endm
+
+.macro LaneLockedRowClaiming vr, other1, other2, partSrc, work1, work2, work3
+        LaneLockedOtherParts \vr, \work1, \partSrc, \work2
+        \vr\()Pandn  \vr\work1, \vr\work1, \vr\partSrc
+        LaneBroadcastCell \vr, \work1, \work2, \work3
+        LaneLockedRemoveCandidates \vr, \other1, \work1, \work2
+        LaneLockedRemoveCandidates \vr, \other2, \work1, \work2
+.endm
+
+.macro LaneLockedRowsInBand vr, rowA, rowB, rowC, partA, partB, partC, work1, work2, work3
+        LaneFoldCells \vr, \partA, \rowA, \work1
+        LaneFoldCells \vr, \partB, \rowB, \work1
+        LaneFoldCells \vr, \partC, \rowC, \work1
+        LaneLockedRowPointing \vr, \rowA, \partA, \partB, \partC, \work1, \work2, \work3
+        LaneLockedRowPointing \vr, \rowB, \partB, \partA, \partC, \work1, \work2, \work3
+        LaneLockedRowPointing \vr, \rowC, \partC, \partA, \partB, \work1, \work2, \work3
+        LaneLockedRowClaiming \vr, \rowB, \rowC, \partA, \work1, \work2, \work3
+        LaneLockedRowClaiming \vr, \rowA, \rowC, \partB, \work1, \work2, \work3
+        LaneLockedRowClaiming \vr, \rowA, \rowB, \partC, \work1, \work2, \work3
+.endm
+
+.macro LaneLockedColumnClaiming vr, rowA, rowB, rowC, bandTarget, bandOther1, bandOther2, work1, work2, work3
+        \vr\()Por    \vr\work1, \vr\bandOther1, \vr\bandOther2
+        \vr\()Pandn  \vr\work1, \vr\work1, \vr\bandTarget
+        LaneLockedOtherCells \vr, \work2, \work1, \work3
+        LaneLockedRemoveCandidates \vr, \rowA, \work2, \work3
+        LaneLockedRemoveCandidates \vr, \rowB, \work2, \work3
+        LaneLockedRemoveCandidates \vr, \rowC, \work2, \work3
+.endm
+
+.macro LaneLockedColumnPointingCells vr, band, work1, work2
+        # Leave numbers in a box that are only in a column of the box
+        LaneLockedOtherCells \vr, \work1, \band, \work2
+        \vr\()Pandn  \vr\band, \vr\work1, \vr\band
+.endm
+
+.macro LaneLockedColumnPointing vr, rowA, rowB, rowC, bandOther1, bandOther2, work1, work2
+        \vr\()Por    \vr\work1, \vr\bandOther1, \vr\bandOther2
+        LaneLockedRemoveCandidates \vr, \rowA, \work1, \work2
+        LaneLockedRemoveCandidates \vr, \rowB, \work1, \work2
+        LaneLockedRemoveCandidates \vr, \rowC, \work1, \work2
+.endm
+
+.macro LaneFindLockedCandidates vr
+        # Take the same steps as FindLockedCandidates
+        \vr\()Pxor   \vr\()15, \vr\()15, \vr\()15
+        LaneLockedRowsInBand \vr, 1, 2, 3, 0, 10, 11, 12, 13, 14
+        LaneLockedRowsInBand \vr, 4, 5, 6, 0, 10, 11, 12, 13, 14
+        LaneLockedRowsInBand \vr, 7, 8, 9, 0, 10, 11, 12, 13, 14
+
+        \vr\()Por    \vr\()10, \vr\()1, \vr\()2
+        \vr\()Por    \vr\()10, \vr\()10, \vr\()3
+        \vr\()Por    \vr\()11, \vr\()4, \vr\()5
+        \vr\()Por    \vr\()11, \vr\()11, \vr\()6
+        \vr\()Por    \vr\()12, \vr\()7, \vr\()8
+        \vr\()Por    \vr\()12, \vr\()12, \vr\()9
+        LaneLockedColumnClaiming \vr, 1, 2, 3, 10, 11, 12, 0, 13, 14
+        LaneLockedColumnClaiming \vr, 4, 5, 6, 11, 10, 12, 0, 13, 14
+        LaneLockedColumnClaiming \vr, 7, 8, 9, 12, 10, 11, 0, 13, 14
+
+        LaneLockedColumnPointingCells \vr, 10, 13, 14
+        LaneLockedColumnPointingCells \vr, 11, 13, 14
+        LaneLockedColumnPointingCells \vr, 12, 13, 14
+        LaneLockedColumnPointing \vr, 1, 2, 3, 11, 12, 13, 14
+        LaneLockedColumnPointing \vr, 4, 5, 6, 10, 12, 13, 14
+        LaneLockedColumnPointing \vr, 7, 8, 9, 10, 11, 13, 14
+.endm
+
+.macro FillSudokuInLanes vr, rb, lanes
+        push    rbp
+        mov     rbp, rsp
+        sub     rsp, (laneFrameSize * \rb)
+        and     rsp, -\rb
+        mov     r12, qword ptr [rsi]
+        mov     r13, qword ptr [rsi + 8]
+.ifc \vr, zmm
+        mov     r14, qword ptr [rsi + 16]
+        mov     r15, qword ptr [rsi + 24]
+.endif
+        LaneLoadRow \vr, 1
+        LaneLoadRow \vr, 2
+        LaneLoadRow \vr, 3
+        LaneLoadRow \vr, 4
+        LaneLoadRow \vr, 5
+        LaneLoadRow \vr, 6
+        LaneLoadRow \vr, 7
+        LaneLoadRow \vr, 8
+        LaneLoadRow \vr, 9
+        xor     r8d, r8d
+        xor     r9d, r9d
+
+5001:
+        \vr\()Pxor  \vr\()10, \vr\()10, \vr\()10
+        \vr\()Pxor  \vr\()11, \vr\()11, \vr\()11
+        LaneCollectUniqueCandidates \vr, \rb, 1
+        LaneCollectUniqueCandidates \vr, \rb, 2
+        LaneCollectUniqueCandidates \vr, \rb, 3
+        LaneCollectUniqueCandidates \vr, \rb, 4
+        LaneCollectUniqueCandidates \vr, \rb, 5
+        LaneCollectUniqueCandidates \vr, \rb, 6
+        LaneCollectUniqueCandidates \vr, \rb, 7
+        LaneCollectUniqueCandidates \vr, \rb, 8
+        LaneCollectUniqueCandidates \vr, \rb, 9
+        \vr\()Movdqa (\vr\()word ptr [rsp + laneFrameColumn * \rb]), \vr\()10
+        LaneFlags \vr, r10, r11, 11, 13
+        or      r8d, r10d
+        cmp     r8d, ((1 << \lanes) - 1)
+        jz      5002f
+
+        # Register 11 holds cells that have changed in this iteration
+        \vr\()Pxor  \vr\()11, \vr\()11, \vr\()11
+        LaneFilterBand \vr, \rb, 1, 2, 3
+        LaneFilterBand \vr, \rb, 4, 5, 6
+        LaneFilterBand \vr, \rb, 7, 8, 9
+
+        # Register 0 holds digits that no cell in a row, column or box has
+        \vr\()Movdqa \vr\()12, \vr\()1
+        \vr\()Pxor  \vr\()13, \vr\()13, \vr\()13
+        LaneCountColumn \vr, 2
+        LaneCountColumn \vr, 3
+        LaneCountColumn \vr, 4
+        LaneCountColumn \vr, 5
+        LaneCountColumn \vr, 6
+        LaneCountColumn \vr, 7
+        LaneCountColumn \vr, 8
+        LaneCountColumn \vr, 9
+        \vr\()Pxor  \vr\()0, \vr\()12, (\vr\()word ptr [rip + sudokuLaneRowPartMask])
+        \vr\()Pandn \vr\()13, \vr\()13, \vr\()12
+        \vr\()Movdqa (\vr\()word ptr [rsp + laneFrameHiddenColumn * \rb]), \vr\()13
+        LaneFindBand \vr, \rb, 0, 1, 2, 3
+        LaneFindBand \vr, \rb, 1, 4, 5, 6
+        LaneFindBand \vr, \rb, 2, 7, 8, 9
+
+        LaneFlags \vr, r10, r11, 0, 13
+        or      r8d, r10d
+        LaneFlags \vr, r10, r11, 11, 13
+        andn    r10d, r8d, r10d
+        jnz     5003f
+
+        # Keep filling cells if the locked candidates method reduces candidates
+        LaneFindLockedCandidates \vr
+        LaneFlags \vr, r10, r11, 15, 13
+        andn    r10d, r8d, r10d
+        jz      5002f
+5003:
+        inc     r9d
+        cmp     r9d, laneMaxLoopcnt
+        jb      5001b
+
+5002:
+        LaneCountFilled \rb, 0
+        LaneCountFilled \rb, 1
+.ifc \vr, zmm
+        LaneCountFilled \rb, 2
+        LaneCountFilled \rb, 3
+.endif
+        LaneSaveRow \vr, 1
+        LaneSaveRow \vr, 2
+        LaneSaveRow \vr, 3
+        LaneSaveRow \vr, 4
+        LaneSaveRow \vr, 5
+        LaneSaveRow \vr, 6
+        LaneSaveRow \vr, 7
+        LaneSaveRow \vr, 8
+        LaneSaveRow \vr, 9
+        mov     eax, r8d
+        vzeroupper
+        mov     rsp, rbp
+        pop     rbp
+        ret
+.endm
+
+# Returns that all puzzles have no solution if the CPU does not support instructions
+.macro FillSudokuInLanesUnavailable lanes
+        mov     eax, ((1 << \lanes) - 1)
+        ret
+.endm
+
+        .global fillTwoSudokuAsm
+        .global fillFourSudokuAsm
+fillTwoSudokuAsm:
+.if ((EnableAvx != 0) && (DiagonalSudoku == 0))
+        FillSudokuInLanes ymm, laneRowByteSizeYmm, 2
+.else
+        FillSudokuInLanesUnavailable 2
+.endif
+
+fillFourSudokuAsm:
+.if ((EnableAvx512 != 0) && (DiagonalSudoku == 0))
+        FillSudokuInLanes zmm, laneRowByteSizeZmm, 4
+.else
+        FillSudokuInLanesUnavailable 4
+.endif
+
         .global loadXmmRegisters
 loadXmmRegisters:
         MacroMovdqa xmm0,  (xmmword ptr [rsi])
@@ -2006,6 +2853,13 @@ saveXmmRegisters:
         MacroMovdqa (xmmword ptr [rdi+240]), xmm15
         ret
 
+# Selects an instruction set that RAX designates (0:SSE4.2, 1:AVX2, 2:AVX-512).
+# This code has only one instruction set and sudokusse_dispatch.s replaces this function
+# in an executable that contains code for all instruction sets.
+        .global sudokuXmmSelectIsa
+sudokuXmmSelectIsa:
+        ret
+
 # Counts solutions of a sudoku puzzle
         # Assign registers to variables (RCX is exclusive for a shift counter)
         .set    xRightestColumn, xmm10
@@ -2024,6 +2878,8 @@ saveXmmRegisters:
         .set    gRegReturn, r13
         .set    gRegOne64,  r14
         .set    gRegFastBitMask64, r15
+        # RBP is callee-saved and keeps it across calling sudokuXmmPrintFunc
+        .set    gRegContext, rbp
 
         .if (UseReg64Most != 0)
         .set    gRegShift,  rcx
@@ -2489,36 +3345,25 @@ testFastSetUniqueCandidatesAtCellSub88:
         jmp [rip + sudokuXmmCountFuncTable + \cellCount * funcPtrByteSize]
 .endm
 
-.macro CountUniqueCandidatesAtNextCell cellCount, candidate
-        test    gRegSum, \candidate
-        jz      11009f
-        mov     gRegNewCandidate, \candidate
-        FastSetUniqueCandidatesAtCell gRegNewCandidate, \cellCount
-        CallCountUniqueCandidatesAtCell (\cellCount + 1)
-11009:
-        mov     gRegSum64, qword ptr [rip + sudokuXmmCandidateArray + \cellCount * arrayElementByteSize]
-.endm
-
 .macro FastPrintAllCells
-        MacroMovdqa  (xmmword ptr [rip + sudokuXmmToPrint]),     xmm0
-        MacroMovdqa  (xmmword ptr [rip + sudokuXmmToPrint+16]),  xmm1
-        MacroMovdqa  (xmmword ptr [rip + sudokuXmmToPrint+32]),  xmm2
-        MacroMovdqa  (xmmword ptr [rip + sudokuXmmToPrint+48]),  xmm3
-        MacroMovdqa  (xmmword ptr [rip + sudokuXmmToPrint+64]),  xmm4
-        MacroMovdqa  (xmmword ptr [rip + sudokuXmmToPrint+80]),  xmm5
-        MacroMovdqa  (xmmword ptr [rip + sudokuXmmToPrint+96]),  xmm6
-        MacroMovdqa  (xmmword ptr [rip + sudokuXmmToPrint+112]), xmm7
-        MacroMovdqa  (xmmword ptr [rip + sudokuXmmToPrint+128]), xmm8
-        MacroMovdqa  (xmmword ptr [rip + sudokuXmmToPrint+144]), xmm9
-        MacroMovdqa  (xmmword ptr [rip + sudokuXmmToPrint+160]), xmm10
-        MacroMovdqa  (xmmword ptr [rip + sudokuXmmToPrint+176]), xmm11
-        MacroMovdqa  (xmmword ptr [rip + sudokuXmmToPrint+192]), xmm12
-        MacroMovdqa  (xmmword ptr [rip + sudokuXmmToPrint+208]), xmm13
-        MacroMovdqa  (xmmword ptr [rip + sudokuXmmToPrint+224]), xmm14
-        MacroMovdqa  (xmmword ptr [rip + sudokuXmmToPrint+240]), xmm15
-
-        push    rbp
-        mov     qword ptr [rip + sudokuXmmStackPointer], rsp
+        MacroMovdqa  (xmmword ptr [gRegContext + enumContextToPrint]),     xmm0
+        MacroMovdqa  (xmmword ptr [gRegContext + enumContextToPrint+16]),  xmm1
+        MacroMovdqa  (xmmword ptr [gRegContext + enumContextToPrint+32]),  xmm2
+        MacroMovdqa  (xmmword ptr [gRegContext + enumContextToPrint+48]),  xmm3
+        MacroMovdqa  (xmmword ptr [gRegContext + enumContextToPrint+64]),  xmm4
+        MacroMovdqa  (xmmword ptr [gRegContext + enumContextToPrint+80]),  xmm5
+        MacroMovdqa  (xmmword ptr [gRegContext + enumContextToPrint+96]),  xmm6
+        MacroMovdqa  (xmmword ptr [gRegContext + enumContextToPrint+112]), xmm7
+        MacroMovdqa  (xmmword ptr [gRegContext + enumContextToPrint+128]), xmm8
+        MacroMovdqa  (xmmword ptr [gRegContext + enumContextToPrint+144]), xmm9
+        MacroMovdqa  (xmmword ptr [gRegContext + enumContextToPrint+160]), xmm10
+        MacroMovdqa  (xmmword ptr [gRegContext + enumContextToPrint+176]), xmm11
+        MacroMovdqa  (xmmword ptr [gRegContext + enumContextToPrint+192]), xmm12
+        MacroMovdqa  (xmmword ptr [gRegContext + enumContextToPrint+208]), xmm13
+        MacroMovdqa  (xmmword ptr [gRegContext + enumContextToPrint+224]), xmm14
+        MacroMovdqa  (xmmword ptr [gRegContext + enumContextToPrint+240]), xmm15
+
+        mov     qword ptr [gRegContext + enumContextStackPointer], rsp
 
         # In the x64 ABI, callers have responsibility to allocate 32 bytes on stack
         .set    MinStackSize, 32
@@ -2528,30 +3373,32 @@ testFastSetUniqueCandidatesAtCellSub88:
         # If we violate this rule, standard C++ libraries will crash abruptly
         # when this code calls std::iostram.
 
-        # RSP is aligned on 16 bytes boundary when a C/C++ function calls here
-        # and RSP is not aligned on 16 bytes boundary after push RBP.
+        # RSP is not aligned on 16 bytes boundary in recursive calls.
         # Flooring RSP to 16*N bytes is required.
         and     rsp, ~0xf
-        call    [rip + sudokuXmmPrintFunc]
-        mov     rsp, qword ptr [rip + sudokuXmmStackPointer]
-        pop     rbp
 
-        MacroMovdqa  xmm0,  (xmmword ptr [rip + sudokuXmmToPrint])
-        MacroMovdqa  xmm1,  (xmmword ptr [rip + sudokuXmmToPrint+16])
-        MacroMovdqa  xmm2,  (xmmword ptr [rip + sudokuXmmToPrint+32])
-        MacroMovdqa  xmm3,  (xmmword ptr [rip + sudokuXmmToPrint+48])
-        MacroMovdqa  xmm4,  (xmmword ptr [rip + sudokuXmmToPrint+64])
-        MacroMovdqa  xmm5,  (xmmword ptr [rip + sudokuXmmToPrint+80])
-        MacroMovdqa  xmm6,  (xmmword ptr [rip + sudokuXmmToPrint+96])
-        MacroMovdqa  xmm7,  (xmmword ptr [rip + sudokuXmmToPrint+112])
-        MacroMovdqa  xmm8,  (xmmword ptr [rip + sudokuXmmToPrint+128])
-        MacroMovdqa  xmm9,  (xmmword ptr [rip + sudokuXmmToPrint+144])
-        MacroMovdqa  xmm10, (xmmword ptr [rip + sudokuXmmToPrint+160])
-        MacroMovdqa  xmm11, (xmmword ptr [rip + sudokuXmmToPrint+176])
-        MacroMovdqa  xmm12, (xmmword ptr [rip + sudokuXmmToPrint+192])
-        MacroMovdqa  xmm13, (xmmword ptr [rip + sudokuXmmToPrint+208])
-        MacroMovdqa  xmm14, (xmmword ptr [rip + sudokuXmmToPrint+224])
-        MacroMovdqa  xmm15, (xmmword ptr [rip + sudokuXmmToPrint+240])
+        # Pass the context block as the first argument in both the Linux and Windows x64 ABIs
+        mov     rdi, gRegContext
+        mov     rcx, gRegContext
+        call    [rip + sudokuXmmPrintFunc]
+        mov     rsp, qword ptr [gRegContext + enumContextStackPointer]
+
+        MacroMovdqa  xmm0,  (xmmword ptr [gRegContext + enumContextToPrint])
+        MacroMovdqa  xmm1,  (xmmword ptr [gRegContext + enumContextToPrint+16])
+        MacroMovdqa  xmm2,  (xmmword ptr [gRegContext + enumContextToPrint+32])
+        MacroMovdqa  xmm3,  (xmmword ptr [gRegContext + enumContextToPrint+48])
+        MacroMovdqa  xmm4,  (xmmword ptr [gRegContext + enumContextToPrint+64])
+        MacroMovdqa  xmm5,  (xmmword ptr [gRegContext + enumContextToPrint+80])
+        MacroMovdqa  xmm6,  (xmmword ptr [gRegContext + enumContextToPrint+96])
+        MacroMovdqa  xmm7,  (xmmword ptr [gRegContext + enumContextToPrint+112])
+        MacroMovdqa  xmm8,  (xmmword ptr [gRegContext + enumContextToPrint+128])
+        MacroMovdqa  xmm9,  (xmmword ptr [gRegContext + enumContextToPrint+144])
+        MacroMovdqa  xmm10, (xmmword ptr [gRegContext + enumContextToPrint+160])
+        MacroMovdqa  xmm11, (xmmword ptr [gRegContext + enumContextToPrint+176])
+        MacroMovdqa  xmm12, (xmmword ptr [gRegContext + enumContextToPrint+192])
+        MacroMovdqa  xmm13, (xmmword ptr [gRegContext + enumContextToPrint+208])
+        MacroMovdqa  xmm14, (xmmword ptr [gRegContext + enumContextToPrint+224])
+        MacroMovdqa  xmm15, (xmmword ptr [gRegContext + enumContextToPrint+240])
 .endm
 
 .macro CountUniqueCandidatesAtCellLoop outBoxShift, inBoxShift, cellCount, xRegSrcTarget, xRegSrcOther1, xRegSrcOther2, rowNumber
@@ -2598,7 +3445,7 @@ testFastSetUniqueCandidatesAtCellSub88:
         # All cells are filled
         add     gRegCount, gRegOne64
 
-        cmp     qword ptr [rip + sudokuXmmPrintAllCandidate], 0
+        cmp     qword ptr [gRegContext + enumContextPrintAllCandidate], 0
         # Jump to 'no print candidates' and make this branch fast
         jnz     10021f
         jmp     gRegReturn
@@ -2606,15 +3453,15 @@ testFastSetUniqueCandidatesAtCellSub88:
 10021:
         not     gRegSum
         and     gRegSum, gRegFastBitMask
-        mov     qword ptr [rip + sudokuXmmRightBottomSolved], gRegSum64
-        mov     qword ptr [rip + sudokuXmmAllPatternCnt], gRegCount
-        mov     qword ptr [rip + sudokuXmmReturnAddr], gRegReturn
+        mov     qword ptr [gRegContext + enumContextRightBottomSolved], gRegSum64
+        mov     qword ptr [gRegContext + enumContextAllPatternCnt], gRegCount
+        mov     qword ptr [gRegContext + enumContextReturnAddr], gRegReturn
 
         FastPrintAllCells
         FastInitMaskRegister
-        mov     gRegReturn, qword ptr [rip + sudokuXmmReturnAddr]
-        mov     gRightBottomElement64, qword ptr [rip + sudokuXmmRightBottomElement]
-        mov     gRegCount, qword ptr [rip + sudokuXmmAllPatternCnt]
+        mov     gRegReturn, qword ptr [gRegContext + enumContextReturnAddr]
+        mov     gRightBottomElement64, qword ptr [gRegContext + enumContextRightBottomElement]
+        mov     gRegCount, qword ptr [gRegContext + enumContextAllPatternCnt]
         jmp     gRegReturn
 
         .else
@@ -2688,8 +3535,13 @@ testFastSetUniqueCandidatesAtCellSub88:
         .endif
 .endm
 
+# Counts solutions of a puzzle in XMM registers
+# RAX : the first cell to fill
+# RDX : the context block of this thread (SudokuSseEnumeratorContext)
         .global sudokuXmmCountFromCell
 sudokuXmmCountFromCell:
+        push    gRegContext
+        mov     gRegContext, rdx
         mov     gRegWork64, sudokuMaxLoopcnt
         FastDec gRegWork64
         cmp     rax, gRegWork64
@@ -2699,13 +3551,13 @@ sudokuXmmCountFromCell:
         ShlNonZero rax, funcPtrByteSizeLog2
         add     rax, gRegWork64
 
-        mov     gRightBottomElement64, qword ptr [rip + sudokuXmmRightBottomElement]
-        mov     qword ptr [rip + sudokuXmmDebug], 0
+        mov     gRightBottomElement64, qword ptr [gRegContext + enumContextRightBottomElement]
         xor     gRegCount, gRegCount
 
         FastInitMaskRegister
         call    [rax]
-        mov     qword ptr [rip + sudokuXmmAllPatternCnt], gRegCount
+        mov     qword ptr [gRegContext + enumContextAllPatternCnt], gRegCount
+        pop     gRegContext
         ret
 
 countAt00:
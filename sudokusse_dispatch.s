@@ -0,0 +1,101 @@
+# Sudoku solver with SSE 4.2 / AVX
+# Copyright (C) 2012-2018 Zettsu Tatsuya
+#
+# Selects one of instruction sets at run time.
+# Makefile assembles sudokusse.s for each of SSE4.2, AVX2 and AVX-512,
+# prefixes its functions with sse42_, avx2_ and avx512_, and weakens its
+# variables to share them between the three objects.
+# This file forwards calls from C++ code to the functions of a selected instruction set.
+
+.intel_syntax noprefix
+.file   "sudokusse_dispatch.s"
+
+        # Variables that sudokusse.s and C++ code share but this file replaces
+        .global sudokuXmmUseAvx
+        .global sudokuXmmUseAvx512
+        .global sudokuXmmIsaSet
+
+        # Functions that C++ code calls
+        .global solveSudokuAsm
+        .global searchSudokuAsm
+        .global fillTwoSudokuAsm
+        .global fillFourSudokuAsm
+        .global loadXmmRegisters
+        .global saveXmmRegisters
+        .global sudokuXmmCountFromCell
+        .global sudokuXmmSelectIsa
+
+.set  numberOfIsa,          3
+.set  numberOfIsaFunctions, 7
+.set  isaFunctionByteSize,  8
+
+.macro IsaFunctionSet prefix
+        .quad \prefix\()solveSudokuAsm
+        .quad \prefix\()searchSudokuAsm
+        .quad \prefix\()fillTwoSudokuAsm
+        .quad \prefix\()fillFourSudokuAsm
+        .quad \prefix\()loadXmmRegisters
+        .quad \prefix\()saveXmmRegisters
+        .quad \prefix\()sudokuXmmCountFromCell
+.endm
+
+.data
+# These variables are set by a thread before multiple threads read
+sudokuXmmUseAvx:                .quad 0
+sudokuXmmUseAvx512:             .quad 0
+sudokuXmmIsaSet:                .quad ((1 << numberOfIsa) - 1)
+
+# Functions of the selected instruction set. SSE4.2 runs on all x86-64 CPUs that this solver supports.
+.align 64
+isaFunctionSet:
+        IsaFunctionSet sse42_
+
+# Functions of all instruction sets in order of RAX in sudokuXmmSelectIsa
+isaFunctionTable:
+        IsaFunctionSet sse42_
+        IsaFunctionSet avx2_
+        IsaFunctionSet avx512_
+
+.text
+.macro IsaForward name, index
+\name:
+        jmp     qword ptr [rip + isaFunctionSet + \index * isaFunctionByteSize]
+.endm
+
+        IsaForward solveSudokuAsm,         0
+        IsaForward searchSudokuAsm,        1
+        IsaForward fillTwoSudokuAsm,       2
+        IsaForward fillFourSudokuAsm,      3
+        IsaForward loadXmmRegisters,       4
+        IsaForward saveXmmRegisters,       5
+        IsaForward sudokuXmmCountFromCell, 6
+
+# Selects an instruction set that RAX designates (0:SSE4.2, 1:AVX2, 2:AVX-512).
+# Call this before running on multi-threading.
+# Destroys RAX, RCX, RDX and R8
+sudokuXmmSelectIsa:
+        cmp     rax, numberOfIsa
+        jae     2f
+
+        xor     ecx, ecx
+        cmp     rax, 1
+        setae   cl
+        mov     qword ptr [rip + sudokuXmmUseAvx], rcx
+        xor     ecx, ecx
+        cmp     rax, 2
+        setae   cl
+        mov     qword ptr [rip + sudokuXmmUseAvx512], rcx
+
+        imul    rax, rax, (numberOfIsaFunctions * isaFunctionByteSize)
+        lea     rdx, [rip + isaFunctionTable]
+        add     rdx, rax
+        lea     r8, [rip + isaFunctionSet]
+        xor     ecx, ecx
+1:
+        mov     rax, qword ptr [rdx + rcx * isaFunctionByteSize]
+        mov     qword ptr [r8 + rcx * isaFunctionByteSize], rax
+        inc     ecx
+        cmp     ecx, numberOfIsaFunctions
+        jb      1b
+2:
+        ret
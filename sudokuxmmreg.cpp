@@ -1,5 +1,5 @@
-// Sudoku solver with SSE 4.2
-// Copyright (C) 2012-2015 Zettsu Tatsuya
+// Sudoku solver with SSE 4.2 / AVX
+// Copyright (C) 2012-2018 Zettsu Tatsuya
 
 #include "sudoku.h"
 
@@ -19,6 +19,81 @@ namespace Sudoku {
             ::"D"(pData):);
         return;
     }
+
+    namespace {
+        // Returns whether the CPU supports an instruction set regardless of this executable
+        bool canCpuUseIsa(SudokuIsa isa) {
+            __builtin_cpu_init();
+            const bool useSse = __builtin_cpu_supports("sse4.2") && __builtin_cpu_supports("popcnt");
+            const bool useAvx2 = useSse && __builtin_cpu_supports("avx2") && __builtin_cpu_supports("bmi");
+            const bool useAvx512 = useAvx2 && __builtin_cpu_supports("avx512f") &&
+                __builtin_cpu_supports("avx512vl") && __builtin_cpu_supports("bmi2");
+
+            switch(isa) {
+            case SudokuIsa::SSE_4_2:
+                return useSse;
+            case SudokuIsa::AVX2:
+                return useAvx2;
+            case SudokuIsa::AVX512:
+                return useAvx512;
+            default:
+                break;
+            }
+            return false;
+        }
+    }
+
+    bool CanUseIsa(SudokuIsa isa) {
+        const uint64_t isaBit = static_cast<uint64_t>(1) << static_cast<unsigned int>(isa);
+        return ((sudokuXmmIsaSet & isaBit) != 0) && canCpuUseIsa(isa);
+    }
+
+    SudokuIsa GetFastestIsa(void) {
+        for(const auto isa : {SudokuIsa::AVX512, SudokuIsa::AVX2, SudokuIsa::SSE_4_2}) {
+            if (CanUseIsa(isa)) {
+                return isa;
+            }
+        }
+
+        // The CPU does not support this executable but it may have run already
+        return GetIsa();
+    }
+
+    SudokuIsa GetIsa(void) {
+        if (sudokuXmmUseAvx512) {
+            return SudokuIsa::AVX512;
+        }
+        return (sudokuXmmUseAvx) ? SudokuIsa::AVX2 : SudokuIsa::SSE_4_2;
+    }
+
+    bool SelectIsa(SudokuIsa isa) {
+        if (!CanUseIsa(isa)) {
+            return false;
+        }
+
+        // Skip the red zone because the compiler regards this function as a leaf function
+        uint64_t isaIndex = static_cast<uint64_t>(isa);
+        asm volatile (
+            "sub rsp, 128\n\t"
+            "call sudokuXmmSelectIsa\n\t"
+            "add rsp, 128\n\t"
+            :"+a"(isaIndex)::"rcx", "rdx", "r8", "memory");
+        return true;
+    }
+
+    const char* GetIsaName(SudokuIsa isa) {
+        switch(isa) {
+        case SudokuIsa::SSE_4_2:
+            return "SSE4.2";
+        case SudokuIsa::AVX2:
+            return "AVX2";
+        case SudokuIsa::AVX512:
+            return "AVX-512";
+        default:
+            break;
+        }
+        return "";
+    }
 }
 
 /*
@@ -79,7 +79,19 @@ protected:
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(SudokuLinuxTimerTest);
+class SudokuLinuxMappedFileTest : public SudokuMappedFileTest {
+    CPPUNIT_TEST_SUITE(SudokuLinuxMappedFileTest);
+    CPPUNIT_TEST(test_Constructor);
+    CPPUNIT_TEST_SUITE_END();
+public:
+    void setUp() override;
+    void tearDown() override;
+protected:
+    void test_Constructor();
+};
+
 CPPUNIT_TEST_SUITE_REGISTRATION(SudokuLinuxProcessorBinderTest);
+CPPUNIT_TEST_SUITE_REGISTRATION(SudokuLinuxMappedFileTest);
 
 // Call before running a test
 void SudokuLinuxTimerTest::setUp() {
@@ -221,6 +233,21 @@ void SudokuLinuxProcessorBinderTest::test_Constructor() {
     CPPUNIT_ASSERT(!pConcreteBinder->failed_);
 }
 
+// Call before running a test
+void SudokuLinuxMappedFileTest::setUp() {
+    return;
+}
+
+// Call after running a test
+void SudokuLinuxMappedFileTest::tearDown() {
+    return;
+}
+
+// Test cases
+void SudokuLinuxMappedFileTest::test_Constructor() {
+    checkMappedFile();
+}
+
 /*
 Local Variables:
 mode: c++
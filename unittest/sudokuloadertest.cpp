@@ -8,6 +8,7 @@
 #include <cassert>
 #include <cstring>
 #include <iostream>
+#include <iterator>
 #include <memory>
 #include "sudoku.h"
 #include "sudokutest.h"
@@ -16,6 +17,7 @@ class SudokuCheckerTest : public CPPUNIT_NS::TestFixture {
     CPPUNIT_TEST_SUITE(SudokuCheckerTest);
     CPPUNIT_TEST(test_initializeGrid);
     CPPUNIT_TEST(test_parse);
+    CPPUNIT_TEST(test_parseWithBuffer);
     CPPUNIT_TEST(test_parseRow);
     CPPUNIT_TEST(test_compare);
     CPPUNIT_TEST(test_checkRowSet);
@@ -31,6 +33,7 @@ public:
 protected:
     void test_initializeGrid();
     void test_parse();
+    void test_parseWithBuffer();
     void test_parseRow();
     void test_compare();
     void test_checkRowSet();
@@ -144,6 +147,38 @@ void SudokuCheckerTest::test_parse() {
     }
 }
 
+void SudokuCheckerTest::test_parseWithBuffer() {
+    if (DiagonalSudokuMode) {
+        return;
+    }
+
+    struct Test {
+        std::string line;
+        bool valid;
+        std::string expected;
+    };
+
+    const Test testSet[] = {
+        {solutionLineSet_, true, solutionOneLine_ + "\n"},
+        {solutionMissingLine_, false, "Invalid cell arrangement\n"},
+        {solutionOverwritten_, false, "Cell 79 overwritten\n"},
+        {solutionLineSet_, true, solutionOneLine_ + "\n"},
+        {"", false, "Invalid cell arrangement\n"},
+        {solutionLineSet_, true, solutionOneLine_ + "\n"}
+    };
+
+    // Strings in the buffer do not leak into next solutions
+    SudokuChecker::Buffer buffer;
+    for(const auto& test : testSet) {
+        SudokuOutStream os;
+        SudokuChecker checker(puzzle_, test.line, SudokuSolverPrint::PRINT, &os, buffer);
+        CPPUNIT_ASSERT_EQUAL(test.valid, checker.Valid());
+        CPPUNIT_ASSERT_EQUAL(0, static_cast<int>(os.str().find(test.expected)));
+    }
+
+    return;
+}
+
 void SudokuCheckerTest::test_parseRow() {
     for(SudokuIndex row = 0; row < Sudoku::SizeOfCellsPerGroup; ++row) {
         std::string rowLine = "9:8:7:6:5:4:3:2:1";
@@ -431,10 +466,67 @@ void SudokuCheckerTest::test_checkUnique() {
     }
 }
 
+class SudokuReusableStringBufferTest : public CPPUNIT_NS::TestFixture {
+    CPPUNIT_TEST_SUITE(SudokuReusableStringBufferTest);
+    CPPUNIT_TEST(test_Write);
+    CPPUNIT_TEST(test_Clear);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp() override;
+    void tearDown() override;
+protected:
+    void test_Write();
+    void test_Clear();
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(SudokuReusableStringBufferTest);
+
+void SudokuReusableStringBufferTest::setUp() {
+    return;
+}
+
+void SudokuReusableStringBufferTest::tearDown() {
+    return;
+}
+
+void SudokuReusableStringBufferTest::test_Write() {
+    SudokuReusableStringBuffer buffer;
+    std::ostream os(&buffer);
+    CPPUNIT_ASSERT(buffer.GetString().empty());
+
+    os << "1:2:" << 3 << ':' << std::string("45") << "\n";
+    os.put('6');
+    os.write("789", 2);
+    CPPUNIT_ASSERT(os.good());
+    CPPUNIT_ASSERT_EQUAL(std::string("1:2:3:45\n678"), buffer.GetString());
+    return;
+}
+
+void SudokuReusableStringBufferTest::test_Clear() {
+    SudokuReusableStringBuffer buffer;
+    std::ostream os(&buffer);
+    const std::string line(Sudoku::CacheGuardSize, '1');
+    os << line;
+    CPPUNIT_ASSERT_EQUAL(line, buffer.GetString());
+
+    const auto capacity = buffer.GetString().capacity();
+    buffer.Clear();
+    CPPUNIT_ASSERT(buffer.GetString().empty());
+    CPPUNIT_ASSERT_EQUAL(capacity, buffer.GetString().capacity());
+
+    os << "23";
+    CPPUNIT_ASSERT_EQUAL(std::string("23"), buffer.GetString());
+    return;
+}
+
 class SudokuDispatcherTest : public CPPUNIT_NS::TestFixture {
     CPPUNIT_TEST_SUITE(SudokuDispatcherTest);
     CPPUNIT_TEST(test_Constructor);
     CPPUNIT_TEST(test_Exec);
+    CPPUNIT_TEST(test_ExecUnique);
+    CPPUNIT_TEST(test_ExecLargeGrids);
+    CPPUNIT_TEST(test_ExecWorkspace);
     CPPUNIT_TEST(test_exec);
     CPPUNIT_TEST(test_execError);
     CPPUNIT_TEST(test_GetMessage);
@@ -446,6 +538,9 @@ public:
 protected:
     void test_Constructor();
     void test_Exec();
+    void test_ExecUnique();
+    void test_ExecLargeGrids();
+    void test_ExecWorkspace();
     void test_exec();
     void test_execError();
     void test_GetMessage();
@@ -536,7 +631,9 @@ void SudokuDispatcherTest::test_Exec() {
         {SudokuSolverCheck::DO_NOT_CHECK, SudokuSolverPrint::DO_NOT_PRINT, 1, 1}
     };
 
-    constexpr SudokuSolverType solverTypeSet[] = {SudokuSolverType::SOLVER_GENERAL, SudokuSolverType::SOLVER_SSE_4_2};
+    constexpr SudokuSolverType solverTypeSet[] = {SudokuSolverType::SOLVER_GENERAL, SudokuSolverType::SOLVER_SSE_4_2,
+                                                  SudokuSolverType::SOLVER_SOA, SudokuSolverType::SOLVER_SSE_INTRINSICS,
+                                                  SudokuSolverType::SOLVER_BITPLANE};
     for(const auto& test : testSet) {
         for(const auto solverType : solverTypeSet) {
             SudokuDispatcher inst(solverType, test.check, test.print, test.printAllCandidate, test.puzzleNum,
@@ -556,6 +653,122 @@ void SudokuDispatcherTest::test_Exec() {
     return;
 }
 
+void SudokuDispatcherTest::test_ExecUnique() {
+    if (DiagonalSudokuMode) {
+        return;
+    }
+
+    struct Test {
+        std::string puzzle;
+        std::string verdict;
+    };
+
+    const Test testSet[] = {
+        {SudokuTestPattern::NoBacktrackString, "unique"},
+        {SudokuTestPattern::BacktrackString, "unique"},
+        {"83...6....1..9.258..25486...43.128....17.43625..68.1....9....1...8....23..42...8.", "multiple"},
+        {"88...............................................................................", "none"}
+    };
+
+    constexpr SudokuSolverType solverTypeSet[] = {SudokuSolverType::SOLVER_GENERAL, SudokuSolverType::SOLVER_SSE_4_2};
+    for(const auto& test : testSet) {
+        for(const auto solverType : solverTypeSet) {
+            SudokuDispatcher inst(solverType, SudokuSolverCheck::CHECK_UNIQUE, SudokuSolverPrint::DO_NOT_PRINT,
+                                  0, 1, test.puzzle);
+            CPPUNIT_ASSERT(!inst.Exec());
+            const std::string expected = test.puzzle + " " + test.verdict + "\n";
+            CPPUNIT_ASSERT_EQUAL(expected, inst.GetMessage());
+        }
+    }
+
+    return;
+}
+
+void SudokuDispatcherTest::test_ExecLargeGrids() {
+    if (DiagonalSudokuMode) {
+        return;
+    }
+
+    struct Test {
+        std::string puzzle;
+        std::string solution;
+        SudokuIndex boxSize;
+    };
+
+    const Test testSet[] = {
+        {SudokuTestPattern::NoBacktrackString, SudokuTestPattern::NoBacktrackStringSolution, 3},
+        {SudokuTestPattern::Grid16String, SudokuTestPattern::Grid16Solution, 4},
+        {SudokuTestPattern::Grid25String, SudokuTestPattern::Grid25Solution, 5}
+    };
+
+    for(const auto& test : testSet) {
+        {
+            SudokuDispatcher inst(SudokuSolverType::SOLVER_SSE_4_2, SudokuSolverCheck::CHECK,
+                                  SudokuSolverPrint::PRINT, 0, 1, test.puzzle);
+            CPPUNIT_ASSERT_EQUAL(test.boxSize, inst.GetBoxSize());
+            CPPUNIT_ASSERT(!inst.Exec());
+            CPPUNIT_ASSERT_EQUAL(test.solution + "\n", inst.GetMessage());
+        }
+        {
+            SudokuDispatcher inst(SudokuSolverType::SOLVER_GENERAL, SudokuSolverCheck::CHECK_UNIQUE,
+                                  SudokuSolverPrint::DO_NOT_PRINT, 0, 1, test.puzzle);
+            CPPUNIT_ASSERT(!inst.Exec());
+            CPPUNIT_ASSERT_EQUAL(test.puzzle + " unique\n", inst.GetMessage());
+        }
+    }
+
+    // Two cells in a row hold the same number
+    std::string puzzle(SudokuGeometry<4>::SizeOfAllCells, '.');
+    puzzle.at(0) = '1';
+    puzzle.at(1) = '1';
+    SudokuDispatcher inst(SudokuSolverType::SOLVER_GENERAL, SudokuSolverCheck::CHECK,
+                          SudokuSolverPrint::DO_NOT_PRINT, 0, 1, puzzle);
+    CPPUNIT_ASSERT(inst.Exec());
+    CPPUNIT_ASSERT(inst.GetMessage().find("Error in case 1") != std::string::npos);
+    return;
+}
+
+void SudokuDispatcherTest::test_ExecWorkspace() {
+    if (DiagonalSudokuMode) {
+        return;
+    }
+
+    const std::string puzzleSet[] = {
+        SudokuTestPattern::BacktrackString, SudokuTestPattern::NoBacktrackString, SudokuTestPattern::ConflictString,
+        SudokuTestPattern::Grid16String, SudokuTestPattern::BacktrackString2, SudokuTestPattern::NoBacktrackString};
+
+    constexpr SudokuSolverType solverTypeSet[] = {SudokuSolverType::SOLVER_GENERAL, SudokuSolverType::SOLVER_SSE_4_2,
+                                                  SudokuSolverType::SOLVER_SOA, SudokuSolverType::SOLVER_SSE_INTRINSICS,
+                                                  SudokuSolverType::SOLVER_BITPLANE};
+
+    // A reused workspace solves puzzles as new solvers do
+    for(const auto solverType : solverTypeSet) {
+        SudokuDispatcherWorkspace workspace;
+        SudokuPuzzleCount puzzleNum = 1;
+        for(const auto& puzzle : puzzleSet) {
+            SudokuDispatcher expected(solverType, SudokuSolverCheck::CHECK, SudokuSolverPrint::PRINT, 0, puzzleNum, puzzle);
+            SudokuDispatcher actual(solverType, SudokuSolverCheck::CHECK, SudokuSolverPrint::PRINT, 0, puzzleNum, puzzle);
+            CPPUNIT_ASSERT_EQUAL(expected.Exec(), actual.Exec(workspace));
+            CPPUNIT_ASSERT_EQUAL(expected.GetMessage(), actual.GetMessage());
+            CPPUNIT_ASSERT_EQUAL(expected.GetStepCount(), actual.GetStepCount());
+            CPPUNIT_ASSERT_EQUAL(expected.GetGuessCount(), actual.GetGuessCount());
+            ++puzzleNum;
+        }
+    }
+
+    // Copies a puzzle in a mapped file to the workspace and leaves the dispatcher
+    const std::string mappedLine = SudokuTestPattern::NoBacktrackString + "\n";
+    SudokuDispatcher inst(SudokuSolverType::SOLVER_GENERAL, SudokuSolverCheck::CHECK, SudokuSolverPrint::PRINT, 0, 1,
+                          mappedLine.c_str(), SudokuTestPattern::NoBacktrackString.size());
+    SudokuDispatcherWorkspace workspace;
+    CPPUNIT_ASSERT(!inst.Exec(workspace));
+    CPPUNIT_ASSERT_EQUAL(SudokuTestPattern::NoBacktrackStringSolution + "\n", inst.GetMessage());
+    CPPUNIT_ASSERT_EQUAL(SudokuTestPattern::NoBacktrackString, workspace.puzzleLine_);
+    CPPUNIT_ASSERT(inst.puzzleLine_.empty());
+    CPPUNIT_ASSERT(inst.pPuzzleLine_ == mappedLine.c_str());
+    return;
+}
+
 void SudokuDispatcherTest::test_exec() {
     if (DiagonalSudokuMode) {
         // Check this in testing for original Sudoku or solve_sudoku_x.py
@@ -576,10 +789,10 @@ void SudokuDispatcherTest::test_exec() {
 
     for(const auto& test : testSet) {
         SudokuDispatcher inst(SudokuSolverType::SOLVER_GENERAL, test.check, test.print, 0, 0, "");
-        std::ostringstream ss;
-        SudokuSolver solver(SudokuTestPattern::NoBacktrackString, 0, &ss, 0);
+        SudokuDispatcherWorkspace workspace;
+        SudokuSolver solver(SudokuTestPattern::NoBacktrackString, 0, &workspace.solutionStream_, 0);
 
-        CPPUNIT_ASSERT(!inst.exec(solver, ss));
+        CPPUNIT_ASSERT(!inst.exec(solver, SudokuTestPattern::NoBacktrackString, workspace));
         std::string expected = test.expected;
         if (!expected.empty()) {
             expected += "\n";
@@ -608,10 +821,10 @@ void SudokuDispatcherTest::test_execError() {
     for(const auto& test : testSetConflict) {
         const std::string puzzleLine = "Puzzle Line";
         SudokuDispatcher inst(SudokuSolverType::SOLVER_GENERAL, test.check, test.print, 0, 12, puzzleLine);
-        std::ostringstream ss;
+        SudokuDispatcherWorkspace workspace;
 
-        SudokuSolver solver(SudokuTestPattern::ConflictString, 0, &ss, 0);
-        CPPUNIT_ASSERT_EQUAL(test.expected, inst.exec(solver, ss));
+        SudokuSolver solver(SudokuTestPattern::ConflictString, 0, &workspace.solutionStream_, 0);
+        CPPUNIT_ASSERT_EQUAL(test.expected, inst.exec(solver, puzzleLine, workspace));
 
         auto message = inst.GetMessage();
         auto pos = message.find(puzzleLine);
@@ -636,6 +849,7 @@ class SudokuMultiDispatcherTest : public CPPUNIT_NS::TestFixture {
     CPPUNIT_TEST(test_Constructor);
     CPPUNIT_TEST(test_AddPuzzle);
     CPPUNIT_TEST(test_ExecAll);
+    CPPUNIT_TEST(test_ExecRange);
     CPPUNIT_TEST(test_GetMessage);
     CPPUNIT_TEST_SUITE_END();
 
@@ -646,6 +860,7 @@ protected:
     void test_Constructor();
     void test_AddPuzzle();
     void test_ExecAll();
+    void test_ExecRange();
     void test_GetMessage();
 };
 
@@ -693,6 +908,41 @@ void SudokuMultiDispatcherTest::test_AddPuzzle() {
     CPPUNIT_ASSERT(!inst.dipatcherSet_.empty());
     CPPUNIT_ASSERT_EQUAL(puzzleNum, inst.dipatcherSet_.at(0).puzzleNum_);
     CPPUNIT_ASSERT_EQUAL(puzzleLine, inst.dipatcherSet_.at(0).puzzleLine_);
+
+    // Copies a puzzle in a mapped file when solving it
+    const std::string mappedLine = puzzleLine + "\n";
+    inst.AddPuzzle(puzzleNum + 1, mappedLine.c_str(), puzzleLine.size());
+    auto& dispatcher = inst.dipatcherSet_.at(1);
+    CPPUNIT_ASSERT(dispatcher.pPuzzleRecord_ == nullptr);
+    CPPUNIT_ASSERT_EQUAL(puzzleNum + 1, dispatcher.puzzleNum_);
+    CPPUNIT_ASSERT(dispatcher.puzzleLine_.empty());
+    CPPUNIT_ASSERT(dispatcher.pPuzzleLine_ == mappedLine.c_str());
+    CPPUNIT_ASSERT_EQUAL(puzzleLine.size(), dispatcher.sizeOfPuzzleLine_);
+
+    std::string buffer;
+    CPPUNIT_ASSERT_EQUAL(puzzleLine, dispatcher.getPuzzleLine(buffer));
+    CPPUNIT_ASSERT_EQUAL(puzzleLine, buffer);
+    CPPUNIT_ASSERT(dispatcher.puzzleLine_.empty());
+
+    // Decodes a record when solving it
+    SudokuPuzzleRecord::Record record;
+    CPPUNIT_ASSERT(SudokuPuzzleRecord::Encode(puzzleLine, record));
+    inst.AddRecord(puzzleNum + 2, record.data());
+    auto& recordDispatcher = inst.dipatcherSet_.at(2);
+    CPPUNIT_ASSERT_EQUAL(puzzleNum + 2, recordDispatcher.puzzleNum_);
+    CPPUNIT_ASSERT(recordDispatcher.puzzleLine_.empty());
+    CPPUNIT_ASSERT(recordDispatcher.pPuzzleLine_ == nullptr);
+    CPPUNIT_ASSERT(recordDispatcher.pPuzzleRecord_ == record.data());
+    CPPUNIT_ASSERT_EQUAL(static_cast<SudokuIndex>(Sudoku::SizeOfCellsOnBoxEdge), recordDispatcher.GetBoxSize());
+
+    std::string expected = puzzleLine;
+    expected.resize(Sudoku::SizeOfAllCells, '.');
+    CPPUNIT_ASSERT_EQUAL(expected, recordDispatcher.getPuzzleLine(buffer));
+    CPPUNIT_ASSERT_EQUAL(expected, buffer);
+    CPPUNIT_ASSERT(recordDispatcher.puzzleLine_.empty());
+
+    // Returns a puzzle which a dispatcher holds
+    CPPUNIT_ASSERT(&inst.dipatcherSet_.at(0).puzzleLine_ == &inst.dipatcherSet_.at(0).getPuzzleLine(buffer));
     return;
 }
 
@@ -723,6 +973,62 @@ void SudokuMultiDispatcherTest::test_ExecAll() {
         CPPUNIT_ASSERT(inst.GetMessage(0).empty());
         CPPUNIT_ASSERT(!inst.GetMessage(1).empty());
     }
+    {
+        // Solves 16x16 puzzles apart from 9x9 puzzles in lanes
+        SudokuMultiDispatcher inst(SudokuSolverType::SOLVER_SSE_4_2, SudokuSolverCheck::CHECK,
+                                   SudokuSolverPrint::PRINT, 0);
+        inst.AddPuzzle(1, SudokuTestPattern::NoBacktrackString);
+        inst.AddPuzzle(2, SudokuTestPattern::Grid16String);
+        inst.AddPuzzle(3, SudokuTestPattern::BacktrackString);
+        CPPUNIT_ASSERT(!inst.ExecAll());
+        CPPUNIT_ASSERT_EQUAL(SudokuTestPattern::NoBacktrackStringSolution + "\n", inst.GetMessage(0));
+        CPPUNIT_ASSERT_EQUAL(SudokuTestPattern::Grid16Solution + "\n", inst.GetMessage(1));
+        CPPUNIT_ASSERT(!inst.GetMessage(2).empty());
+    }
+    return;
+}
+
+void SudokuMultiDispatcherTest::test_ExecRange() {
+    if (DiagonalSudokuMode) {
+        // Check this in testing for original Sudoku or solve_sudoku_x.py
+        return;
+    }
+
+    for(const auto solverType : {SudokuSolverType::SOLVER_GENERAL, SudokuSolverType::SOLVER_SSE_4_2}) {
+        SudokuMultiDispatcher inst(solverType, SudokuSolverCheck::CHECK, SudokuSolverPrint::PRINT, 0);
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), inst.GetSize());
+        inst.AddPuzzle(1, SudokuTestPattern::NoBacktrackString);
+        inst.AddPuzzle(2, SudokuTestPattern::ConflictString);
+        inst.AddPuzzle(3, SudokuTestPattern::BacktrackString);
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(3), inst.GetSize());
+
+        // Solves puzzles in the range only
+        CPPUNIT_ASSERT(!inst.ExecRange(2, 3));
+        CPPUNIT_ASSERT(inst.GetMessage(0).empty());
+        CPPUNIT_ASSERT(inst.GetMessage(1).empty());
+        CPPUNIT_ASSERT(!inst.GetMessage(2).empty());
+
+        CPPUNIT_ASSERT(!inst.ExecRange(0, 0));
+        CPPUNIT_ASSERT(inst.GetMessage(0).empty());
+        CPPUNIT_ASSERT(inst.ExecRange(0, 10));
+        CPPUNIT_ASSERT_EQUAL(SudokuTestPattern::NoBacktrackStringSolution + "\n", inst.GetMessage(0));
+        CPPUNIT_ASSERT(!inst.GetMessage(1).empty());
+
+        // Solves puzzles in the same ranges with a workspace
+        SudokuMultiDispatcher instWorkspace(solverType, SudokuSolverCheck::CHECK, SudokuSolverPrint::PRINT, 0);
+        instWorkspace.AddPuzzle(1, SudokuTestPattern::NoBacktrackString);
+        instWorkspace.AddPuzzle(2, SudokuTestPattern::ConflictString);
+        instWorkspace.AddPuzzle(3, SudokuTestPattern::BacktrackString);
+        SudokuDispatcherWorkspace workspace;
+        CPPUNIT_ASSERT(!instWorkspace.ExecRange(2, 3, workspace));
+        CPPUNIT_ASSERT(instWorkspace.ExecRange(0, 10, workspace));
+        for(size_t i=0; i<inst.GetSize(); ++i) {
+            CPPUNIT_ASSERT_EQUAL(inst.GetMessage(i), instWorkspace.GetMessage(i));
+        }
+        CPPUNIT_ASSERT_EQUAL(inst.GetStepCount(), instWorkspace.GetStepCount());
+        CPPUNIT_ASSERT_EQUAL(inst.GetGuessCount(), instWorkspace.GetGuessCount());
+    }
+
     return;
 }
 
@@ -771,141 +1077,617 @@ void SudokuMultiDispatcherTest::test_GetMessage() {
     return;
 }
 
-class SudokuLoaderTest : public CPPUNIT_NS::TestFixture {
-    CPPUNIT_TEST_SUITE(SudokuLoaderTest);
-    CPPUNIT_TEST(test_Constructor);
-    CPPUNIT_TEST(test_CanLaunch);
-    CPPUNIT_TEST(test_setSingleMode);
-    CPPUNIT_TEST(test_setMultiMode);
-    CPPUNIT_TEST(test_setNumberOfThreads);
-    CPPUNIT_TEST(test_getMeasureCount);
-    CPPUNIT_TEST(test_execSingle);
-    CPPUNIT_TEST(test_execMultiPassedCpp);
-    CPPUNIT_TEST(test_execMultiPassedSse);
-    CPPUNIT_TEST(test_execMultiFailed);
-    CPPUNIT_TEST(test_printHeader);
-    CPPUNIT_TEST(test_readLines);
-    CPPUNIT_TEST(test_execAll);
-    CPPUNIT_TEST(test_writeMessage);
-    CPPUNIT_TEST(test_solveSudoku);
-    CPPUNIT_TEST(test_enumerateSudoku);
+class SudokuPuzzleRecordTest : public CPPUNIT_NS::TestFixture {
+    CPPUNIT_TEST_SUITE(SudokuPuzzleRecordTest);
+    CPPUNIT_TEST(test_IsRecordFile);
+    CPPUNIT_TEST(test_IsRecordStream);
+    CPPUNIT_TEST(test_GetSize);
+    CPPUNIT_TEST(test_GetRecord);
+    CPPUNIT_TEST(test_GetNumber);
+    CPPUNIT_TEST(test_WriteHeader);
+    CPPUNIT_TEST(test_Encode);
     CPPUNIT_TEST_SUITE_END();
 
 public:
     void setUp() override;
     void tearDown() override;
 protected:
-    void test_Constructor();
-    void test_setSingleMode();
-    void test_setMultiMode();
-    void test_setNumberOfThreads();
-    void test_CanLaunch();
-    void test_getMeasureCount();
-    void test_execSingle();
-    void test_execMultiPassedCpp();
-    void test_execMultiPassedSse();
-    void test_execMultiFailed();
-    void test_printHeader();
-    void test_readLines();
-    void test_execAll();
-    void test_writeMessage();
-    void test_solveSudoku();
-    void test_enumerateSudoku();
-private:
-    std::unique_ptr<SudokuInStream> createSudokuStream(const std::string& str);
-    // Use istringstream and do not use istrstream
-    std::unique_ptr<SudokuInStream>  pSudokuInStream_;   // source of initial puzzle maps
-    std::unique_ptr<SudokuOutStream> pSudokuOutStream_;  // destination to write strings
-    std::unique_ptr<SudokuLoader>    pInstance_;         // tested object
-    // command line arguments
-    static const int argc_ = 1;
-    static const char* const argv_[2];
+    void test_IsRecordFile();
+    void test_IsRecordStream();
+    void test_GetSize();
+    void test_GetRecord();
+    void test_GetNumber();
+    void test_WriteHeader();
+    void test_Encode();
 };
 
-const char* const SudokuLoaderTest::argv_[] {"sudoku", 0};
-
-CPPUNIT_TEST_SUITE_REGISTRATION(SudokuLoaderTest);
-
-std::unique_ptr<SudokuInStream> SudokuLoaderTest::createSudokuStream(const std::string& str) {
-    // Split into each line
-    std::string lines;
+CPPUNIT_TEST_SUITE_REGISTRATION(SudokuPuzzleRecordTest);
 
-    for(SudokuIndex lineCount = 0; lineCount<Sudoku::SizeOfGroupsPerMap; ++lineCount) {
-        lines += str.substr(lineCount * Sudoku::SizeOfGroupsPerMap, Sudoku::SizeOfGroupsPerMap);
-        lines += '\n';
-    }
+void SudokuPuzzleRecordTest::setUp() {
+    return;
+}
 
-    return std::unique_ptr<SudokuInStream>(new SudokuInStream(lines.c_str()));
+void SudokuPuzzleRecordTest::tearDown() {
+    return;
 }
 
-// Call before running a test
-void SudokuLoaderTest::setUp() {
-    pSudokuInStream_ = createSudokuStream(SudokuTestPattern::NoBacktrackString);
-    pSudokuOutStream_ = decltype(pSudokuOutStream_)(new SudokuOutStream());
-    pInstance_ = decltype(pInstance_)(new SudokuLoader(argc_, argv_, pSudokuInStream_.get(), pSudokuOutStream_.get()));
+void SudokuPuzzleRecordTest::test_IsRecordFile() {
+    const std::string data = "SDKB";
+    CPPUNIT_ASSERT(SudokuPuzzleRecord::IsRecordFile(data.c_str(), data.size()));
+    CPPUNIT_ASSERT(!SudokuPuzzleRecord::IsRecordFile(data.c_str(), data.size() - 1));
+    CPPUNIT_ASSERT(!SudokuPuzzleRecord::IsRecordFile(nullptr, data.size()));
+    CPPUNIT_ASSERT(!SudokuPuzzleRecord::IsRecordFile(SudokuTestPattern::NoBacktrackString.c_str(),
+                                                     SudokuTestPattern::NoBacktrackString.size()));
     return;
 }
 
-// Call after running a test
-void SudokuLoaderTest::tearDown() {
-    assert(pInstance_);
-    assert(pSudokuOutStream_);
-    assert(pSudokuInStream_);
-    pInstance_.reset();
+void SudokuPuzzleRecordTest::test_IsRecordStream() {
+    struct Test {
+        std::string data;
+        bool expected;
+        std::string firstLine;
+        std::string rest;
+    };
 
-    assert(pSudokuOutStream_);
-    assert(pSudokuInStream_);
-    pSudokuOutStream_.reset();
-    pSudokuInStream_.reset();
+    const Test testSet[] = {
+        {"", false, "", ""},
+        {"\n", false, "", ""},
+        {"SDK", false, "SDK", ""},
+        {"SDKB", true, "SDKB", ""},
+        {std::string("SDKB\x01\x00", 6), true, "SDKB", std::string("\x01\x00", 2)},
+        {"SDKA12\n34\n", false, "SDKA12", "34\n"},
+        {"S.2\n34\n", false, "S.2", "34\n"},
+        {"12\n34\n", false, "12", "34\n"}
+    };
+
+    for(const auto& test : testSet) {
+        std::istringstream is(test.data);
+        std::string firstLine = "initial";
+        CPPUNIT_ASSERT_EQUAL(test.expected, SudokuPuzzleRecord::IsRecordStream(is, firstLine));
+        CPPUNIT_ASSERT_EQUAL(test.firstLine, firstLine);
+        const std::string rest((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
+        CPPUNIT_ASSERT_EQUAL(test.rest, rest);
+    }
     return;
 }
 
-void SudokuLoaderTest::test_Constructor() {
-    SudokuLoader inst(0, nullptr, nullptr, nullptr);
-    CPPUNIT_ASSERT(inst.solverType_ == SudokuSolverType::SOLVER_GENERAL);
-    CPPUNIT_ASSERT(inst.check_ == SudokuSolverCheck::CHECK);
-    CPPUNIT_ASSERT(inst.isBenchmark_ == false);
-    CPPUNIT_ASSERT(inst.verbose_ == true);
-    CPPUNIT_ASSERT(inst.measureCount_ == 1);
-    CPPUNIT_ASSERT(inst.printAllCandidate_ == 0);
+void SudokuPuzzleRecordTest::test_GetSize() {
+    constexpr SudokuPuzzleCount sizeOfRecords = 3;
+    std::string header;
+    SudokuPuzzleRecord::WriteHeader(sizeOfRecords, header);
+    const std::string data = header + std::string(sizeOfRecords * SudokuPuzzleRecord::SizeOfRecord, '\0');
+
+    SudokuPuzzleCount actual = 0;
+    CPPUNIT_ASSERT(SudokuPuzzleRecord::GetSize(data.c_str(), data.size(), actual));
+    CPPUNIT_ASSERT_EQUAL(sizeOfRecords, actual);
+
+    // Truncated records and headers
+    CPPUNIT_ASSERT(!SudokuPuzzleRecord::GetSize(data.c_str(), data.size() - 1, actual));
+    CPPUNIT_ASSERT_EQUAL(static_cast<SudokuPuzzleCount>(0), actual);
+    CPPUNIT_ASSERT(!SudokuPuzzleRecord::GetSize(data.c_str(), SudokuPuzzleRecord::SizeOfHeader - 1, actual));
+
+    // Invalid version and size of cells
+    for(const size_t offset : {4, 6}) {
+        std::string invalidData = data;
+        ++invalidData.at(offset);
+        CPPUNIT_ASSERT(!SudokuPuzzleRecord::GetSize(invalidData.c_str(), invalidData.size(), actual));
+    }
+    return;
 }
 
-// Test cases
-void SudokuLoaderTest::test_setSingleMode() {
-    size_t streamIndex = 0;
-    for(const auto& test : SudokuTestPattern::testArgs) {
-        auto pSudokuInStream = createSudokuStream(SudokuTestPattern::testSet[streamIndex].presetStr);
-        SudokuLoader inst(test.argc, test.argv, pSudokuInStream.get(), pSudokuOutStream_.get());
+void SudokuPuzzleRecordTest::test_GetRecord() {
+    const std::string data(SudokuPuzzleRecord::SizeOfHeader + SudokuPuzzleRecord::SizeOfRecord * 2, '\0');
+    const auto pData = reinterpret_cast<const uint8_t*>(data.c_str());
+    CPPUNIT_ASSERT(SudokuPuzzleRecord::GetRecord(data.c_str(), 0) == (pData + 16));
+    CPPUNIT_ASSERT(SudokuPuzzleRecord::GetRecord(data.c_str(), 1) == (pData + 57));
+    return;
+}
 
-        CPPUNIT_ASSERT(SudokuTestPattern::testSet[streamIndex].presetStr.compare(inst.sudokuStr_) == 0);
-        CPPUNIT_ASSERT_EQUAL(test.isBenchmark, inst.isBenchmark_);
-        CPPUNIT_ASSERT_EQUAL(test.verbose, inst.verbose_);
-        CPPUNIT_ASSERT_EQUAL(test.measureCount, inst.measureCount_);
-        CPPUNIT_ASSERT_EQUAL(test.printAllCandidate, inst.printAllCandidate_);
-        CPPUNIT_ASSERT(pSudokuOutStream_.get() == pInstance_->pSudokuOutStream_);
-        streamIndex = (streamIndex + 1) % arraySizeof(SudokuTestPattern::testSet);
+void SudokuPuzzleRecordTest::test_GetNumber() {
+    const uint8_t record[] = {0x21, 0xaf, 0x09, 0x90};
+    const SudokuIndex expectedSet[] = {1, 2, 0, 0, 9, 0, 0, 9};
+    for(SudokuIndex i = 0; i < arraySizeof(expectedSet); ++i) {
+        CPPUNIT_ASSERT_EQUAL(expectedSet[i], SudokuPuzzleRecord::GetNumber(record, i));
     }
+    return;
+}
 
-    streamIndex = 0;
-    for(const auto& test : SudokuTestPattern::testArgs) {
-        auto pSudokuInStream = createSudokuStream(SudokuTestPattern::testSet[streamIndex].presetStr);
-        SudokuLoader inst(0, nullptr, nullptr, nullptr);
-        inst.setSingleMode(test.argc, test.argv, pSudokuInStream.get());
+void SudokuPuzzleRecordTest::test_WriteHeader() {
+    std::string header = "initial";
+    SudokuPuzzleRecord::WriteHeader(0x123456789aULL, header);
+    const std::string expected("SDKB\x01\x00\x51\x00\x9a\x78\x56\x34\x12\x00\x00\x00", 16);
+    CPPUNIT_ASSERT_EQUAL(expected, header);
+    CPPUNIT_ASSERT_EQUAL(SudokuPuzzleRecord::SizeOfHeader, header.size());
+    return;
+}
 
-        CPPUNIT_ASSERT(SudokuTestPattern::testSet[streamIndex].presetStr.compare(inst.sudokuStr_) == 0);
-        CPPUNIT_ASSERT_EQUAL(test.isBenchmark, inst.isBenchmark_);
-        CPPUNIT_ASSERT_EQUAL(test.verbose, inst.verbose_);
-        CPPUNIT_ASSERT_EQUAL(test.measureCount, inst.measureCount_);
-        CPPUNIT_ASSERT_EQUAL(test.printAllCandidate, inst.printAllCandidate_);
-        streamIndex = (streamIndex + 1) % arraySizeof(SudokuTestPattern::testSet);
-    }
+void SudokuPuzzleRecordTest::test_Encode() {
+    struct Test {
+        std::string puzzleLine;
+        std::string decoded;
+    };
 
-    // Missing a stream does not make SudokuLoader crash
-    auto pSudokuInStream = createSudokuStream(SudokuTestPattern::testSet[streamIndex].presetStr);
-    SudokuLoader instNoOut(SudokuTestPattern::testArgs[0].argc,
-                           SudokuTestPattern::testArgs[0].argv, pSudokuInStream.get(), nullptr);
-    SudokuLoader instNoIn(SudokuTestPattern::testArgs[0].argc,
-                          SudokuTestPattern::testArgs[0].argv, nullptr, pSudokuOutStream_.get());
+    const std::string blankLine(Sudoku::SizeOfAllCells, '.');
+    const Test testSet[] = {
+        {"", blankLine},
+        {"12", "12" + blankLine.substr(2)},
+        {"0a 9", "...9" + blankLine.substr(4)},
+        {SudokuTestPattern::NoBacktrackString, SudokuTestPattern::NoBacktrackString},
+        {SudokuTestPattern::NoBacktrackString + "\r", SudokuTestPattern::NoBacktrackString},
+        {SudokuTestPattern::NoBacktrackStringSolution, SudokuTestPattern::NoBacktrackStringSolution},
+        {SudokuTestPattern::BacktrackString2, SudokuTestPattern::BacktrackString}
+    };
+
+    for(const auto& test : testSet) {
+        SudokuPuzzleRecord::Record record;
+        CPPUNIT_ASSERT(SudokuPuzzleRecord::Encode(test.puzzleLine, record));
+        CPPUNIT_ASSERT_EQUAL(SudokuPuzzleRecord::SizeOfRecord, record.size());
+        std::string decoded = "initial";
+        SudokuPuzzleRecord::Decode(record.data(), decoded);
+        CPPUNIT_ASSERT_EQUAL(test.decoded, decoded);
+    }
+
+    // Puzzles larger than 9x9
+    SudokuPuzzleRecord::Record record;
+    CPPUNIT_ASSERT(!SudokuPuzzleRecord::Encode(std::string(SudokuGeometry<4>::SizeOfAllCells, '.'), record));
+    return;
+}
+
+class SudokuPuzzleLineParserTest : public CPPUNIT_NS::TestFixture {
+    CPPUNIT_TEST_SUITE(SudokuPuzzleLineParserTest);
+    CPPUNIT_TEST(test_Constructor);
+    CPPUNIT_TEST(test_Parse);
+    CPPUNIT_TEST(test_findLines);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp() override;
+    void tearDown() override;
+protected:
+    void test_Constructor();
+    void test_Parse();
+    void test_findLines();
+private:
+    using LineSet = SudokuPuzzleLineParser::LineSet;
+    using StringSet = std::vector<std::string>;
+    StringSet toStringSet(const LineSet& lineSet);
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(SudokuPuzzleLineParserTest);
+
+void SudokuPuzzleLineParserTest::setUp() {
+    return;
+}
+
+void SudokuPuzzleLineParserTest::tearDown() {
+    return;
+}
+
+SudokuPuzzleLineParserTest::StringSet SudokuPuzzleLineParserTest::toStringSet(const LineSet& lineSet) {
+    StringSet stringSet;
+    for(const auto& line : lineSet) {
+        stringSet.push_back(std::string(line.first, line.second));
+    }
+    return stringSet;
+}
+
+void SudokuPuzzleLineParserTest::test_Constructor() {
+    const std::string data = "12\n";
+    SudokuPuzzleLineParser inst(data.c_str(), data.size());
+    CPPUNIT_ASSERT(inst.pData_ == data.c_str());
+    CPPUNIT_ASSERT_EQUAL(data.size(), inst.size_);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), inst.offset_);
+
+    SudokuPuzzleLineParser nullInst(nullptr, data.size());
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), nullInst.size_);
+
+    auto pRunner = Sudoku::CreateParallelRunner();
+    LineSet lineSet;
+    CPPUNIT_ASSERT(!nullInst.Parse(1, 1, *pRunner, lineSet));
+    CPPUNIT_ASSERT(lineSet.empty());
+    return;
+}
+
+void SudokuPuzzleLineParserTest::test_Parse() {
+    struct Test {
+        std::string data;
+        StringSet expected;
+    };
+
+    const Test testSet[] = {
+        {"", {}},
+        {"1", {"1"}},
+        {"12\n345\n6\n78", {"12", "345", "6", "78"}},
+        {"12\n345\n6\n78\n", {"12", "345", "6", "78"}},
+        {"12\r\n345\r\n", {"12\r", "345\r"}},
+        {"12\n345\n\n6\n78\n", {"12", "345"}},
+        {"\n12\n", {}}
+    };
+
+    auto pRunner = Sudoku::CreateParallelRunner();
+    for(const auto& test : testSet) {
+        for(size_t sizeOfWindow = 0; sizeOfWindow <= test.data.size() + 1; ++sizeOfWindow) {
+            for(size_t numberOfRanges = 0; numberOfRanges <= 5; ++numberOfRanges) {
+                SudokuPuzzleLineParser inst(test.data.c_str(), test.data.size());
+                StringSet actual;
+                LineSet lineSet;
+
+                // Windows cover all lines in order
+                bool continues = true;
+                while(continues) {
+                    continues = inst.Parse(sizeOfWindow, numberOfRanges, *pRunner, lineSet);
+                    const auto stringSet = toStringSet(lineSet);
+                    actual.insert(actual.end(), stringSet.begin(), stringSet.end());
+                }
+                CPPUNIT_ASSERT(test.expected == actual);
+                CPPUNIT_ASSERT(!inst.Parse(sizeOfWindow, numberOfRanges, *pRunner, lineSet));
+                CPPUNIT_ASSERT(lineSet.empty());
+            }
+        }
+    }
+
+    return;
+}
+
+void SudokuPuzzleLineParserTest::test_findLines() {
+    struct Test {
+        size_t rangeBegin;
+        size_t rangeEnd;
+        StringSet expected;
+    };
+
+    const std::string data = "12\n345\n6\n78";
+    const Test testSet[] = {
+        {0, 11, {"12", "345", "6", "78"}},
+        {0, 1, {"12"}},
+        {0, 4, {"12", "345"}},
+        {4, 8, {"6"}},
+        {8, 11, {"78"}},
+        {3, 3, {}},
+        {4, 6, {}},
+        {10, 11, {}}
+    };
+
+    const char* pBegin = data.c_str();
+    const char* pEnd = pBegin + data.size();
+    for(const auto& test : testSet) {
+        LineSet lineSet {SudokuPuzzleLineParser::Line(pBegin, 1)};
+        SudokuPuzzleLineParser::findLines(pBegin, pBegin + test.rangeBegin, pBegin + test.rangeEnd, pEnd, lineSet);
+        CPPUNIT_ASSERT(test.expected == toStringSet(lineSet));
+    }
+
+    return;
+}
+
+class SudokuPuzzleChunkQueueTest : public CPPUNIT_NS::TestFixture {
+    CPPUNIT_TEST_SUITE(SudokuPuzzleChunkQueueTest);
+    CPPUNIT_TEST(test_Constructor);
+    CPPUNIT_TEST(test_Pop);
+    CPPUNIT_TEST(test_Steal);
+    CPPUNIT_TEST(test_PopAll);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp() override;
+    void tearDown() override;
+protected:
+    void test_Constructor();
+    void test_Pop();
+    void test_Steal();
+    void test_PopAll();
+private:
+    using Chunk = SudokuPuzzleChunkQueue::Chunk;
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(SudokuPuzzleChunkQueueTest);
+
+void SudokuPuzzleChunkQueueTest::setUp() {
+    return;
+}
+
+void SudokuPuzzleChunkQueueTest::tearDown() {
+    return;
+}
+
+void SudokuPuzzleChunkQueueTest::test_Constructor() {
+    struct Test {
+        size_t sizeOfPuzzle;
+        size_t numberOfWorkers;
+        std::vector<size_t> sizeSet;
+    };
+
+    const Test testSet[] = {
+        {0,   1, {0}},
+        {0,   2, {0, 0}},
+        {10,  0, {10}},
+        {10,  1, {10}},
+        {10,  3, {3, 3, 4}},
+        {2,   3, {0, 1, 1}},
+        {100, 4, {25, 25, 25, 25}}
+    };
+
+    for(const auto& test : testSet) {
+        SudokuPuzzleChunkQueue inst(test.sizeOfPuzzle, test.numberOfWorkers);
+        CPPUNIT_ASSERT_EQUAL(test.sizeSet.size(), inst.workerSet_.size());
+
+        size_t begin = 0;
+        for(size_t i=0; i<test.sizeSet.size(); ++i) {
+            const auto& chunkSet = inst.workerSet_.at(i)->chunkSet;
+            if (test.sizeSet.at(i) == 0) {
+                CPPUNIT_ASSERT(chunkSet.empty());
+                continue;
+            }
+
+            // Contiguous chunks
+            CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), chunkSet.size());
+            CPPUNIT_ASSERT_EQUAL(begin, chunkSet.front().first);
+            begin += test.sizeSet.at(i);
+            CPPUNIT_ASSERT_EQUAL(begin, chunkSet.front().second);
+        }
+        CPPUNIT_ASSERT_EQUAL(test.sizeOfPuzzle, begin);
+    }
+
+    return;
+}
+
+void SudokuPuzzleChunkQueueTest::test_Pop() {
+    // Chunks shrink as puzzles run out
+    const Chunk expectedSet[] = {{0, 100}, {100, 175}, {175, 231}, {231, 273}, {273, 304}, {304, 328},
+                                 {328, 346}, {346, 362}, {362, 378}, {378, 394}, {394, 400}};
+
+    SudokuPuzzleChunkQueue inst(400, 1);
+    for(const auto& expected : expectedSet) {
+        Chunk chunk;
+        CPPUNIT_ASSERT(inst.Pop(0, chunk));
+        CPPUNIT_ASSERT_EQUAL(expected.first, chunk.first);
+        CPPUNIT_ASSERT_EQUAL(expected.second, chunk.second);
+    }
+
+    Chunk chunk;
+    CPPUNIT_ASSERT(!inst.Pop(0, chunk));
+    return;
+}
+
+void SudokuPuzzleChunkQueueTest::test_Steal() {
+    SudokuPuzzleChunkQueue inst(300, 3);
+    // Worker 0 finished its chunk and worker 1 took a part of its chunk
+    inst.workerSet_.at(0)->chunkSet.clear();
+    inst.workerSet_.at(1)->chunkSet.front().first = 150;
+
+    // Steals the latter half of the largest chunk
+    Chunk chunk;
+    CPPUNIT_ASSERT(inst.Pop(0, chunk));
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(250), chunk.first);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(266), chunk.second);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(250), inst.workerSet_.at(2)->chunkSet.back().second);
+
+    // Other workers can steal the rest of the stolen chunk
+    const auto& stolenSet = inst.workerSet_.at(0)->chunkSet;
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), stolenSet.size());
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(266), stolenSet.front().first);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(300), stolenSet.front().second);
+
+    // Takes a whole small chunk
+    inst.workerSet_.at(1)->chunkSet.clear();
+    inst.workerSet_.at(2)->chunkSet.clear();
+    inst.workerSet_.at(0)->chunkSet.front().first = 290;
+    CPPUNIT_ASSERT(inst.Pop(1, chunk));
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(290), chunk.first);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(300), chunk.second);
+    CPPUNIT_ASSERT(inst.workerSet_.at(0)->chunkSet.empty());
+    CPPUNIT_ASSERT(!inst.Pop(2, chunk));
+    return;
+}
+
+void SudokuPuzzleChunkQueueTest::test_PopAll() {
+    // Workers take each puzzle once in any order of popping
+    for(size_t numberOfWorkers=1; numberOfWorkers<=5; ++numberOfWorkers) {
+        constexpr size_t sizeOfPuzzle = 1000;
+        SudokuPuzzleChunkQueue inst(sizeOfPuzzle, numberOfWorkers);
+        std::vector<int> takenSet(sizeOfPuzzle, 0);
+
+        // Worker 0 is eight times slower than others
+        size_t workerIndex = 0;
+        size_t slowWorkerTurn = 0;
+        size_t activeCount = numberOfWorkers;
+        std::vector<bool> activeSet(numberOfWorkers, true);
+        std::vector<size_t> takenCountSet(numberOfWorkers, 0);
+        while(activeCount > 0) {
+            workerIndex = (workerIndex + 1) % numberOfWorkers;
+            if (!activeSet.at(workerIndex) ||
+                ((workerIndex == 0) && (numberOfWorkers > 1) && ((slowWorkerTurn++ % 8) != 0))) {
+                continue;
+            }
+
+            Chunk chunk;
+            if (!inst.Pop(workerIndex, chunk)) {
+                activeSet.at(workerIndex) = false;
+                --activeCount;
+                continue;
+            }
+
+            CPPUNIT_ASSERT(chunk.first < chunk.second);
+            CPPUNIT_ASSERT(chunk.second <= sizeOfPuzzle);
+            for(auto i=chunk.first; i<chunk.second; ++i) {
+                ++takenSet.at(i);
+            }
+            takenCountSet.at(workerIndex) += chunk.second - chunk.first;
+        }
+
+        for(const auto taken : takenSet) {
+            CPPUNIT_ASSERT_EQUAL(1, taken);
+        }
+
+        // Other workers take over puzzles of the slow worker
+        if (numberOfWorkers > 1) {
+            CPPUNIT_ASSERT(takenCountSet.at(0) < (sizeOfPuzzle / numberOfWorkers));
+        }
+    }
+
+    return;
+}
+
+class SudokuLoaderTest : public CPPUNIT_NS::TestFixture {
+    CPPUNIT_TEST_SUITE(SudokuLoaderTest);
+    CPPUNIT_TEST(test_Constructor);
+    CPPUNIT_TEST(test_CanLaunch);
+    CPPUNIT_TEST(test_setSingleMode);
+    CPPUNIT_TEST(test_setMultiMode);
+    CPPUNIT_TEST(test_setNumberOfThreads);
+    CPPUNIT_TEST(test_setSplitDepth);
+    CPPUNIT_TEST(test_setSingleModeParallel);
+    CPPUNIT_TEST(test_setIsa);
+    CPPUNIT_TEST(test_selectIsa);
+    CPPUNIT_TEST(test_setSubsets);
+    CPPUNIT_TEST(test_setBranchPolicy);
+    CPPUNIT_TEST(test_setValueOrder);
+    CPPUNIT_TEST(test_setSteps);
+    CPPUNIT_TEST(test_getMeasureCount);
+    CPPUNIT_TEST(test_execSingle);
+    CPPUNIT_TEST(test_execMultiPassedCpp);
+    CPPUNIT_TEST(test_execMultiPassedSse);
+    CPPUNIT_TEST(test_execMultiUnique);
+    CPPUNIT_TEST(test_execMultiFailed);
+    CPPUNIT_TEST(test_execMultiSteps);
+    CPPUNIT_TEST(test_execMultiWindows);
+    CPPUNIT_TEST(test_execMultiMapped);
+    CPPUNIT_TEST(test_execRecords);
+    CPPUNIT_TEST(test_printHeader);
+    CPPUNIT_TEST(test_readLines);
+    CPPUNIT_TEST(test_execAll);
+    CPPUNIT_TEST(test_writeMessage);
+    CPPUNIT_TEST(test_solveSudoku);
+    CPPUNIT_TEST(test_enumerateSudoku);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp() override;
+    void tearDown() override;
+protected:
+    void test_Constructor();
+    void test_setSingleMode();
+    void test_setMultiMode();
+    void test_setNumberOfThreads();
+    void test_setSplitDepth();
+    void test_setSingleModeParallel();
+    void test_setIsa();
+    void test_selectIsa();
+    void test_setSubsets();
+    void test_setBranchPolicy();
+    void test_setValueOrder();
+    void test_setSteps();
+    void test_CanLaunch();
+    void test_getMeasureCount();
+    void test_execSingle();
+    void test_execMultiPassedCpp();
+    void test_execMultiPassedSse();
+    void test_execMultiUnique();
+    void test_execMultiFailed();
+    void test_execMultiSteps();
+    void test_execMultiWindows();
+    void test_execMultiMapped();
+    void test_execRecords();
+    void test_printHeader();
+    void test_readLines();
+    void test_execAll();
+    void test_writeMessage();
+    void test_solveSudoku();
+    void test_enumerateSudoku();
+private:
+    std::unique_ptr<SudokuInStream> createSudokuStream(const std::string& str);
+    // Use istringstream and do not use istrstream
+    std::unique_ptr<SudokuInStream>  pSudokuInStream_;   // source of initial puzzle maps
+    std::unique_ptr<SudokuOutStream> pSudokuOutStream_;  // destination to write strings
+    std::unique_ptr<SudokuLoader>    pInstance_;         // tested object
+    // command line arguments
+    static const int argc_ = 1;
+    static const char* const argv_[2];
+};
+
+const char* const SudokuLoaderTest::argv_[] {"sudoku", 0};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(SudokuLoaderTest);
+
+std::unique_ptr<SudokuInStream> SudokuLoaderTest::createSudokuStream(const std::string& str) {
+    // Split into each line
+    std::string lines;
+
+    for(SudokuIndex lineCount = 0; lineCount<Sudoku::SizeOfGroupsPerMap; ++lineCount) {
+        lines += str.substr(lineCount * Sudoku::SizeOfGroupsPerMap, Sudoku::SizeOfGroupsPerMap);
+        lines += '\n';
+    }
+
+    return std::unique_ptr<SudokuInStream>(new SudokuInStream(lines.c_str()));
+}
+
+// Call before running a test
+void SudokuLoaderTest::setUp() {
+    pSudokuInStream_ = createSudokuStream(SudokuTestPattern::NoBacktrackString);
+    pSudokuOutStream_ = decltype(pSudokuOutStream_)(new SudokuOutStream());
+    pInstance_ = decltype(pInstance_)(new SudokuLoader(argc_, argv_, pSudokuInStream_.get(), pSudokuOutStream_.get()));
+    return;
+}
+
+// Call after running a test
+void SudokuLoaderTest::tearDown() {
+    assert(pInstance_);
+    assert(pSudokuOutStream_);
+    assert(pSudokuInStream_);
+    pInstance_.reset();
+
+    assert(pSudokuOutStream_);
+    assert(pSudokuInStream_);
+    pSudokuOutStream_.reset();
+    pSudokuInStream_.reset();
+    return;
+}
+
+void SudokuLoaderTest::test_Constructor() {
+    SudokuLoader inst(0, nullptr, nullptr, nullptr);
+    CPPUNIT_ASSERT(inst.solverType_ == SudokuSolverType::SOLVER_GENERAL);
+    CPPUNIT_ASSERT(inst.check_ == SudokuSolverCheck::CHECK);
+    CPPUNIT_ASSERT(inst.isBenchmark_ == false);
+    CPPUNIT_ASSERT(inst.verbose_ == true);
+    CPPUNIT_ASSERT(inst.measureCount_ == 1);
+    CPPUNIT_ASSERT(inst.printAllCandidate_ == 0);
+}
+
+// Test cases
+void SudokuLoaderTest::test_setSingleMode() {
+    size_t streamIndex = 0;
+    for(const auto& test : SudokuTestPattern::testArgs) {
+        auto pSudokuInStream = createSudokuStream(SudokuTestPattern::testSet[streamIndex].presetStr);
+        SudokuLoader inst(test.argc, test.argv, pSudokuInStream.get(), pSudokuOutStream_.get());
+
+        CPPUNIT_ASSERT(SudokuTestPattern::testSet[streamIndex].presetStr.compare(inst.sudokuStr_) == 0);
+        CPPUNIT_ASSERT_EQUAL(test.isBenchmark, inst.isBenchmark_);
+        CPPUNIT_ASSERT_EQUAL(test.verbose, inst.verbose_);
+        CPPUNIT_ASSERT_EQUAL(test.measureCount, inst.measureCount_);
+        CPPUNIT_ASSERT_EQUAL(test.printAllCandidate, inst.printAllCandidate_);
+        CPPUNIT_ASSERT(pSudokuOutStream_.get() == pInstance_->pSudokuOutStream_);
+        streamIndex = (streamIndex + 1) % arraySizeof(SudokuTestPattern::testSet);
+    }
+
+    streamIndex = 0;
+    for(const auto& test : SudokuTestPattern::testArgs) {
+        auto pSudokuInStream = createSudokuStream(SudokuTestPattern::testSet[streamIndex].presetStr);
+        SudokuLoader inst(0, nullptr, nullptr, nullptr);
+        inst.setSingleMode(test.argc, test.argv, pSudokuInStream.get());
+
+        CPPUNIT_ASSERT(SudokuTestPattern::testSet[streamIndex].presetStr.compare(inst.sudokuStr_) == 0);
+        CPPUNIT_ASSERT_EQUAL(test.isBenchmark, inst.isBenchmark_);
+        CPPUNIT_ASSERT_EQUAL(test.verbose, inst.verbose_);
+        CPPUNIT_ASSERT_EQUAL(test.measureCount, inst.measureCount_);
+        CPPUNIT_ASSERT_EQUAL(test.printAllCandidate, inst.printAllCandidate_);
+        streamIndex = (streamIndex + 1) % arraySizeof(SudokuTestPattern::testSet);
+    }
+
+    // Missing a stream does not make SudokuLoader crash
+    auto pSudokuInStream = createSudokuStream(SudokuTestPattern::testSet[streamIndex].presetStr);
+    SudokuLoader instNoOut(SudokuTestPattern::testArgs[0].argc,
+                           SudokuTestPattern::testArgs[0].argv, pSudokuInStream.get(), nullptr);
+    SudokuLoader instNoIn(SudokuTestPattern::testArgs[0].argc,
+                          SudokuTestPattern::testArgs[0].argv, nullptr, pSudokuOutStream_.get());
 
     return;
 }
@@ -921,6 +1703,13 @@ struct SudokuTestArgsMultiMode {
 };
 
 namespace {
+    // The C++ solver substitutes the solver with AVX2 intrinsics unless it is available
+#if defined(SUDOKU_SOA_MAP)
+    constexpr SudokuSolverType SoaSolverType = SudokuSolverType::SOLVER_SOA;
+#else
+    constexpr SudokuSolverType SoaSolverType = SudokuSolverType::SOLVER_GENERAL;
+#endif
+
     constexpr SudokuTestArgsMultiMode testArgsMultiMode[] {
         // Find a solution
         {1, {"sudoku", nullptr, nullptr, nullptr, nullptr},
@@ -953,6 +1742,24 @@ namespace {
         {4, {"sudoku", "../data/sudoku_example1.txt", "avx", "off", nullptr},
                 false, SudokuSolverType::SOLVER_SSE_4_2, SudokuSolverCheck::DO_NOT_CHECK,
                     SudokuSolverPrint::DO_NOT_PRINT, 1},
+        {3, {"sudoku", "../data/sudoku_example1.txt", "2", nullptr, nullptr},
+                false, SoaSolverType, SudokuSolverCheck::CHECK,
+                    SudokuSolverPrint::DO_NOT_PRINT, 1},
+        {4, {"sudoku", "../data/sudoku_example1.txt", "soa", "print", nullptr},
+                false, SoaSolverType, SudokuSolverCheck::CHECK,
+                    SudokuSolverPrint::PRINT, 1},
+        {3, {"sudoku", "../data/sudoku_example1.txt", "3", nullptr, nullptr},
+                false, SudokuSolverType::SOLVER_SSE_INTRINSICS, SudokuSolverCheck::CHECK,
+                    SudokuSolverPrint::DO_NOT_PRINT, 1},
+        {4, {"sudoku", "../data/sudoku_example1.txt", "intrinsics", "off", nullptr},
+                false, SudokuSolverType::SOLVER_SSE_INTRINSICS, SudokuSolverCheck::DO_NOT_CHECK,
+                    SudokuSolverPrint::DO_NOT_PRINT, 1},
+        {3, {"sudoku", "../data/sudoku_example1.txt", "4", nullptr, nullptr},
+                false, SudokuSolverType::SOLVER_BITPLANE, SudokuSolverCheck::CHECK,
+                    SudokuSolverPrint::DO_NOT_PRINT, 1},
+        {4, {"sudoku", "../data/sudoku_example1.txt", "bitplane", "print", nullptr},
+                false, SudokuSolverType::SOLVER_BITPLANE, SudokuSolverCheck::CHECK,
+                    SudokuSolverPrint::PRINT, 1},
         {4, {"sudoku", "../data/sudoku_example1.txt", "0", "2", nullptr},
                 false, SudokuSolverType::SOLVER_GENERAL, SudokuSolverCheck::CHECK,
                     SudokuSolverPrint::PRINT, 1},
@@ -995,6 +1802,21 @@ namespace {
         {4, {"sudoku", "../data/sudoku_example1.txt", "sse", "pre-N", nullptr},
                 false, SudokuSolverType::SOLVER_SSE_4_2, SudokuSolverCheck::CHECK,
                     SudokuSolverPrint::DO_NOT_PRINT, 1},
+        {4, {"sudoku", "../data/sudoku_example1.txt", "sse", "unique", nullptr},
+                false, SudokuSolverType::SOLVER_SSE_4_2, SudokuSolverCheck::CHECK_UNIQUE,
+                    SudokuSolverPrint::DO_NOT_PRINT, 1},
+        {5, {"sudoku", "../data/sudoku_example1.txt", "0", "3", "-N2"},
+                false, SudokuSolverType::SOLVER_GENERAL, SudokuSolverCheck::CHECK_UNIQUE,
+                    SudokuSolverPrint::DO_NOT_PRINT, 2},
+        {5, {"sudoku", "../data/sudoku_example1.txt", "-S", "sse", "0"},
+                false, SudokuSolverType::SOLVER_SSE_4_2, SudokuSolverCheck::CHECK,
+                    SudokuSolverPrint::DO_NOT_PRINT, 1},
+        {2, {"sudoku", "-", nullptr, nullptr, nullptr},
+                false, SudokuSolverType::SOLVER_GENERAL, SudokuSolverCheck::CHECK,
+                    SudokuSolverPrint::DO_NOT_PRINT, 1},
+        {4, {"sudoku", "-", "sse", "-N2", nullptr},
+                false, SudokuSolverType::SOLVER_SSE_4_2, SudokuSolverCheck::CHECK,
+                    SudokuSolverPrint::DO_NOT_PRINT, 2},
     };
 }
 
@@ -1015,6 +1837,7 @@ void SudokuLoaderTest::test_setMultiMode() {
         SudokuLoader inst(0, nullptr, nullptr, nullptr);
         CPPUNIT_ASSERT_EQUAL(!test.expected, inst.setMultiMode(test.argc, test.argv));
         CPPUNIT_ASSERT_EQUAL(static_cast<int>(test.solverType), static_cast<int>(inst.solverType_));
+        CPPUNIT_ASSERT_EQUAL(static_cast<int>(test.check), static_cast<int>(inst.check_));
 
         auto numberOfCores = Sudoku::CreateParallelRunner()->GetHardwareConcurrency();
         auto expected = (test.numberOfThreads == 0) ? numberOfCores : test.numberOfThreads;
@@ -1061,6 +1884,307 @@ void SudokuLoaderTest::test_setNumberOfThreads() {
     }
 }
 
+void SudokuLoaderTest::test_setSplitDepth() {
+    struct Test {
+        int argc;
+        const char * const argv[3];
+        int argIndex;
+        bool expected;
+        SudokuIndex splitDepth;
+    };
+
+    constexpr SudokuIndex defaultDepth = SudokuSseParallelEnumerator::DefaultSplitDepth;
+    constexpr Test testSet[] = {
+        {0, {nullptr, nullptr, nullptr},   0, false, defaultDepth},
+        {1, {"command", nullptr, nullptr}, 1, false, defaultDepth},
+        {2, {"command", "-N2", nullptr},  1, false, defaultDepth},
+        {2, {"command", "-D0", nullptr},  1, true, 0},
+        {2, {"command", "-D5", nullptr},  1, true, 5},
+        {2, {"command", "-D", nullptr},   1, true, defaultDepth},
+        {2, {"command", "-D-1", nullptr}, 1, true, defaultDepth}
+    };
+
+    for(const auto& test : testSet) {
+        SudokuLoader inst(0, nullptr, nullptr, pSudokuOutStream_.get());
+        CPPUNIT_ASSERT_EQUAL(test.expected, inst.setSplitDepth(test.argc, test.argv, test.argIndex));
+        CPPUNIT_ASSERT_EQUAL(test.splitDepth, inst.splitDepth_);
+    }
+}
+
+void SudokuLoaderTest::test_setSingleModeParallel() {
+    struct Test {
+        int argc;
+        const char * const argv[5];
+        SudokuPatternCount printAllCandidate;
+        SudokuLoader::NumberOfCores numberOfThreads;
+        SudokuIndex splitDepth;
+    };
+
+    constexpr SudokuIndex defaultDepth = SudokuSseParallelEnumerator::DefaultSplitDepth;
+    constexpr Test testSet[] = {
+        {2, {"sudoku", "0", nullptr, nullptr, nullptr}, 0, 1, defaultDepth},
+        {3, {"sudoku", "0", "10", nullptr, nullptr}, 10, 1, defaultDepth},
+        {3, {"sudoku", "0", "-N3", nullptr, nullptr}, 0, 3, defaultDepth},
+        {4, {"sudoku", "0", "-D2", "-N4", nullptr}, 0, 4, 2},
+        {5, {"sudoku", "0", "-N2", "7", "-D1"}, 7, 2, 1}
+    };
+
+    for(const auto& test : testSet) {
+        auto pSudokuInStream = createSudokuStream(SudokuTestPattern::testSet[0].presetStr);
+        SudokuLoader inst(test.argc, test.argv, pSudokuInStream.get(), pSudokuOutStream_.get());
+        CPPUNIT_ASSERT_EQUAL(test.printAllCandidate, inst.printAllCandidate_);
+        CPPUNIT_ASSERT_EQUAL(test.numberOfThreads, inst.numberOfThreads_);
+        CPPUNIT_ASSERT_EQUAL(test.splitDepth, inst.splitDepth_);
+    }
+}
+
+void SudokuLoaderTest::test_setIsa() {
+    struct Test {
+        int argc;
+        const char * const argv[3];
+        int argIndex;
+        bool expected;
+        bool valid;
+        SudokuIsa isa;
+    };
+
+    const auto initialIsa = Sudoku::GetFastestIsa();
+    const Test testSet[] = {
+        {0, {nullptr, nullptr, nullptr},      0, false, true, initialIsa},
+        {1, {"command", nullptr, nullptr},    1, false, true, initialIsa},
+        {2, {"command", "file-Isse", nullptr}, 1, false, true, initialIsa},
+        {2, {"command", "-N2", nullptr},      1, false, true, initialIsa},
+        {2, {"command", "-I", nullptr},       1, true, false, initialIsa},
+        {2, {"command", "-Ix", nullptr},      1, true, false, initialIsa},
+        {2, {"command", "-Isse2", nullptr},   1, true, false, initialIsa},
+        {2, {"command", "-Isse", nullptr},    1, true, true, SudokuIsa::SSE_4_2},
+        {2, {"command", "-Iavx2", nullptr},   1, true, true, SudokuIsa::AVX2},
+        {2, {"command", "-Iavx512", nullptr}, 1, true, true, SudokuIsa::AVX512}
+    };
+
+    for(const auto& test : testSet) {
+        SudokuLoader inst(0, nullptr, nullptr, pSudokuOutStream_.get());
+        CPPUNIT_ASSERT(initialIsa == inst.isa_);
+        CPPUNIT_ASSERT_EQUAL(false, inst.isaSpecified_);
+        CPPUNIT_ASSERT_EQUAL(test.expected, inst.setIsa(test.argc, test.argv, test.argIndex));
+        CPPUNIT_ASSERT(test.isa == inst.isa_);
+        CPPUNIT_ASSERT_EQUAL(test.expected && test.valid, inst.isaSpecified_);
+        CPPUNIT_ASSERT_EQUAL(test.valid, inst.invalidArg_.empty());
+    }
+
+    // Single mode also takes an instruction set after the count
+    const auto isaIndex = static_cast<size_t>(initialIsa);
+    const std::string isaArg = std::string(SudokuOption::CommandLineArgIsa) + SudokuOption::CommandLineIsaSet[isaIndex];
+    const char * const argv[] = {"sudoku", "1", isaArg.c_str(), nullptr};
+    auto pSudokuInStream = createSudokuStream(SudokuTestPattern::testSet[0].presetStr);
+    SudokuLoader inst(3, argv, pSudokuInStream.get(), pSudokuOutStream_.get());
+    CPPUNIT_ASSERT(initialIsa == inst.isa_);
+    CPPUNIT_ASSERT_EQUAL(true, inst.isaSpecified_);
+    CPPUNIT_ASSERT_EQUAL(static_cast<SudokuPatternCount>(0), inst.printAllCandidate_);
+
+    // Does not parse an unknown name as the count of patterns and stops
+    const char * const invalidArgv[] = {"sudoku", "0", "-Iavx3", "2", nullptr};
+    pSudokuInStream = createSudokuStream(SudokuTestPattern::testSet[0].presetStr);
+    pSudokuOutStream_->str("");
+    SudokuLoader invalidInst(4, invalidArgv, pSudokuInStream.get(), pSudokuOutStream_.get());
+    CPPUNIT_ASSERT_EQUAL(static_cast<SudokuPatternCount>(2), invalidInst.printAllCandidate_);
+    CPPUNIT_ASSERT_EQUAL(SudokuLoader::ExitStatusFailed, invalidInst.Exec());
+    CPPUNIT_ASSERT_EQUAL(std::string("Invalid argument -Iavx3\n"), pSudokuOutStream_->str());
+}
+
+void SudokuLoaderTest::test_selectIsa() {
+    // This executable contains code for only one instruction set
+    const auto expected = (sudokuXmmUseAvx512) ? SudokuIsa::AVX512 :
+        ((sudokuXmmUseAvx) ? SudokuIsa::AVX2 : SudokuIsa::SSE_4_2);
+    CPPUNIT_ASSERT(expected == Sudoku::GetIsa());
+    CPPUNIT_ASSERT(expected == Sudoku::GetFastestIsa());
+    CPPUNIT_ASSERT(Sudoku::CanUseIsa(expected));
+    CPPUNIT_ASSERT(Sudoku::SelectIsa(expected));
+
+    for(const auto isa : {SudokuIsa::SSE_4_2, SudokuIsa::AVX2, SudokuIsa::AVX512}) {
+        CPPUNIT_ASSERT(std::string(Sudoku::GetIsaName(isa)).size() > 0);
+        if (isa == expected) {
+            continue;
+        }
+
+        CPPUNIT_ASSERT(!Sudoku::CanUseIsa(isa));
+        CPPUNIT_ASSERT(!Sudoku::SelectIsa(isa));
+        CPPUNIT_ASSERT(expected == Sudoku::GetIsa());
+
+        // Falls back to the fastest instruction set
+        SudokuLoader inst(0, nullptr, nullptr, pSudokuOutStream_.get());
+        inst.isa_ = isa;
+        inst.selectIsa();
+        CPPUNIT_ASSERT(expected == inst.isa_);
+        CPPUNIT_ASSERT(expected == Sudoku::GetIsa());
+    }
+}
+
+void SudokuLoaderTest::test_setSubsets() {
+    struct Test {
+        int argc;
+        const char * const argv[3];
+        int argIndex;
+        bool expected;
+    };
+
+    constexpr Test testSet[] = {
+        {0, {nullptr, nullptr, nullptr},   0, false},
+        {1, {"command", nullptr, nullptr}, 1, false},
+        {2, {"command", "-N2", nullptr},   1, false},
+        {2, {"command", "-Sx", nullptr},   1, false},
+        {2, {"command", "-S", nullptr},    1, true}
+    };
+
+    for(const auto& test : testSet) {
+        SudokuLoader inst(0, nullptr, nullptr, pSudokuOutStream_.get());
+        CPPUNIT_ASSERT(!inst.findSubsets_);
+        CPPUNIT_ASSERT_EQUAL(test.expected, inst.setSubsets(test.argc, test.argv, test.argIndex));
+        CPPUNIT_ASSERT_EQUAL(test.expected, inst.findSubsets_);
+    }
+
+    // Both modes enable it for all solvers
+    for(const auto& arg : {"-S", "10"}) {
+        const bool expected = (std::string(arg) == SudokuOption::CommandLineArgSubsets);
+        const char * const argv[] {"sudoku", "0", arg};
+        auto pSudokuInStream = createSudokuStream(SudokuTestPattern::testSet[0].presetStr);
+        SudokuLoader inst(arraySizeof(argv), argv, pSudokuInStream.get(), pSudokuOutStream_.get());
+        CPPUNIT_ASSERT_EQUAL(expected, inst.findSubsets_);
+        CPPUNIT_ASSERT_EQUAL(expected, Sudoku::UsesSubsetElimination());
+    }
+
+    return;
+}
+
+void SudokuLoaderTest::test_setBranchPolicy() {
+    struct Test {
+        int argc;
+        const char * const argv[3];
+        int argIndex;
+        bool expected;
+        bool valid;
+        SudokuBranchPolicy policy;
+    };
+
+    constexpr Test testSet[] = {
+        {0, {nullptr, nullptr, nullptr},       0, false, true,  SudokuBranchPolicy::FIXED_GROUP},
+        {1, {"command", nullptr, nullptr},     1, false, true,  SudokuBranchPolicy::FIXED_GROUP},
+        {2, {"command", "-N2", nullptr},       1, false, true,  SudokuBranchPolicy::FIXED_GROUP},
+        {2, {"command", "-Bunknown", nullptr}, 1, true,  false, SudokuBranchPolicy::FIXED_GROUP},
+        {2, {"command", "-Bmvr", nullptr},     1, true,  false, SudokuBranchPolicy::FIXED_GROUP},
+        {2, {"command", "-Bfixed", nullptr},   1, true,  true,  SudokuBranchPolicy::FIXED_GROUP},
+        {2, {"command", "-Bgroups", nullptr},  1, true,  true,  SudokuBranchPolicy::ALL_GROUPS},
+        {2, {"command", "-Bmrv", nullptr},     1, true,  true,  SudokuBranchPolicy::MIN_REMAINING}
+    };
+
+    for(const auto& test : testSet) {
+        SudokuLoader inst(0, nullptr, nullptr, pSudokuOutStream_.get());
+        CPPUNIT_ASSERT(inst.branchPolicy_ == SudokuBranchPolicy::FIXED_GROUP);
+        CPPUNIT_ASSERT_EQUAL(test.expected, inst.setBranchPolicy(test.argc, test.argv, test.argIndex));
+        CPPUNIT_ASSERT(inst.branchPolicy_ == test.policy);
+        CPPUNIT_ASSERT_EQUAL(test.valid, inst.invalidArg_.empty());
+    }
+
+    // Stops with an unknown name
+    const char * const invalidArgv[] = {"sudoku", "0", "-Bmvr", nullptr};
+    auto pInvalidInStream = createSudokuStream(SudokuTestPattern::testSet[0].presetStr);
+    pSudokuOutStream_->str("");
+    SudokuLoader invalidInst(3, invalidArgv, pInvalidInStream.get(), pSudokuOutStream_.get());
+    CPPUNIT_ASSERT_EQUAL(SudokuLoader::ExitStatusFailed, invalidInst.Exec());
+    CPPUNIT_ASSERT_EQUAL(std::string("Invalid argument -Bmvr\n"), pSudokuOutStream_->str());
+
+    // Both modes set it for all solvers
+    for(const auto& arg : {"-Bmrv", "10"}) {
+        const auto expected = (std::string(arg) == "-Bmrv") ?
+            SudokuBranchPolicy::MIN_REMAINING : SudokuBranchPolicy::FIXED_GROUP;
+        const char * const argv[] {"sudoku", "0", arg};
+        auto pSudokuInStream = createSudokuStream(SudokuTestPattern::testSet[0].presetStr);
+        SudokuLoader inst(arraySizeof(argv), argv, pSudokuInStream.get(), pSudokuOutStream_.get());
+        CPPUNIT_ASSERT(inst.branchPolicy_ == expected);
+        CPPUNIT_ASSERT(Sudoku::GetBranchPolicy() == expected);
+    }
+
+    Sudoku::SetBranchPolicy(SudokuBranchPolicy::FIXED_GROUP);
+    return;
+}
+
+void SudokuLoaderTest::test_setValueOrder() {
+    struct Test {
+        int argc;
+        const char * const argv[3];
+        int argIndex;
+        bool expected;
+        bool valid;
+        SudokuValueOrder order;
+    };
+
+    constexpr Test testSet[] = {
+        {0, {nullptr, nullptr, nullptr},          0, false, true,  SudokuValueOrder::ASCENDING},
+        {1, {"command", nullptr, nullptr},        1, false, true,  SudokuValueOrder::ASCENDING},
+        {2, {"command", "-Bmrv", nullptr},        1, false, true,  SudokuValueOrder::ASCENDING},
+        {2, {"command", "-Vunknown", nullptr},    1, true,  false, SudokuValueOrder::ASCENDING},
+        {2, {"command", "-Vlvc", nullptr},        1, true,  false, SudokuValueOrder::ASCENDING},
+        {2, {"command", "-Vascending", nullptr},  1, true,  true,  SudokuValueOrder::ASCENDING},
+        {2, {"command", "-Vlcv", nullptr},        1, true,  true,  SudokuValueOrder::LEAST_CONSTRAINING},
+        {2, {"command", "-Vplaces", nullptr},     1, true,  true,  SudokuValueOrder::FEWEST_PLACES}
+    };
+
+    for(const auto& test : testSet) {
+        SudokuLoader inst(0, nullptr, nullptr, pSudokuOutStream_.get());
+        CPPUNIT_ASSERT(inst.valueOrder_ == SudokuValueOrder::ASCENDING);
+        CPPUNIT_ASSERT_EQUAL(test.expected, inst.setValueOrder(test.argc, test.argv, test.argIndex));
+        CPPUNIT_ASSERT(inst.valueOrder_ == test.order);
+        CPPUNIT_ASSERT_EQUAL(test.valid, inst.invalidArg_.empty());
+    }
+
+    // Stops with an unknown name
+    const char * const invalidArgv[] = {"sudoku", "0", "-Vlvc", nullptr};
+    auto pInvalidInStream = createSudokuStream(SudokuTestPattern::testSet[0].presetStr);
+    pSudokuOutStream_->str("");
+    SudokuLoader invalidInst(3, invalidArgv, pInvalidInStream.get(), pSudokuOutStream_.get());
+    CPPUNIT_ASSERT_EQUAL(SudokuLoader::ExitStatusFailed, invalidInst.Exec());
+    CPPUNIT_ASSERT_EQUAL(std::string("Invalid argument -Vlvc\n"), pSudokuOutStream_->str());
+
+    // Both modes set it for all solvers
+    for(const auto& arg : {"-Vlcv", "10"}) {
+        const auto expected = (std::string(arg) == "-Vlcv") ?
+            SudokuValueOrder::LEAST_CONSTRAINING : SudokuValueOrder::ASCENDING;
+        const char * const argv[] {"sudoku", "0", arg};
+        auto pSudokuInStream = createSudokuStream(SudokuTestPattern::testSet[0].presetStr);
+        SudokuLoader inst(arraySizeof(argv), argv, pSudokuInStream.get(), pSudokuOutStream_.get());
+        CPPUNIT_ASSERT(inst.valueOrder_ == expected);
+        CPPUNIT_ASSERT(Sudoku::GetValueOrder() == expected);
+    }
+
+    Sudoku::SetValueOrder(SudokuValueOrder::ASCENDING);
+    return;
+}
+
+void SudokuLoaderTest::test_setSteps() {
+    struct Test {
+        int argc;
+        const char * const argv[3];
+        int argIndex;
+        bool expected;
+    };
+
+    constexpr Test testSet[] = {
+        {0, {nullptr, nullptr, nullptr},   0, false},
+        {1, {"command", nullptr, nullptr}, 1, false},
+        {2, {"command", "-Rx", nullptr},   1, false},
+        {2, {"command", "-R", nullptr},    1, true}
+    };
+
+    for(const auto& test : testSet) {
+        SudokuLoader inst(0, nullptr, nullptr, pSudokuOutStream_.get());
+        CPPUNIT_ASSERT(!inst.printSteps_);
+        CPPUNIT_ASSERT_EQUAL(test.expected, inst.setSteps(test.argc, test.argv, test.argIndex));
+        CPPUNIT_ASSERT_EQUAL(test.expected, inst.printSteps_);
+    }
+
+    return;
+}
+
 namespace {
     enum class SudokuLoaderExec {
         EXEC_PUBLIC,
@@ -1092,6 +2216,11 @@ void SudokuLoaderTest::test_execSingle() {
         }
     }
 
+    // Reports which instruction set the assembly code uses
+    std::string expected = "Solving with SSE/AVX (";
+    expected += Sudoku::GetIsaName(Sudoku::GetIsa());
+    expected += ")\n";
+    CPPUNIT_ASSERT(pSudokuOutStream_->str().find(expected) != std::string::npos);
     return;
 }
 
@@ -1143,12 +2272,38 @@ void SudokuLoaderTest::test_execMultiPassedSse() {
     inst.solverType_ = SudokuSolverType::SOLVER_SSE_4_2;
     CPPUNIT_ASSERT_EQUAL(SudokuLoader::ExitStatusPassed, inst.execMulti(&is));
 
-    std::string expected = "Solving with SSE/AVX\nAll 2 cases passed.\n";
+    std::string expected = "Solving with SSE/AVX (";
+    expected += Sudoku::GetIsaName(Sudoku::GetIsa());
+    expected += ")\nAll 2 cases passed.\n";
     std::string actual = pSudokuOutStream_->str();
     actual.resize(expected.size());
     CPPUNIT_ASSERT_EQUAL(expected, actual);
 }
 
+void SudokuLoaderTest::test_execMultiUnique() {
+    if (DiagonalSudokuMode) {
+        return;
+    }
+
+    const std::string multiple = "83...6....1..9.258..25486...43.128....17.43625..68.1....9....1...8....23..42...8.";
+    std::string pattern = SudokuTestPattern::NoBacktrackString;
+    pattern += "\n" + multiple;
+    SudokuInStream is(pattern);
+
+    SudokuLoader inst(0, nullptr, nullptr, pSudokuOutStream_.get());
+    inst.solverType_ = SudokuSolverType::SOLVER_SSE_4_2;
+    inst.check_ = SudokuSolverCheck::CHECK_UNIQUE;
+    CPPUNIT_ASSERT_EQUAL(SudokuLoader::ExitStatusPassed, inst.execMulti(&is));
+
+    std::string expected = "Solving with SSE/AVX (";
+    expected += Sudoku::GetIsaName(Sudoku::GetIsa());
+    expected += ")\n";
+    expected += SudokuTestPattern::NoBacktrackString + " unique\n";
+    expected += multiple + " multiple\n";
+    expected += "All 2 cases checked.\n";
+    CPPUNIT_ASSERT_EQUAL(expected, pSudokuOutStream_->str());
+}
+
 void SudokuLoaderTest::test_execMultiFailed() {
     const std::string pattern = "111111111........................................................................";
     SudokuInStream is(pattern);
@@ -1162,6 +2317,159 @@ void SudokuLoaderTest::test_execMultiFailed() {
     return;
 }
 
+void SudokuLoaderTest::test_execMultiSteps() {
+    const auto& presetStr = (DiagonalSudokuMode) ?
+        SudokuTestPattern::testSetDiagonal[0].presetStr : SudokuTestPattern::testSet[1].presetStr;
+    SudokuInStream is(presetStr);
+    SudokuLoader inst(0, nullptr, nullptr, pSudokuOutStream_.get());
+    inst.printSteps_ = true;
+    CPPUNIT_ASSERT_EQUAL(SudokuLoader::ExitStatusPassed, inst.execMulti(&is));
+
+    const std::string actual = pSudokuOutStream_->str();
+    const std::string header = "All 1 cases passed.\nSteps : ";
+    const auto pos = actual.find(header);
+    CPPUNIT_ASSERT(pos != std::string::npos);
+    SudokuPatternCount steps = 0;
+    std::istringstream is2(actual.substr(pos + header.size()));
+    is2 >> steps;
+    CPPUNIT_ASSERT(steps > 0);
+    CPPUNIT_ASSERT(actual.find("\nGuesses : ") != std::string::npos);
+    CPPUNIT_ASSERT(actual.find(" per puzzle)\n") != std::string::npos);
+    return;
+}
+
+void SudokuLoaderTest::test_execMultiWindows() {
+    if (DiagonalSudokuMode) {
+        return;
+    }
+
+    // Spans windows of 64, 128 and 256 puzzles
+    constexpr SudokuPuzzleCount sizeOfPuzzles = SudokuLoader::InitialWindowSize * 3 + 5;
+    const std::string multiple = "83...6....1..9.258..25486...43.128....17.43625..68.1....9....1...8....23..42...8.";
+    std::string pattern;
+    std::string expected = "Solving with SSE/AVX (";
+    expected += Sudoku::GetIsaName(Sudoku::GetIsa());
+    expected += ")\n";
+    for(SudokuPuzzleCount i=0; i<sizeOfPuzzles; ++i) {
+        const bool unique = ((i % 3) != 0);
+        const auto& puzzle = unique ? SudokuTestPattern::NoBacktrackString : multiple;
+        pattern += puzzle + "\n";
+        expected += puzzle + (unique ? " unique\n" : " multiple\n");
+    }
+    expected += "All " + std::to_string(sizeOfPuzzles) + " cases checked.\n";
+
+    // Reads puzzles from stdin
+    constexpr int argc = 4;
+    const char* argv[] = {"sudoku", "-", "sse", "-N3"};
+    for(const auto extra : {"", "\n" }) {
+        SudokuInStream is(pattern + extra);
+        pSudokuOutStream_.reset(new SudokuOutStream);
+        SudokuLoader inst(argc, argv, &is, pSudokuOutStream_.get());
+        inst.check_ = SudokuSolverCheck::CHECK_UNIQUE;
+        CPPUNIT_ASSERT_EQUAL(SudokuLoader::ExitStatusPassed, inst.Exec());
+        CPPUNIT_ASSERT_EQUAL(expected, pSudokuOutStream_->str());
+    }
+
+    return;
+}
+
+void SudokuLoaderTest::test_execMultiMapped() {
+    if (DiagonalSudokuMode) {
+        return;
+    }
+
+    constexpr SudokuPuzzleCount sizeOfPuzzles = SudokuLoader::InitialWindowSize * 3 + 5;
+    std::string pattern;
+    for(SudokuPuzzleCount i=0; i<sizeOfPuzzles; ++i) {
+        pattern += ((i % 2) == 0) ? SudokuTestPattern::NoBacktrackString : SudokuTestPattern::BacktrackString;
+        pattern += "\n";
+    }
+
+    // Finds the same puzzles as reading them from a stream
+    const std::string extraSet[] = {"", "\n", "\n" + SudokuTestPattern::NoBacktrackString};
+    for(const auto& extra : extraSet) {
+        const std::string data = pattern + extra;
+        for(SudokuLoader::NumberOfCores numberOfThreads = 1; numberOfThreads <= 3; ++numberOfThreads) {
+            SudokuInStream is(data);
+            pSudokuOutStream_.reset(new SudokuOutStream);
+            SudokuLoader streamInst(0, nullptr, nullptr, pSudokuOutStream_.get());
+            streamInst.print_ = SudokuSolverPrint::PRINT;
+            streamInst.numberOfThreads_ = numberOfThreads;
+            CPPUNIT_ASSERT_EQUAL(SudokuLoader::ExitStatusPassed, streamInst.execMulti(&is));
+            const auto expected = pSudokuOutStream_->str();
+
+            pSudokuOutStream_.reset(new SudokuOutStream);
+            SudokuLoader inst(0, nullptr, nullptr, pSudokuOutStream_.get());
+            inst.print_ = SudokuSolverPrint::PRINT;
+            inst.numberOfThreads_ = numberOfThreads;
+            CPPUNIT_ASSERT_EQUAL(SudokuLoader::ExitStatusPassed, inst.execMulti(data.c_str(), data.size()));
+            CPPUNIT_ASSERT_EQUAL(expected, pSudokuOutStream_->str());
+            CPPUNIT_ASSERT_EQUAL(SudokuLoader::ExitStatusFailed, inst.execMulti(nullptr, 0));
+        }
+    }
+
+    const std::string expected = "All " + std::to_string(sizeOfPuzzles) + " cases passed.\n";
+    const auto actual = pSudokuOutStream_->str();
+    CPPUNIT_ASSERT(actual.find(expected) != std::string::npos);
+    return;
+}
+
+void SudokuLoaderTest::test_execRecords() {
+    if (DiagonalSudokuMode) {
+        return;
+    }
+
+    constexpr SudokuPuzzleCount sizeOfPuzzles = SudokuLoader::InitialWindowSize * 3 + 5;
+    std::string pattern;
+    std::string data;
+    SudokuPuzzleRecord::WriteHeader(sizeOfPuzzles, data);
+    for(SudokuPuzzleCount i=0; i<sizeOfPuzzles; ++i) {
+        const auto& puzzle = ((i % 2) == 0) ? SudokuTestPattern::NoBacktrackString : SudokuTestPattern::BacktrackString;
+        pattern += puzzle + "\n";
+        SudokuPuzzleRecord::Record record;
+        CPPUNIT_ASSERT(SudokuPuzzleRecord::Encode(puzzle, record));
+        data.append(record.begin(), record.end());
+    }
+
+    // Solves the same puzzles as text lines with the C++ and SSE solvers
+    const SudokuSolverType solverTypeSet[] = {SudokuSolverType::SOLVER_GENERAL, SudokuSolverType::SOLVER_SSE_4_2};
+    const SudokuSolverPrint printSet[] = {SudokuSolverPrint::DO_NOT_PRINT, SudokuSolverPrint::PRINT};
+    for(const auto solverType : solverTypeSet) {
+        for(const auto print : printSet) {
+            SudokuInStream is(pattern);
+            pSudokuOutStream_.reset(new SudokuOutStream);
+            SudokuLoader streamInst(0, nullptr, nullptr, pSudokuOutStream_.get());
+            streamInst.solverType_ = solverType;
+            streamInst.print_ = print;
+            CPPUNIT_ASSERT_EQUAL(SudokuLoader::ExitStatusPassed, streamInst.execMulti(&is));
+            const auto expected = pSudokuOutStream_->str();
+
+            pSudokuOutStream_.reset(new SudokuOutStream);
+            SudokuLoader inst(0, nullptr, nullptr, pSudokuOutStream_.get());
+            inst.solverType_ = solverType;
+            inst.print_ = print;
+            inst.numberOfThreads_ = 2;
+            CPPUNIT_ASSERT_EQUAL(SudokuLoader::ExitStatusPassed, inst.execMulti(data.c_str(), data.size()));
+            CPPUNIT_ASSERT_EQUAL(expected, pSudokuOutStream_->str());
+        }
+    }
+
+    // Truncated records
+    pSudokuOutStream_.reset(new SudokuOutStream);
+    SudokuLoader inst(0, nullptr, nullptr, pSudokuOutStream_.get());
+    CPPUNIT_ASSERT_EQUAL(SudokuLoader::ExitStatusFailed, inst.execMulti(data.c_str(), data.size() - 1));
+    CPPUNIT_ASSERT_EQUAL(std::string("Invalid puzzle records\n"), pSudokuOutStream_->str());
+
+    // Records from stdin
+    SudokuInStream is(data);
+    pSudokuOutStream_.reset(new SudokuOutStream);
+    SudokuLoader streamInst(0, nullptr, nullptr, pSudokuOutStream_.get());
+    CPPUNIT_ASSERT_EQUAL(SudokuLoader::ExitStatusFailed, streamInst.execMulti(&is));
+    CPPUNIT_ASSERT_EQUAL(std::string("Invalid puzzle records (records cannot be read from stdin)\n"),
+                         pSudokuOutStream_->str());
+    return;
+}
+
 void SudokuLoaderTest::test_printHeader() {
     struct Test {
         SudokuSolverType solverType;
@@ -1170,7 +2478,9 @@ void SudokuLoaderTest::test_printHeader() {
 
     const Test testSet[] = {
         {SudokuSolverType::SOLVER_GENERAL, "C++"},
-        {SudokuSolverType::SOLVER_SSE_4_2, "SSE"}
+        {SudokuSolverType::SOLVER_SSE_4_2, "SSE"},
+        {SudokuSolverType::SOLVER_SSE_INTRINSICS, "intrinsics"},
+        {SudokuSolverType::SOLVER_BITPLANE, "bitplanes"}
     };
 
     SudokuLoader inst(0, nullptr, nullptr, pSudokuOutStream_.get());
@@ -1187,46 +2497,35 @@ void SudokuLoaderTest::test_printHeader() {
 
 void SudokuLoaderTest::test_readLines() {
     constexpr SudokuPuzzleCount numberOfPuzzles = 3;
-
-    struct Test {
-        SudokuLoader::NumberOfCores numberOfCores;
-        std::vector<SudokuLoader::DispatcherPtrSet::size_type> sizeSet;
-        std::vector<SudokuPuzzleCount> numSet;
-    };
-
-    const Test testSet[] = {
-        {1, {3, 0, 0}, {1, 2, 3}},
-        {2, {2, 1, 0}, {1, 3, 0}},
-        {3, {1, 1, 1}, {1, 0, 0}}
-    };
-
     std::string pattern = SudokuTestPattern::NoBacktrackString;
     pattern += "\n" + SudokuTestPattern::BacktrackString;
     pattern += "\n" + SudokuTestPattern::BacktrackString2;
 
-    for(const auto& test : testSet) {
-        SudokuLoader::DispatcherPtrSet dispatcherSet;
-        for(SudokuPuzzleCount i=0; i<numberOfPuzzles; ++i) {
-            dispatcherSet.push_back(
-                SudokuLoader::DispatcherPtr(
-                    new SudokuMultiDispatcher(
-                        SudokuSolverType::SOLVER_GENERAL, SudokuSolverCheck::DO_NOT_CHECK,
-                        SudokuSolverPrint::DO_NOT_PRINT, 0)));
-        }
-
-        SudokuInStream is(pattern);
-        SudokuLoader inst(0, nullptr, nullptr, pSudokuOutStream_.get());
-        CPPUNIT_ASSERT_EQUAL(numberOfPuzzles, inst.readLines(test.numberOfCores, &is, dispatcherSet));
+    SudokuMultiDispatcher dispatcher(SudokuSolverType::SOLVER_GENERAL, SudokuSolverCheck::DO_NOT_CHECK,
+                                     SudokuSolverPrint::DO_NOT_PRINT, 0);
+    SudokuInStream is(pattern);
+    SudokuLoader inst(0, nullptr, nullptr, pSudokuOutStream_.get());
+    CPPUNIT_ASSERT_EQUAL(numberOfPuzzles, inst.readLines(&is, dispatcher, 1, numberOfPuzzles + 1));
 
-        for(SudokuPuzzleCount i = 0; i < numberOfPuzzles; ++i) {
-            CPPUNIT_ASSERT_EQUAL(test.sizeSet.at(i), dispatcherSet.at(i)->dipatcherSet_.size());
-        }
+    // Threads share all puzzles
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(numberOfPuzzles), dispatcher.dipatcherSet_.size());
+    for(SudokuPuzzleCount i = 0; i < numberOfPuzzles; ++i) {
+        CPPUNIT_ASSERT_EQUAL(i + 1, dispatcher.dipatcherSet_.at(i).puzzleNum_);
+    }
 
-        for(SudokuPuzzleCount i = 0; i < numberOfPuzzles; ++i) {
-            if (i < dispatcherSet.at(0)->dipatcherSet_.size()) {
-                CPPUNIT_ASSERT_EQUAL(test.numSet.at(i), dispatcherSet.at(0)->dipatcherSet_.at(i).puzzleNum_);
-            }
+    // Reads puzzles in windows and continues line numbers
+    SudokuInStream isWindow(pattern);
+    constexpr SudokuPuzzleCount sizeOfWindow = 2;
+    SudokuPuzzleCount lineNum = 1;
+    for(const auto expected : {sizeOfWindow, numberOfPuzzles - sizeOfWindow, static_cast<SudokuPuzzleCount>(0)}) {
+        SudokuMultiDispatcher windowDispatcher(SudokuSolverType::SOLVER_GENERAL, SudokuSolverCheck::DO_NOT_CHECK,
+                                               SudokuSolverPrint::DO_NOT_PRINT, 0);
+        CPPUNIT_ASSERT_EQUAL(expected, inst.readLines(&isWindow, windowDispatcher, lineNum, sizeOfWindow));
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(expected), windowDispatcher.dipatcherSet_.size());
+        for(SudokuPuzzleCount i = 0; i < expected; ++i) {
+            CPPUNIT_ASSERT_EQUAL(lineNum + i, windowDispatcher.dipatcherSet_.at(i).puzzleNum_);
         }
+        lineNum += expected;
     }
 
     return;
@@ -1240,32 +2539,30 @@ void SudokuLoaderTest::test_execAll() {
 
     const int resultSet[] = {SudokuLoader::ExitStatusPassed, SudokuLoader::ExitStatusFailed};
     for(auto result : resultSet) {
-        constexpr SudokuPuzzleCount sizeOfPuzzles = 32;
+        constexpr SudokuPuzzleCount sizeOfPuzzles = 64;
         std::string pattern;
         for(SudokuPuzzleCount i=0; i<sizeOfPuzzles; ++i) {
             if (((i + 1) == sizeOfPuzzles) && (result == SudokuLoader::ExitStatusFailed)) {
                 pattern += SudokuTestPattern::ConflictString;
             } else {
-                pattern += SudokuTestPattern::NoBacktrackString;
+                pattern += ((i % 2) == 0) ? SudokuTestPattern::NoBacktrackString : SudokuTestPattern::BacktrackString;
             }
             pattern += "\n";
         }
 
-        for (SudokuLoader::NumberOfCores numberOfCores=1; numberOfCores<=16; ++numberOfCores) {
-            SudokuLoader::DispatcherPtrSet dispatcherSet;
-
-            for(SudokuLoader::NumberOfCores i=0; i<numberOfCores; ++i) {
-                dispatcherSet.push_back(
-                    SudokuLoader::DispatcherPtr(
-                        new SudokuMultiDispatcher(
-                            SudokuSolverType::SOLVER_GENERAL, SudokuSolverCheck::CHECK,
-                            SudokuSolverPrint::DO_NOT_PRINT, 0)));
-            }
-
+        for (SudokuLoader::NumberOfCores numberOfCores=0; numberOfCores<=16; ++numberOfCores) {
+            SudokuMultiDispatcher dispatcher(SudokuSolverType::SOLVER_GENERAL, SudokuSolverCheck::CHECK,
+                                             SudokuSolverPrint::PRINT, 0);
             SudokuInStream is(pattern);
             SudokuLoader inst(0, nullptr, nullptr, pSudokuOutStream_.get());
-            inst.readLines(numberOfCores, &is, dispatcherSet);
-            CPPUNIT_ASSERT_EQUAL(result, inst.execAll(numberOfCores, dispatcherSet));
+            inst.readLines(&is, dispatcher, 1, sizeOfPuzzles);
+            CPPUNIT_ASSERT_EQUAL(result, inst.execAll(numberOfCores, dispatcher));
+
+            // Solves every puzzle once
+            for(SudokuPuzzleCount i=0; i<sizeOfPuzzles; ++i) {
+                CPPUNIT_ASSERT(!dispatcher.GetMessage(i).empty());
+                CPPUNIT_ASSERT(dispatcher.dipatcherSet_.at(i).GetStepCount() > 0);
+            }
         }
     }
 
@@ -1273,16 +2570,8 @@ void SudokuLoaderTest::test_execAll() {
 }
 
 void SudokuLoaderTest::test_writeMessage() {
-    SudokuLoader::DispatcherPtrSet dispatcherSet;
-    constexpr SudokuLoader::NumberOfCores numberOfCores = 3;
-    for(SudokuLoader::NumberOfCores i=0; i<numberOfCores; ++i) {
-        dispatcherSet.push_back(
-            SudokuLoader::DispatcherPtr(
-                new SudokuMultiDispatcher(
-                    SudokuSolverType::SOLVER_GENERAL, SudokuSolverCheck::DO_NOT_CHECK,
-                    SudokuSolverPrint::DO_NOT_PRINT, 0)));
-    }
-
+    SudokuMultiDispatcher dispatcher(SudokuSolverType::SOLVER_GENERAL, SudokuSolverCheck::DO_NOT_CHECK,
+                                     SudokuSolverPrint::DO_NOT_PRINT, 0);
     constexpr SudokuPuzzleCount sizeOfPuzzles = 7;
     std::string pattern;
     for(SudokuPuzzleCount i=0; i<sizeOfPuzzles; ++i) {
@@ -1292,21 +2581,17 @@ void SudokuLoaderTest::test_writeMessage() {
     SudokuInStream is(pattern);
 
     SudokuLoader inst(0, nullptr, nullptr, pSudokuOutStream_.get());
-    CPPUNIT_ASSERT_EQUAL(sizeOfPuzzles, inst.readLines(numberOfCores, &is, dispatcherSet));
+    CPPUNIT_ASSERT_EQUAL(sizeOfPuzzles, inst.readLines(&is, dispatcher, 1, sizeOfPuzzles));
 
-    dispatcherSet.at(0)->dipatcherSet_.at(0).message_ = "A";
-    dispatcherSet.at(0)->dipatcherSet_.at(1).message_ = "D";
-    dispatcherSet.at(0)->dipatcherSet_.at(2).message_ = "G";
-    dispatcherSet.at(1)->dipatcherSet_.at(0).message_ = "B";
-    dispatcherSet.at(1)->dipatcherSet_.at(1).message_ = "E";
-    dispatcherSet.at(2)->dipatcherSet_.at(0).message_ = "C";
-    dispatcherSet.at(2)->dipatcherSet_.at(1).message_ = "F";
+    const std::string messageSet = "ABCDEFG";
+    for(SudokuPuzzleCount i=0; i<sizeOfPuzzles; ++i) {
+        dispatcher.dipatcherSet_.at(i).message_ = messageSet.substr(i, 1);
+    }
 
     std::ostringstream os;
-    inst.writeMessage(0, 0, dispatcherSet, nullptr);
-    inst.writeMessage(numberOfCores, sizeOfPuzzles, dispatcherSet, &os);
-    std::string expected = "ABCDEFG";
-    CPPUNIT_ASSERT_EQUAL(expected, os.str());
+    inst.writeMessage(0, dispatcher, nullptr);
+    inst.writeMessage(sizeOfPuzzles, dispatcher, &os);
+    CPPUNIT_ASSERT_EQUAL(messageSet, os.str());
     return;
 }
 
@@ -1360,22 +2645,26 @@ void SudokuLoaderTest::test_solveSudoku() {
 }
 
 void SudokuLoaderTest::test_enumerateSudoku() {
-    constexpr int argc = 2;
-    const char* argv[2] {"sudoku", "0"};
     const char* presetStrSet[] {"123456789456789123789123456295874................................................",
                                 ".............................................295874...789123456456789123123456789"};
+    // Counts solutions on a single thread and multiple threads
+    constexpr int argcSet[] {2, 4};
+    const char* argv[4] {"sudoku", "0", "-N3", "-D2"};
 
-    for(const auto& test : presetStrSet) {
-        if ((sudokuXmmAssumeCellsPacked != 0) && (!isdigit(*test))) {
-            continue;
+    for(const auto& argc : argcSet) {
+        for(const auto& test : presetStrSet) {
+            if ((sudokuXmmAssumeCellsPacked != 0) && (!isdigit(*test))) {
+                continue;
+            }
+            auto pSudokuInStream = createSudokuStream(test);
+            pSudokuOutStream_->str("");
+            SudokuLoader inst(argc, argv, pSudokuInStream.get(), pSudokuOutStream_.get());
+
+            inst.enumerateSudoku();
+            const std::string expected = "Number of solutions : 1140000\n";
+            const auto actual = pSudokuOutStream_->str();
+            CPPUNIT_ASSERT(actual.find(expected) != std::string::npos);
         }
-        auto pSudokuInStream = createSudokuStream(test);
-        SudokuLoader inst(argc, argv, pSudokuInStream.get(), pSudokuOutStream_.get());
-
-        inst.enumerateSudoku();
-        const auto actual = sudokuXmmAllPatternCnt;
-        constexpr decltype(actual) expected = 1140000ull;
-        CPPUNIT_ASSERT_EQUAL(expected, actual);
     }
     return;
 }
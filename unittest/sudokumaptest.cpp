@@ -7,7 +7,9 @@
 #include <cppunit/extensions/HelperMacros.h>
 #include <cassert>
 #include <cstring>
+#include <initializer_list>
 #include <memory>
+#include <set>
 #include "sudoku.h"
 #include "sudokutest.h"
 
@@ -42,7 +44,12 @@ class SudokuMapTest : public CPPUNIT_NS::TestFixture {
     CPPUNIT_TEST(test_Preset);
     CPPUNIT_TEST(test_Print);
     CPPUNIT_TEST(test_IsFilled);
+    CPPUNIT_TEST(test_Rewind);
+    CPPUNIT_TEST(test_collectPlacedCandidates);
+    CPPUNIT_TEST(test_Propagate);
     CPPUNIT_TEST(test_FillCrossing);
+    CPPUNIT_TEST(test_FindLockedCandidates);
+    CPPUNIT_TEST(test_FindSubsets);
     CPPUNIT_TEST(test_CanSetUniqueCell);
     CPPUNIT_TEST(test_SetUniqueCell);
     CPPUNIT_TEST(test_CountFilledCells);
@@ -61,7 +68,12 @@ protected:
     void test_Preset();
     void test_Print();
     void test_IsFilled();
+    void test_Rewind();
+    void test_collectPlacedCandidates();
+    void test_Propagate();
     void test_FillCrossing();
+    void test_FindLockedCandidates();
+    void test_FindSubsets();
     void test_CanSetUniqueCell();
     void test_SetUniqueCell();
     void test_CountFilledCells();
@@ -92,9 +104,11 @@ CPPUNIT_TEST_SUITE_REGISTRATION(SudokuMapTest);
 class SudokuSseMapTest : public CPPUNIT_NS::TestFixture {
     CPPUNIT_TEST_SUITE(SudokuSseMapTest);
     CPPUNIT_TEST(test_Preset);
+    CPPUNIT_TEST(test_PresetRecord);
     CPPUNIT_TEST(test_Print);
     CPPUNIT_TEST(test_FillCrossing);
     CPPUNIT_TEST(test_GetNextCell);
+    CPPUNIT_TEST(test_FindSubsets);
     CPPUNIT_TEST(test_CanSetUniqueCell);
     CPPUNIT_TEST(test_SetUniqueCell);
     CPPUNIT_TEST_SUITE_END();
@@ -105,9 +119,11 @@ public:
 
 protected:
     void test_Preset();
+    void test_PresetRecord();
     void test_Print();
     void test_FillCrossing();
     void test_GetNextCell();
+    void test_FindSubsets();
     void test_CanSetUniqueCell();
     void test_SetUniqueCell();
 
@@ -383,6 +399,163 @@ void SudokuMapTest::test_FillCrossing() {
     return;
 }
 
+void SudokuMapTest::test_Rewind() {
+    // Changes nothing without a trail
+    setAllCellsFullCandidates();
+    pInstance_->SetUniqueCell(0, SudokuTestCandidates::OneOnly);
+    CPPUNIT_ASSERT_EQUAL(SudokuTestCandidates::OneOnly, pInstance_->cells_[0].candidates_);
+
+    SudokuMapTrail trail;
+    setAllCellsFullCandidates();
+    pInstance_->SetTrail(&trail);
+    const auto initialMark = trail.GetMark();
+
+    // Records cells only if they change
+    pInstance_->SetUniqueCell(0, SudokuTestCandidates::OneOnly);
+    const auto firstMark = trail.GetMark();
+    CPPUNIT_ASSERT_EQUAL(initialMark + 1, firstMark);
+    pInstance_->SetUniqueCell(0, SudokuTestCandidates::OneOnly);
+    CPPUNIT_ASSERT_EQUAL(firstMark, trail.GetMark());
+
+    pInstance_->SetUniqueCell(1, SudokuTestCandidates::TwoOnly);
+    CPPUNIT_ASSERT(!pInstance_->FillCrossing());
+    CPPUNIT_ASSERT(trail.GetMark() > (firstMark + 1));
+
+    // Rewinds the second cell and cells filled after it
+    pInstance_->Rewind(firstMark);
+    CPPUNIT_ASSERT_EQUAL(firstMark, trail.GetMark());
+    CPPUNIT_ASSERT_EQUAL(SudokuTestCandidates::OneOnly, pInstance_->cells_[0].candidates_);
+    for(SudokuIndex i=1;i<Sudoku::SizeOfAllCells;++i) {
+        CPPUNIT_ASSERT_EQUAL(SudokuTestCandidates::All, pInstance_->cells_[i].candidates_);
+    }
+
+    pInstance_->Rewind(initialMark);
+    for(SudokuIndex i=0;i<Sudoku::SizeOfAllCells;++i) {
+        CPPUNIT_ASSERT_EQUAL(SudokuTestCandidates::All, pInstance_->cells_[i].candidates_);
+    }
+
+    pInstance_->SetTrail(nullptr);
+    return;
+}
+
+void SudokuMapTest::test_collectPlacedCandidates() {
+    setAllCellsFullCandidates();
+    pInstance_->cells_[SudokuTestPosition::Head].candidates_ = SudokuTestCandidates::OneOnly;
+    pInstance_->cells_[SudokuTestPosition::Last].candidates_ = SudokuTestCandidates::NineOnly;
+    pInstance_->collectPlacedCandidates();
+
+    constexpr SudokuIndex lastGroup = Sudoku::SizeOfGroupsPerMap - 1;
+    for(SudokuIndex i=0;i<Sudoku::SizeOfGroupsPerCell;++i) {
+        for(SudokuIndex j=0;j<Sudoku::SizeOfGroupsPerMap;++j) {
+            const auto expected = (j == 0) ? SudokuTestCandidates::OneOnly :
+                ((j == lastGroup) ? SudokuTestCandidates::NineOnly : SudokuTestCandidates::Empty);
+            CPPUNIT_ASSERT_EQUAL(expected, pInstance_->placedCandidates_[i][j]);
+        }
+    }
+
+    // Follows a cell that gets a unique candidate
+    pInstance_->SetUniqueCell(1, SudokuTestCandidates::TwoOnly);
+    SudokuCellCandidates expected = SudokuTestCandidates::OneOnly | SudokuTestCandidates::TwoOnly;
+    CPPUNIT_ASSERT_EQUAL(expected, pInstance_->placedCandidates_[0][0]);
+    CPPUNIT_ASSERT_EQUAL(SudokuTestCandidates::TwoOnly, pInstance_->placedCandidates_[1][1]);
+    CPPUNIT_ASSERT_EQUAL(expected, pInstance_->placedCandidates_[2][0]);
+
+    if (DiagonalSudokuMode) {
+        expected = SudokuTestCandidates::OneOnly | SudokuTestCandidates::NineOnly;
+        CPPUNIT_ASSERT_EQUAL(expected, pInstance_->placedDiagonalCandidates_[0]);
+        CPPUNIT_ASSERT_EQUAL(SudokuTestCandidates::Empty, pInstance_->placedDiagonalCandidates_[1]);
+    }
+
+    return;
+}
+
+void SudokuMapTest::test_Propagate() {
+    // Fills the same cells as FillCrossing() does until it stalls
+    const auto& presetStr = (DiagonalSudokuMode) ?
+        SudokuTestPattern::DiagonalSudokuString2 : SudokuTestPattern::BacktrackString;
+    const auto resultNum = (DiagonalSudokuMode) ?
+        SudokuTestPattern::DiagonalSudokuResult2 : SudokuTestPattern::BacktrackResult;
+    SudokuMap expected;
+    expected.Preset(presetStr, 0);
+    auto count = expected.CountFilledCells();
+    for(;;) {
+        CPPUNIT_ASSERT(!expected.FillCrossing());
+        const auto newCount = expected.CountFilledCells();
+        if (count == newCount) {
+            break;
+        }
+        count = newCount;
+    }
+
+    pInstance_->Preset(presetStr, 0);
+    CPPUNIT_ASSERT(!pInstance_->Propagate());
+    CPPUNIT_ASSERT(!pInstance_->IsFilled());
+    CPPUNIT_ASSERT_EQUAL(count, pInstance_->filledCellCnt_);
+    for(SudokuIndex i=0;i<Sudoku::SizeOfAllCells;++i) {
+        CPPUNIT_ASSERT_EQUAL(expected.cells_[i].candidates_, pInstance_->cells_[i].candidates_);
+    }
+
+    // Nothing to do
+    CPPUNIT_ASSERT(!pInstance_->Propagate());
+    CPPUNIT_ASSERT_EQUAL(count, pInstance_->filledCellCnt_);
+
+    // Fills cells after a right guess
+    const auto cellIndex = pInstance_->SelectBacktrackedCellIndex();
+    pInstance_->SetUniqueCell(cellIndex, indexToCandidate(resultNum[cellIndex]));
+    CPPUNIT_ASSERT(!pInstance_->Propagate());
+    CPPUNIT_ASSERT(pInstance_->filledCellCnt_ > count);
+    CPPUNIT_ASSERT_EQUAL(pInstance_->CountFilledCells(), pInstance_->filledCellCnt_);
+
+    // Inconsistent
+    SudokuMap conflicted;
+    conflicted.Preset(SudokuTestPattern::ConflictString, 0);
+    CPPUNIT_ASSERT(conflicted.Propagate());
+    return;
+}
+
+void SudokuMapTest::test_FindLockedCandidates() {
+    constexpr SudokuCellCandidates candidate = 1;
+    for(const auto& test : SudokuTestLockedCandidates::testSet) {
+        setAllCellsFullCandidates();
+        for(const auto cellIndex : test.preset) {
+            pInstance_->cells_[cellIndex].candidates_ = SudokuTestCandidates::All & ~candidate;
+        }
+
+        CPPUNIT_ASSERT(pInstance_->FindLockedCandidates());
+        for(SudokuIndex i=0;i<Sudoku::SizeOfAllCells;++i) {
+            const bool removed = SudokuTestLockedCandidates::IsRemoved(test, i);
+            const SudokuCellCandidates expected = SudokuTestCandidates::All & ~(removed ? candidate : 0);
+            CPPUNIT_ASSERT_EQUAL(expected, pInstance_->cells_[i].candidates_);
+        }
+
+        // Nothing to remove
+        CPPUNIT_ASSERT(!pInstance_->FindLockedCandidates());
+    }
+
+    return;
+}
+
+void SudokuMapTest::test_FindSubsets() {
+    for(const auto& test : SudokuTestSubsets::testSet) {
+        setAllCellsFullCandidates();
+        for(SudokuIndex i=0;i<Sudoku::SizeOfCellsPerGroup;++i) {
+            pInstance_->cells_[i].candidates_ = test.preset[i];
+        }
+
+        CPPUNIT_ASSERT_EQUAL(test.found, pInstance_->FindSubsets());
+        for(SudokuIndex i=0;i<Sudoku::SizeOfAllCells;++i) {
+            const SudokuCellCandidates expected = (i < Sudoku::SizeOfCellsPerGroup) ?
+                test.expected[i] : SudokuTestCandidates::All;
+            CPPUNIT_ASSERT_EQUAL(expected, pInstance_->cells_[i].candidates_);
+        }
+
+        // Nothing to remove
+        CPPUNIT_ASSERT(!pInstance_->FindSubsets());
+    }
+
+    return;
+}
+
 void SudokuMapTest::test_CanSetUniqueCell() {
     for(SudokuIndex i=0;i<Sudoku::SizeOfAllCells;++i) {
         assert(i < arraySizeof(pInstance_->cells_));
@@ -606,6 +779,7 @@ void SudokuMapTest::test_findUnusedCandidate() {
     setAllCellsFullCandidates();
     setTopLineExceptRightest();
     auto target = Sudoku::SizeOfCellsPerGroup - 1;
+    pInstance_->collectPlacedCandidates();
     CPPUNIT_ASSERT_EQUAL(false, pInstance_->findUnusedCandidate(pInstance_->cells_[target]));
     auto expected = indexToCandidate(target+1);
     CPPUNIT_ASSERT_EQUAL(expected, pInstance_->cells_[target].candidates_);
@@ -614,6 +788,7 @@ void SudokuMapTest::test_findUnusedCandidate() {
     setAllCellsFullCandidates();
     setTopLineExceptRightest();
     pInstance_->cells_[Sudoku::SizeOfAllCells - 1].candidates_ = indexToCandidate(Sudoku::SizeOfCellsPerGroup);
+    pInstance_->collectPlacedCandidates();
     CPPUNIT_ASSERT_EQUAL(true, pInstance_->findUnusedCandidate(pInstance_->cells_[target]));
     expected = SudokuTestCandidates::Empty;
     CPPUNIT_ASSERT_EQUAL(expected, pInstance_->cells_[target].candidates_);
@@ -625,6 +800,7 @@ void SudokuMapTest::test_findUnusedCandidate() {
             candidates_ = indexToCandidate(i+1);
     }
     target = Sudoku::SizeOfAllCells - 1;
+    pInstance_->collectPlacedCandidates();
     CPPUNIT_ASSERT_EQUAL(false, pInstance_->findUnusedCandidate(pInstance_->cells_[target]));
     expected = indexToCandidate(Sudoku::SizeOfCellsPerGroup);
     CPPUNIT_ASSERT_EQUAL(expected, pInstance_->cells_[target].candidates_);
@@ -640,6 +816,7 @@ void SudokuMapTest::test_findUnusedCandidate() {
         }
     }
     target = SudokuTestPosition::Center;
+    pInstance_->collectPlacedCandidates();
     CPPUNIT_ASSERT_EQUAL(false, pInstance_->findUnusedCandidate(pInstance_->cells_[target]));
     expected = SudokuTestCandidates::CenterOnly;
     CPPUNIT_ASSERT_EQUAL(expected, pInstance_->cells_[target].candidates_);
@@ -660,6 +837,7 @@ void SudokuMapTest::test_findUnusedCandidate() {
     }
 
     target = SudokuTestPosition::Head;
+    pInstance_->collectPlacedCandidates();
     CPPUNIT_ASSERT_EQUAL(false, pInstance_->findUnusedCandidate(pInstance_->cells_[target]));
     expected = indexToCandidate(Sudoku::SizeOfCellsPerGroup);
     CPPUNIT_ASSERT_EQUAL(expected, pInstance_->cells_[target].candidates_);
@@ -673,6 +851,7 @@ void SudokuMapTest::test_findUnusedCandidate() {
         pInstance_->cells_[test.cellPosition].candidates_ = indexToCandidate(test.candidateIndex);
     }
     target = SudokuTestPosition::Head;
+    pInstance_->collectPlacedCandidates();
     CPPUNIT_ASSERT_EQUAL(false, pInstance_->findUnusedCandidate(pInstance_->cells_[target]));
     expected = SudokuTestCandidates::FourAndSix;
     CPPUNIT_ASSERT_EQUAL(expected, pInstance_->cells_[target].candidates_);
@@ -694,6 +873,7 @@ void SudokuMapTest::test_findUnusedCandidateX() {
     }
 
     const auto target = SudokuTestPosition::Last;
+    pInstance_->collectPlacedCandidates();
     CPPUNIT_ASSERT_EQUAL(false, pInstance_->findUnusedCandidate(pInstance_->cells_[target]));
     const auto expected = indexToCandidate(Sudoku::SizeOfCellsPerGroup);
     CPPUNIT_ASSERT_EQUAL(expected, pInstance_->cells_[target].candidates_);
@@ -725,6 +905,7 @@ void SudokuMapTest::test_findUnusedCandidateX() {
         // top right
         const auto target = Sudoku::SizeOfCellsPerGroup - 1;
         const auto expected = indexToCandidate(1);
+        pInstance_->collectPlacedCandidates();
         CPPUNIT_ASSERT_EQUAL(false, pInstance_->findUnusedCandidate(pInstance_->cells_[target]));
         CPPUNIT_ASSERT_EQUAL(expected, pInstance_->cells_[target].candidates_);
     }
@@ -863,6 +1044,24 @@ void SudokuSseMapTest::test_Preset() {
     return;
 }
 
+void SudokuSseMapTest::test_PresetRecord() {
+    const std::string presetStrSet[] = {
+        "", "1234567890", SudokuTestPattern::NoBacktrackString, SudokuTestPattern::BacktrackString,
+        SudokuTestPattern::BacktrackString2, SudokuTestPattern::NoBacktrackStringSolution};
+
+    for(const auto& presetStr : presetStrSet) {
+        SudokuPuzzleRecord::Record record;
+        CPPUNIT_ASSERT(SudokuPuzzleRecord::Encode(presetStr, record));
+
+        SudokuSseMap expected;
+        expected.Preset(presetStr);
+        pInstance_->PresetRecord(record.data());
+        CPPUNIT_ASSERT_EQUAL(0, memcmp(&expected.xmmRegSet_, &pInstance_->xmmRegSet_, sizeof(expected.xmmRegSet_)));
+    }
+
+    return;
+}
+
 void SudokuSseMapTest::test_Print() {
     SudokuCellCandidates candidates = 0x40201;
     size_t regIndex = pInstance_->InitialRegisterNum * SudokuSse::RegisterWordCnt;
@@ -930,6 +1129,31 @@ void SudokuSseMapTest::test_GetNextCell() {
     }
 }
 
+void SudokuSseMapTest::test_FindSubsets() {
+    for(const auto& test : SudokuTestSubsets::testSet) {
+        setAllCellsFullCandidates();
+        SudokuSseCandidateCell cell;
+        for(SudokuIndex i=0;i<Sudoku::SizeOfCellsPerGroup;++i) {
+            pInstance_->getCell(i, cell);
+            pInstance_->xmmRegSet_.regVal_[cell.regIndex] &= ~cell.mask;
+            pInstance_->xmmRegSet_.regVal_[cell.regIndex] |= test.preset[i] << cell.shift;
+        }
+
+        CPPUNIT_ASSERT_EQUAL(test.found, pInstance_->FindSubsets());
+        for(SudokuIndex i=0;i<Sudoku::SizeOfAllCells;++i) {
+            const SudokuSseElement expected = (i < Sudoku::SizeOfCellsPerGroup) ?
+                test.expected[i] : SudokuTestCandidates::All;
+            pInstance_->getCell(i, cell);
+            CPPUNIT_ASSERT_EQUAL(expected, pInstance_->GetCandidates(cell));
+        }
+
+        // Nothing to remove
+        CPPUNIT_ASSERT(!pInstance_->FindSubsets());
+    }
+
+    return;
+}
+
 void SudokuSseMapTest::test_CanSetUniqueCell() {
     constexpr size_t regIndex = 0;
     SudokuCellCandidates candidate = 1;
@@ -991,6 +1215,1432 @@ void SudokuSseMapTest::test_SetUniqueCell() {
     CPPUNIT_ASSERT_EQUAL(candidate << Sudoku::SizeOfCandidates, pInstance_->xmmRegSet_.regVal_[regIndex]);
 }
 
+#if defined(SUDOKU_SOA_MAP)
+class SudokuSoaMapTest : public CPPUNIT_NS::TestFixture {
+    CPPUNIT_TEST_SUITE(SudokuSoaMapTest);
+    CPPUNIT_TEST(test_Preset);
+    CPPUNIT_TEST(test_Print);
+    CPPUNIT_TEST(test_FillCrossing);
+    CPPUNIT_TEST(test_IsConsistent);
+    CPPUNIT_TEST(test_CountFilledCells);
+    CPPUNIT_TEST(test_SelectBacktrackedCellIndex);
+    CPPUNIT_TEST(test_SetUniqueCell);
+    CPPUNIT_TEST(test_Exec);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp() override;
+    void tearDown() override;
+
+protected:
+    void test_Preset();
+    void test_Print();
+    void test_FillCrossing();
+    void test_IsConsistent();
+    void test_CountFilledCells();
+    void test_SelectBacktrackedCellIndex();
+    void test_SetUniqueCell();
+    void test_Exec();
+
+private:
+    void checkCells(const SudokuSoaMap& map, const SudokuIndex* expectedIndexes);
+    void setCell(SudokuIndex cellIndex, SudokuCellCandidates candidates);
+    SudokuSoaMap instance_;  // tested object
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(SudokuSoaMapTest);
+
+// Call before running a test
+void SudokuSoaMapTest::setUp() {
+    instance_ = SudokuSoaMap();
+    for(SudokuIndex i=0;i<Sudoku::SizeOfAllCells;++i) {
+        const SudokuCellCandidates expected = SudokuTestCandidates::All;
+        CPPUNIT_ASSERT_EQUAL(expected, instance_.GetCandidates(i));
+    }
+    return;
+}
+
+// Call after running a test
+void SudokuSoaMapTest::tearDown() {
+    return;
+}
+
+// Confirms that rows and boxes hold the same cells
+void SudokuSoaMapTest::checkCells(const SudokuSoaMap& map, const SudokuIndex* expectedIndexes) {
+    for(SudokuIndex i=0;i<Sudoku::SizeOfAllCells;++i) {
+        const SudokuIndex row = i / Sudoku::SizeOfCellsPerGroup;
+        const SudokuIndex column = i % Sudoku::SizeOfCellsPerGroup;
+        const auto index = expectedIndexes[i];
+        const SudokuCellCandidates expected = (index == 0) ? SudokuTestCandidates::All :
+            SudokuTestCommon::ConvertToCandidate(index);
+        const SudokuCellCandidates actualRow = map.rows_[row][column];
+        const SudokuCellCandidates actualBox = map.boxes_[SudokuSoaMap::getBoxIndex(row, column)]
+            [SudokuSoaMap::getBoxPosition(row, column)];
+        CPPUNIT_ASSERT_EQUAL(expected, actualRow);
+        CPPUNIT_ASSERT_EQUAL(expected, actualBox);
+    }
+
+    for(SudokuIndex i=0;i<Sudoku::SizeOfGroupsPerMap;++i) {
+        for(SudokuIndex j=Sudoku::SizeOfCellsPerGroup;j<SudokuSoaMap::SudokuLaneCnt;++j) {
+            CPPUNIT_ASSERT_EQUAL(static_cast<SudokuSoaMap::Lane>(0), map.rows_[i][j]);
+            CPPUNIT_ASSERT_EQUAL(static_cast<SudokuSoaMap::Lane>(0), map.boxes_[i][j]);
+        }
+    }
+    return;
+}
+
+void SudokuSoaMapTest::setCell(SudokuIndex cellIndex, SudokuCellCandidates candidates) {
+    const SudokuIndex row = cellIndex / Sudoku::SizeOfCellsPerGroup;
+    const SudokuIndex column = cellIndex % Sudoku::SizeOfCellsPerGroup;
+    instance_.rows_[row][column] = static_cast<SudokuSoaMap::Lane>(candidates);
+    instance_.copyRowsToBoxes();
+    return;
+}
+
+void SudokuSoaMapTest::test_Preset() {
+    for(const auto& test : SudokuTestPattern::testSet) {
+        SudokuSoaMap map;
+        map.Preset(test.presetStr);
+        checkCells(map, test.presetNum);
+    }
+
+    // Pad with blank cells
+    SudokuSoaMap map;
+    map.Preset("1");
+    CPPUNIT_ASSERT_EQUAL(static_cast<SudokuCellCandidates>(SudokuTestCandidates::UniqueBase), map.GetCandidates(0));
+    CPPUNIT_ASSERT_EQUAL(static_cast<SudokuCellCandidates>(SudokuTestCandidates::All), map.GetCandidates(1));
+    return;
+}
+
+void SudokuSoaMapTest::test_Print() {
+    SudokuSoaMap soaMap;
+    SudokuMap map;
+    soaMap.Preset(SudokuTestPattern::BacktrackString);
+    map.Preset(SudokuTestPattern::BacktrackString, 0);
+
+    SudokuOutStream expected;
+    SudokuOutStream actual;
+    map.Print(&expected);
+    soaMap.Print(&actual);
+    CPPUNIT_ASSERT(expected.str() == actual.str());
+    return;
+}
+
+void SudokuSoaMapTest::test_FillCrossing() {
+    if (DiagonalSudokuMode) {
+        instance_.Preset(SudokuTestPattern::DiagonalSudokuString1);
+        CPPUNIT_ASSERT_EQUAL(false, instance_.FillCrossing());
+        CPPUNIT_ASSERT_EQUAL(true, instance_.IsFilled());
+        checkCells(instance_, SudokuTestPattern::DiagonalSudokuResult1);
+        return;
+    }
+
+    // Naked and hidden singles solve this puzzle
+    instance_.Preset(SudokuTestPattern::NoBacktrackString);
+    CPPUNIT_ASSERT_EQUAL(false, instance_.FillCrossing());
+    CPPUNIT_ASSERT_EQUAL(true, instance_.IsFilled());
+    checkCells(instance_, SudokuTestPattern::NoBacktrackResult);
+
+    // They fill some cells and stall
+    instance_.Preset(SudokuTestPattern::BacktrackString);
+    const auto filledCount = instance_.CountFilledCells();
+    CPPUNIT_ASSERT_EQUAL(false, instance_.FillCrossing());
+    CPPUNIT_ASSERT_EQUAL(false, instance_.IsFilled());
+    CPPUNIT_ASSERT(instance_.CountFilledCells() > filledCount);
+
+    // Cells must agree with the solution
+    for(SudokuIndex i=0;i<Sudoku::SizeOfAllCells;++i) {
+        const auto candidates = instance_.GetCandidates(i);
+        const auto expected = SudokuTestCommon::ConvertToCandidate(SudokuTestPattern::BacktrackResult[i]);
+        CPPUNIT_ASSERT(candidates & expected);
+    }
+
+    // A row holds the same numbers
+    instance_.Preset(SudokuTestPattern::ConflictString);
+    CPPUNIT_ASSERT_EQUAL(true, instance_.FillCrossing());
+
+    // A row lacks a number
+    instance_ = SudokuSoaMap();
+    for(SudokuIndex i=0;i<Sudoku::SizeOfCellsPerGroup;++i) {
+        setCell(i, SudokuTestCandidates::DoubleLine);
+    }
+    CPPUNIT_ASSERT_EQUAL(true, instance_.FillCrossing());
+
+    // A cell holds two numbers which no other cells in its column can hold
+    instance_ = SudokuSoaMap();
+    for(SudokuIndex i=1;i<Sudoku::SizeOfGroupsPerMap;++i) {
+        setCell(i * Sudoku::SizeOfCellsPerGroup, SudokuTestCandidates::DoubleLine);
+    }
+    CPPUNIT_ASSERT_EQUAL(true, instance_.FillCrossing());
+    return;
+}
+
+void SudokuSoaMapTest::test_IsConsistent() {
+    if (DiagonalSudokuMode) {
+        return;
+    }
+
+    instance_.Preset(SudokuTestPattern::NoBacktrackString);
+    CPPUNIT_ASSERT_EQUAL(false, instance_.IsConsistent());
+    CPPUNIT_ASSERT_EQUAL(false, instance_.FillCrossing());
+    CPPUNIT_ASSERT_EQUAL(true, instance_.IsConsistent());
+
+    // Swaps two cells in a row
+    const auto left = instance_.GetCandidates(0);
+    const auto right = instance_.GetCandidates(1);
+    instance_.SetUniqueCell(0, right);
+    instance_.SetUniqueCell(1, left);
+    CPPUNIT_ASSERT_EQUAL(true, instance_.IsFilled());
+    CPPUNIT_ASSERT_EQUAL(false, instance_.IsConsistent());
+    return;
+}
+
+void SudokuSoaMapTest::test_CountFilledCells() {
+    CPPUNIT_ASSERT_EQUAL(static_cast<SudokuIndex>(0), instance_.CountFilledCells());
+
+    for(const auto& test : SudokuTestPattern::testSet) {
+        instance_.Preset(test.presetStr);
+        SudokuIndex expected = 0;
+        for(SudokuIndex i=0;i<Sudoku::SizeOfAllCells;++i) {
+            expected += (test.presetNum[i] != 0) ? 1 : 0;
+        }
+        CPPUNIT_ASSERT_EQUAL(expected, instance_.CountFilledCells());
+    }
+    return;
+}
+
+void SudokuSoaMapTest::test_SelectBacktrackedCellIndex() {
+    // The first cell of all cells which have the fewest candidates
+    CPPUNIT_ASSERT_EQUAL(static_cast<SudokuIndex>(0), instance_.SelectBacktrackedCellIndex());
+
+    constexpr SudokuIndex cellIndexSet[] {1, 8, 9, 17, 40, 72, 79};
+    for(const auto cellIndex : cellIndexSet) {
+        instance_ = SudokuSoaMap();
+        setCell(cellIndex, SudokuTestCandidates::DoubleLine);
+        CPPUNIT_ASSERT_EQUAL(cellIndex, instance_.SelectBacktrackedCellIndex());
+
+        // Skips filled cells
+        setCell(0, SudokuTestCandidates::UniqueBase);
+        CPPUNIT_ASSERT_EQUAL(cellIndex, instance_.SelectBacktrackedCellIndex());
+
+        // Selects the first cell of the two cells
+        setCell(cellIndex + 1, SudokuTestCandidates::DoubleLine);
+        CPPUNIT_ASSERT_EQUAL(cellIndex, instance_.SelectBacktrackedCellIndex());
+
+        // Selects a cell which has fewer candidates
+        setCell(cellIndex + 1, SudokuTestCandidates::DoubleLine & ~SudokuTestCandidates::UniqueBase);
+        CPPUNIT_ASSERT_EQUAL(static_cast<SudokuIndex>(cellIndex + 1), instance_.SelectBacktrackedCellIndex());
+    }
+    return;
+}
+
+void SudokuSoaMapTest::test_SetUniqueCell() {
+    for(SudokuIndex i=0;i<Sudoku::SizeOfAllCells;++i) {
+        const SudokuCellCandidates candidate = SudokuTestCandidates::UniqueBase << (i % Sudoku::SizeOfCandidates);
+        instance_.SetUniqueCell(i, candidate);
+        CPPUNIT_ASSERT_EQUAL(candidate, instance_.GetCandidates(i));
+        const SudokuIndex row = i / Sudoku::SizeOfCellsPerGroup;
+        const SudokuIndex column = i % Sudoku::SizeOfCellsPerGroup;
+        const SudokuCellCandidates actual = instance_.boxes_[SudokuSoaMap::getBoxIndex(row, column)]
+            [SudokuSoaMap::getBoxPosition(row, column)];
+        CPPUNIT_ASSERT_EQUAL(candidate, actual);
+    }
+    return;
+}
+
+void SudokuSoaMapTest::test_Exec() {
+    auto exec = [this](const SudokuTestPattern::TestSet& test) {
+        SudokuOutStream sudokuOutStream;
+        SudokuSoaSolver inst(test.presetStr, &sudokuOutStream);
+        CPPUNIT_ASSERT_EQUAL(test.result, inst.Exec(true, false));
+        CPPUNIT_ASSERT(inst.count_ >= 1);
+        if (test.result) {
+            checkCells(inst.map_, test.resultNum);
+        }
+    };
+
+    if (DiagonalSudokuMode) {
+        for(const auto& test : SudokuTestPattern::testSetDiagonal) {
+            exec(test);
+        }
+    } else {
+        for(const auto& test : SudokuTestPattern::testSet) {
+            exec(test);
+        }
+    }
+
+    SudokuOutStream sudokuOutStream;
+    SudokuSoaSolver inst(SudokuTestPattern::NoBacktrackString, &sudokuOutStream);
+    inst.PrintType();
+    CPPUNIT_ASSERT(sudokuOutStream.str() == "[C++ with AVX2]\n");
+    return;
+}
+#endif
+
+class SudokuBitplaneMapTest : public CPPUNIT_NS::TestFixture {
+    CPPUNIT_TEST_SUITE(SudokuBitplaneMapTest);
+    CPPUNIT_TEST(test_Preset);
+    CPPUNIT_TEST(test_Print);
+    CPPUNIT_TEST(test_FillCrossing);
+    CPPUNIT_TEST(test_place);
+    CPPUNIT_TEST(test_CountFilledCells);
+    CPPUNIT_TEST(test_SelectBacktrackedCellIndex);
+    CPPUNIT_TEST(test_SetUniqueCell);
+    CPPUNIT_TEST(test_Exec);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp() override;
+    void tearDown() override;
+
+protected:
+    void test_Preset();
+    void test_Print();
+    void test_FillCrossing();
+    void test_place();
+    void test_CountFilledCells();
+    void test_SelectBacktrackedCellIndex();
+    void test_SetUniqueCell();
+    void test_Exec();
+
+private:
+    void checkCells(const SudokuBitplaneMap& map, const SudokuIndex* expectedIndexes);
+    std::unique_ptr<SudokuBitplaneMap> pInstance_;  // tested object
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(SudokuBitplaneMapTest);
+
+// Call before running a test
+void SudokuBitplaneMapTest::setUp() {
+    pInstance_ = decltype(pInstance_)(new SudokuBitplaneMap());
+    for(SudokuIndex i=0;i<Sudoku::SizeOfAllCells;++i) {
+        const SudokuCellCandidates expected = SudokuTestCandidates::All;
+        CPPUNIT_ASSERT_EQUAL(expected, pInstance_->GetCandidates(i));
+    }
+    return;
+}
+
+// Call after running a test
+void SudokuBitplaneMapTest::tearDown() {
+    return;
+}
+
+void SudokuBitplaneMapTest::checkCells(const SudokuBitplaneMap& map, const SudokuIndex* expectedIndexes) {
+    for(SudokuIndex i=0;i<Sudoku::SizeOfAllCells;++i) {
+        const auto index = expectedIndexes[i];
+        const SudokuCellCandidates expected = (index == 0) ? SudokuTestCandidates::All :
+            SudokuTestCommon::ConvertToCandidate(index);
+        CPPUNIT_ASSERT_EQUAL(expected, map.GetCandidates(i));
+    }
+    return;
+}
+
+void SudokuBitplaneMapTest::test_Preset() {
+    for(const auto& test : SudokuTestPattern::testSet) {
+        SudokuBitplaneMap map;
+        map.Preset(test.presetStr);
+        checkCells(map, test.presetNum);
+    }
+
+    // Pad with blank cells
+    SudokuBitplaneMap map;
+    map.Preset("1");
+    CPPUNIT_ASSERT_EQUAL(static_cast<SudokuCellCandidates>(SudokuTestCandidates::UniqueBase), map.GetCandidates(0));
+    CPPUNIT_ASSERT_EQUAL(static_cast<SudokuCellCandidates>(SudokuTestCandidates::All), map.GetCandidates(1));
+    return;
+}
+
+void SudokuBitplaneMapTest::test_Print() {
+    SudokuBitplaneMap bitplaneMap;
+    SudokuMap map;
+    bitplaneMap.Preset(SudokuTestPattern::BacktrackString);
+    map.Preset(SudokuTestPattern::BacktrackString, 0);
+
+    SudokuOutStream expected;
+    SudokuOutStream actual;
+    map.Print(&expected);
+    bitplaneMap.Print(&actual);
+    CPPUNIT_ASSERT(expected.str() == actual.str());
+    return;
+}
+
+void SudokuBitplaneMapTest::test_FillCrossing() {
+    if (DiagonalSudokuMode) {
+        pInstance_->Preset(SudokuTestPattern::DiagonalSudokuString1);
+        CPPUNIT_ASSERT_EQUAL(false, pInstance_->FillCrossing());
+        CPPUNIT_ASSERT_EQUAL(true, pInstance_->IsFilled());
+        checkCells(*pInstance_, SudokuTestPattern::DiagonalSudokuResult1);
+        return;
+    }
+
+    // Naked and hidden singles solve this puzzle
+    pInstance_->Preset(SudokuTestPattern::NoBacktrackString);
+    CPPUNIT_ASSERT_EQUAL(false, pInstance_->FillCrossing());
+    CPPUNIT_ASSERT_EQUAL(true, pInstance_->IsFilled());
+    checkCells(*pInstance_, SudokuTestPattern::NoBacktrackResult);
+
+    // They fill some cells and stall
+    pInstance_->Preset(SudokuTestPattern::BacktrackString);
+    const auto filledCount = pInstance_->CountFilledCells();
+    CPPUNIT_ASSERT_EQUAL(false, pInstance_->FillCrossing());
+    CPPUNIT_ASSERT_EQUAL(false, pInstance_->IsFilled());
+    CPPUNIT_ASSERT(pInstance_->CountFilledCells() > filledCount);
+
+    // Cells must agree with the solution
+    for(SudokuIndex i=0;i<Sudoku::SizeOfAllCells;++i) {
+        const auto candidates = pInstance_->GetCandidates(i);
+        const auto expected = SudokuTestCommon::ConvertToCandidate(SudokuTestPattern::BacktrackResult[i]);
+        CPPUNIT_ASSERT(candidates & expected);
+    }
+
+    // A row holds the same numbers
+    pInstance_->Preset(SudokuTestPattern::ConflictString);
+    CPPUNIT_ASSERT_EQUAL(true, pInstance_->FillCrossing());
+
+    // A row lacks a number
+    pInstance_.reset(new SudokuBitplaneMap());
+    for(SudokuIndex i=0;i<Sudoku::SizeOfCellsPerGroup;++i) {
+        pInstance_->SetUniqueCell(i, SudokuTestCandidates::DoubleLine);
+    }
+    CPPUNIT_ASSERT_EQUAL(true, pInstance_->FillCrossing());
+
+    // Three numbers can be placed only at the first cell of a column
+    pInstance_.reset(new SudokuBitplaneMap());
+    for(SudokuIndex i=1;i<Sudoku::SizeOfGroupsPerMap;++i) {
+        pInstance_->SetUniqueCell(i * Sudoku::SizeOfCellsPerGroup, SudokuTestCandidates::DoubleLine);
+    }
+    CPPUNIT_ASSERT_EQUAL(true, pInstance_->FillCrossing());
+    return;
+}
+
+void SudokuBitplaneMapTest::test_place() {
+    // Places 1 at the center of the puzzle
+    constexpr SudokuIndex center = 40;
+    constexpr SudokuIndex band = center / SudokuBitplaneMap::SizeOfCellsPerBand;
+    pInstance_->SetUniqueCell(center, SudokuTestCandidates::UniqueBase);
+    pInstance_->place(0, band, static_cast<SudokuBitplaneMap::Band>(1) << (center % SudokuBitplaneMap::SizeOfCellsPerBand));
+
+    for(SudokuIndex i=0;i<Sudoku::SizeOfAllCells;++i) {
+        const SudokuIndex row = i / Sudoku::SizeOfCellsPerGroup;
+        const SudokuIndex column = i % Sudoku::SizeOfCellsPerGroup;
+        const bool sameBox = ((row / Sudoku::SizeOfCellsOnBoxEdge) == 1) && ((column / Sudoku::SizeOfCellsOnBoxEdge) == 1);
+        const bool onDiagonal = DiagonalSudokuMode && ((row == column) || (row + column + 1 == Sudoku::SizeOfCellsPerGroup));
+        SudokuCellCandidates expected = SudokuTestCandidates::All;
+        if (i == center) {
+            expected = SudokuTestCandidates::UniqueBase;
+        } else if ((row == 4) || (column == 4) || sameBox || onDiagonal) {
+            expected = SudokuTestCandidates::All & ~SudokuTestCandidates::UniqueBase;
+        }
+        CPPUNIT_ASSERT_EQUAL(expected, pInstance_->GetCandidates(i));
+    }
+
+    CPPUNIT_ASSERT_EQUAL(static_cast<SudokuBitplaneMap::Band>(1) << (center % SudokuBitplaneMap::SizeOfCellsPerBand),
+                         pInstance_->placed_[band]);
+    return;
+}
+
+void SudokuBitplaneMapTest::test_CountFilledCells() {
+    CPPUNIT_ASSERT_EQUAL(static_cast<SudokuIndex>(0), pInstance_->CountFilledCells());
+
+    for(const auto& test : SudokuTestPattern::testSet) {
+        pInstance_->Preset(test.presetStr);
+        SudokuIndex expected = 0;
+        for(SudokuIndex i=0;i<Sudoku::SizeOfAllCells;++i) {
+            expected += (test.presetNum[i] != 0) ? 1 : 0;
+        }
+        CPPUNIT_ASSERT_EQUAL(expected, pInstance_->CountFilledCells());
+    }
+    return;
+}
+
+void SudokuBitplaneMapTest::test_SelectBacktrackedCellIndex() {
+    // The first cell of all cells which have the fewest candidates
+    CPPUNIT_ASSERT_EQUAL(static_cast<SudokuIndex>(0), pInstance_->SelectBacktrackedCellIndex());
+
+    constexpr SudokuIndex cellIndexSet[] {1, 8, 9, 17, 26, 40, 72, 79};
+    for(const auto cellIndex : cellIndexSet) {
+        pInstance_.reset(new SudokuBitplaneMap());
+        pInstance_->SetUniqueCell(cellIndex, SudokuTestCandidates::DoubleLine);
+        CPPUNIT_ASSERT_EQUAL(cellIndex, pInstance_->SelectBacktrackedCellIndex());
+
+        // Skips filled cells
+        pInstance_->SetUniqueCell(0, SudokuTestCandidates::UniqueBase);
+        CPPUNIT_ASSERT_EQUAL(cellIndex, pInstance_->SelectBacktrackedCellIndex());
+
+        // Selects the first cell of the two cells
+        pInstance_->SetUniqueCell(cellIndex + 1, SudokuTestCandidates::DoubleLine);
+        CPPUNIT_ASSERT_EQUAL(cellIndex, pInstance_->SelectBacktrackedCellIndex());
+    }
+
+    // Selects a cell which has fewer candidates if no cells have two candidates
+    pInstance_.reset(new SudokuBitplaneMap());
+    pInstance_->SetUniqueCell(30, SudokuTestCandidates::DoubleLine | SudokuTestCandidates::CenterLine);
+    pInstance_->SetUniqueCell(50, SudokuTestCandidates::DoubleLine | SudokuTestCandidates::UniqueBase);
+    CPPUNIT_ASSERT_EQUAL(static_cast<SudokuIndex>(50), pInstance_->SelectBacktrackedCellIndex());
+    return;
+}
+
+void SudokuBitplaneMapTest::test_SetUniqueCell() {
+    for(SudokuIndex i=0;i<Sudoku::SizeOfAllCells;++i) {
+        const SudokuCellCandidates candidate = SudokuTestCandidates::UniqueBase << (i % Sudoku::SizeOfCandidates);
+        pInstance_->SetUniqueCell(i, candidate);
+        CPPUNIT_ASSERT_EQUAL(candidate, pInstance_->GetCandidates(i));
+    }
+    return;
+}
+
+void SudokuBitplaneMapTest::test_Exec() {
+    auto exec = [this](const SudokuTestPattern::TestSet& test) {
+        SudokuOutStream sudokuOutStream;
+        SudokuBitplaneSolver inst(test.presetStr, &sudokuOutStream);
+        CPPUNIT_ASSERT_EQUAL(test.result, inst.Exec(true, false));
+        CPPUNIT_ASSERT(inst.count_ >= 1);
+        if (test.result) {
+            checkCells(inst.map_, test.resultNum);
+        }
+    };
+
+    if (DiagonalSudokuMode) {
+        for(const auto& test : SudokuTestPattern::testSetDiagonal) {
+            exec(test);
+        }
+    } else {
+        for(const auto& test : SudokuTestPattern::testSet) {
+            exec(test);
+        }
+    }
+
+    SudokuOutStream sudokuOutStream;
+    SudokuBitplaneSolver inst(SudokuTestPattern::NoBacktrackString, &sudokuOutStream);
+    inst.PrintType();
+    CPPUNIT_ASSERT(sudokuOutStream.str() == "[Bitplane]\n");
+    return;
+}
+
+class SudokuBranchSelectorTest : public CPPUNIT_NS::TestFixture {
+    CPPUNIT_TEST_SUITE(SudokuBranchSelectorTest);
+    CPPUNIT_TEST(test_Select);
+    CPPUNIT_TEST(test_SelectBacktrackedCellIndex);
+    CPPUNIT_TEST(test_FindNextCell);
+    CPPUNIT_TEST(test_Order);
+    CPPUNIT_TEST(test_OrderCandidates);
+    CPPUNIT_TEST(test_Exec);
+    CPPUNIT_TEST(test_GetGuessCount);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp() override;
+    void tearDown() override;
+
+protected:
+    void test_Select();
+    void test_SelectBacktrackedCellIndex();
+    void test_FindNextCell();
+    void test_Order();
+    void test_OrderCandidates();
+    void test_Exec();
+    void test_GetGuessCount();
+
+private:
+    using CountSet = SudokuBranchSelector::CountSet;
+    using CandidatesSet = SudokuBranchSelector::CandidatesSet;
+    using OrderedSet = SudokuBranchSelector::OrderedSet;
+    struct OrderTest {
+        SudokuValueOrder order;
+        SudokuCellCandidates expected[3];
+    };
+    // A cell which holds candidates 1, 2 and 3 and its expected orders
+    static constexpr SudokuIndex CellToOrder = 40;
+    static const OrderTest OrderTestSet[];
+    // Cells which have the fewest candidates in a column and in a row respectively
+    static constexpr SudokuIndex CellInColumn = 10;
+    static constexpr SudokuIndex CellInRow = 80;
+    static void setCandidates(CountSet& countSet);
+    static void setCandidates(CandidatesSet& candidatesSet);
+    static SudokuCellCandidates getCandidates(SudokuIndex count);
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(SudokuBranchSelectorTest);
+
+constexpr SudokuIndex SudokuBranchSelectorTest::CellInColumn;
+constexpr SudokuIndex SudokuBranchSelectorTest::CellInRow;
+constexpr SudokuIndex SudokuBranchSelectorTest::CellToOrder;
+
+// 20 cells in the row, column and box of CellToOrder hold 3, 12 cells hold 1, and 8 cells hold 2.
+// 1 and 2 have only one place in the column and the row respectively.
+const SudokuBranchSelectorTest::OrderTest SudokuBranchSelectorTest::OrderTestSet[] {
+    {SudokuValueOrder::ASCENDING, {1, 2, 4}},
+    {SudokuValueOrder::LEAST_CONSTRAINING, {2, 1, 4}},
+    {SudokuValueOrder::FEWEST_PLACES, {1, 2, 4}}
+};
+
+// Call before running a test
+void SudokuBranchSelectorTest::setUp() {
+    return;
+}
+
+// Call after running a test
+void SudokuBranchSelectorTest::tearDown() {
+    Sudoku::SetBranchPolicy(SudokuBranchPolicy::FIXED_GROUP);
+    Sudoku::SetValueOrder(SudokuValueOrder::ASCENDING);
+    return;
+}
+
+// Fills the second column except CellInColumn and sets two candidates to CellInColumn and CellInRow.
+// The second column has fewer candidates than the bottom row but CellInRow has more blank cells in its groups.
+void SudokuBranchSelectorTest::setCandidates(CountSet& countSet) {
+    for(SudokuIndex i=0;i<Sudoku::SizeOfAllCells;++i) {
+        countSet[i] = Sudoku::SizeOfCandidates;
+    }
+
+    for(SudokuIndex row=0;row<Sudoku::SizeOfGroupsPerMap;++row) {
+        countSet[row * Sudoku::SizeOfCellsPerGroup + 1] = 1;
+    }
+    countSet[CellInColumn] = 2;
+    countSet[CellInRow] = 2;
+    return;
+}
+
+// Removes 1 from the column of CellToOrder, and 2 from its row and its box
+void SudokuBranchSelectorTest::setCandidates(CandidatesSet& candidatesSet) {
+    for(SudokuIndex i=0;i<Sudoku::SizeOfAllCells;++i) {
+        candidatesSet[i] = Sudoku::AllCandidates;
+    }
+    candidatesSet[CellToOrder] = getCandidates(3);
+
+    for(SudokuIndex i : {4, 13, 22, 31, 49, 58, 67, 76}) {
+        candidatesSet[i] &= ~1u;
+    }
+    for(SudokuIndex i : {36, 37, 38, 39, 41, 42, 43, 44, 30, 32, 48, 50}) {
+        candidatesSet[i] &= ~2u;
+    }
+    return;
+}
+
+SudokuCellCandidates SudokuBranchSelectorTest::getCandidates(SudokuIndex count) {
+    return (1u << count) - 1;
+}
+
+void SudokuBranchSelectorTest::test_Select() {
+    CountSet countSet;
+    SudokuIndex cellIndex = Sudoku::SizeOfAllCells;
+    for(SudokuIndex i=0;i<Sudoku::SizeOfAllCells;++i) {
+        countSet[i] = 1;
+    }
+    CPPUNIT_ASSERT(!SudokuBranchSelector::Select(SudokuBranchPolicy::ALL_GROUPS, countSet, cellIndex));
+    CPPUNIT_ASSERT(!SudokuBranchSelector::Select(SudokuBranchPolicy::MIN_REMAINING, countSet, cellIndex));
+    CPPUNIT_ASSERT_EQUAL(static_cast<SudokuIndex>(Sudoku::SizeOfAllCells), cellIndex);
+
+    // Takes the first cell in ties
+    for(SudokuIndex i=0;i<Sudoku::SizeOfAllCells;++i) {
+        countSet[i] = Sudoku::SizeOfCandidates;
+    }
+    CPPUNIT_ASSERT(SudokuBranchSelector::Select(SudokuBranchPolicy::ALL_GROUPS, countSet, cellIndex));
+    CPPUNIT_ASSERT_EQUAL(static_cast<SudokuIndex>(0), cellIndex);
+    CPPUNIT_ASSERT(SudokuBranchSelector::Select(SudokuBranchPolicy::MIN_REMAINING, countSet, cellIndex));
+    CPPUNIT_ASSERT_EQUAL(static_cast<SudokuIndex>(0), cellIndex);
+
+    // Skips cells which have no candidates
+    countSet[40] = 0;
+    countSet[50] = 3;
+    CPPUNIT_ASSERT(SudokuBranchSelector::Select(SudokuBranchPolicy::ALL_GROUPS, countSet, cellIndex));
+    CPPUNIT_ASSERT_EQUAL(static_cast<SudokuIndex>(50), cellIndex);
+    CPPUNIT_ASSERT(SudokuBranchSelector::Select(SudokuBranchPolicy::MIN_REMAINING, countSet, cellIndex));
+    CPPUNIT_ASSERT_EQUAL(static_cast<SudokuIndex>(50), cellIndex);
+
+    setCandidates(countSet);
+    CPPUNIT_ASSERT(SudokuBranchSelector::Select(SudokuBranchPolicy::ALL_GROUPS, countSet, cellIndex));
+    CPPUNIT_ASSERT_EQUAL(CellInColumn, cellIndex);
+    CPPUNIT_ASSERT(SudokuBranchSelector::Select(SudokuBranchPolicy::MIN_REMAINING, countSet, cellIndex));
+    CPPUNIT_ASSERT_EQUAL(CellInRow, cellIndex);
+    return;
+}
+
+void SudokuBranchSelectorTest::test_SelectBacktrackedCellIndex() {
+    CountSet countSet;
+    setCandidates(countSet);
+
+    SudokuMap map;
+    for(SudokuIndex i=0;i<Sudoku::SizeOfAllCells;++i) {
+        map.cells_[i].SetCandidates(getCandidates(countSet[i]));
+    }
+
+    // Rows only
+    CPPUNIT_ASSERT_EQUAL(CellInRow, map.SelectBacktrackedCellIndex());
+    Sudoku::SetBranchPolicy(SudokuBranchPolicy::ALL_GROUPS);
+    CPPUNIT_ASSERT_EQUAL(CellInColumn, map.SelectBacktrackedCellIndex());
+    Sudoku::SetBranchPolicy(SudokuBranchPolicy::MIN_REMAINING);
+    CPPUNIT_ASSERT_EQUAL(CellInRow, map.SelectBacktrackedCellIndex());
+    return;
+}
+
+void SudokuBranchSelectorTest::test_FindNextCell() {
+    CountSet countSet;
+    setCandidates(countSet);
+
+    SudokuSseMap map;
+    map.Preset("");
+    for(SudokuIndex i=0;i<Sudoku::SizeOfAllCells;++i) {
+        SudokuSseCandidateCell cell;
+        SudokuSseMap::getCell(i, cell);
+        auto& regVal = map.xmmRegSet_.regVal_[cell.regIndex];
+        regVal = (regVal & ~cell.mask) | (getCandidates(countSet[i]) << cell.shift);
+    }
+
+    struct Test {
+        SudokuBranchPolicy policy;
+        SudokuIndex expected;
+    };
+
+    constexpr Test testSet[] {
+        {SudokuBranchPolicy::FIXED_GROUP, CellInRow},
+        {SudokuBranchPolicy::ALL_GROUPS, CellInColumn},
+        {SudokuBranchPolicy::MIN_REMAINING, CellInRow}
+    };
+
+    for(const auto& test : testSet) {
+        Sudoku::SetBranchPolicy(test.policy);
+        SudokuSseCandidateCell expected;
+        SudokuSseMap::getCell(test.expected, expected);
+        SudokuSseCandidateCell actual;
+        CPPUNIT_ASSERT(map.FindNextCell(actual));
+        CPPUNIT_ASSERT_EQUAL(expected.regIndex, actual.regIndex);
+        CPPUNIT_ASSERT_EQUAL(expected.shift, actual.shift);
+        CPPUNIT_ASSERT_EQUAL(expected.mask, actual.mask);
+    }
+
+    return;
+}
+
+void SudokuBranchSelectorTest::test_Order() {
+    CandidatesSet candidatesSet;
+    setCandidates(candidatesSet);
+
+    for(const auto& test : OrderTestSet) {
+        OrderedSet orderedSet;
+        CPPUNIT_ASSERT_EQUAL(static_cast<SudokuIndex>(3),
+                             SudokuBranchSelector::Order(test.order, candidatesSet, CellToOrder, orderedSet));
+        for(SudokuIndex i=0;i<3;++i) {
+            CPPUNIT_ASSERT_EQUAL(test.expected[i], orderedSet[i]);
+        }
+    }
+
+    CPPUNIT_ASSERT_EQUAL(static_cast<SudokuIndex>(12), SudokuBranchSelector::countPeers(candidatesSet, CellToOrder, 1));
+    CPPUNIT_ASSERT_EQUAL(static_cast<SudokuIndex>(8), SudokuBranchSelector::countPeers(candidatesSet, CellToOrder, 2));
+    CPPUNIT_ASSERT_EQUAL(static_cast<SudokuIndex>(20), SudokuBranchSelector::countPeers(candidatesSet, CellToOrder, 4));
+    CPPUNIT_ASSERT_EQUAL(static_cast<SudokuIndex>(1), SudokuBranchSelector::countPlaces(candidatesSet, CellToOrder, 1));
+    CPPUNIT_ASSERT_EQUAL(static_cast<SudokuIndex>(1), SudokuBranchSelector::countPlaces(candidatesSet, CellToOrder, 2));
+    CPPUNIT_ASSERT_EQUAL(static_cast<SudokuIndex>(9), SudokuBranchSelector::countPlaces(candidatesSet, CellToOrder, 4));
+
+    // A filled cell and a cell which has no candidates
+    OrderedSet orderedSet;
+    candidatesSet[0] = 0x100;
+    candidatesSet[1] = 0;
+    for(const auto& test : OrderTestSet) {
+        CPPUNIT_ASSERT_EQUAL(static_cast<SudokuIndex>(1), SudokuBranchSelector::Order(test.order, candidatesSet, 0, orderedSet));
+        CPPUNIT_ASSERT_EQUAL(static_cast<SudokuCellCandidates>(0x100), orderedSet[0]);
+        CPPUNIT_ASSERT_EQUAL(static_cast<SudokuIndex>(0), SudokuBranchSelector::Order(test.order, candidatesSet, 1, orderedSet));
+    }
+
+    return;
+}
+
+void SudokuBranchSelectorTest::test_OrderCandidates() {
+    CandidatesSet candidatesSet;
+    setCandidates(candidatesSet);
+
+    SudokuMap map;
+    SudokuSseMap sseMap;
+    sseMap.Preset("");
+    for(SudokuIndex i=0;i<Sudoku::SizeOfAllCells;++i) {
+        map.cells_[i].SetCandidates(candidatesSet[i]);
+        SudokuSseCandidateCell cell;
+        SudokuSseMap::getCell(i, cell);
+        auto& regVal = sseMap.xmmRegSet_.regVal_[cell.regIndex];
+        regVal = (regVal & ~cell.mask) | (candidatesSet[i] << cell.shift);
+    }
+
+    SudokuSseCandidateCell cell;
+    SudokuSseMap::getCell(CellToOrder, cell);
+    for(const auto& test : OrderTestSet) {
+        Sudoku::SetValueOrder(test.order);
+        SudokuCellCandidates orderedSet[Sudoku::SizeOfCandidates];
+        SudokuCellCandidates sseOrderedSet[Sudoku::SizeOfCandidates];
+        CPPUNIT_ASSERT_EQUAL(static_cast<SudokuIndex>(3), map.OrderCandidates(CellToOrder, orderedSet));
+        CPPUNIT_ASSERT_EQUAL(static_cast<SudokuIndex>(3), sseMap.OrderCandidates(cell, sseOrderedSet));
+        for(SudokuIndex i=0;i<3;++i) {
+            CPPUNIT_ASSERT_EQUAL(test.expected[i], orderedSet[i]);
+            CPPUNIT_ASSERT_EQUAL(test.expected[i], sseOrderedSet[i]);
+        }
+    }
+
+    return;
+}
+
+void SudokuBranchSelectorTest::test_Exec() {
+    auto solve = [](const SudokuTestPattern::TestSet& test) {
+        SudokuOutStream sudokuOutStream;
+        SudokuSolver cppSolver(test.presetStr, 0, &sudokuOutStream);
+        CPPUNIT_ASSERT_EQUAL(test.result, cppSolver.Exec(true, false));
+        SudokuSseSolver sseSolver(test.presetStr, &sudokuOutStream, 0);
+        CPPUNIT_ASSERT_EQUAL(test.result, sseSolver.Exec(true, false));
+        SudokuSseIntrinsicsSolver intrinsicsSolver(test.presetStr, &sudokuOutStream);
+        CPPUNIT_ASSERT_EQUAL(test.result, intrinsicsSolver.Exec(true, false));
+    };
+
+    for(const auto policy : {SudokuBranchPolicy::FIXED_GROUP, SudokuBranchPolicy::ALL_GROUPS, SudokuBranchPolicy::MIN_REMAINING}) {
+        Sudoku::SetBranchPolicy(policy);
+        for(const auto& orderTest : OrderTestSet) {
+            Sudoku::SetValueOrder(orderTest.order);
+            if (DiagonalSudokuMode) {
+                for(const auto& test : SudokuTestPattern::testSetDiagonal) {
+                    solve(test);
+                }
+            } else {
+                for(const auto& test : SudokuTestPattern::testSet) {
+                    solve(test);
+                }
+            }
+        }
+    }
+
+    return;
+}
+
+void SudokuBranchSelectorTest::test_GetGuessCount() {
+    if (DiagonalSudokuMode) {
+        return;
+    }
+
+    for(const auto& orderTest : OrderTestSet) {
+        Sudoku::SetValueOrder(orderTest.order);
+        for(const auto& presetStr : {SudokuTestPattern::NoBacktrackString, SudokuTestPattern::BacktrackString}) {
+            const bool guesses = (presetStr == SudokuTestPattern::BacktrackString);
+            SudokuOutStream sudokuOutStream;
+            SudokuSolver cppSolver(presetStr, 0, &sudokuOutStream);
+            CPPUNIT_ASSERT(cppSolver.Exec(true, false));
+            CPPUNIT_ASSERT_EQUAL(guesses, cppSolver.GetGuessCount() > 0);
+            SudokuSseSolver sseSolver(presetStr, &sudokuOutStream, 0);
+            CPPUNIT_ASSERT(sseSolver.Exec(true, false));
+            CPPUNIT_ASSERT_EQUAL(guesses, sseSolver.GetGuessCount() > 0);
+            SudokuSseIntrinsicsSolver intrinsicsSolver(presetStr, &sudokuOutStream);
+            CPPUNIT_ASSERT(intrinsicsSolver.Exec(true, false));
+            CPPUNIT_ASSERT_EQUAL(guesses, intrinsicsSolver.GetGuessCount() > 0);
+        }
+    }
+
+    return;
+}
+
+class SudokuGridMapTest : public CPPUNIT_NS::TestFixture {
+    CPPUNIT_TEST_SUITE(SudokuGridMapTest);
+    CPPUNIT_TEST(test_Geometry);
+    CPPUNIT_TEST(test_Preset);
+    CPPUNIT_TEST(test_Print);
+    CPPUNIT_TEST(test_ConvertCharToCandidate);
+    CPPUNIT_TEST(test_FillCrossing);
+    CPPUNIT_TEST(test_IsSolutionOf);
+    CPPUNIT_TEST(test_SelectBacktrackedCellIndex);
+    CPPUNIT_TEST(test_Exec);
+    CPPUNIT_TEST(test_ExecLargeGrids);
+    CPPUNIT_TEST(test_CountUpTo);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp() override;
+    void tearDown() override;
+
+protected:
+    void test_Geometry();
+    void test_Preset();
+    void test_Print();
+    void test_ConvertCharToCandidate();
+    void test_FillCrossing();
+    void test_IsSolutionOf();
+    void test_SelectBacktrackedCellIndex();
+    void test_Exec();
+    void test_ExecLargeGrids();
+    void test_CountUpTo();
+
+private:
+    template <SudokuIndex BoxSize> void checkGeometry();
+    void checkCells(const SudokuGridMap<3>& map, const SudokuIndex* expectedIndexes);
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(SudokuGridMapTest);
+
+// Call before running a test
+void SudokuGridMapTest::setUp() {
+    return;
+}
+
+// Call after running a test
+void SudokuGridMapTest::tearDown() {
+    return;
+}
+
+template <SudokuIndex BoxSize>
+void SudokuGridMapTest::checkGeometry() {
+    using Map = SudokuGridMap<BoxSize>;
+    using Geometry = typename Map::Geometry;
+    constexpr SudokuIndex size = Geometry::SizeOfCellsPerGroup;
+
+    for(SudokuIndex groupId=0;groupId<Geometry::SizeOfGroupsPerCell;++groupId) {
+        for(SudokuIndex groupIndex=0;groupIndex<Geometry::SizeOfGroupsPerMap;++groupIndex) {
+            std::set<SudokuIndex> cellSet;
+            for(SudokuIndex position=0;position<size;++position) {
+                const auto cellIndex = Map::Group_[(groupId * size + groupIndex) * size + position];
+                CPPUNIT_ASSERT(cellIndex < Geometry::SizeOfAllCells);
+                CPPUNIT_ASSERT_EQUAL(groupIndex, Map::ReverseGroup_[cellIndex * Geometry::SizeOfGroupsPerCell + groupId]);
+                cellSet.insert(cellIndex);
+            }
+            CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(size), cellSet.size());
+        }
+    }
+
+    // Two bars cross at the center of odd-sized puzzles
+    for(SudokuIndex bar=0;bar<2;++bar) {
+        for(SudokuIndex position=0;position<size;++position) {
+            const auto cellIndex = Map::Diagonal_[bar * size + position];
+            CPPUNIT_ASSERT_EQUAL(position, static_cast<SudokuIndex>(cellIndex / size));
+            CPPUNIT_ASSERT(Geometry::IsOnDiagonal(bar, cellIndex));
+        }
+    }
+
+    SudokuIndex cellCount = 0;
+    for(SudokuIndex cellIndex=0;cellIndex<Geometry::SizeOfAllCells;++cellIndex) {
+        cellCount += Geometry::IsOnDiagonal(0, cellIndex) ? 1 : 0;
+    }
+    CPPUNIT_ASSERT_EQUAL(size, cellCount);
+    return;
+}
+
+void SudokuGridMapTest::checkCells(const SudokuGridMap<3>& map, const SudokuIndex* expectedIndexes) {
+    for(SudokuIndex i=0;i<Sudoku::SizeOfAllCells;++i) {
+        const auto index = expectedIndexes[i];
+        const SudokuCellCandidates expected = (index == 0) ? SudokuTestCandidates::All :
+            SudokuTestCommon::ConvertToCandidate(index);
+        CPPUNIT_ASSERT_EQUAL(expected, map.GetCandidates(i));
+    }
+    return;
+}
+
+void SudokuGridMapTest::test_Geometry() {
+    // Same as the tables that sudokumap.rb generates
+    for(SudokuIndex groupId=0;groupId<Sudoku::SizeOfGroupsPerCell;++groupId) {
+        for(SudokuIndex groupIndex=0;groupIndex<Sudoku::SizeOfGroupsPerMap;++groupIndex) {
+            for(SudokuIndex position=0;position<Sudoku::SizeOfCellsPerGroup;++position) {
+                const auto index = (groupId * Sudoku::SizeOfGroupsPerMap + groupIndex) * Sudoku::SizeOfCellsPerGroup + position;
+                CPPUNIT_ASSERT_EQUAL(SudokuMap::Group_[groupId][groupIndex][position], SudokuGridMap<3>::Group_[index]);
+            }
+        }
+    }
+
+    for(SudokuIndex cellIndex=0;cellIndex<Sudoku::SizeOfAllCells;++cellIndex) {
+        for(SudokuIndex groupId=0;groupId<Sudoku::SizeOfGroupsPerCell;++groupId) {
+            CPPUNIT_ASSERT_EQUAL(SudokuMap::ReverseGroup_[cellIndex][groupId],
+                                 SudokuGridMap<3>::ReverseGroup_[cellIndex * Sudoku::SizeOfGroupsPerCell + groupId]);
+        }
+    }
+
+    checkGeometry<3>();
+    checkGeometry<4>();
+    checkGeometry<5>();
+
+    CPPUNIT_ASSERT_EQUAL(static_cast<SudokuCellCandidates>(SudokuTestCandidates::All),
+                         static_cast<SudokuCellCandidates>(SudokuGeometry<3>::AllCandidates));
+    CPPUNIT_ASSERT_EQUAL(static_cast<SudokuCellCandidates>(0xffff),
+                         static_cast<SudokuCellCandidates>(SudokuGeometry<4>::AllCandidates));
+    CPPUNIT_ASSERT_EQUAL(static_cast<SudokuCellCandidates>(0x1ffffff),
+                         static_cast<SudokuCellCandidates>(SudokuGeometry<5>::AllCandidates));
+    return;
+}
+
+void SudokuGridMapTest::test_Preset() {
+    for(const auto& test : SudokuTestPattern::testSet) {
+        SudokuGridMap<3> map;
+        map.Preset(test.presetStr);
+        checkCells(map, test.presetNum);
+    }
+
+    // Pad with blank cells
+    SudokuGridMap<4> map;
+    map.Preset("1G");
+    CPPUNIT_ASSERT_EQUAL(static_cast<SudokuCellCandidates>(1), map.GetCandidates(0));
+    CPPUNIT_ASSERT_EQUAL(static_cast<SudokuCellCandidates>(0x8000), map.GetCandidates(1));
+    CPPUNIT_ASSERT_EQUAL(static_cast<SudokuCellCandidates>(SudokuGeometry<4>::AllCandidates), map.GetCandidates(2));
+    return;
+}
+
+void SudokuGridMapTest::test_Print() {
+    SudokuGridMap<3> gridMap;
+    SudokuMap map;
+    gridMap.Preset(SudokuTestPattern::BacktrackString);
+    map.Preset(SudokuTestPattern::BacktrackString, 0);
+
+    SudokuOutStream expected;
+    SudokuOutStream actual;
+    map.Print(&expected);
+    gridMap.Print(&actual);
+    CPPUNIT_ASSERT(expected.str() == actual.str());
+
+    SudokuGridMap<4> largeMap;
+    largeMap.Preset("9ABCDEFG");
+    SudokuOutStream largeActual;
+    largeMap.Print(&largeActual);
+    CPPUNIT_ASSERT(largeActual.str().find("9:A:B:C:D:E:F:G:123456789ABCDEFG:") == 0);
+    return;
+}
+
+void SudokuGridMapTest::test_ConvertCharToCandidate() {
+    struct Test {
+        char c;
+        SudokuCellCandidates expected4;
+        SudokuCellCandidates expected5;
+    };
+
+    constexpr Test testSet[] {
+        {'1', 1, 1}, {'9', 0x100, 0x100}, {'A', 0x200, 0x200}, {'g', 0x8000, 0x8000},
+        {'H', 0, 0x10000}, {'P', 0, 0x1000000}, {'Q', 0, 0}, {'0', 0, 0}, {'.', 0, 0}, {' ', 0, 0}
+    };
+
+    for(const auto& test : testSet) {
+        CPPUNIT_ASSERT_EQUAL(test.expected4, SudokuGridMap<4>::ConvertCharToCandidate(test.c));
+        CPPUNIT_ASSERT_EQUAL(test.expected5, SudokuGridMap<5>::ConvertCharToCandidate(test.c));
+    }
+
+    for(SudokuIndex number=1;number<=SudokuGeometry<5>::SizeOfCandidates;++number) {
+        const auto c = SudokuGridMap<5>::ConvertNumberToChar(number);
+        CPPUNIT_ASSERT_EQUAL(static_cast<SudokuCellCandidates>(1u << (number - 1)), SudokuGridMap<5>::ConvertCharToCandidate(c));
+    }
+    return;
+}
+
+void SudokuGridMapTest::test_FillCrossing() {
+    SudokuGridMap<3> map;
+    if (DiagonalSudokuMode) {
+        map.Preset(SudokuTestPattern::DiagonalSudokuString1);
+        CPPUNIT_ASSERT_EQUAL(false, map.FillCrossing());
+        CPPUNIT_ASSERT_EQUAL(true, map.IsFilled());
+        checkCells(map, SudokuTestPattern::DiagonalSudokuResult1);
+        return;
+    }
+
+    // Naked and hidden singles solve this puzzle
+    map.Preset(SudokuTestPattern::NoBacktrackString);
+    CPPUNIT_ASSERT_EQUAL(false, map.FillCrossing());
+    CPPUNIT_ASSERT_EQUAL(true, map.IsFilled());
+    checkCells(map, SudokuTestPattern::NoBacktrackResult);
+
+    // They fill some cells and stall
+    map.Preset(SudokuTestPattern::BacktrackString);
+    const auto filledCount = map.CountFilledCells();
+    CPPUNIT_ASSERT_EQUAL(false, map.FillCrossing());
+    CPPUNIT_ASSERT_EQUAL(false, map.IsFilled());
+    CPPUNIT_ASSERT(map.CountFilledCells() > filledCount);
+
+    // A row holds the same numbers
+    map.Preset(SudokuTestPattern::ConflictString);
+    CPPUNIT_ASSERT_EQUAL(true, map.FillCrossing());
+
+    // A row lacks a number
+    SudokuGridMap<4> largeMap;
+    for(SudokuIndex i=0;i<SudokuGeometry<4>::SizeOfCellsPerGroup;++i) {
+        largeMap.SetUniqueCell(i, 0xfffe);
+    }
+    CPPUNIT_ASSERT_EQUAL(true, largeMap.FillCrossing());
+
+    // Two numbers can be placed only at the first cell of a column
+    largeMap = SudokuGridMap<4>();
+    for(SudokuIndex i=1;i<SudokuGeometry<4>::SizeOfGroupsPerMap;++i) {
+        largeMap.SetUniqueCell(i * SudokuGeometry<4>::SizeOfCellsPerGroup, 0xfffc);
+    }
+    CPPUNIT_ASSERT_EQUAL(true, largeMap.FillCrossing());
+    return;
+}
+
+void SudokuGridMapTest::test_IsSolutionOf() {
+    if (DiagonalSudokuMode) {
+        return;
+    }
+
+    SudokuGridMap<4> map;
+    map.Preset(SudokuTestPattern::Grid16Solution);
+    CPPUNIT_ASSERT(map.IsSolutionOf(SudokuTestPattern::Grid16String));
+    CPPUNIT_ASSERT(map.IsSolutionOf(""));
+
+    // Overwrites a preset cell
+    std::string puzzle = SudokuTestPattern::Grid16String;
+    const auto cellIndex = puzzle.find_first_not_of('.');
+    puzzle.at(cellIndex) = (puzzle.at(cellIndex) == '1') ? '2' : '1';
+    CPPUNIT_ASSERT(!map.IsSolutionOf(puzzle));
+
+    // Swaps two cells in a row
+    std::string solution = SudokuTestPattern::Grid16Solution;
+    std::swap(solution.at(0), solution.at(1));
+    map.Preset(solution);
+    CPPUNIT_ASSERT(!map.IsSolutionOf(""));
+
+    // Not filled
+    map.Preset(SudokuTestPattern::Grid16String);
+    CPPUNIT_ASSERT(!map.IsSolutionOf(SudokuTestPattern::Grid16String));
+    return;
+}
+
+void SudokuGridMapTest::test_SelectBacktrackedCellIndex() {
+    SudokuGridMap<5> map;
+    CPPUNIT_ASSERT_EQUAL(static_cast<SudokuIndex>(0), map.SelectBacktrackedCellIndex());
+
+    // Skips filled cells
+    map.SetUniqueCell(0, 1);
+    CPPUNIT_ASSERT_EQUAL(static_cast<SudokuIndex>(1), map.SelectBacktrackedCellIndex());
+
+    map.SetUniqueCell(300, 0x1000007);
+    map.SetUniqueCell(400, 0x1000003);
+    map.SetUniqueCell(500, 0x1000001);
+    CPPUNIT_ASSERT_EQUAL(static_cast<SudokuIndex>(500), map.SelectBacktrackedCellIndex());
+    return;
+}
+
+void SudokuGridMapTest::test_Exec() {
+    auto exec = [this](const SudokuTestPattern::TestSet& test) {
+        SudokuOutStream sudokuOutStream;
+        SudokuGridSolver<3> inst(test.presetStr, &sudokuOutStream);
+        CPPUNIT_ASSERT_EQUAL(test.result, inst.Exec(true, false));
+        CPPUNIT_ASSERT(inst.count_ >= 1);
+        if (test.result) {
+            checkCells(inst.map_, test.resultNum);
+        }
+    };
+
+    if (DiagonalSudokuMode) {
+        for(const auto& test : SudokuTestPattern::testSetDiagonal) {
+            exec(test);
+        }
+    } else {
+        for(const auto& test : SudokuTestPattern::testSet) {
+            exec(test);
+        }
+    }
+
+    SudokuOutStream sudokuOutStream;
+    SudokuGridSolver<3> inst(SudokuTestPattern::NoBacktrackString, &sudokuOutStream);
+    inst.PrintType();
+    CPPUNIT_ASSERT(sudokuOutStream.str() == "[C++ 9x9]\n");
+    return;
+}
+
+void SudokuGridMapTest::test_ExecLargeGrids() {
+    if (DiagonalSudokuMode) {
+        return;
+    }
+
+    {
+        SudokuOutStream sudokuOutStream;
+        SudokuGridSolver<4> inst(SudokuTestPattern::Grid16String, &sudokuOutStream);
+        CPPUNIT_ASSERT(inst.Exec(true, false));
+        CPPUNIT_ASSERT(inst.IsSolutionOf(SudokuTestPattern::Grid16String));
+        SudokuGridMap<4> expected;
+        expected.Preset(SudokuTestPattern::Grid16Solution);
+        for(SudokuIndex i=0;i<SudokuGeometry<4>::SizeOfAllCells;++i) {
+            CPPUNIT_ASSERT_EQUAL(expected.GetCandidates(i), inst.map_.GetCandidates(i));
+        }
+        inst.PrintType();
+        CPPUNIT_ASSERT(sudokuOutStream.str() == "[C++ 16x16]\n");
+    }
+
+    {
+        SudokuOutStream sudokuOutStream;
+        SudokuGridSolver<5> inst(SudokuTestPattern::Grid25String, &sudokuOutStream);
+        CPPUNIT_ASSERT(inst.Exec(true, false));
+        CPPUNIT_ASSERT(inst.IsSolutionOf(SudokuTestPattern::Grid25String));
+        SudokuGridMap<5> expected;
+        expected.Preset(SudokuTestPattern::Grid25Solution);
+        for(SudokuIndex i=0;i<SudokuGeometry<5>::SizeOfAllCells;++i) {
+            CPPUNIT_ASSERT_EQUAL(expected.GetCandidates(i), inst.map_.GetCandidates(i));
+        }
+        inst.PrintType();
+        CPPUNIT_ASSERT(sudokuOutStream.str() == "[C++ 25x25]\n");
+    }
+
+    // Two cells in a row hold the same number
+    std::string puzzle(SudokuGeometry<4>::SizeOfAllCells, '.');
+    puzzle.at(0) = 'G';
+    puzzle.at(15) = 'G';
+    SudokuGridSolver<4> inst(puzzle, nullptr);
+    CPPUNIT_ASSERT(!inst.Exec(true, false));
+    return;
+}
+
+void SudokuGridMapTest::test_CountUpTo() {
+    if (DiagonalSudokuMode) {
+        return;
+    }
+
+    struct Test {
+        std::string puzzle;
+        SudokuPatternCount maxCount;
+        SudokuPatternCount expected;
+    };
+
+    const Test testSet[] {
+        {SudokuTestPattern::NoBacktrackString, 2, 1},
+        {SudokuTestPattern::BacktrackString, 2, 1},
+        {"83...6....1..9.258..25486...43.128....17.43625..68.1....9....1...8....23..42...8.", 2, 2},
+        {"83...6....1..9.258..25486...43.128....17.43625..68.1....9....1...8....23..42...8.", 1, 1},
+        {SudokuTestPattern::ConflictString, 2, 0}
+    };
+
+    for(const auto& test : testSet) {
+        SudokuGridSolver<3> inst(test.puzzle, nullptr);
+        CPPUNIT_ASSERT_EQUAL(test.expected, inst.CountUpTo(test.maxCount));
+    }
+
+    SudokuGridSolver<4> inst(SudokuTestPattern::Grid16String, nullptr);
+    CPPUNIT_ASSERT_EQUAL(static_cast<SudokuPatternCount>(1), inst.CountUpTo(2));
+    return;
+}
+
+#if defined(SUDOKU_SOA_MAP)
+class SudokuSoa16MapTest : public CPPUNIT_NS::TestFixture {
+    CPPUNIT_TEST_SUITE(SudokuSoa16MapTest);
+    CPPUNIT_TEST(test_Preset);
+    CPPUNIT_TEST(test_Print);
+    CPPUNIT_TEST(test_FillCrossing);
+    CPPUNIT_TEST(test_fillDiagonalBars);
+    CPPUNIT_TEST(test_IsFilled);
+    CPPUNIT_TEST(test_SelectBacktrackedCellIndex);
+    CPPUNIT_TEST(test_Exec);
+    CPPUNIT_TEST(test_CountUpTo);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp() override;
+    void tearDown() override;
+
+protected:
+    void test_Preset();
+    void test_Print();
+    void test_FillCrossing();
+    void test_fillDiagonalBars();
+    void test_IsFilled();
+    void test_SelectBacktrackedCellIndex();
+    void test_Exec();
+    void test_CountUpTo();
+
+private:
+    void checkCells(const SudokuSoa16Map& map, const std::string& expectedStr);
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(SudokuSoa16MapTest);
+
+// Call before running a test
+void SudokuSoa16MapTest::setUp() {
+    return;
+}
+
+// Call after running a test
+void SudokuSoa16MapTest::tearDown() {
+    return;
+}
+
+void SudokuSoa16MapTest::checkCells(const SudokuSoa16Map& map, const std::string& expectedStr) {
+    SudokuGridMap<4> expected;
+    expected.Preset(expectedStr);
+    for(SudokuIndex i=0;i<SudokuGeometry<4>::SizeOfAllCells;++i) {
+        CPPUNIT_ASSERT_EQUAL(expected.GetCandidates(i), map.GetCandidates(i));
+    }
+    return;
+}
+
+void SudokuSoa16MapTest::test_Preset() {
+    SudokuSoa16Map map;
+    checkCells(map, "");
+    map.Preset(SudokuTestPattern::Grid16String);
+    checkCells(map, SudokuTestPattern::Grid16String);
+
+    // Pad with blank cells
+    map.Preset("1G");
+    CPPUNIT_ASSERT_EQUAL(static_cast<SudokuCellCandidates>(1), map.GetCandidates(0));
+    CPPUNIT_ASSERT_EQUAL(static_cast<SudokuCellCandidates>(0x8000), map.GetCandidates(1));
+    CPPUNIT_ASSERT_EQUAL(static_cast<SudokuCellCandidates>(0xffff), map.GetCandidates(2));
+    CPPUNIT_ASSERT_EQUAL(static_cast<SudokuCellCandidates>(0xffff), map.GetCandidates(255));
+    return;
+}
+
+void SudokuSoa16MapTest::test_Print() {
+    SudokuSoa16Map map;
+    SudokuGridMap<4> gridMap;
+    map.Preset(SudokuTestPattern::Grid16String);
+    gridMap.Preset(SudokuTestPattern::Grid16String);
+
+    SudokuOutStream expected;
+    SudokuOutStream actual;
+    gridMap.Print(&expected);
+    map.Print(&actual);
+    CPPUNIT_ASSERT(expected.str() == actual.str());
+    return;
+}
+
+void SudokuSoa16MapTest::test_FillCrossing() {
+    SudokuSoa16Map map;
+    CPPUNIT_ASSERT_EQUAL(false, map.FillCrossing());
+    checkCells(map, "");
+
+    // Finds the last number in a column and a row
+    SudokuSoa16Map rowMap;
+    for(SudokuIndex i=0;i<(SudokuGeometry<4>::SizeOfCellsPerGroup - 1);++i) {
+        map.SetUniqueCell(i * SudokuGeometry<4>::SizeOfCellsPerGroup + 1, 1u << i);
+        rowMap.SetUniqueCell(SudokuGeometry<4>::SizeOfCellsPerGroup * 2 + i, 1u << i);
+    }
+    CPPUNIT_ASSERT_EQUAL(false, map.FillCrossing());
+    CPPUNIT_ASSERT_EQUAL(false, rowMap.FillCrossing());
+    CPPUNIT_ASSERT_EQUAL(static_cast<SudokuCellCandidates>(0x8000), map.GetCandidates(15 * 16 + 1));
+    CPPUNIT_ASSERT_EQUAL(static_cast<SudokuCellCandidates>(0x8000), rowMap.GetCandidates(2 * 16 + 15));
+
+    if (DiagonalSudokuMode) {
+        return;
+    }
+
+    // Naked and hidden singles fill some cells at least
+    map.Preset(SudokuTestPattern::Grid16String);
+    const auto filledCount = map.CountFilledCells();
+    CPPUNIT_ASSERT_EQUAL(false, map.FillCrossing());
+    CPPUNIT_ASSERT(map.CountFilledCells() > filledCount);
+    CPPUNIT_ASSERT_EQUAL(map.CountFilledCells() == SudokuGeometry<4>::SizeOfAllCells, map.IsFilled());
+
+    // Two cells in a row hold the same number
+    std::string puzzle(SudokuGeometry<4>::SizeOfAllCells, '.');
+    puzzle.at(0) = 'G';
+    puzzle.at(15) = 'G';
+    map.Preset(puzzle);
+    CPPUNIT_ASSERT_EQUAL(true, map.FillCrossing());
+
+    // Two cells in a box hold the same number
+    puzzle.at(15) = '.';
+    puzzle.at(17) = 'G';
+    map.Preset(puzzle);
+    CPPUNIT_ASSERT_EQUAL(true, map.FillCrossing());
+
+    // A row lacks a number
+    map = SudokuSoa16Map();
+    for(SudokuIndex i=0;i<SudokuGeometry<4>::SizeOfCellsPerGroup;++i) {
+        map.SetUniqueCell(i, 0xfffe);
+    }
+    CPPUNIT_ASSERT_EQUAL(true, map.FillCrossing());
+
+    // Two numbers can be placed only at the first cell of a column
+    map = SudokuSoa16Map();
+    for(SudokuIndex i=1;i<SudokuGeometry<4>::SizeOfGroupsPerMap;++i) {
+        map.SetUniqueCell(i * SudokuGeometry<4>::SizeOfCellsPerGroup, 0xfffc);
+    }
+    CPPUNIT_ASSERT_EQUAL(true, map.FillCrossing());
+    return;
+}
+
+void SudokuSoa16MapTest::test_fillDiagonalBars() {
+    using Geometry = SudokuGeometry<4>;
+    SudokuSoa16Map map;
+    bool changed = false;
+    CPPUNIT_ASSERT_EQUAL(false, map.fillDiagonalBars(changed));
+    CPPUNIT_ASSERT_EQUAL(false, changed);
+
+    // Finds the last number in a bar
+    for(SudokuIndex i=0;i<(Geometry::SizeOfCellsPerGroup - 1);++i) {
+        map.SetUniqueCell(Geometry::GetDiagonalCell(1, i), 1u << i);
+    }
+    CPPUNIT_ASSERT_EQUAL(false, map.fillDiagonalBars(changed));
+    CPPUNIT_ASSERT_EQUAL(true, changed);
+    CPPUNIT_ASSERT_EQUAL(static_cast<SudokuCellCandidates>(0x8000), map.GetCandidates(Geometry::GetDiagonalCell(1, 15)));
+
+    // Two cells in a bar hold the same number
+    map.SetUniqueCell(Geometry::GetDiagonalCell(1, 15), 1);
+    CPPUNIT_ASSERT_EQUAL(true, map.fillDiagonalBars(changed));
+    return;
+}
+
+void SudokuSoa16MapTest::test_IsFilled() {
+    SudokuSoa16Map map;
+    CPPUNIT_ASSERT_EQUAL(false, map.IsFilled());
+    CPPUNIT_ASSERT_EQUAL(static_cast<SudokuIndex>(0), map.CountFilledCells());
+
+    map.Preset(SudokuTestPattern::Grid16Solution);
+    CPPUNIT_ASSERT_EQUAL(true, map.IsFilled());
+    CPPUNIT_ASSERT_EQUAL(static_cast<SudokuIndex>(256), map.CountFilledCells());
+    CPPUNIT_ASSERT(map.IsSolutionOf(SudokuTestPattern::Grid16String) == !DiagonalSudokuMode);
+
+    map.SetUniqueCell(255, 3);
+    CPPUNIT_ASSERT_EQUAL(false, map.IsFilled());
+    CPPUNIT_ASSERT_EQUAL(static_cast<SudokuIndex>(255), map.CountFilledCells());
+    return;
+}
+
+void SudokuSoa16MapTest::test_SelectBacktrackedCellIndex() {
+    SudokuSoa16Map map;
+    CPPUNIT_ASSERT_EQUAL(static_cast<SudokuIndex>(0), map.SelectBacktrackedCellIndex());
+
+    // Skips filled cells
+    map.SetUniqueCell(0, 1);
+    CPPUNIT_ASSERT_EQUAL(static_cast<SudokuIndex>(1), map.SelectBacktrackedCellIndex());
+
+    // Takes the first cell in ties
+    map.SetUniqueCell(40, 0x8007);
+    map.SetUniqueCell(120, 0x8003);
+    map.SetUniqueCell(200, 0x8003);
+    CPPUNIT_ASSERT_EQUAL(static_cast<SudokuIndex>(120), map.SelectBacktrackedCellIndex());
+    map.SetUniqueCell(255, 0x8001);
+    CPPUNIT_ASSERT_EQUAL(static_cast<SudokuIndex>(255), map.SelectBacktrackedCellIndex());
+    return;
+}
+
+void SudokuSoa16MapTest::test_Exec() {
+    {
+        SudokuOutStream sudokuOutStream;
+        SudokuSoa16Solver inst(SudokuTestPattern::Grid16String, &sudokuOutStream);
+        inst.PrintType();
+        CPPUNIT_ASSERT(sudokuOutStream.str() == "[C++ 16x16 with AVX2]\n");
+    }
+
+    if (DiagonalSudokuMode) {
+        return;
+    }
+
+    {
+        SudokuOutStream sudokuOutStream;
+        SudokuSoa16Solver inst(SudokuTestPattern::Grid16String, &sudokuOutStream);
+        CPPUNIT_ASSERT(inst.Exec(true, false));
+        CPPUNIT_ASSERT(inst.count_ >= 1);
+        CPPUNIT_ASSERT(inst.IsSolutionOf(SudokuTestPattern::Grid16String));
+        checkCells(inst.map_, SudokuTestPattern::Grid16Solution);
+    }
+
+    // Two cells in a column hold the same number
+    std::string puzzle(SudokuGeometry<4>::SizeOfAllCells, '.');
+    puzzle.at(0) = 'G';
+    puzzle.at(240) = 'G';
+    SudokuSoa16Solver inst(puzzle, nullptr);
+    CPPUNIT_ASSERT(!inst.Exec(true, false));
+    return;
+}
+
+void SudokuSoa16MapTest::test_CountUpTo() {
+    if (DiagonalSudokuMode) {
+        return;
+    }
+
+    SudokuSoa16Solver inst(SudokuTestPattern::Grid16String, nullptr);
+    CPPUNIT_ASSERT_EQUAL(static_cast<SudokuPatternCount>(1), inst.CountUpTo(2));
+
+    // Keeps the puzzle
+    CPPUNIT_ASSERT(inst.Exec(true, false));
+    CPPUNIT_ASSERT(inst.IsSolutionOf(SudokuTestPattern::Grid16String));
+
+    SudokuSoa16Solver blank("", nullptr);
+    CPPUNIT_ASSERT_EQUAL(static_cast<SudokuPatternCount>(2), blank.CountUpTo(2));
+    return;
+}
+#endif
+
 /*
 Local Variables:
 mode: c++
@@ -17,8 +17,10 @@ public:
     SudokuSolverCommonTest(std::shared_ptr<TestedT>& pInst);
     virtual ~SudokuSolverCommonTest();
     void test_Exec();
+    void test_Reset();
     void test_PrintType(const char *pExpectedStr);
     void test_solve();
+    void test_solveWithSubsets();
     bool call_fillCells(SudokuSolver& inst);
     bool call_fillCells(SudokuSseSolver& inst);
     void test_fillCells();
@@ -26,7 +28,9 @@ public:
 
 private:
     void exec(const SudokuTestPattern::TestSet& test);
+    void reset(const SudokuTestPattern::TestSet& test, TestedT& resetInst, SudokuOutStream& resetOutStream);
     void solve(const SudokuTestPattern::TestSet& test);
+    void solveWithSubsets(const SudokuTestPattern::TestSet& test);
     void fillCells(const SudokuTestPattern::TestSet& test);
     void checkCells(TestedT *pInst, const SudokuIndex* expectedIndexes);
     bool filterRetvalFillCells(bool original);
@@ -38,8 +42,10 @@ class SudokuSolverTest : public CPPUNIT_NS::TestFixture {
     CPPUNIT_TEST_SUITE(SudokuSolverTest);
     CPPUNIT_TEST(test_Constructor);
     CPPUNIT_TEST(test_Exec);
+    CPPUNIT_TEST(test_Reset);
     CPPUNIT_TEST(test_PrintType);
     CPPUNIT_TEST(test_solve);
+    CPPUNIT_TEST(test_solveWithSubsets);
     CPPUNIT_TEST(test_fillCells);
     CPPUNIT_TEST_SUITE_END();
 
@@ -49,8 +55,10 @@ public:
 protected:
     void test_Constructor();
     void test_Exec();
+    void test_Reset();
     void test_PrintType();
     void test_solve();
+    void test_solveWithSubsets();
     void test_fillCells();
 private:
     void verifyTestVector(void);
@@ -66,10 +74,16 @@ class SudokuSseSolverTest : public CPPUNIT_NS::TestFixture {
     CPPUNIT_TEST_SUITE(SudokuSseSolverTest);
     CPPUNIT_TEST(test_Constructor);
     CPPUNIT_TEST(test_Exec);
+    CPPUNIT_TEST(test_Reset);
     CPPUNIT_TEST(test_Enumerate);
     CPPUNIT_TEST(test_PrintType);
     CPPUNIT_TEST(test_solve);
+    CPPUNIT_TEST(test_solveWithSubsets);
     CPPUNIT_TEST(test_fillCells);
+    CPPUNIT_TEST(test_searchCells);
+    CPPUNIT_TEST(test_FindNextCell);
+    CPPUNIT_TEST(test_SolveLanes);
+    CPPUNIT_TEST(test_SolveWithIntrinsics);
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -79,10 +93,16 @@ public:
 protected:
     void test_Constructor();
     void test_Exec();
+    void test_Reset();
     void test_Enumerate();
     void test_PrintType();
     void test_solve();
+    void test_solveWithSubsets();
     void test_fillCells();
+    void test_searchCells();
+    void test_FindNextCell();
+    void test_SolveLanes();
+    void test_SolveWithIntrinsics();
 
 private:
     std::unique_ptr<SudokuOutStream> pSudokuOutStream_;  // destination to write strings
@@ -229,6 +249,47 @@ void SudokuSolverCommonTest<TestedT, CandidatesT>::test_Exec() {
     return;
 }
 
+template <class TestedT, class CandidatesT>
+void SudokuSolverCommonTest<TestedT, CandidatesT>::reset(const SudokuTestPattern::TestSet& test,
+                                                        TestedT& resetInst, SudokuOutStream& resetOutStream) {
+    SudokuOutStream sudokuOutStream;
+    TestedT inst(test.presetStr, 0, &sudokuOutStream, 0);
+    const auto expected = inst.Exec(false, false);
+
+    resetOutStream.str("");
+    resetInst.Reset(test.presetStr);
+    CPPUNIT_ASSERT_EQUAL(0, resetInst.GetStepCount());
+    CPPUNIT_ASSERT_EQUAL(0, resetInst.GetGuessCount());
+    CPPUNIT_ASSERT_EQUAL(expected, resetInst.Exec(false, false));
+    CPPUNIT_ASSERT_EQUAL(sudokuOutStream.str(), resetOutStream.str());
+    CPPUNIT_ASSERT_EQUAL(inst.GetStepCount(), resetInst.GetStepCount());
+    CPPUNIT_ASSERT_EQUAL(inst.GetGuessCount(), resetInst.GetGuessCount());
+    return;
+}
+
+// A reset solver solves puzzles one after another as new solvers do
+template <class TestedT, class CandidatesT>
+void SudokuSolverCommonTest<TestedT, CandidatesT>::test_Reset() {
+    SudokuOutStream resetOutStream;
+    TestedT resetInst(SudokuTestPattern::BacktrackString, 0, &resetOutStream, 0);
+    resetInst.Exec(false, false);
+
+    // Solves conflicted puzzles between others
+    for(size_t round=0; round<2; ++round) {
+        if (DiagonalSudokuMode) {
+            for(const auto& test : SudokuTestPattern::testSetDiagonal) {
+                reset(test, resetInst, resetOutStream);
+            }
+        } else {
+            for(const auto& test : SudokuTestPattern::testSet) {
+                reset(test, resetInst, resetOutStream);
+            }
+        }
+    }
+
+    return;
+}
+
 template <class TestedT, class CandidatesT>
 void SudokuSolverCommonTest<TestedT, CandidatesT>::test_PrintType(const char *pExpectedStr) {
     pInstance_->PrintType();
@@ -268,6 +329,37 @@ void SudokuSolverCommonTest<TestedT, CandidatesT>::test_solve() {
     return;
 }
 
+template <class TestedT, class CandidatesT>
+void SudokuSolverCommonTest<TestedT, CandidatesT>::solveWithSubsets(const SudokuTestPattern::TestSet& test) {
+    // Destroy after destructing an instance which uses 'sudokuOutStream'
+    SudokuOutStream sudokuOutStream;
+    {
+        TestedT inst(test.presetStr, 0, &sudokuOutStream, 0);
+        CPPUNIT_ASSERT_EQUAL(test.result, inst.solve(inst.map_, true, false));
+        if (test.result) {
+            checkCells(&inst, test.resultNum);
+        }
+    }
+    return;
+}
+
+template <class TestedT, class CandidatesT>
+void SudokuSolverCommonTest<TestedT, CandidatesT>::test_solveWithSubsets() {
+    // Finding subsets must lead the same solutions
+    Sudoku::SetSubsetElimination(true);
+    if (DiagonalSudokuMode) {
+        for(const auto& test : SudokuTestPattern::testSetDiagonal) {
+            solveWithSubsets(test);
+        }
+    } else {
+        for(const auto& test : SudokuTestPattern::testSet) {
+            solveWithSubsets(test);
+        }
+    }
+    Sudoku::SetSubsetElimination(false);
+    return;
+}
+
 template <>
 bool SudokuSolverCommonTest<SudokuSolver, SudokuCellCandidates>::filterRetvalFillCells(bool original) {
     return original;
@@ -341,6 +433,11 @@ void SudokuSolverTest::test_Exec() {
     return;
 }
 
+void SudokuSolverTest::test_Reset() {
+    pCommonTester_->test_Reset();
+    return;
+}
+
 void SudokuSolverTest::test_PrintType() {
     pCommonTester_->test_PrintType("[C++]\n");
     return;
@@ -351,6 +448,11 @@ void SudokuSolverTest::test_solve() {
     return;
 }
 
+void SudokuSolverTest::test_solveWithSubsets() {
+    pCommonTester_->test_solveWithSubsets();
+    return;
+}
+
 void SudokuSolverTest::test_fillCells() {
     pCommonTester_->test_fillCells();
     return;
@@ -391,6 +493,11 @@ void SudokuSseSolverTest::test_Exec() {
     return;
 }
 
+void SudokuSseSolverTest::test_Reset() {
+    pCommonTester_->test_Reset();
+    return;
+}
+
 void SudokuSseSolverTest::test_Enumerate() {
     const std::string presetStr = "123456789456789123789123456295874631.............................................";
     SudokuSseSolver solver(presetStr, pSudokuOutStream_.get(), 1);
@@ -433,11 +540,111 @@ void SudokuSseSolverTest::test_solve() {
     return;
 }
 
+void SudokuSseSolverTest::test_solveWithSubsets() {
+    pCommonTester_->test_solveWithSubsets();
+    return;
+}
+
 void SudokuSseSolverTest::test_fillCells() {
     pCommonTester_->test_fillCells();
     return;
 }
 
+void SudokuSseSolverTest::test_searchCells() {
+    // Backtracking in assembly must take the same steps as recursive calls in C++
+    const std::string presetStrSet[] {SudokuTestPattern::NoBacktrackString, SudokuTestPattern::BacktrackString,
+            SudokuTestPattern::ConflictString, SudokuTestPattern::DiagonalSudokuString1};
+    for(const auto& presetStr : presetStrSet) {
+        SudokuOutStream sudokuOutStream;
+        SudokuSseSolver expected(presetStr, &sudokuOutStream, 0);
+        SudokuSseSolver actual(presetStr, &sudokuOutStream, 0);
+
+        const auto expectedResult = expected.solve(expected.map_, true, true);
+        CPPUNIT_ASSERT_EQUAL(expectedResult, actual.searchCells(actual.map_));
+        CPPUNIT_ASSERT_EQUAL(expected.count_, actual.count_);
+        if (expectedResult) {
+            for(size_t i=0; i<arraySizeof(expected.map_.xmmRegSet_.regVal_); ++i) {
+                CPPUNIT_ASSERT_EQUAL(expected.map_.xmmRegSet_.regVal_[i], actual.map_.xmmRegSet_.regVal_[i]);
+            }
+        }
+    }
+    return;
+}
+
+void SudokuSseSolverTest::test_FindNextCell() {
+    // Must choose the same cell as the assembly does
+    const std::string presetStrSet[] {SudokuTestPattern::NoBacktrackString, SudokuTestPattern::BacktrackString,
+            SudokuTestPattern::BacktrackString2, SudokuTestPattern::ConflictString};
+    for(const auto& presetStr : presetStrSet) {
+        SudokuSseMap map;
+        map.Preset(presetStr);
+        SudokuSseMapResult result;
+        map.FillCrossing(true, result);
+        if (result.aborted) {
+            continue;
+        }
+
+        SudokuSseCandidateCell expected;
+        SudokuSseCandidateCell actual;
+        const auto expectedFound = map.GetNextCell(result, expected);
+        CPPUNIT_ASSERT_EQUAL(expectedFound, map.FindNextCell(actual));
+        if (expectedFound) {
+            CPPUNIT_ASSERT_EQUAL(expected.regIndex, actual.regIndex);
+            CPPUNIT_ASSERT_EQUAL(expected.shift, actual.shift);
+            CPPUNIT_ASSERT_EQUAL(expected.mask, actual.mask);
+        }
+    }
+    return;
+}
+
+void SudokuSseSolverTest::test_SolveLanes() {
+    if (!SudokuSseLaneSolver::CanSolve()) {
+        return;
+    }
+
+    // Solving puzzles in lanes must get the same solutions as solving one by one.
+    // An odd number of puzzles leaves some lanes idle. The last puzzle has multiple
+    // solutions and lanes find the same one only if they remove locked candidates.
+    const std::string presetStrSet[] {SudokuTestPattern::NoBacktrackString, SudokuTestPattern::BacktrackString,
+            SudokuTestPattern::ConflictString, SudokuTestPattern::BacktrackString2, SudokuTestPattern::BacktrackString,
+            "0000000000000003085001020000000507000004000100090000000500000073002010000000040009"};
+
+    // Run two lanes in YMM registers and four lanes in ZMM registers if available
+    const size_t laneCntSet[] {2, SudokuSseLaneSolver::GetLaneCount()};
+    for(const auto laneCnt : laneCntSet) {
+        std::vector<SudokuSseMap> mapSet(arraySizeof(presetStrSet));
+        for(size_t i=0; i<arraySizeof(presetStrSet); ++i) {
+            mapSet.at(i).Preset(presetStrSet[i]);
+        }
+
+        SudokuSseLaneSolver solver;
+        solver.laneCnt_ = laneCnt;
+        SudokuPuzzleCount expectedCnt = 0;
+        const auto actualCnt = solver.Solve(mapSet);
+
+        for(size_t i=0; i<arraySizeof(presetStrSet); ++i) {
+            SudokuOutStream sudokuOutStream;
+            SudokuSseSolver expected(presetStrSet[i], &sudokuOutStream, 0);
+            const auto solved = expected.solve(expected.map_, true, true);
+            if (!solved) {
+                continue;
+            }
+
+            ++expectedCnt;
+            const auto& actual = mapSet.at(i);
+            for(size_t j=SudokuSseMap::InitialRegisterNum * SudokuSse::RegisterWordCnt;
+                j<(SudokuSseMap::InitialRegisterNum + Sudoku::SizeOfGroupsPerMap) * SudokuSse::RegisterWordCnt; ++j) {
+                CPPUNIT_ASSERT_EQUAL(expected.map_.xmmRegSet_.regVal_[j], actual.xmmRegSet_.regVal_[j]);
+            }
+        }
+
+        CPPUNIT_ASSERT_EQUAL(expectedCnt, actualCnt);
+        CPPUNIT_ASSERT(expectedCnt > 0);
+    }
+
+    return;
+}
+
 /*
 Local Variables:
 mode: c++
@@ -446,3 +653,61 @@ tab-width: nil
 c-file-style: "stroustrup"
 End:
 */
+
+void SudokuSseSolverTest::test_SolveWithIntrinsics() {
+    // Intrinsics must fill the same cells and take the same steps as the assembly
+    const std::string presetStrSet[] {SudokuTestPattern::NoBacktrackString, SudokuTestPattern::BacktrackString,
+            SudokuTestPattern::BacktrackString2, SudokuTestPattern::ConflictString,
+            SudokuTestPattern::DiagonalSudokuString1};
+    for(const auto& presetStr : presetStrSet) {
+        SudokuSseMap expectedMap;
+        SudokuSseMap actualMap;
+        expectedMap.Preset(presetStr);
+        actualMap.Preset(presetStr);
+        SudokuSseMapResult expectedResult;
+        SudokuSseMapResult actualResult;
+        expectedMap.FillCrossing(true, expectedResult);
+        actualMap.FillCrossingWithIntrinsics(actualResult);
+        CPPUNIT_ASSERT_EQUAL(expectedResult.aborted, actualResult.aborted);
+        if (expectedResult.aborted) {
+            continue;
+        }
+
+        CPPUNIT_ASSERT_EQUAL(expectedResult.elementCnt, actualResult.elementCnt);
+        CPPUNIT_ASSERT_EQUAL(expectedResult.nextCellFound, actualResult.nextCellFound);
+        if (expectedResult.nextCellFound) {
+            CPPUNIT_ASSERT_EQUAL(expectedResult.nextOutBoxIndex, actualResult.nextOutBoxIndex);
+            CPPUNIT_ASSERT_EQUAL(expectedResult.nextInBoxIndex, actualResult.nextInBoxIndex);
+            CPPUNIT_ASSERT_EQUAL(expectedResult.nextRowNumber, actualResult.nextRowNumber);
+        }
+
+        // The assembly also leaves its work registers
+        const size_t rowBegin = SudokuSseMap::InitialRegisterNum * SudokuSse::RegisterWordCnt;
+        const size_t rowEnd = rowBegin + Sudoku::SizeOfGroupsPerMap * SudokuSse::RegisterWordCnt;
+        for(size_t i=rowBegin; i<rowEnd; ++i) {
+            CPPUNIT_ASSERT_EQUAL(expectedMap.xmmRegSet_.regVal_[i], actualMap.xmmRegSet_.regVal_[i]);
+        }
+    }
+
+    for(const auto& presetStr : presetStrSet) {
+        SudokuOutStream sudokuOutStream;
+        SudokuSseSolver expected(presetStr, &sudokuOutStream, 0);
+        SudokuSseIntrinsicsSolver actual(presetStr, &sudokuOutStream);
+        const auto expectedResult = expected.searchCells(expected.map_);
+        CPPUNIT_ASSERT_EQUAL(expectedResult, actual.Exec(true, false));
+        CPPUNIT_ASSERT_EQUAL(expected.count_, actual.count_);
+        if (expectedResult) {
+            const size_t rowBegin = SudokuSseMap::InitialRegisterNum * SudokuSse::RegisterWordCnt;
+            const size_t rowEnd = rowBegin + Sudoku::SizeOfGroupsPerMap * SudokuSse::RegisterWordCnt;
+            for(size_t i=rowBegin; i<rowEnd; ++i) {
+                CPPUNIT_ASSERT_EQUAL(expected.map_.xmmRegSet_.regVal_[i], actual.map_.xmmRegSet_.regVal_[i]);
+            }
+        }
+    }
+
+    SudokuOutStream sudokuOutStream;
+    SudokuSseIntrinsicsSolver solver(SudokuTestPattern::NoBacktrackString, &sudokuOutStream);
+    solver.PrintType();
+    CPPUNIT_ASSERT_EQUAL(std::string("[SSE 4.2 intrinsics]\n"), sudokuOutStream.str());
+    return;
+}
@@ -5,9 +5,12 @@
 // http://www.atmarkit.co.jp/fdotnet/cpptest/cpptest02/cpptest02_03.html
 
 #include <cppunit/extensions/HelperMacros.h>
+#include <algorithm>
 #include <cassert>
 #include <cstring>
+#include <future>
 #include <memory>
+#include <vector>
 #include "sudoku.h"
 #include "sudokutest.h"
 
@@ -20,7 +23,7 @@ class SudokuSseEnumeratorMapTest : public CPPUNIT_NS::TestFixture {
     CPPUNIT_TEST(test_Print);
     CPPUNIT_TEST(test_PrintFromAsm);
     CPPUNIT_TEST(test_Enumerate);
-    CPPUNIT_TEST(test_GetInstance);
+    CPPUNIT_TEST(test_EnumerateConcurrently);
     CPPUNIT_TEST(test_powerOfTwoPlusOne);
     CPPUNIT_TEST_SUITE_END();
 
@@ -35,7 +38,7 @@ protected:
     void test_Print();
     void test_PrintFromAsm();
     void test_Enumerate();
-    void test_GetInstance();
+    void test_EnumerateConcurrently();
     void test_powerOfTwoPlusOne();
 private:
     std::unique_ptr<SudokuSseEnumeratorMap> pInstance_;
@@ -44,6 +47,46 @@ private:
 
 CPPUNIT_TEST_SUITE_REGISTRATION( SudokuSseEnumeratorMapTest );
 
+class SudokuSseMapEnumeratorTest : public CPPUNIT_NS::TestFixture {
+    CPPUNIT_TEST_SUITE(SudokuSseMapEnumeratorTest);
+    CPPUNIT_TEST(test_Enumerate);
+    CPPUNIT_TEST(test_SetMaxCount);
+    CPPUNIT_TEST(test_IsSuitable);
+    CPPUNIT_TEST(test_printSolution);
+    CPPUNIT_TEST(test_getCandidates);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp() override {}
+    void tearDown() override {}
+protected:
+    void test_Enumerate();
+    void test_SetMaxCount();
+    void test_IsSuitable();
+    void test_printSolution();
+    void test_getCandidates();
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION( SudokuSseMapEnumeratorTest );
+
+class SudokuSseParallelEnumeratorTest : public CPPUNIT_NS::TestFixture {
+    CPPUNIT_TEST_SUITE(SudokuSseParallelEnumeratorTest);
+    CPPUNIT_TEST(test_Constructor);
+    CPPUNIT_TEST(test_canSetCell);
+    CPPUNIT_TEST(test_Enumerate);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp() override {}
+    void tearDown() override {}
+protected:
+    void test_Constructor();
+    void test_canSetCell();
+    void test_Enumerate();
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION( SudokuSseParallelEnumeratorTest );
+
 class SudokuSseTest : public CPPUNIT_NS::TestFixture {
     CPPUNIT_TEST_SUITE(SudokuSseTest);
     CPPUNIT_TEST(test_Compare);
@@ -88,6 +131,7 @@ class SudokuSseTest : public CPPUNIT_NS::TestFixture {
     CPPUNIT_TEST(test_CheckDiagonalThreeCells);
     CPPUNIT_TEST(test_CheckDiagonalNineCells);
     CPPUNIT_TEST(test_CheckConsistency);
+    CPPUNIT_TEST(test_FindLockedCandidates);
     CPPUNIT_TEST(test_FastCollectCandidatesAtRow);
     CPPUNIT_TEST(test_FastCollectCandidatesAtBox);
     CPPUNIT_TEST(test_FastCollectCandidatesAtColumn);
@@ -140,6 +184,7 @@ protected:
     void test_CheckDiagonalThreeCells();
     void test_CheckDiagonalNineCells();
     void test_CheckConsistency();
+    void test_FindLockedCandidates();
     void test_FastCollectCandidatesAtRow();
     void test_FastCollectCandidatesAtBox();
     void test_FastCollectCandidatesAtColumn();
@@ -208,18 +253,22 @@ void SudokuSseEnumeratorMapTest::test_Constructor() {
         CPPUNIT_ASSERT_EQUAL(static_cast<SudokuCellCandidates>(0), pInstance_->rightBottomElement_);
         CPPUNIT_ASSERT_EQUAL(static_cast<gRegister>(0), pInstance_->firstCell_);
         CPPUNIT_ASSERT_EQUAL(static_cast<SudokuPatternCount>(0), pInstance_->patternNumber_);
-        CPPUNIT_ASSERT_EQUAL(pInstance_.get(), pInstance_->pInstance_);
+        CPPUNIT_ASSERT_EQUAL(pInstance_.get(), pInstance_->context_.pInstance);
 
         for(const auto& regVal : pInstance_->xmmRegSet_.regVal_) {
             CPPUNIT_ASSERT_EQUAL(static_cast<SudokuSseElement>(0), regVal);
         }
 
-        const uint64_t actual = sudokuXmmPrintAllCandidate;
+        const uint64_t actual = pInstance_->context_.printAllCandidate;
         constexpr decltype(actual) expected = 0ull;
         CPPUNIT_ASSERT_EQUAL(expected, actual);
     } while(0);
 
-    CPPUNIT_ASSERT_EQUAL(pInstance_.get(), SudokuSseEnumeratorMap::pInstance_);
+    // Each instance has its own context
+    SudokuOutStream sudokuOutStream;
+    SudokuSseEnumeratorMap map(&sudokuOutStream);
+    CPPUNIT_ASSERT_EQUAL(&map, map.context_.pInstance);
+    CPPUNIT_ASSERT_EQUAL(pInstance_.get(), pInstance_->context_.pInstance);
 }
 
 void SudokuSseEnumeratorMapTest::test_SetToPrint() {
@@ -227,7 +276,7 @@ void SudokuSseEnumeratorMapTest::test_SetToPrint() {
 
     for(const auto& expected : testSet) {
         pInstance_->SetToPrint(expected);
-        const auto actual = sudokuXmmPrintAllCandidate;
+        const auto actual = pInstance_->context_.printAllCandidate;
         CPPUNIT_ASSERT_EQUAL(expected, actual);
     }
 }
@@ -340,7 +389,7 @@ void SudokuSseEnumeratorMapTest::test_Print() {
                       "Unexpected test.expextedRegVal and map.xmmRegSet_ size");
         ::memmove(&(xmmRegSet.regXmmVal_[SudokuSseEnumeratorMap::InitialRegisterNum]),
                   test.expextedRegVal, sizeof(test.expextedRegVal));
-        sudokuXmmRightBottomSolved = test.rightBottomElement;
+        map.context_.rightBottomSolved = test.rightBottomElement;
 
         map.Print(true, xmmRegSet);
         std::string expected(test.expctedPrintSolved);
@@ -381,7 +430,7 @@ void SudokuSseEnumeratorMapTest::test_PrintFromAsm() {
         SudokuOutStream sudokuOutStream;
         SudokuSseEnumeratorMap map(&sudokuOutStream);
         map.patternNumber_ = i;
-        sudokuXmmPrintAllCandidate = maxCount;
+        map.SetToPrint(maxCount);
 
         map.PrintFromAsm(xmmRegSet);
         if (i >= maxCount) {
@@ -395,12 +444,12 @@ void SudokuSseEnumeratorMapTest::test_PrintFromAsm() {
         SudokuOutStream sudokuOutStream;
         SudokuSseEnumeratorMap map(&sudokuOutStream);
         map.patternNumber_ = 9875;
-        sudokuXmmPrintAllCandidate = 10000;
+        map.SetToPrint(10000);
 
         static_assert(sizeof(test.expextedRegVal) < sizeof(xmmRegSet), "Unexpected test.expextedRegVal and xmmRegSet");
         ::memmove(&(xmmRegSet.regXmmVal_[SudokuSseEnumeratorMap::InitialRegisterNum]),
                   test.expextedRegVal, sizeof(test.expextedRegVal));
-        sudokuXmmRightBottomSolved = test.rightBottomElement;
+        map.context_.rightBottomSolved = test.rightBottomElement;
         map.PrintFromAsm(xmmRegSet);
 
         std::string expected("[Solution 9876]\n");
@@ -423,8 +472,37 @@ void SudokuSseEnumeratorMapTest::test_Enumerate() {
     }
 }
 
-void SudokuSseEnumeratorMapTest::test_GetInstance() {
-    CPPUNIT_ASSERT_EQUAL(pInstance_.get(), SudokuSseEnumeratorMap::GetInstance());
+void SudokuSseEnumeratorMapTest::test_EnumerateConcurrently() {
+    struct TestSet {
+        size_t blankCells;
+        SudokuPatternCount expected;
+    };
+
+    constexpr TestSet testSet[] {{16, 2}, {18, 4}, {23, 8}, {24, 12}, {25, 48}, {26, 96}, {27, 288}};
+    const std::string solutionStr = "835126749416397258792548631643912875981754362527683194269835417178469523354271986";
+    static_assert(sizeof(sudokuXmmPrintFunc) == sizeof(&PrintPattern), "Unexpected uintptr_t size");
+    sudokuXmmPrintFunc = reinterpret_cast<uintptr_t>(&PrintPattern);
+
+    // Counts and prints solutions of puzzles on threads at the same time
+    constexpr size_t repeatCount = 4;
+    for(size_t i=0; i<repeatCount; ++i) {
+        std::vector<std::future<bool>> futureSet;
+        for(const auto& test : testSet) {
+            futureSet.push_back(std::async(std::launch::async, [&solutionStr, test]() {
+                        SudokuOutStream sudokuOutStream;
+                        SudokuSseEnumeratorMap map(&sudokuOutStream);
+                        map.Preset(solutionStr.substr(0, solutionStr.size() - test.blankCells));
+                        map.SetToPrint(1);
+                        const auto actual = map.Enumerate();
+                        const auto found = (sudokuOutStream.str().find("[Solution 1]\n") != std::string::npos);
+                        return (test.expected == actual) && found;
+                    }));
+        }
+
+        for(auto& result : futureSet) {
+            CPPUNIT_ASSERT(result.get());
+        }
+    }
 }
 
 void SudokuSseEnumeratorMapTest::test_powerOfTwoPlusOne() {
@@ -442,6 +520,217 @@ void SudokuSseEnumeratorMapTest::test_powerOfTwoPlusOne() {
     }
 }
 
+namespace {
+    const std::string SolutionOfQuiz2 = "835126749416397258792548631643912875981754362527683194269835417178469523354271986";
+}
+
+void SudokuSseMapEnumeratorTest::test_Enumerate() {
+    // Solutions of original Sudoku puzzles are not always solutions of diagonal Sudoku puzzles
+    if (DiagonalSudokuMode) {
+        return;
+    }
+
+    struct TestSet {
+        const char* presetStr;
+        SudokuPatternCount expected;
+    };
+
+    // Preset cells are scattered
+    const TestSet testSet[] {
+        {SolutionOfQuiz2.c_str(), 1},
+        {"83...6....1..9.258..25486...43.128....17.43625..68.1....9....1...8....23..42...8.", 7},
+        {"83.1..7......97.58.....8.3.6......7..8...4.6.5.....1...698...17...46.5.....2.1.8.", 21},
+        {".....6..9.1..97...7..54.6316.3.1..7.981..43.2....8.1.....8...171.......335..719..", 18},
+        {"83.12.7.....39..5.792..8.....39.287..81.5436..2.6...942.9....1...84.9..33...71..6", 1},
+        {"88...............................................................................", 0}};
+
+    for(const auto& test : testSet) {
+        SudokuSseMap map;
+        map.Preset(test.presetStr);
+        SudokuSseMapEnumerator enumerator(nullptr, 0);
+        CPPUNIT_ASSERT_EQUAL(test.expected, enumerator.Enumerate(map));
+
+        // Counts the same number of solutions in the original enumerator
+        if ((test.expected > 0) && (sudokuXmmAssumeCellsPacked == 0)) {
+            SudokuOutStream sudokuOutStream;
+            SudokuSseEnumeratorMap enumeratorMap(&sudokuOutStream);
+            enumeratorMap.Preset(test.presetStr);
+            CPPUNIT_ASSERT_EQUAL(test.expected, enumeratorMap.Count());
+        }
+    }
+}
+
+void SudokuSseMapEnumeratorTest::test_SetMaxCount() {
+    if (DiagonalSudokuMode) {
+        return;
+    }
+
+    struct TestSet {
+        const char* presetStr;
+        SudokuPatternCount maxCount;
+        SudokuPatternCount expected;
+    };
+
+    const TestSet testSet[] {
+        {SolutionOfQuiz2.c_str(), 0, 0},
+        {SolutionOfQuiz2.c_str(), 2, 1},
+        {"83...6....1..9.258..25486...43.128....17.43625..68.1....9....1...8....23..42...8.", 1, 1},
+        {"83...6....1..9.258..25486...43.128....17.43625..68.1....9....1...8....23..42...8.", 2, 2},
+        {"83...6....1..9.258..25486...43.128....17.43625..68.1....9....1...8....23..42...8.", 7, 7},
+        {"83...6....1..9.258..25486...43.128....17.43625..68.1....9....1...8....23..42...8.", 8, 7},
+        {"88...............................................................................", 2, 0}};
+
+    for(const auto& test : testSet) {
+        SudokuSseMap map;
+        map.Preset(test.presetStr);
+        SudokuOutStream sudokuOutStream;
+        SudokuSseMapEnumerator enumerator(&sudokuOutStream, 0);
+        enumerator.SetMaxCount(test.maxCount);
+        CPPUNIT_ASSERT_EQUAL(test.expected, enumerator.Enumerate(map));
+        // Resets the count for each puzzle
+        CPPUNIT_ASSERT_EQUAL(test.expected, enumerator.Enumerate(map));
+    }
+}
+
+void SudokuSseMapEnumeratorTest::test_IsSuitable() {
+    struct TestSet {
+        std::string presetStr;
+        bool expected;
+    };
+
+    const TestSet testSet[] {
+        {"", false}, {"1", false}, {SolutionOfQuiz2, false},
+        {SolutionOfQuiz2.substr(0, 40), false},
+        {".2", true}, {"1.3", true},
+        {SolutionOfQuiz2.substr(0, 79) + ".6", true}};
+
+    for(const auto& test : testSet) {
+        SudokuSseMap map;
+        map.Preset(test.presetStr);
+        CPPUNIT_ASSERT_EQUAL(test.expected && !DiagonalSudokuMode, SudokuSseMapEnumerator::IsSuitable(map));
+    }
+}
+
+void SudokuSseMapEnumeratorTest::test_printSolution() {
+    // Solutions of original Sudoku puzzles are not always solutions of diagonal Sudoku puzzles
+    if (DiagonalSudokuMode) {
+        return;
+    }
+
+    const std::string presetStr = "83...6....1..9.258..25486...43.128....17.43625..68.1....9....1...8....23..42...8.";
+    for(SudokuPatternCount printAllCandidate=0; printAllCandidate<9; printAllCandidate+=2) {
+        SudokuOutStream sudokuOutStream;
+        SudokuSseMap map;
+        map.Preset(presetStr);
+        SudokuSseMapEnumerator enumerator(&sudokuOutStream, printAllCandidate);
+        CPPUNIT_ASSERT_EQUAL(static_cast<SudokuPatternCount>(7), enumerator.Enumerate(map));
+
+        // Prints solutions up to the number
+        const auto expected = std::min(printAllCandidate, static_cast<SudokuPatternCount>(7));
+        const auto str = sudokuOutStream.str();
+        CPPUNIT_ASSERT_EQUAL(static_cast<ptrdiff_t>(expected), std::count(str.begin(), str.end(), '['));
+        CPPUNIT_ASSERT_EQUAL(static_cast<ptrdiff_t>(expected * (Sudoku::SizeOfGroupsPerMap + 1)),
+                             std::count(str.begin(), str.end(), '\n'));
+    }
+
+    SudokuOutStream sudokuOutStream;
+    SudokuSseMap map;
+    map.Preset(SolutionOfQuiz2);
+    SudokuSseMapEnumerator enumerator(&sudokuOutStream, 1);
+    enumerator.Enumerate(map);
+    std::string expected = "[Solution 1]\n";
+    expected += "8:3:5:1:2:6:7:4:9\n4:1:6:3:9:7:2:5:8\n7:9:2:5:4:8:6:3:1\n6:4:3:9:1:2:8:7:5\n9:8:1:7:5:4:3:6:2\n";
+    expected += "5:2:7:6:8:3:1:9:4\n2:6:9:8:3:5:4:1:7\n1:7:8:4:6:9:5:2:3\n3:5:4:2:7:1:9:8:6\n";
+    CPPUNIT_ASSERT_EQUAL(expected, sudokuOutStream.str());
+}
+
+void SudokuSseMapEnumeratorTest::test_getCandidates() {
+    SudokuSseMap map;
+    map.Preset(SolutionOfQuiz2);
+    for(SudokuLoopIndex i=0; i<Sudoku::SizeOfAllCells; ++i) {
+        const SudokuSseElement expected = 1 << (SolutionOfQuiz2[i] - '1');
+        CPPUNIT_ASSERT_EQUAL(expected, SudokuSseMapEnumerator::getCandidates(map, i));
+    }
+
+    map.Preset("");
+    for(SudokuLoopIndex i=0; i<Sudoku::SizeOfAllCells; ++i) {
+        CPPUNIT_ASSERT_EQUAL(static_cast<SudokuSseElement>(Sudoku::AllCandidates), SudokuSseMapEnumerator::getCandidates(map, i));
+    }
+}
+
+void SudokuSseParallelEnumeratorTest::test_Constructor() {
+    struct TestSet {
+        const char* presetStr;
+        SudokuIndex splitDepth;
+        SudokuPuzzleCount expected;
+    };
+
+    constexpr TestSet testSet[] {
+        {"", 0, 1}, {"", 1, 9}, {"", 2, 72}, {"", 3, 504},
+        {"12", 1, 7}, {"12.4", 1, 6}, {"12.4", 2, 30},
+        {"835126749416397258792548631643912875981754362527683194269835417178469523354271986", 4, 1},
+        {"83512674941639725879254863164391287598175436252768319426983541717846952335427198.", 4, 1}};
+
+    for(const auto& test : testSet) {
+        SudokuSseParallelEnumerator enumerator(test.presetStr, test.splitDepth);
+        CPPUNIT_ASSERT_EQUAL(test.expected, enumerator.GetSubtreeCount());
+        for(const auto& subtree : enumerator.subtreeSet_) {
+            CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(Sudoku::SizeOfAllCells), subtree.size());
+        }
+    }
+
+    SudokuSseParallelEnumerator enumerator("1", 1);
+    CPPUNIT_ASSERT_EQUAL(static_cast<SudokuPuzzleCount>(8), enumerator.GetSubtreeCount());
+    CPPUNIT_ASSERT(enumerator.subtreeSet_.at(0).substr(0, 3) == "12.");
+    CPPUNIT_ASSERT(enumerator.subtreeSet_.at(7).substr(0, 3) == "19.");
+}
+
+void SudokuSseParallelEnumeratorTest::test_canSetCell() {
+    struct TestSet {
+        SudokuLoopIndex cellIndex;
+        char cell;
+        bool expected;
+    };
+
+    // 1 at the top-left corner, 2 at the center of the puzzle and 3 at the bottom-right corner
+    std::string puzzle(Sudoku::SizeOfAllCells, '.');
+    puzzle[0] = '1';
+    puzzle[40] = '2';
+    puzzle[80] = '3';
+
+    constexpr TestSet testSet[] {
+        {1, '1', false}, {9, '1', false}, {20, '1', false}, {30, '1', true},
+        {36, '2', false}, {4, '2', false}, {50, '2', false}, {60, '2', true},
+        {8, '3', false}, {72, '3', false}, {60, '3', false}, {10, '3', true},
+        {1, '4', true}};
+
+    SudokuSseParallelEnumerator enumerator("", 0);
+    for(const auto& test : testSet) {
+        CPPUNIT_ASSERT_EQUAL(test.expected, enumerator.canSetCell(puzzle, test.cellIndex, test.cell));
+    }
+}
+
+void SudokuSseParallelEnumeratorTest::test_Enumerate() {
+    struct TestSet {
+        size_t blankCells;
+        SudokuPatternCount expected;
+    };
+
+    constexpr TestSet testSet[] {{0, 1}, {18, 4}, {26, 96}, {27, 288}};
+    const std::string solutionStr = "835126749416397258792548631643912875981754362527683194269835417178469523354271986";
+    auto pParallelRunner = Sudoku::CreateParallelRunner();
+
+    for(const auto& test : testSet) {
+        const auto presetStr = solutionStr.substr(0, solutionStr.size() - test.blankCells);
+        for(SudokuIndex splitDepth=0; splitDepth<8; splitDepth+=3) {
+            for(SudokuSseParallelEnumerator::NumberOfCores numberOfThreads=1; numberOfThreads<=4; ++numberOfThreads) {
+                SudokuSseParallelEnumerator enumerator(presetStr, splitDepth);
+                CPPUNIT_ASSERT_EQUAL(test.expected, enumerator.Enumerate(*pParallelRunner, numberOfThreads));
+            }
+        }
+    }
+}
+
 // Call before running a test
 void SudokuSseTest::setUp()
 {
@@ -3069,6 +3358,73 @@ void SudokuSseTest::test_CheckConsistency() {
     return;
 }
 
+void SudokuSseTest::test_FindLockedCandidates() {
+    constexpr SudokuSseElement candidate = 1;
+    constexpr SudokuSseElement allCandidates = 0x1ff;
+
+    // Returns an index of regVal and a bit position of a cell
+    auto cellPosition = [](SudokuIndex cellIndex, size_t& regIndex, SudokuIndex& shift) {
+        const auto row = cellIndex / Sudoku::SizeOfCellsPerGroup;
+        const auto column = cellIndex % Sudoku::SizeOfCellsPerGroup;
+        regIndex = row * 4 + Sudoku::SizeOfBoxesOnEdge - 1 - column / Sudoku::SizeOfCellsOnBoxEdge;
+        shift = Sudoku::SizeOfCandidates * (Sudoku::SizeOfCellsOnBoxEdge - 1 - column % Sudoku::SizeOfCellsOnBoxEdge);
+    };
+
+    for(const auto& test : SudokuTestLockedCandidates::testSet) {
+        RowRegisterSet xmmRegSet;
+        for(size_t i=0; i<arraySizeof(xmmRegSet.regVal); ++i) {
+            xmmRegSet.regVal[i] = ((i % 4) == 3) ? 0 : 0x7ffffff;
+        }
+
+        for(const auto cellIndex : test.preset) {
+            size_t regIndex = 0;
+            SudokuIndex shift = 0;
+            cellPosition(cellIndex, regIndex, shift);
+            xmmRegSet.regVal[regIndex] &= ~(candidate << shift);
+        }
+
+        for(SudokuIndex trial=0; trial<2; ++trial) {
+            gRegister changed = 0;
+            asm volatile (
+                "movdqa  xmm1,  xmmword ptr [rsi]\n\t"
+                "movdqa  xmm2,  xmmword ptr [rsi+16]\n\t"
+                "movdqa  xmm3,  xmmword ptr [rsi+32]\n\t"
+                "movdqa  xmm4,  xmmword ptr [rsi+48]\n\t"
+                "movdqa  xmm5,  xmmword ptr [rsi+64]\n\t"
+                "movdqa  xmm6,  xmmword ptr [rsi+80]\n\t"
+                "movdqa  xmm7,  xmmword ptr [rsi+96]\n\t"
+                "movdqa  xmm8,  xmmword ptr [rsi+112]\n\t"
+                "movdqa  xmm9,  xmmword ptr [rsi+128]\n\t"
+                "call testFindLockedCandidates\n\t"
+                "movdqa  xmmword ptr [rsi], xmm1\n\t"
+                "movdqa  xmmword ptr [rsi+16], xmm2\n\t"
+                "movdqa  xmmword ptr [rsi+32], xmm3\n\t"
+                "movdqa  xmmword ptr [rsi+48], xmm4\n\t"
+                "movdqa  xmmword ptr [rsi+64], xmm5\n\t"
+                "movdqa  xmmword ptr [rsi+80], xmm6\n\t"
+                "movdqa  xmmword ptr [rsi+96], xmm7\n\t"
+                "movdqa  xmmword ptr [rsi+112], xmm8\n\t"
+                "movdqa  xmmword ptr [rsi+128], xmm9\n\t"
+                :"=a"(changed):"S"(&xmmRegSet):"rbx","r15","memory");
+
+            // Removes candidates at the first trial and nothing at the second trial
+            const gRegister expected = (trial == 0) ? 1 : 0;
+            CPPUNIT_ASSERT_EQUAL(expected, changed);
+
+            for(SudokuIndex cellIndex=0; cellIndex<Sudoku::SizeOfAllCells; ++cellIndex) {
+                size_t regIndex = 0;
+                SudokuIndex shift = 0;
+                cellPosition(cellIndex, regIndex, shift);
+                const SudokuSseElement expectedCell = allCandidates &
+                    ~(SudokuTestLockedCandidates::IsRemoved(test, cellIndex) ? candidate : 0);
+                CPPUNIT_ASSERT_EQUAL(expectedCell, (xmmRegSet.regVal[regIndex] >> shift) & allCandidates);
+            }
+        }
+    }
+
+    return;
+}
+
 void SudokuSseTest::test_FastCollectCandidatesAtRow() {
     struct TestSet {
         gRegister arghigh;
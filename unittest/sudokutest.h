@@ -85,6 +85,66 @@ namespace SudokuTestPosition {
     constexpr SudokuIndex Last = Sudoku::SizeOfAllCells - 1;  // last and bottom-right corner
 };
 
+// Cells that lack 1 in a puzzle and cells that lose 1 by the locked candidates method
+namespace SudokuTestLockedCandidates {
+    constexpr SudokuIndex SizeOfCells = 6;
+    struct TestSet {
+        SudokuIndex preset[SizeOfCells];
+        SudokuIndex expected[SizeOfCells];
+    };
+
+    constexpr TestSet testSet[] {
+        // Pointing in a row
+        {{9, 10, 11, 18, 19, 20}, {3, 4, 5, 6, 7, 8}},
+        // Pointing in a column
+        {{1, 2, 10, 11, 19, 20}, {27, 36, 45, 54, 63, 72}},
+        // Claiming in a row
+        {{3, 4, 5, 6, 7, 8}, {9, 10, 11, 18, 19, 20}},
+        // Claiming in a column
+        {{27, 36, 45, 54, 63, 72}, {1, 2, 10, 11, 19, 20}}
+    };
+
+    inline bool IsRemoved(const TestSet& test, SudokuIndex cellIndex) {
+        for(SudokuIndex i=0; i<SizeOfCells; ++i) {
+            if ((test.preset[i] == cellIndex) || (test.expected[i] == cellIndex)) {
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+// Naked and hidden subsets in the top row and other cells hold all candidates
+namespace SudokuTestSubsets {
+    struct TestSet {
+        SudokuCellCandidates preset[Sudoku::SizeOfCellsPerGroup];
+        SudokuCellCandidates expected[Sudoku::SizeOfCellsPerGroup];
+        bool found;
+    };
+
+    constexpr SudokuCellCandidates All = SudokuTestCandidates::All;
+    constexpr TestSet testSet[] {
+        // Naked pair [1,2]
+        {{0x3, All, All, All, 0x3, All, All, All, All},
+         {0x3, 0x1fc, 0x1fc, 0x1fc, 0x3, 0x1fc, 0x1fc, 0x1fc, 0x1fc}, true},
+        // Naked triple [1,2], [2,3], [1,3]
+        {{0x3, All, All, 0x6, All, All, 0x5, All, All},
+         {0x3, 0x1f8, 0x1f8, 0x6, 0x1f8, 0x1f8, 0x5, 0x1f8, 0x1f8}, true},
+        // Hidden pair [1,2]
+        {{All, 0x1fc, 0x1fc, 0x1fc, All, 0x1fc, 0x1fc, 0x1fc, 0x1fc},
+         {0x3, 0x1fc, 0x1fc, 0x1fc, 0x3, 0x1fc, 0x1fc, 0x1fc, 0x1fc}, true},
+        // Hidden triple [1,2,3]
+        {{All, 0x1f8, 0x1f8, All, 0x1f8, 0x1f8, All, 0x1f8, 0x1f8},
+         {0x7, 0x1f8, 0x1f8, 0x7, 0x1f8, 0x1f8, 0x7, 0x1f8, 0x1f8}, true},
+        // A filled cell [1] does not make a hidden pair [1,2]
+        {{All, 0x1fc, 0x1fc, 0x1fc, All, 0x1fc, 0x1fc, 0x1fc, 0x1},
+         {All, 0x1fc, 0x1fc, 0x1fc, All, 0x1fc, 0x1fc, 0x1fc, 0x1}, false},
+        // Nothing to remove
+        {{All, All, All, All, All, All, All, All, All},
+         {All, All, All, All, All, All, All, All, All}, false}
+    };
+}
+
 // These cases are based on the book;
 // Dennis E. Shasha (May 2007), "Puzzles for Programmers and Pros", Wrox
 // (I read its Japanese translation published by Ohmsha).
@@ -133,6 +193,30 @@ namespace SudokuTestPattern {
         {NoBacktrackString, NoBacktrackPreset, NoBacktrackResult, false},
     };
 
+    // 16x16 and 25x25 puzzles which have unique solutions (1..9 and A..P mean 1..25)
+    const std::string Grid16String =
+        ".8..1F......3.G.E.1A..C.25......2.......D7..F.......53G2E..A8..."
+        "52....FB....E1...EA..D.7..289.....4...8..A.3D..C7..6.E......25.G"
+        "..9B..5...4....D3A25.........F1..G...4..69.........1D..8..A5.6.."
+        "C.693.2..FBE.......D....C67.1A..4...85.....2..9..13.6.9......4.F";
+    const std::string Grid16Solution =
+        "D87C1FAE9B6432G5EF1A78CD253G694B235GB649D78CFEA196B453G2E1FA8DC7"
+        "52G849FB7CD6E13A1EA3CD675G289BF4B94FG2851AE3D76C7DC6AE31B49F258G"
+        "6C9B2A53FE41G87D3A259CB68DG74F1E8GD7E41F69CBA352F4E1DG7832A5C6B9"
+        "C769312A4FBE5GD8G58DFBE4C6791A234BFE85DGA3127C96A132679CG85DB4EF";
+    const std::string Grid25String =
+        "EP.9.74.8K..J..H.L5O.A2....B..H..G.....4.9.EMNC....LO..N.J.CA1.I2.8K4F..E..3C..NDE....HO.51I..B...8F4...7.2.IAPDM..N...J.L.G."
+        "..6K.EM..D..G.O2C...4..L8M.9A......N.6...P.O..1..IF78L...IC1DE.AM3KNJ6.HO...HG.5..6.N..ICB4L..8..MA9..IC2.....7.8LF.....3NJK6"
+        "I.C..O...5.FLH8.1E.AJ36....K...9..E5.PDG.N...F.8.L9E.1M...H...K..O...P...NC..P.O.6K7..BC..FH4..M.....4...BI.N....19.....O5.DP"
+        "76.FK.1...GPEMD.JI...8H..D.E..K...6I...NL..H.A91.2N.3JC...MG..5O.AB.....7F....B.LH5..6...7.MGDECI.J3.85.......9.2B...6..PGDME"
+        "....69A...OGD..I3.CN8F.5..BN3I.P.....H5.9.....J.4..F...I.N3.M912A.4......ED.ODE.6K7.JB.N3C...L..MA21A..2..L....6.....OPD..C..";
+    const std::string Grid25Solution =
+        "EPM9D74F8KCNJ63HGL5O1A2IB2ABI1H5OGLK7F84D9PEMNC36J5LOGHN3J6CA1BI278K4FDPE9M3CJ6NDEM9PLHOG51IA2B7K48F4KF8712BIAPDM9EN6C3JHL5GO"
+        "JN6K3EM9ADH5GPO2C1BI47FL8MD9AE4F8L7N36KJ5PHOG21BCIF78L42BIC1DE9AM3KNJ65HOPGOHGP53J6KN12ICB4L7F8EDMA9B1IC25OGPH748LFEADM93NJK6"
+        "I2CNBOGPD54FLH8M1E9AJ367K63K7JM9A1E5OPDGBN2ICF48HL9EA1MF8LH43JK76OD5GPB2INCG5PDOJ6K732BCNIFH48LME91A84LHFBICN2EMA19J736KO5GDP"
+        "764FKA12B9GPEMDCJIN3L8HO5DGEMPK74F6IC3JNLO8H5A91B2NI3JCPDEMG8L5OHAB912K67F4192BALH5O86K4F7PMGDECINJ3H85OLCN3JI9A2B1KF674PGDME"
+        "KJ7469A12MOGDEPI3BCN8FL5HCBN3IGPDEOF8H5L92MA16JK47LFH58ICN3BM912A64JK7GOPEDPODEG6K74JBIN3C85FLH9MA21AM1298LH5FJ674KGEOPDIBC3N";
+
     struct TestArgs {
         int    argc;
         const char* argv[4];
@@ -4,6 +4,8 @@
 // I use CppUnit code on the website.
 // http://www.atmarkit.co.jp/fdotnet/cpptest/cpptest02/cpptest02_03.html
 
+#include <cstdio>
+#include <fstream>
 #include <functional>
 #include <cppunit/extensions/HelperMacros.h>
 #include "sudoku.h"
@@ -122,6 +124,40 @@ protected:
 
 class SudokuProcessorBinderTest : public CPPUNIT_NS::TestFixture {};
 
+class SudokuMappedFileTest : public CPPUNIT_NS::TestFixture {
+protected:
+    // Call from derived classes
+    void checkMappedFile(void) {
+        const std::string filename = "sudoku_mapped_file_test.txt";
+        std::remove(filename.c_str());
+        {
+            auto pMappedFile = Sudoku::CreateMappedFile(filename);
+            CPPUNIT_ASSERT(pMappedFile->GetData() == nullptr);
+            CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), pMappedFile->GetSize());
+        }
+
+        // Empty files are not mapped
+        const std::string contentSet[] = {"", "1\n23\n456"};
+        for(const auto& content : contentSet) {
+            {
+                std::ofstream os(filename, std::ios::binary);
+                os << content;
+            }
+
+            auto pMappedFile = Sudoku::CreateMappedFile(filename);
+            CPPUNIT_ASSERT_EQUAL(content.size(), pMappedFile->GetSize());
+            if (content.empty()) {
+                CPPUNIT_ASSERT(pMappedFile->GetData() == nullptr);
+            } else {
+                const std::string actual(pMappedFile->GetData(), pMappedFile->GetSize());
+                CPPUNIT_ASSERT_EQUAL(content, actual);
+            }
+        }
+
+        std::remove(filename.c_str());
+    }
+};
+
 /*
 Local Variables:
 mode: c++
@@ -70,7 +70,19 @@ protected:
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(SudokuWindowsTimerTest);
+class SudokuWindowsMappedFileTest : public SudokuMappedFileTest {
+    CPPUNIT_TEST_SUITE(SudokuWindowsMappedFileTest);
+    CPPUNIT_TEST(test_Constructor);
+    CPPUNIT_TEST_SUITE_END();
+public:
+    void setUp() override;
+    void tearDown() override;
+protected:
+    void test_Constructor();
+};
+
 CPPUNIT_TEST_SUITE_REGISTRATION(SudokuWindowsProcessorBinderTest);
+CPPUNIT_TEST_SUITE_REGISTRATION(SudokuWindowsMappedFileTest);
 
 // Call before running a test
 void SudokuWindowsTimerTest::setUp() {
@@ -212,6 +224,21 @@ void SudokuWindowsProcessorBinderTest::test_Constructor() {
     CPPUNIT_ASSERT(!pConcreteBinder->failed_);
 }
 
+// Call before running a test
+void SudokuWindowsMappedFileTest::setUp() {
+    return;
+}
+
+// Call after running a test
+void SudokuWindowsMappedFileTest::tearDown() {
+    return;
+}
+
+// Test cases
+void SudokuWindowsMappedFileTest::test_Constructor() {
+    checkMappedFile();
+}
+
 /*
 Local Variables:
 mode: c++